@@ -0,0 +1,230 @@
+#include <WSBench/WSBench.h>
+
+#include <random>
+
+/*
+ * WeissBitStreamBench [options]
+ *
+ * Writes & reads back random fields of random widths with LSB & MSB first bit streams & reports their throughput,
+ * against a reader that loads a byte at a time (what the snapshot codec used before WSBitStream.h).
+ * The decode pass peeks a 15 bit Huffman code, looks its length up & consumes it, as an inflater does.
+ *
+ * Options :
+ *   -n <fields>   Fields per pass (defaults to 4194304)
+ *   -w <bits>     Widest field, from 1 to 56 (defaults to 24)
+ *   -r <passes>   Measured passes (defaults to 8)
+ */
+
+struct BenchOptions {
+    size_t   m_nFields  = 4194304u;
+    uint32_t m_maxWidth = 24u;
+    size_t   m_nPasses  = 8u;
+};
+
+constexpr const uint32_t HUFFMAN_BITS = 15u;
+
+static void PrintUsage() noexcept
+{
+    WS::Print("Usage : WeissBitStreamBench [-n <fields>] [-w <bits>] [-r <passes>]");
+}
+
+// Loads a byte whenever the buffer runs short, least significant bit first
+class ByteBitReader {
+private:
+    const uint8_t* m_pData;
+    size_t         m_size;
+    size_t         m_offset = 0u;
+    uint64_t       m_bits   = 0u;
+    uint32_t       m_count  = 0u;
+
+public:
+    ByteBitReader(const uint8_t* data, const size_t size) noexcept : m_pData(data), m_size(size) {  }
+
+    [[nodiscard]] inline uint64_t Read(const uint32_t count) noexcept
+    {
+        while (this->m_count < count) {
+            const uint64_t byte = (this->m_offset < this->m_size) ? this->m_pData[this->m_offset] : 0u;
+
+            this->m_bits  |= byte << this->m_count;
+            this->m_count += 8u;
+            this->m_offset++;
+        }
+
+        const uint64_t value = this->m_bits & ((uint64_t(1u) << count) - 1u);
+
+        this->m_bits  >>= count;
+        this->m_count -= count;
+
+        return value;
+    }
+};
+
+struct PassResult {
+    double                m_nanoseconds = 0.0;
+    uint64_t              m_checksum    = 0u;
+    WS::PerfCounterValues m_counters;
+};
+
+// Runs "function" once to warm up, then "nPasses" times, "function" returns a checksum that keeps the reads alive
+template <typename _F>
+static PassResult MeasurePasses(const size_t nPasses, const _F& function) noexcept
+{
+    PassResult result;
+    result.m_checksum = function();
+
+    const WS::PerfScope scope(WS::GetBenchCounters(), result.m_counters);
+    const uint64_t      start = WS::GetBenchTimestamp();
+
+    for (size_t p = 0u; p < nPasses; p++)
+        result.m_checksum += function();
+
+    result.m_nanoseconds = static_cast<double>(WS::GetBenchTimestamp() - start) / static_cast<double>(nPasses);
+
+    return result;
+}
+
+static void PrintPass(const char* name, const PassResult& result, const size_t nFields, const size_t nBytes, const size_t nPasses) noexcept
+{
+    WS::Print(std::fixed, std::setprecision(2), name, " : ",
+              static_cast<double>(nFields) / result.m_nanoseconds * 1000.0, " M fields/s, ",
+              static_cast<double>(nBytes) / result.m_nanoseconds, " GB/s",
+              WS::FormatPerfCounters(result.m_counters, nFields * nPasses, "field"),
+              std::defaultfloat, std::setprecision(6));
+}
+
+template <WS::BitOrder _ORDER>
+static void RunOrder(const BenchOptions& options, const std::vector<uint64_t>& values, const std::vector<uint8_t>& widths, const std::vector<uint8_t>& codeLengths) noexcept
+{
+    const char* order = (_ORDER == WS::BitOrder::LSB_FIRST) ? "LSB" : "MSB";
+
+    std::vector<uint8_t> stream;
+    stream.reserve(values.size() * 8u + WS::WS_BIT_STREAM_PADDING);
+
+    const PassResult write = MeasurePasses(options.m_nPasses, [&]() {
+        stream.clear();
+
+        WS::BitWriter<_ORDER> writer(stream);
+        for (size_t i = 0u; i < values.size(); i++)
+            writer.Write(values[i], widths[i]);
+
+        writer.Flush();
+
+        return static_cast<uint64_t>(stream.size());
+    });
+
+    const size_t nBytes = stream.size();
+
+    // Unchecked readers may load up to WS_BIT_STREAM_PADDING bytes past the stream
+    std::vector<uint8_t> padded = stream;
+    padded.resize(nBytes + WS::WS_BIT_STREAM_PADDING, 0u);
+
+    const PassResult checked = MeasurePasses(options.m_nPasses, [&]() {
+        WS::BitReader<_ORDER, true> reader(stream.data(), nBytes);
+        uint64_t checksum = 0u;
+
+        for (size_t i = 0u; i < values.size(); i++)
+            checksum += reader.Read(widths[i]);
+
+        return checksum;
+    });
+
+    const PassResult unchecked = MeasurePasses(options.m_nPasses, [&]() {
+        WS::BitReader<_ORDER, false> reader(padded.data(), nBytes);
+        uint64_t checksum = 0u;
+
+        for (size_t i = 0u; i < values.size(); i++)
+            checksum += reader.Read(widths[i]);
+
+        return checksum;
+    });
+
+    // A refill covers several codes : up to 56 bits, 3 codes of at most 15 bits
+    const PassResult huffman = MeasurePasses(options.m_nPasses, [&]() {
+        WS::BitReader<_ORDER, true> reader(stream.data(), nBytes);
+        uint64_t checksum = 0u;
+        const size_t nCodes = nBytes * 8u / HUFFMAN_BITS;
+
+        for (size_t i = 0u; i < nCodes;) {
+            reader.Refill();
+
+            for (size_t c = 0u; c < 3u && i < nCodes; c++, i++) {
+                const uint64_t code = reader.Peek(HUFFMAN_BITS);
+
+                reader.Consume(codeLengths[code]);
+                checksum += code;
+            }
+        }
+
+        return checksum;
+    });
+
+    uint64_t expected = 0u;
+    for (const uint64_t value : values)
+        expected += value;
+
+    const bool bMatches = (checked.m_checksum == unchecked.m_checksum) && (checked.m_checksum == expected * (options.m_nPasses + 1u));
+
+    WS::Print("\n", order, " first : ", nBytes, " bytes per pass", bMatches ? "" : " (READ BACK VALUES DON'T MATCH)");
+
+    PrintPass("  Write             ", write, values.size(), nBytes, options.m_nPasses);
+    PrintPass("  Read (checked)    ", checked, values.size(), nBytes, options.m_nPasses);
+    PrintPass("  Read (unchecked)  ", unchecked, values.size(), nBytes, options.m_nPasses);
+    PrintPass("  Peek / Consume    ", huffman, nBytes * 8u / HUFFMAN_BITS, nBytes, options.m_nPasses);
+
+    if constexpr (_ORDER == WS::BitOrder::LSB_FIRST) {
+        const PassResult bytes = MeasurePasses(options.m_nPasses, [&]() {
+            ByteBitReader reader(stream.data(), nBytes);
+            uint64_t checksum = 0u;
+
+            for (size_t i = 0u; i < values.size(); i++)
+                checksum += reader.Read(widths[i]);
+
+            return checksum;
+        });
+
+        PrintPass("  Read (bytewise)   ", bytes, values.size(), nBytes, options.m_nPasses);
+    }
+}
+
+int WS::EntryPoint(int argc, char** argv) {
+    BenchOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-n" && i + 1 < argc) {
+            options.m_nFields = std::max<size_t>(1u, std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "-w" && i + 1 < argc) {
+            options.m_maxWidth = std::clamp<uint32_t>(static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)), 1u, WS::WS_BIT_STREAM_MAX_BITS);
+        } else if (argument == "-r" && i + 1 < argc) {
+            options.m_nPasses = std::max<size_t>(1u, std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    std::mt19937_64 random(42u);
+    std::uniform_int_distribution<uint32_t> width(1u, options.m_maxWidth);
+
+    std::vector<uint64_t> values(options.m_nFields);
+    std::vector<uint8_t>  widths(options.m_nFields);
+
+    for (size_t i = 0u; i < options.m_nFields; i++) {
+        widths[i] = static_cast<uint8_t>(width(random));
+        values[i] = random() & ((uint64_t(1u) << widths[i]) - 1u);
+    }
+
+    // Code lengths of a typical literal / length alphabet, from 5 to 12 bits
+    std::vector<uint8_t> codeLengths(size_t(1u) << HUFFMAN_BITS);
+    for (uint8_t& length : codeLengths)
+        length = static_cast<uint8_t>(5u + random() % 8u);
+
+    WS::Print("Fields   : ", options.m_nFields, " of 1 to ", options.m_maxWidth, " bits, ", options.m_nPasses, " passes");
+    WS::Print("Counters : ", WS::GetBenchCounters().Describe());
+
+    RunOrder<WS::BitOrder::LSB_FIRST>(options, values, widths, codeLengths);
+    RunOrder<WS::BitOrder::MSB_FIRST>(options, values, widths, codeLengths);
+
+    return 0;
+}
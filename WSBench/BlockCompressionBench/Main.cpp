@@ -0,0 +1,149 @@
+#include <WSBench/WSBench.h>
+
+#include <random>
+
+/*
+ * WeissBlockCompressionBench [options]
+ *
+ * Measures the CPU encoders in megapixels per second & the PSNR of their output on a synthetic image (gradients, edges & noise),
+ * then encodes a solid 4x4 block of every value of every channel & reports the largest error once decoded.
+ * Solid blocks should decode within a level of their color, a larger error is flagged.
+ *
+ * Hardware counters only count the calling thread, they're read per pixel over a strip of the image
+ * short enough to be encoded & decoded without the encoder's worker threads.
+ *
+ * Options :
+ *   -w <pixels>   Width & height of the synthetic image (defaults to 1024)
+ */
+
+struct BenchOptions {
+    uint32_t m_size = 1024u;
+};
+
+static void PrintUsage() noexcept
+{
+    WS::Print("Usage : WeissBlockCompressionBench [-w <pixels>]");
+}
+
+[[nodiscard]] static WS::Image MakeSyntheticImage(const uint32_t size) noexcept
+{
+    WS::Image    image(size, size);
+    std::mt19937 random(42u);
+
+    for (uint32_t y = 0u; y < size; y++) {
+        for (uint32_t x = 0u; x < size; x++) {
+            const uint32_t noise = random() & 15u;
+            const bool     bEdge = ((x / 37u) + (y / 29u)) % 2u == 0u;
+
+            image.SetPixelColor(x, y, WS::Coloru8(static_cast<uint8_t>(x * 255u / size),
+                                                  static_cast<uint8_t>(bEdge ? 200u + noise : 40u + noise),
+                                                  static_cast<uint8_t>(y * 255u / size),
+                                                  static_cast<uint8_t>(bEdge ? 255u : 128u + x % 128u)));
+        }
+    }
+
+    return image;
+}
+
+// Largest per channel error of solid blocks, channels are swept one at a time over every value while the others vary
+[[nodiscard]] static uint32_t MeasureSolidBlockError(const WS::TextureFormat format, const bool bAlpha) noexcept
+{
+    uint32_t maxError = 0u;
+
+    for (uint32_t channel = 0u; channel < 3u; channel++) {
+        for (uint32_t value = 0u; value < 256u; value++) {
+            WS::Coloru8 color(static_cast<uint8_t>(value * 7u + 91u), static_cast<uint8_t>(255u - value), static_cast<uint8_t>(value * 13u), 255u);
+            color.m_arr[channel] = static_cast<uint8_t>(value);
+
+            WS::Image block(4u, 4u);
+            for (uint32_t i = 0u; i < 16u; i++)
+                block.GetBuffer()[i] = color;
+
+            const std::vector<uint8_t> encoded = WS::EncodeBlocks(block, format);
+            const WS::Image            decoded = WS::DecodeBlocks(encoded.data(), format, 4u, 4u);
+
+            for (uint32_t i = 0u; i < 16u; i++)
+                for (uint32_t c = 0u; c < (bAlpha ? 4u : 3u); c++)
+                    maxError = std::max<uint32_t>(maxError, static_cast<uint32_t>(std::abs(static_cast<int>(decoded.GetBuffer()[i].m_arr[c]) - static_cast<int>(color.m_arr[c]))));
+        }
+    }
+
+    return maxError;
+}
+
+// Top rows of "image", fewer block rows than the encoder spreads over threads
+[[nodiscard]] static WS::Image MakeCounterStrip(const WS::Image& image) noexcept
+{
+    const uint32_t height = std::min<uint32_t>(image.GetHeight(), 28u);
+
+    WS::Image strip(image.GetWidth(), height);
+    std::memcpy(strip.GetBuffer(), image.GetBuffer(), static_cast<size_t>(strip.GetPixelCount()) * sizeof(WS::Coloru8));
+
+    return strip;
+}
+
+static void RunFormat(const WS::Image& image, const WS::Image& strip, const char* name, const WS::TextureFormat format, const WS::BC7Quality quality, const bool bAlpha) noexcept
+{
+    const double megapixels = static_cast<double>(image.GetPixelCount()) / 1e6;
+
+    std::vector<uint8_t> encoded(WS::GetTextureLevelSize(format, image.GetWidth(), image.GetHeight()));
+
+    const uint64_t encodeStart = WS::GetBenchTimestamp();
+    WS::EncodeBlocks(image, format, encoded.data(), quality);
+    const uint64_t encodeTime = std::max<uint64_t>(WS::GetBenchTimestamp() - encodeStart, 1u);
+
+    const uint64_t  decodeStart = WS::GetBenchTimestamp();
+    const WS::Image decoded     = WS::DecodeBlocks(encoded.data(), format, image.GetWidth(), image.GetHeight());
+    const uint64_t  decodeTime  = std::max<uint64_t>(WS::GetBenchTimestamp() - decodeStart, 1u);
+
+    std::vector<uint8_t>  encodedStrip(WS::GetTextureLevelSize(format, strip.GetWidth(), strip.GetHeight()));
+    WS::PerfCounterValues encodeCounters, decodeCounters;
+
+    {
+        const WS::PerfScope scope(WS::GetBenchCounters(), encodeCounters);
+        WS::EncodeBlocks(strip, format, encodedStrip.data(), quality);
+    }
+
+    {
+        const WS::PerfScope scope(WS::GetBenchCounters(), decodeCounters);
+        const WS::Image     decodedStrip = WS::DecodeBlocks(encodedStrip.data(), format, strip.GetWidth(), strip.GetHeight());
+    }
+
+    const uint32_t solidError = MeasureSolidBlockError(format, bAlpha);
+    const size_t   nPixels    = static_cast<size_t>(strip.GetPixelCount());
+
+    WS::Print(std::fixed, std::setprecision(2),
+              name, " : PSNR ", WS::ComputePSNR(image, decoded, bAlpha), " dB, solid block error ", solidError, solidError > 1u ? " (SOLID BLOCKS ARE OFF)" : "", "\n",
+              "  encode   : ", megapixels / (static_cast<double>(encodeTime) / 1e9), " MP/s", WS::FormatPerfCounters(encodeCounters, nPixels, "pixel"), "\n",
+              "  decode   : ", megapixels / (static_cast<double>(decodeTime) / 1e9), " MP/s", WS::FormatPerfCounters(decodeCounters, nPixels, "pixel"),
+              std::defaultfloat, std::setprecision(6));
+}
+
+int WS::EntryPoint(int argc, char** argv) {
+    BenchOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-w" && i + 1 < argc) {
+            options.m_size = std::max<uint32_t>(4u, static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10)));
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    const WS::Image image = MakeSyntheticImage(options.m_size);
+    const WS::Image strip = MakeCounterStrip(image);
+
+    WS::Print(options.m_size, "x", options.m_size, " synthetic image");
+    WS::Print("Counters : ", WS::GetBenchCounters().Describe());
+
+    RunFormat(image, strip, "BC1        ", WS::TextureFormat::BC1, WS::BC7Quality::NORMAL, false);
+    RunFormat(image, strip, "BC3        ", WS::TextureFormat::BC3, WS::BC7Quality::NORMAL, true);
+    RunFormat(image, strip, "BC7 fast   ", WS::TextureFormat::BC7, WS::BC7Quality::FAST,   true);
+    RunFormat(image, strip, "BC7 normal ", WS::TextureFormat::BC7, WS::BC7Quality::NORMAL, true);
+    RunFormat(image, strip, "BC7 slow   ", WS::TextureFormat::BC7, WS::BC7Quality::SLOW,   true);
+
+    return 0;
+}
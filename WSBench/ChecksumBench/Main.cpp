@@ -0,0 +1,270 @@
+#include <WSBench/WSBench.h>
+
+#include <random>
+
+/*
+ * WeissChecksumBench [options]
+ *
+ * Measures CRC32, CRC32C & Adler-32 in GB/s on a cache resident & a memory bound buffer by default, next to the speed of
+ * summing the buffer (what memory bandwidth allows) & of a byte at a time CRC32 table. The multi-threaded pass checksums
+ * a slice of the buffer per thread & merges the slices with CombineCrc32 / CombineCrc32C / CombineAdler32.
+ * Every kernel is checked against a plain reference (byte at a time tables & a scalar Adler-32) on the measured buffers
+ * & on every size up to 5000 bytes at 4 alignments, so that a dispatched kernel computing wrong results gets flagged.
+ *
+ * Options :
+ *   -s <bytes,...>   Buffer sizes (defaults to 32768,67108864)
+ *   -t <bytes>       Bytes processed per measurement (defaults to 1073741824)
+ *   -j <threads>     Threads of the multi-threaded pass (defaults to the hardware threads)
+ */
+
+struct BenchOptions {
+    std::vector<size_t> m_sizes          = { 32768u, 67108864u };
+    size_t              m_bytesPerResult = 1073741824u;
+    size_t              m_nThreads       = std::max<size_t>(1u, std::thread::hardware_concurrency());
+};
+
+static void PrintUsage() noexcept
+{
+    WS::Print("Usage : WeissChecksumBench [-s <bytes,...>] [-t <bytes>] [-j <threads>]");
+}
+
+[[nodiscard]] static std::vector<size_t> ParseList(const char* text) noexcept
+{
+    std::vector<size_t> values;
+    std::stringstream   stream(text);
+    std::string         value;
+
+    while (std::getline(stream, value, ','))
+        if (const size_t parsed = std::strtoul(value.c_str(), nullptr, 10); parsed > 0u)
+            values.push_back(parsed);
+
+    return values;
+}
+
+// The classic single table CRC, what most code does without slicing or SIMD ("_POLYNOMIAL" is reflected)
+template <uint32_t _POLYNOMIAL>
+[[nodiscard]] static uint32_t CrcBytewise(const uint8_t* data, const size_t size) noexcept
+{
+    static const std::array<uint32_t, 256u> table = []() {
+        std::array<uint32_t, 256u> entries{};
+
+        for (uint32_t b = 0u; b < 256u; b++) {
+            uint32_t crc = b;
+
+            for (uint32_t k = 0u; k < 8u; k++)
+                crc = (crc & 1u) ? (crc >> 1u) ^ _POLYNOMIAL : crc >> 1u;
+
+            entries[b] = crc;
+        }
+
+        return entries;
+    }();
+
+    uint32_t crc = ~0u;
+    for (size_t i = 0u; i < size; i++)
+        crc = (crc >> 8u) ^ table[(crc ^ data[i]) & 0xFFu];
+
+    return ~crc;
+}
+
+[[nodiscard]] static inline uint32_t Crc32Bytewise(const uint8_t* data, const size_t size) noexcept { return CrcBytewise<0xEDB88320u>(data, size); }
+
+[[nodiscard]] static inline uint32_t Crc32CBytewise(const uint8_t* data, const size_t size) noexcept { return CrcBytewise<0x82F63B78u>(data, size); }
+
+// Adler-32 a byte at a time, reduced every 5552 bytes (the most that can't overflow 32 bits)
+[[nodiscard]] static uint32_t Adler32Scalar(const uint8_t* data, const size_t size) noexcept
+{
+    uint32_t a = 1u, b = 0u;
+
+    for (size_t begin = 0u; begin < size; begin += 5552u) {
+        for (size_t i = begin; i < std::min<size_t>(begin + 5552u, size); i++) {
+            a += data[i];
+            b += a;
+        }
+
+        a %= 65521u;
+        b %= 65521u;
+    }
+
+    return (b << 16u) | a;
+}
+
+// " (CRC32C DOESN'T MATCH ...)" for every kernel disagreeing with its reference on "data", empty when they all agree
+[[nodiscard]] static std::string CheckAgainstReferences(const uint8_t* data, const size_t size) noexcept
+{
+    std::string mismatches;
+
+    if (WS::Crc32(data, size) != Crc32Bytewise(data, size))
+        mismatches += " (CRC32 DOESN'T MATCH THE BYTEWISE TABLE)";
+
+    if (WS::Crc32C(data, size) != Crc32CBytewise(data, size))
+        mismatches += " (CRC32C DOESN'T MATCH THE BYTEWISE TABLE)";
+
+    if (WS::Adler32(data, size) != Adler32Scalar(data, size))
+        mismatches += " (ADLER-32 DOESN'T MATCH THE SCALAR LOOP)";
+
+    return mismatches;
+}
+
+// Checks every size up to "maxSize" at 4 alignments, the kernels' heads & tails are where they differ from one size to the next
+[[nodiscard]] static std::string CheckSizesAgainstReferences(const size_t maxSize) noexcept
+{
+    std::vector<uint8_t> buffer(maxSize + 3u);
+
+    std::mt19937_64 random(7u);
+    for (uint8_t& byte : buffer)
+        byte = static_cast<uint8_t>(random());
+
+    for (size_t offset = 0u; offset < 4u; offset++) {
+        for (size_t size = 0u; size <= maxSize; size++) {
+            const std::string mismatches = CheckAgainstReferences(buffer.data() + offset, size);
+
+            if (!mismatches.empty())
+                return mismatches + " at " + std::to_string(size) + " bytes, offset " + std::to_string(offset);
+        }
+    }
+
+    return {};
+}
+
+// Sums the buffer 8 bytes at a time : as fast as memory (or the cache) delivers it
+[[nodiscard]] static uint64_t SumWords(const uint8_t* data, const size_t size) noexcept
+{
+    uint64_t sums[4] = {};
+
+    for (size_t i = 0u; i + 32u <= size; i += 32u)
+        for (size_t w = 0u; w < 4u; w++)
+            sums[w] += WS::ReadLittleEndian<uint64_t>(data + i + w * 8u);
+
+    return sums[0] + sums[1] + sums[2] + sums[3];
+}
+
+// Gigabytes per second of "function" called on "size" bytes until about "bytesPerResult" are processed, adds its hardware counters to "counters"
+template <typename _F>
+static double MeasureThroughput(const size_t size, const size_t bytesPerResult, const _F& function, WS::PerfCounterValues& counters) noexcept
+{
+    const size_t repetitions = std::max<size_t>(1u, bytesPerResult / size);
+    uint64_t     sink        = function();
+
+    const WS::PerfScope scope(WS::GetBenchCounters(), counters);
+    const uint64_t      start = WS::GetBenchTimestamp();
+
+    // The barrier keeps pure functions of the same buffer from being computed once
+    for (size_t r = 0u; r < repetitions; r++) {
+        sink += function();
+        asm volatile("" : : : "memory");
+    }
+
+    const uint64_t elapsed = std::max<uint64_t>(WS::GetBenchTimestamp() - start, 1u);
+
+    // Keeps the results alive
+    asm volatile("" : : "r"(sink));
+
+    return static_cast<double>(size * repetitions) / static_cast<double>(elapsed);
+}
+
+// Checksums a slice per thread & combines the slices in order
+template <typename _C, typename _M>
+[[nodiscard]] static uint32_t ChecksumInParallel(const uint8_t* data, const size_t size, const size_t nThreads, const _C& checksum, const _M& combine) noexcept
+{
+    const size_t sliceSize = (size + nThreads - 1u) / nThreads;
+
+    std::vector<uint32_t>    results(nThreads, 0u);
+    std::vector<std::thread> workers;
+
+    for (size_t t = 1u; t < nThreads && t * sliceSize < size; t++)
+        workers.emplace_back([&, t]() { results[t] = checksum(data + t * sliceSize, std::min(sliceSize, size - t * sliceSize)); });
+
+    results[0] = checksum(data, std::min(sliceSize, size));
+
+    for (std::thread& worker : workers)
+        worker.join();
+
+    uint32_t result = results[0];
+    for (size_t t = 1u; t <= workers.size(); t++)
+        result = combine(result, results[t], std::min(sliceSize, size - t * sliceSize));
+
+    return result;
+}
+
+int WS::EntryPoint(int argc, char** argv) {
+    BenchOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-s" && i + 1 < argc) {
+            options.m_sizes = ParseList(argv[++i]);
+        } else if (argument == "-t" && i + 1 < argc) {
+            options.m_bytesPerResult = std::max<size_t>(1u, std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "-j" && i + 1 < argc) {
+            options.m_nThreads = std::max<size_t>(1u, std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.m_sizes.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    WS::Print("Checksums : ", WS::GetChecksumImplementations());
+    WS::Print("Counters  : ", WS::GetBenchCounters().Describe());
+
+    const std::string sizeMismatches = CheckSizesAgainstReferences(5000u);
+    WS::Print("Sizes 0 to 5000 at 4 alignments : ", sizeMismatches.empty() ? "every kernel matches its reference" : sizeMismatches.substr(1u));
+
+    for (const size_t size : options.m_sizes) {
+        std::vector<uint8_t> buffer(size);
+
+        std::mt19937_64 random(42u);
+        for (uint8_t& byte : buffer)
+            byte = static_cast<uint8_t>(random());
+
+        const uint8_t* data = buffer.data();
+
+        WS::PerfCounterValues sumCounters, bytewiseCounters, crc32Counters, crc32CCounters, adler32Counters;
+
+        const double sum      = MeasureThroughput(size, options.m_bytesPerResult, [&]() { return SumWords(data, size); }, sumCounters);
+        const double bytewise = MeasureThroughput(size, std::min<size_t>(options.m_bytesPerResult, 268435456u), [&]() { return uint64_t(Crc32Bytewise(data, size)); }, bytewiseCounters);
+        const double crc32    = MeasureThroughput(size, options.m_bytesPerResult, [&]() { return uint64_t(WS::Crc32(data, size)); }, crc32Counters);
+        const double crc32C   = MeasureThroughput(size, options.m_bytesPerResult, [&]() { return uint64_t(WS::Crc32C(data, size)); }, crc32CCounters);
+        const double adler32  = MeasureThroughput(size, options.m_bytesPerResult, [&]() { return uint64_t(WS::Adler32(data, size)); }, adler32Counters);
+
+        WS::Print(std::fixed, std::setprecision(2), "\n", size, " bytes", CheckAgainstReferences(data, size), "\n",
+                  "  Sum of words       : ", sum, " GB/s", WS::FormatPerfCounters(sumCounters, size, "byte"), "\n",
+                  "  CRC32 (bytewise)   : ", bytewise, " GB/s", WS::FormatPerfCounters(bytewiseCounters, size, "byte"), "\n",
+                  "  CRC32              : ", crc32, " GB/s", WS::FormatPerfCounters(crc32Counters, size, "byte"), "\n",
+                  "  CRC32C             : ", crc32C, " GB/s", WS::FormatPerfCounters(crc32CCounters, size, "byte"), "\n",
+                  "  Adler-32           : ", adler32, " GB/s", WS::FormatPerfCounters(adler32Counters, size, "byte"),
+                  std::defaultfloat, std::setprecision(6));
+
+        // Threads only pay off on buffers far larger than what starting them costs
+        if (options.m_nThreads < 2u || size < (size_t(1u) << 20u))
+            continue;
+
+        const auto crc32Slice   = [](const uint8_t* slice, const size_t sliceSize) { return WS::Crc32(slice, sliceSize); };
+        const auto crc32CSlice  = [](const uint8_t* slice, const size_t sliceSize) { return WS::Crc32C(slice, sliceSize); };
+        const auto adler32Slice = [](const uint8_t* slice, const size_t sliceSize) { return WS::Adler32(slice, sliceSize); };
+
+        WS::PerfCounterValues parallelCounters;
+
+        const double parallelCrc32   = MeasureThroughput(size, options.m_bytesPerResult, [&]() { return uint64_t(ChecksumInParallel(data, size, options.m_nThreads, crc32Slice, WS::CombineCrc32)); }, parallelCounters);
+        const double parallelCrc32C  = MeasureThroughput(size, options.m_bytesPerResult, [&]() { return uint64_t(ChecksumInParallel(data, size, options.m_nThreads, crc32CSlice, WS::CombineCrc32C)); }, parallelCounters);
+        const double parallelAdler32 = MeasureThroughput(size, options.m_bytesPerResult, [&]() { return uint64_t(ChecksumInParallel(data, size, options.m_nThreads, adler32Slice, WS::CombineAdler32)); }, parallelCounters);
+
+        const bool bCombinedMatch = ChecksumInParallel(data, size, options.m_nThreads, crc32Slice, WS::CombineCrc32)    == WS::Crc32(data, size)  &&
+                                    ChecksumInParallel(data, size, options.m_nThreads, crc32CSlice, WS::CombineCrc32C)  == WS::Crc32C(data, size) &&
+                                    ChecksumInParallel(data, size, options.m_nThreads, adler32Slice, WS::CombineAdler32) == WS::Adler32(data, size);
+
+        WS::Print(std::fixed, std::setprecision(2), "  ", options.m_nThreads, " threads", bCombinedMatch ? "" : " (COMBINED CHECKSUMS DON'T MATCH)", "\n",
+                  "    CRC32            : ", parallelCrc32, " GB/s\n",
+                  "    CRC32C           : ", parallelCrc32C, " GB/s\n",
+                  "    Adler-32         : ", parallelAdler32, " GB/s",
+                  std::defaultfloat, std::setprecision(6));
+    }
+
+    return 0;
+}
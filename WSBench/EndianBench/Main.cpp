@@ -0,0 +1,143 @@
+#include <WSBench/WSBench.h>
+
+#include <random>
+
+/*
+ * WeissEndianBench [options]
+ *
+ * Measures byte swaps & bit reversals of 16, 32 & 64 bit arrays in GB/s : a loop of scalar SwapEndian / ReverseBits calls
+ * against SwapEndianArray (out of place & in place) & ReverseBitsArray, on a cache resident & a memory bound buffer by default.
+ * The arrays use SSSE3 / AVX2 shuffles when the running CPU has them, whatever flags the engine is compiled with.
+ *
+ * Options :
+ *   -s <bytes,...>   Buffer sizes (defaults to 16384,67108864)
+ *   -t <bytes>       Bytes processed per measurement (defaults to 1073741824)
+ */
+
+struct BenchOptions {
+    std::vector<size_t> m_sizes          = { 16384u, 67108864u };
+    size_t              m_bytesPerResult = 1073741824u;
+};
+
+static void PrintUsage() noexcept
+{
+    WS::Print("Usage : WeissEndianBench [-s <bytes,...>] [-t <bytes>]");
+}
+
+[[nodiscard]] static std::vector<size_t> ParseList(const char* text) noexcept
+{
+    std::vector<size_t> values;
+    std::stringstream   stream(text);
+    std::string         value;
+
+    while (std::getline(stream, value, ','))
+        if (const size_t parsed = std::strtoul(value.c_str(), nullptr, 10); parsed > 0u)
+            values.push_back(parsed);
+
+    return values;
+}
+
+// Gigabytes per second of "function" called on "size" bytes until about "bytesPerResult" are processed, adds its hardware counters to "counters"
+template <typename _F>
+static double MeasureThroughput(const size_t size, const size_t bytesPerResult, const _F& function, WS::PerfCounterValues& counters) noexcept
+{
+    const size_t repetitions = std::max<size_t>(1u, bytesPerResult / size);
+
+    // Warms the caches & the page tables up
+    function();
+
+    const WS::PerfScope scope(WS::GetBenchCounters(), counters);
+    const uint64_t      start = WS::GetBenchTimestamp();
+
+    for (size_t r = 0u; r < repetitions; r++)
+        function();
+
+    return static_cast<double>(size * repetitions) / static_cast<double>(std::max<uint64_t>(WS::GetBenchTimestamp() - start, 1u));
+}
+
+template <typename _T>
+static void RunElementSize(const size_t size, const size_t bytesPerResult, std::vector<uint8_t>& src, std::vector<uint8_t>& dst) noexcept
+{
+    const size_t count = size / sizeof(_T);
+
+    _T*       pDst = reinterpret_cast<_T*>(dst.data());
+    const _T* pSrc = reinterpret_cast<const _T*>(src.data());
+
+    WS::PerfCounterValues scalarCounters, arrayCounters, inPlaceCounters, scalarBitsCounters, bitsCounters;
+
+    // The scalar loops are kept from being vectorized, so that they show what a value at a time costs
+    const double scalar = MeasureThroughput(size, bytesPerResult, [&]() {
+        for (size_t i = 0u; i < count; i++) {
+            pDst[i] = WS::SwapEndian(pSrc[i]);
+            asm volatile("" : : : "memory");
+        }
+    }, scalarCounters);
+
+    const double array   = MeasureThroughput(size, bytesPerResult, [&]() { WS::SwapEndianArray(pSrc, pDst, count, sizeof(_T)); }, arrayCounters);
+    const double inPlace = MeasureThroughput(size, bytesPerResult, [&]() { WS::SwapEndianArray(pDst, count, sizeof(_T)); }, inPlaceCounters);
+
+    const double scalarBits = MeasureThroughput(size, bytesPerResult, [&]() {
+        for (size_t i = 0u; i < count; i++) {
+            pDst[i] = WS::ReverseBits(pSrc[i]);
+            asm volatile("" : : : "memory");
+        }
+    }, scalarBitsCounters);
+
+    const double bits = MeasureThroughput(size, bytesPerResult, [&]() { WS::ReverseBitsArray(pSrc, pDst, count, sizeof(_T)); }, bitsCounters);
+
+    const std::string label = std::to_string(sizeof(_T) * 8u) + " bit";
+
+    WS::Print(std::fixed, std::setprecision(2),
+              label, " SwapEndian loop      : ", scalar, " GB/s", WS::FormatPerfCounters(scalarCounters, count, "value"), "\n",
+              label, " SwapEndianArray      : ", array, " GB/s", WS::FormatPerfCounters(arrayCounters, count, "value"), "\n",
+              label, " SwapEndianArray (in) : ", inPlace, " GB/s", WS::FormatPerfCounters(inPlaceCounters, count, "value"), "\n",
+              label, " ReverseBits loop     : ", scalarBits, " GB/s", WS::FormatPerfCounters(scalarBitsCounters, count, "value"), "\n",
+              label, " ReverseBitsArray     : ", bits, " GB/s", WS::FormatPerfCounters(bitsCounters, count, "value"),
+              std::defaultfloat, std::setprecision(6));
+}
+
+int WS::EntryPoint(int argc, char** argv) {
+    BenchOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-s" && i + 1 < argc) {
+            options.m_sizes = ParseList(argv[++i]);
+
+            // Whole 64 bit values
+            for (size_t& size : options.m_sizes)
+                size = std::max<size_t>(size & ~size_t(7u), sizeof(uint64_t));
+        } else if (argument == "-t" && i + 1 < argc) {
+            options.m_bytesPerResult = std::max<size_t>(1u, std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.m_sizes.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    WS::Print("Instructions : ", WS::GetByteShuffleImplementation());
+
+    WS::Print("Counters     : ", WS::GetBenchCounters().Describe());
+
+    for (const size_t size : options.m_sizes) {
+        std::vector<uint8_t> src(size), dst(size);
+
+        std::mt19937 random(42u);
+        for (uint8_t& byte : src)
+            byte = static_cast<uint8_t>(random());
+
+        WS::Print("\n", size, " bytes");
+
+        RunElementSize<uint16_t>(size, options.m_bytesPerResult, src, dst);
+        RunElementSize<uint32_t>(size, options.m_bytesPerResult, src, dst);
+        RunElementSize<uint64_t>(size, options.m_bytesPerResult, src, dst);
+    }
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include <WSBench/WSBench.h>
+
+/*
+ * WeissIoEngineBench [options]
+ *
+ * Ping-pongs timestamped messages between an echo server & a client over loopback,
+ * once per event loop engine, & reports the round trips per second & their latency.
+ *
+ * Options :
+ *   -e <engine>       epoll, io_uring or both (default)
+ *   -c <connections>  Concurrent connections, each with one message in flight (defaults to 128)
+ *   -s <bytes>        Message size, at least 8 (defaults to 64)
+ *   -d <seconds>      Measured duration per engine (defaults to 3)
+ *   -l <loops>        Server event loops (defaults to 1)
+ *   -r                Gives each server loop its own SO_REUSEPORT listener, pinned to a CPU with CPU steering
+ */
+
+struct BenchOptions {
+    size_t m_nConnections = 128u;
+    size_t m_messageSize  = 64u;
+    double m_duration     = 3.0;
+    size_t m_nServerLoops = 1u;
+    bool   m_bSharded     = false;
+};
+
+static void PrintUsage() noexcept
+{
+    WS::Print("Usage : WeissIoEngineBench [-e epoll|io_uring|both] [-c <connections>] [-s <bytes>] [-d <seconds>] [-l <loops>] [-r]");
+}
+
+static const char* GetEngineName(const WS::IoEngine engine) noexcept
+{
+    return (engine == WS::IoEngine::IO_URING) ? "io_uring" : "epoll";
+}
+
+static bool RunEngine(const WS::IoEngine engine, const BenchOptions& options) noexcept
+{
+    WS::EventLoopCallbacks serverCallbacks;
+    serverCallbacks.m_onData = [](WS::Connection& connection) {
+        connection.Send(connection.GetReadData(), connection.GetReadSize());
+        connection.Consume(connection.GetReadSize());
+    };
+
+    WS::EventLoopGroup server(serverCallbacks, options.m_nServerLoops, engine);
+    WS::ListenOptions listenOptions;
+    listenOptions.m_bShardedListeners = options.m_bSharded;
+    listenOptions.m_bPinThreads       = options.m_bSharded;
+    listenOptions.m_bCpuSteering      = options.m_bSharded;
+
+    if (!server.Listen(0u, listenOptions))
+        return false;
+
+    server.Start();
+
+    std::vector<uint8_t> message(options.m_messageSize, 0xA5u);
+    WS::LatencySamples   latencies;
+    bool                 bMeasuring = false;
+    size_t               nConnected = 0u, nClosed = 0u, nRoundTrips = 0u;
+
+    const auto sendMessage = [&message](WS::Connection& connection) {
+        const uint64_t timestamp = WS::GetBenchTimestamp();
+        std::memcpy(message.data(), &timestamp, sizeof(timestamp));
+
+        connection.Send(message.data(), message.size());
+    };
+
+    WS::EventLoopCallbacks clientCallbacks;
+    clientCallbacks.m_onConnect = [&](WS::Connection& connection) {
+        nConnected++;
+        sendMessage(connection);
+    };
+    clientCallbacks.m_onData = [&](WS::Connection& connection) {
+        while (connection.GetReadSize() >= message.size()) {
+            uint64_t timestamp;
+            std::memcpy(&timestamp, connection.GetReadData(), sizeof(timestamp));
+            connection.Consume(message.size());
+
+            if (bMeasuring) {
+                latencies.Add(WS::GetBenchTimestamp() - timestamp);
+                nRoundTrips++;
+            }
+
+            sendMessage(connection);
+        }
+    };
+    clientCallbacks.m_onClose = [&](WS::Connection&) { nClosed++; };
+
+    bool bSucceeded = false;
+
+    {
+        WS::EventLoop client(clientCallbacks, engine);
+
+        if (!client.IsValid()) {
+            WS::Print(GetEngineName(engine), " : the client loop couldn't be created");
+        } else if (client.GetEngine() != engine) {
+            WS::Print(GetEngineName(engine), " : unavailable, the loops fell back to ", GetEngineName(client.GetEngine()));
+        } else {
+            for (size_t i = 0u; i < options.m_nConnections; i++)
+                client.Connect("127.0.0.1", server.GetPort());
+
+            const std::chrono::steady_clock::time_point connectDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (nConnected + nClosed < options.m_nConnections && std::chrono::steady_clock::now() < connectDeadline)
+                client.RunOnce(10);
+
+            // Warm up : buffers, connection tables & caches reach their steady state
+            const std::chrono::steady_clock::time_point warmupEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+            while (std::chrono::steady_clock::now() < warmupEnd)
+                client.RunOnce(10);
+
+            latencies.Reserve(1u << 22u);
+            bMeasuring = true;
+
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            const std::chrono::steady_clock::time_point end   = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(options.m_duration));
+
+            while (std::chrono::steady_clock::now() < end)
+                client.RunOnce(10);
+
+            bMeasuring = false;
+
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            WS::Print(std::left, std::setw(9), GetEngineName(engine), ": ", nConnected, " connections, ",
+                      std::fixed, std::setprecision(0), static_cast<double>(nRoundTrips) / elapsed, " msgs/s, ",
+                      std::setprecision(1), "p50 ", latencies.GetPercentile(50.0), " us, p99 ", latencies.GetPercentile(99.0), " us",
+                      std::defaultfloat, std::setprecision(6));
+
+            bSucceeded = nRoundTrips > 0u;
+        }
+    }
+
+    server.Stop();
+
+    return bSucceeded;
+}
+
+int WS::EntryPoint(int argc, char** argv) {
+    BenchOptions options;
+    std::vector<WS::IoEngine> engines = { WS::IoEngine::EPOLL, WS::IoEngine::IO_URING };
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-e" && i + 1 < argc) {
+            const std::string name = argv[++i];
+
+            if      (name == "epoll")    engines = { WS::IoEngine::EPOLL };
+            else if (name == "io_uring") engines = { WS::IoEngine::IO_URING };
+            else if (name != "both") {
+                PrintUsage();
+                return 1;
+            }
+        } else if (argument == "-c" && i + 1 < argc) {
+            options.m_nConnections = std::strtoul(argv[++i], nullptr, 10);
+        } else if (argument == "-s" && i + 1 < argc) {
+            options.m_messageSize = std::max<size_t>(sizeof(uint64_t), std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "-d" && i + 1 < argc) {
+            options.m_duration = std::strtod(argv[++i], nullptr);
+        } else if (argument == "-l" && i + 1 < argc) {
+            options.m_nServerLoops = std::max<size_t>(1u, std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "-r") {
+            options.m_bSharded = true;
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    WS::RaiseFileDescriptorLimit();
+
+    WS::Print("Loopback echo, ", options.m_messageSize, " byte messages, ", options.m_nServerLoops, " server loop(s)", options.m_bSharded ? " with sharded listeners, " : ", ", options.m_duration, " s per engine");
+
+    bool bSucceeded = true;
+    for (const WS::IoEngine engine : engines)
+        bSucceeded &= RunEngine(engine, options);
+
+    return bSucceeded ? 0 : 1;
+}
@@ -0,0 +1,166 @@
+#include <WSBench/WSBench.h>
+
+#include <random>
+
+/*
+ * WeissMetricsBench [options]
+ *
+ * Measures the cost of counter increments (per thread slots against a shared atomic, from one & several threads),
+ * histogram records & registry snapshots, then checks the histogram's percentiles against exact ones.
+ *
+ * Options :
+ *   -n <operations>   Operations per measurement (defaults to 10000000)
+ *   -j <threads>      Threads of the concurrent measurements (defaults to one per hardware thread)
+ *   -o <file>         JSON export of the registry (none by default)
+ */
+
+struct BenchOptions {
+    size_t      m_nOperations = 10000000u;
+    size_t      m_nThreads    = std::max(1u, std::thread::hardware_concurrency());
+    std::string m_output;
+};
+
+static void PrintUsage() noexcept
+{
+    WS::Print("Usage : WeissMetricsBench [-n <operations>] [-j <threads>] [-o <file>]");
+}
+
+/*
+ * Average nanoseconds per operation of "function" run by "nThreads" threads at once, "nOperations" in total,
+ * "counters" receives the hardware counters of the first thread (for "nOperations / nThreads" operations)
+ */
+template <typename _F>
+static double MeasureConcurrent(const size_t nOperations, const size_t nThreads, const _F& function, WS::PerfCounterValues& counters) noexcept
+{
+    std::vector<std::thread> threads;
+
+    const uint64_t start = WS::GetBenchTimestamp();
+
+    for (size_t t = 0u; t < nThreads; t++)
+        threads.emplace_back([&function, &counters, nOperations, nThreads, t]() {
+            WS::PerfCounterValues threadCounters;
+
+            {
+                const WS::PerfScope scope(WS::GetBenchCounters(), threadCounters);
+
+                for (size_t i = 0u; i < nOperations / nThreads; i++)
+                    function(i);
+            }
+
+            if (t == 0u)
+                counters = threadCounters;
+        });
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // Per operation of a thread, i.e what a caller pays
+    return static_cast<double>(WS::GetBenchTimestamp() - start) * static_cast<double>(nThreads) / static_cast<double>(nOperations);
+}
+
+int WS::EntryPoint(int argc, char** argv) {
+    BenchOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-n" && i + 1 < argc) {
+            options.m_nOperations = std::max<size_t>(1u, std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "-j" && i + 1 < argc) {
+            options.m_nThreads = std::max<size_t>(1u, std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "-o" && i + 1 < argc) {
+            options.m_output = argv[++i];
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    WS::MetricsRegistry& registry = WS::MetricsRegistry::Get();
+
+    WS::Counter&   counter   = registry.GetCounter("bench.counter");
+    WS::Histogram& histogram = registry.GetHistogram("bench.latency_ns");
+
+    // The baseline every thread contends on
+    static std::atomic<uint64_t> s_shared = 0u;
+
+    // ---------- Counters ---------- //
+
+    const size_t perThread = options.m_nOperations / options.m_nThreads;
+
+    WS::PerfCounterValues counterCounters, sharedCounters, counterThreadCounters, sharedThreadCounters;
+
+    const double counterTime       = MeasureConcurrent(options.m_nOperations, 1u, [&counter](const size_t) { counter.Add(); }, counterCounters);
+    const double sharedTime        = MeasureConcurrent(options.m_nOperations, 1u, [](const size_t) { s_shared.fetch_add(1u, std::memory_order_relaxed); }, sharedCounters);
+    const double counterThreadTime = MeasureConcurrent(options.m_nOperations, options.m_nThreads, [&counter](const size_t) { counter.Add(); }, counterThreadCounters);
+    const double sharedThreadTime  = MeasureConcurrent(options.m_nOperations, options.m_nThreads, [](const size_t) { s_shared.fetch_add(1u, std::memory_order_relaxed); }, sharedThreadCounters);
+
+    const uint64_t expected = options.m_nOperations + perThread * options.m_nThreads;
+
+    WS::Print("Counters          : ", WS::GetBenchCounters().Describe());
+
+    WS::Print(std::fixed, std::setprecision(2),
+              "Counter::Add      : ", counterTime, " ns/op", WS::FormatPerfCounters(counterCounters, options.m_nOperations), " (1 thread), ",
+              counterThreadTime, " ns/op", WS::FormatPerfCounters(counterThreadCounters, perThread), " (", options.m_nThreads, " threads)\n",
+              "Shared atomic     : ", sharedTime, " ns/op", WS::FormatPerfCounters(sharedCounters, options.m_nOperations), " (1 thread), ",
+              sharedThreadTime, " ns/op", WS::FormatPerfCounters(sharedThreadCounters, perThread), " (", options.m_nThreads, " threads)\n",
+              "Merged value      : ", counter.GetValue(), ((counter.GetValue() == expected) ? " (exact)" : " (MISMATCH)"),
+              std::defaultfloat, std::setprecision(6));
+
+    // ---------- Histograms ---------- //
+
+    // Log-normal latencies around 20 us, with a long tail
+    std::mt19937                        generator(42u);
+    std::lognormal_distribution<double> distribution(10.0, 1.0);
+
+    std::vector<uint64_t> values(std::min<size_t>(options.m_nOperations, 1000000u));
+    for (uint64_t& value : values)
+        value = static_cast<uint64_t>(distribution(generator));
+
+    WS::PerfCounterValues recordCounters, recordThreadCounters;
+
+    const double recordTime       = MeasureConcurrent(options.m_nOperations, 1u, [&histogram, &values](const size_t i) { histogram.Record(values[i % values.size()]); }, recordCounters);
+    const double recordThreadTime = MeasureConcurrent(options.m_nOperations, options.m_nThreads, [&histogram, &values](const size_t i) { histogram.Record(values[i % values.size()]); }, recordThreadCounters);
+
+    const uint64_t snapshotStart = WS::GetBenchTimestamp();
+    static_cast<void>(registry.TakeSnapshot());
+    const double snapshotTime = static_cast<double>(WS::GetBenchTimestamp() - snapshotStart) / 1000.0;
+
+    WS::Print(std::fixed, std::setprecision(2),
+              "Histogram::Record : ", recordTime, " ns/op", WS::FormatPerfCounters(recordCounters, options.m_nOperations), " (1 thread), ",
+              recordThreadTime, " ns/op", WS::FormatPerfCounters(recordThreadCounters, perThread), " (", options.m_nThreads, " threads)\n",
+              "TakeSnapshot      : ", snapshotTime, " us",
+              std::defaultfloat, std::setprecision(6));
+
+    // ---------- Accuracy ---------- //
+
+    WS::Histogram& accuracy = registry.GetHistogram("bench.accuracy_ns");
+    for (const uint64_t value : values)
+        accuracy.Record(value);
+
+    std::sort(values.begin(), values.end());
+    const WS::HistogramSnapshot accuracySnapshot = accuracy.TakeSnapshot();
+
+    static constexpr const std::pair<const char*, double> PERCENTILES[] = { { "p50  ", 50.0 }, { "p90  ", 90.0 }, { "p99  ", 99.0 }, { "p99.9", 99.9 } };
+
+    for (const auto& [label, percentile] : PERCENTILES) {
+        const uint64_t exact    = values[static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(values.size()))) - 1u];
+        const uint64_t reported = accuracySnapshot.GetPercentile(percentile);
+
+        WS::Print(std::fixed, std::setprecision(2), label, "             : ", reported, " ns (exact ", exact, " ns, ",
+                  100.0 * (static_cast<double>(reported) - static_cast<double>(exact)) / static_cast<double>(std::max<uint64_t>(exact, 1u)), " %)",
+                  std::defaultfloat, std::setprecision(6));
+    }
+
+    if (!options.m_output.empty()) {
+        std::ofstream file(options.m_output, std::ios::binary);
+        registry.TakeSnapshot().WriteJson(file);
+
+        if (!file) {
+            WS::Print(options.m_output, " : could not write the metrics");
+            return 1;
+        }
+    }
+
+    return 0;
+}
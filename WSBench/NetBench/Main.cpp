@@ -0,0 +1,639 @@
+#include <WSBench/WSBench.h>
+
+/*
+ * WeissNetBench [options]
+ *
+ * Runs a server & clients (one thread per connection) over loopback with the blocking WSSocket API & measures,
+ * for every protocol, message size & connection count :
+ *   connect  : TCP connections established per second
+ *   latency  : request / response round trips per second & their p50 / p99 / p999 latency
+ *   stream   : bulk throughput received by the server, & the datagrams lost on the way for UDP
+ * Results are printed & written as JSON.
+ *
+ * Options :
+ *   -p <protocol>     tcp, udp or both (default)
+ *   -s <sizes>        Comma separated message sizes in bytes, at least 8 (defaults to 64,1024,16384)
+ *   -c <connections>  Comma separated connection counts (defaults to 1,16)
+ *   -d <seconds>      Measured duration per case (defaults to 1)
+ *   -j <path>         JSON output (defaults to WeissNetBench.json, - for the standard output)
+ */
+
+struct BenchOptions {
+    bool                m_bTcp             = true;
+    bool                m_bUdp             = true;
+    std::vector<size_t> m_sizes            = { 64u, 1024u, 16384u };
+    std::vector<size_t> m_connectionCounts = { 1u, 16u };
+    double              m_duration         = 1.0;
+    std::string         m_jsonPath         = "WeissNetBench.json";
+};
+
+constexpr const size_t MAX_DATAGRAM_SIZE = 65507u; // IPv4 limit
+constexpr const int    POLL_TIMEOUT      = 100;    // Milliseconds, also how long a UDP request waits for its response
+
+using TcpSocket = WS::ClientSocket<WS::SocketProtocol::TCP>;
+
+static void PrintUsage() noexcept
+{
+    WS::Print("Usage : WeissNetBench [-p tcp|udp|both] [-s <size,...>] [-c <connections,...>] [-d <seconds>] [-j <path>]");
+}
+
+[[nodiscard]] static std::vector<size_t> ParseList(const char* text) noexcept
+{
+    std::vector<size_t> values;
+    std::stringstream   stream(text);
+    std::string         value;
+
+    while (std::getline(stream, value, ','))
+        if (const size_t parsed = std::strtoul(value.c_str(), nullptr, 10); parsed > 0u)
+            values.push_back(parsed);
+
+    return values;
+}
+
+// True once the socket has data to read, false after POLL_TIMEOUT
+[[nodiscard]] static bool WaitReadable(const WS::WS_SOCKET_TYPE socket) noexcept
+{
+    pollfd descriptor{};
+    descriptor.fd     = socket;
+    descriptor.events = POLLIN;
+
+    return poll(&descriptor, 1u, POLL_TIMEOUT) > 0;
+}
+
+template <WS::SocketProtocol _PROTOCOL>
+[[nodiscard]] static bool SendAll(WS::SocketBase<_PROTOCOL>& socket, const uint8_t* data, size_t size) noexcept
+{
+    while (size > 0u) {
+        const int64_t sent = socket.Send(data, size);
+        if (sent <= 0)
+            return false;
+
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+
+    return true;
+}
+
+template <WS::SocketProtocol _PROTOCOL>
+[[nodiscard]] static bool ReceiveAll(WS::SocketBase<_PROTOCOL>& socket, uint8_t* data, size_t size) noexcept
+{
+    while (size > 0u) {
+        const int64_t received = socket.Receive(data, size);
+        if (received <= 0)
+            return false;
+
+        data += received;
+        size -= static_cast<size_t>(received);
+    }
+
+    return true;
+}
+
+// ---------- Report ---------- //
+
+// One JSON object per case, numbers only besides the protocol & test names
+class BenchReport {
+private:
+    std::ostringstream m_results;
+    size_t             m_nResults = 0u;
+
+public:
+    void Add(const char* protocol, const char* test, const size_t size, const size_t connections, const std::initializer_list<std::pair<const char*, double>> values) noexcept
+    {
+        this->m_results << (this->m_nResults++ > 0u ? ",\n" : "\n")
+                        << "    { \"protocol\": \"" << protocol << "\", \"test\": \"" << test << "\", \"size\": " << size << ", \"connections\": " << connections;
+
+        for (const std::pair<const char*, double>& value : values)
+            this->m_results << ", \"" << value.first << "\": " << std::fixed << std::setprecision(3) << value.second << std::defaultfloat;
+
+        this->m_results << " }";
+    }
+
+    [[nodiscard]] std::string ToJson(const BenchOptions& options) const noexcept
+    {
+        std::ostringstream json;
+        json << "{\n  \"benchmark\": \"WeissNetBench\",\n  \"duration\": " << options.m_duration
+             << ",\n  \"hardware_concurrency\": " << std::thread::hardware_concurrency()
+             << ",\n  \"results\": [" << this->m_results.str() << "\n  ]\n}\n";
+
+        return json.str();
+    }
+};
+
+// ---------- Phases ---------- //
+
+enum class Phase : int { CONNECTING, WARMUP, MEASURING, STOPPED };
+
+// Shared by the clients of a case : every client reports once connected, then runs until STOPPED & only records while MEASURING
+struct RunState {
+    std::atomic<Phase>  m_phase   = Phase::CONNECTING;
+    std::atomic<size_t> m_nReady  = 0u;
+    std::atomic<size_t> m_nFailed = 0u;
+
+    inline void SetReady(const bool bConnected) noexcept
+    {
+        if (!bConnected)
+            this->m_nFailed++;
+
+        this->m_nReady++;
+    }
+
+    // Spins until the warm up starts, false if the case is already over
+    [[nodiscard]] inline bool WaitStart() const noexcept
+    {
+        while (this->m_phase.load() == Phase::CONNECTING)
+            std::this_thread::yield();
+
+        return this->m_phase.load() != Phase::STOPPED;
+    }
+
+    [[nodiscard]] inline bool IsRunning()   const noexcept { return this->m_phase.load(std::memory_order_relaxed) != Phase::STOPPED;   }
+    [[nodiscard]] inline bool IsMeasuring() const noexcept { return this->m_phase.load(std::memory_order_relaxed) == Phase::MEASURING; }
+};
+
+/*
+ * Waits for the clients to connect, warms up then measures for "duration" seconds, calling "onStart" & "onEnd" around it.
+ * Returns the measured seconds, 0 if a client failed to connect.
+ */
+template <typename _OnStart, typename _OnEnd>
+[[nodiscard]] static double RunPhases(RunState& state, const size_t nClients, const double duration, const _OnStart& onStart, const _OnEnd& onEnd) noexcept
+{
+    const std::chrono::steady_clock::time_point connectDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (state.m_nReady.load() < nClients && std::chrono::steady_clock::now() < connectDeadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    if (state.m_nReady.load() < nClients || state.m_nFailed.load() > 0u) {
+        state.m_phase = Phase::STOPPED;
+        return 0.0;
+    }
+
+    // Buffers, caches & the scheduler reach their steady state
+    state.m_phase = Phase::WARMUP;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    onStart();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    state.m_phase = Phase::MEASURING;
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+
+    state.m_phase = Phase::STOPPED;
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    onEnd();
+
+    return elapsed;
+}
+
+// ---------- Servers ---------- //
+
+enum class ServerMode { ECHO, DISCARD, CLOSE };
+
+/*
+ * Accepts connections on a thread & serves each on its own thread : ECHO sends back messages of a fixed size,
+ * DISCARD counts the bytes received & CLOSE closes connections as soon as they're accepted.
+ */
+class TcpServer {
+private:
+    WS::ServerSocket<WS::SocketProtocol::TCP> m_listener;
+    std::thread                               m_acceptThread;
+    std::vector<std::thread>                  m_connectionThreads;
+    std::atomic<bool>                         m_bStopping = false;
+
+public:
+    std::atomic<uint64_t> m_bytesReceived = 0u;
+    std::atomic<uint64_t> m_nAccepted     = 0u;
+
+public:
+    [[nodiscard]] bool Start(const ServerMode mode, const size_t messageSize) noexcept
+    {
+        if (!this->m_listener.Bind(static_cast<uint16_t>(0u)) || !this->m_listener.Listen())
+            return false;
+
+        this->m_acceptThread = std::thread([this, mode, messageSize]() {
+            while (!this->m_bStopping.load()) {
+                if (!WaitReadable(this->m_listener.GetHandle()))
+                    continue;
+
+                TcpSocket connection = this->m_listener.Accept();
+                if (!connection.IsValid())
+                    continue;
+
+                this->m_nAccepted++;
+
+                if (mode == ServerMode::CLOSE)
+                    continue;
+
+                (void)connection.SetNoDelay(true);
+
+                // Ends when the client disconnects
+                this->m_connectionThreads.emplace_back([this, mode, messageSize, handle = connection.Release()]() {
+                    TcpSocket            socket(handle);
+                    std::vector<uint8_t> buffer(std::max<size_t>(messageSize, 1u << 16u));
+
+                    if (mode == ServerMode::ECHO) {
+                        while (ReceiveAll(socket, buffer.data(), messageSize) && SendAll(socket, buffer.data(), messageSize));
+                    } else {
+                        int64_t received;
+                        while ((received = socket.Receive(buffer.data(), buffer.size())) > 0)
+                            this->m_bytesReceived.fetch_add(static_cast<uint64_t>(received), std::memory_order_relaxed);
+                    }
+                });
+            }
+        });
+
+        return true;
+    }
+
+    [[nodiscard]] inline uint16_t GetPort() const noexcept { return this->m_listener.GetPort(); }
+
+    // The clients must have disconnected
+    void Stop() noexcept
+    {
+        this->m_bStopping = true;
+
+        if (this->m_acceptThread.joinable())
+            this->m_acceptThread.join();
+
+        for (std::thread& thread : this->m_connectionThreads)
+            thread.join();
+    }
+};
+
+// Serves every client from a single socket & thread : ECHO sends datagrams back, DISCARD counts them
+class UdpServer {
+private:
+    WS::ServerSocket<WS::SocketProtocol::UDP> m_socket;
+    std::thread                               m_thread;
+    std::atomic<bool>                         m_bStopping = false;
+
+public:
+    std::atomic<uint64_t> m_bytesReceived     = 0u;
+    std::atomic<uint64_t> m_datagramsReceived = 0u;
+
+public:
+    [[nodiscard]] bool Start(const ServerMode mode) noexcept
+    {
+        if (!this->m_socket.Bind(static_cast<uint16_t>(0u)))
+            return false;
+
+        (void)this->m_socket.SetBufferSizes(1 << 22, 1 << 22);
+
+        this->m_thread = std::thread([this, mode]() {
+            std::vector<uint8_t> buffer(MAX_DATAGRAM_SIZE);
+            WS::SocketAddress    address;
+
+            while (!this->m_bStopping.load()) {
+                if (!WaitReadable(this->m_socket.GetHandle()))
+                    continue;
+
+                const int64_t received = this->m_socket.ReceiveFrom(buffer.data(), buffer.size(), address);
+                if (received < 0)
+                    continue;
+
+                this->m_bytesReceived.fetch_add(static_cast<uint64_t>(received), std::memory_order_relaxed);
+                this->m_datagramsReceived.fetch_add(1u, std::memory_order_relaxed);
+
+                if (mode == ServerMode::ECHO)
+                    (void)this->m_socket.SendTo(buffer.data(), static_cast<size_t>(received), address);
+            }
+        });
+
+        return true;
+    }
+
+    [[nodiscard]] inline uint16_t GetPort() const noexcept { return this->m_socket.GetPort(); }
+
+    void Stop() noexcept
+    {
+        this->m_bStopping = true;
+
+        if (this->m_thread.joinable())
+            this->m_thread.join();
+    }
+};
+
+// ---------- Cases ---------- //
+
+static bool RunConnect(const size_t nConnections, const BenchOptions& options, BenchReport& report) noexcept
+{
+    TcpServer server;
+    if (!server.Start(ServerMode::CLOSE, 0u))
+        return false;
+
+    RunState                 state;
+    std::atomic<uint64_t>    nConnects = 0u, nFailures = 0u;
+    std::vector<std::thread> clients;
+
+    for (size_t i = 0u; i < nConnections; i++) {
+        clients.emplace_back([&]() {
+            state.SetReady(true);
+            if (!state.WaitStart())
+                return;
+
+            while (state.IsRunning()) {
+                TcpSocket socket;
+                if (!socket.Connect("127.0.0.1", server.GetPort())) {
+                    if (state.IsMeasuring())
+                        nFailures.fetch_add(1u, std::memory_order_relaxed);
+
+                    continue;
+                }
+
+                // Resets rather than closes, TIME_WAIT would otherwise exhaust the ephemeral ports within a second
+                const linger abort = { 1, 0 };
+                setsockopt(socket.GetHandle(), SOL_SOCKET, SO_LINGER, &abort, sizeof(abort));
+
+                if (state.IsMeasuring())
+                    nConnects.fetch_add(1u, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    const double elapsed = RunPhases(state, nConnections, options.m_duration, []() {  }, []() {  });
+
+    for (std::thread& client : clients)
+        client.join();
+
+    server.Stop();
+
+    if (elapsed <= 0.0)
+        return false;
+
+    const double rate = static_cast<double>(nConnects.load()) / elapsed;
+
+    WS::Print("tcp connect             x ", std::setw(3), nConnections, " : ", std::fixed, std::setprecision(0), rate, " connections/s, ",
+              nFailures.load(), " failed", std::defaultfloat, std::setprecision(6));
+
+    report.Add("tcp", "connect", 0u, nConnections, { { "connections_per_second", rate }, { "failed", static_cast<double>(nFailures.load()) } });
+
+    return nConnects.load() > 0u;
+}
+
+template <WS::SocketProtocol _PROTOCOL>
+static bool RunLatency(const size_t messageSize, const size_t nConnections, const BenchOptions& options, BenchReport& report) noexcept
+{
+    constexpr const bool  bTcp     = _PROTOCOL == WS::SocketProtocol::TCP;
+    constexpr const char* protocol = bTcp ? "tcp" : "udp";
+
+    TcpServer tcpServer;
+    UdpServer udpServer;
+
+    if (bTcp ? !tcpServer.Start(ServerMode::ECHO, messageSize) : !udpServer.Start(ServerMode::ECHO))
+        return false;
+
+    const uint16_t port = bTcp ? tcpServer.GetPort() : udpServer.GetPort();
+
+    RunState                           state;
+    std::vector<std::vector<uint64_t>> samples(nConnections);
+    std::atomic<uint64_t>              nLost = 0u;
+    std::vector<std::thread>           clients;
+
+    for (size_t i = 0u; i < nConnections; i++) {
+        clients.emplace_back([&, i]() {
+            WS::ClientSocket<_PROTOCOL> socket;
+
+            bool bConnected = socket.Connect("127.0.0.1", port);
+            if constexpr (bTcp)
+                bConnected = bConnected && socket.SetNoDelay(true);
+
+            state.SetReady(bConnected);
+            if (!bConnected || !state.WaitStart())
+                return;
+
+            std::vector<uint8_t> request(messageSize, 0xA5u), response(messageSize);
+            samples[i].reserve(1u << 20u);
+
+            while (state.IsRunning()) {
+                const uint64_t timestamp = WS::GetBenchTimestamp();
+                std::memcpy(request.data(), &timestamp, sizeof(timestamp));
+
+                if constexpr (bTcp) {
+                    if (!SendAll(socket, request.data(), messageSize) || !ReceiveAll(socket, response.data(), messageSize))
+                        return;
+                } else {
+                    if (socket.Send(request.data(), messageSize) < 0)
+                        return;
+
+                    // A lost datagram times out, late responses to earlier requests are skipped
+                    bool bAnswered = false;
+                    while (!bAnswered && WaitReadable(socket.GetHandle()))
+                        bAnswered = socket.Receive(response.data(), messageSize) >= 8 && std::memcmp(response.data(), &timestamp, sizeof(timestamp)) == 0;
+
+                    if (!bAnswered) {
+                        if (state.IsMeasuring())
+                            nLost++;
+
+                        continue;
+                    }
+                }
+
+                if (state.IsMeasuring())
+                    samples[i].push_back(WS::GetBenchTimestamp() - timestamp);
+            }
+        });
+    }
+
+    const double elapsed = RunPhases(state, nConnections, options.m_duration, []() {  }, []() {  });
+
+    for (std::thread& client : clients)
+        client.join();
+
+    if (bTcp) tcpServer.Stop();
+    else      udpServer.Stop();
+
+    if (elapsed <= 0.0)
+        return false;
+
+    WS::LatencySamples latencies;
+    for (const std::vector<uint64_t>& clientSamples : samples)
+        for (const uint64_t sample : clientSamples)
+            latencies.Add(sample);
+
+    const double rate = static_cast<double>(latencies.GetCount()) / elapsed;
+    const double p50  = latencies.GetPercentile(50.0);
+    const double p99  = latencies.GetPercentile(99.0);
+    const double p999 = latencies.GetPercentile(99.9);
+
+    WS::Print(protocol, " latency ", std::setw(7), messageSize, " B x ", std::setw(3), nConnections, " : ",
+              std::fixed, std::setprecision(0), rate, " req/s, ", std::setprecision(1),
+              "p50 ", p50, " us, p99 ", p99, " us, p999 ", p999, " us", (nLost.load() > 0u ? ", lost " : ""),
+              (nLost.load() > 0u ? std::to_string(nLost.load()) : std::string()), std::defaultfloat, std::setprecision(6));
+
+    report.Add(protocol, "latency", messageSize, nConnections, { { "requests_per_second", rate }, { "p50_us", p50 }, { "p99_us", p99 }, { "p999_us", p999 },
+                                                                 { "lost", static_cast<double>(nLost.load()) } });
+
+    return latencies.GetCount() > 0u;
+}
+
+template <WS::SocketProtocol _PROTOCOL>
+static bool RunStream(const size_t messageSize, const size_t nConnections, const BenchOptions& options, BenchReport& report) noexcept
+{
+    constexpr const bool  bTcp     = _PROTOCOL == WS::SocketProtocol::TCP;
+    constexpr const char* protocol = bTcp ? "tcp" : "udp";
+
+    TcpServer tcpServer;
+    UdpServer udpServer;
+
+    if (bTcp ? !tcpServer.Start(ServerMode::DISCARD, messageSize) : !udpServer.Start(ServerMode::DISCARD))
+        return false;
+
+    const uint16_t port = bTcp ? tcpServer.GetPort() : udpServer.GetPort();
+
+    RunState                 state;
+    std::atomic<uint64_t>    datagramsSent = 0u;
+    std::vector<std::thread> clients;
+
+    for (size_t i = 0u; i < nConnections; i++) {
+        clients.emplace_back([&]() {
+            WS::ClientSocket<_PROTOCOL> socket;
+
+            const bool bConnected = socket.Connect("127.0.0.1", port);
+
+            state.SetReady(bConnected);
+            if (!bConnected || !state.WaitStart())
+                return;
+
+            const std::vector<uint8_t> message(messageSize, 0xA5u);
+
+            while (state.IsRunning()) {
+                if constexpr (bTcp) {
+                    if (!SendAll(socket, message.data(), messageSize))
+                        return;
+                } else if (socket.Send(message.data(), messageSize) > 0 && state.IsMeasuring()) {
+                    datagramsSent.fetch_add(1u, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    // Measured on the receiving side, as a sender can outrun it
+    uint64_t startBytes = 0u, endBytes = 0u, startDatagrams = 0u, endDatagrams = 0u;
+
+    const double elapsed = RunPhases(state, nConnections, options.m_duration, [&]() {
+        startBytes     = bTcp ? tcpServer.m_bytesReceived.load() : udpServer.m_bytesReceived.load();
+        startDatagrams = udpServer.m_datagramsReceived.load();
+    }, [&]() {
+        endBytes     = bTcp ? tcpServer.m_bytesReceived.load() : udpServer.m_bytesReceived.load();
+        endDatagrams = udpServer.m_datagramsReceived.load();
+    });
+
+    for (std::thread& client : clients)
+        client.join();
+
+    if (bTcp) tcpServer.Stop();
+    else      udpServer.Stop();
+
+    if (elapsed <= 0.0)
+        return false;
+
+    const double bytesPerSecond = static_cast<double>(endBytes - startBytes) / elapsed;
+    const double received       = static_cast<double>(endDatagrams - startDatagrams);
+    const double sent           = static_cast<double>(datagramsSent.load());
+    const double lossRatio      = (sent > 0.0) ? std::max(0.0, 1.0 - received / sent) : 0.0;
+
+    if constexpr (bTcp) {
+        WS::Print(protocol, " stream  ", std::setw(7), messageSize, " B x ", std::setw(3), nConnections, " : ",
+                  std::fixed, std::setprecision(2), bytesPerSecond * 8.0 / 1e9, " Gbit/s", std::defaultfloat, std::setprecision(6));
+
+        report.Add(protocol, "stream", messageSize, nConnections, { { "bytes_per_second", bytesPerSecond } });
+    } else {
+        WS::Print(protocol, " stream  ", std::setw(7), messageSize, " B x ", std::setw(3), nConnections, " : ",
+                  std::fixed, std::setprecision(2), bytesPerSecond * 8.0 / 1e9, " Gbit/s received, ",
+                  std::setprecision(0), received / elapsed, " datagrams/s, ", std::setprecision(1), lossRatio * 100.0, " % lost",
+                  std::defaultfloat, std::setprecision(6));
+
+        report.Add(protocol, "stream", messageSize, nConnections, { { "bytes_per_second", bytesPerSecond }, { "datagrams_per_second", received / elapsed },
+                                                                    { "loss_ratio", lossRatio } });
+    }
+
+    return endBytes > startBytes;
+}
+
+int WS::EntryPoint(int argc, char** argv) {
+    BenchOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-p" && i + 1 < argc) {
+            const std::string name = argv[++i];
+
+            options.m_bTcp = name == "tcp" || name == "both";
+            options.m_bUdp = name == "udp" || name == "both";
+
+            if (!options.m_bTcp && !options.m_bUdp) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (argument == "-s" && i + 1 < argc) {
+            options.m_sizes = ParseList(argv[++i]);
+
+            for (size_t& size : options.m_sizes)
+                size = std::max<size_t>(size, sizeof(uint64_t));
+        } else if (argument == "-c" && i + 1 < argc) {
+            options.m_connectionCounts = ParseList(argv[++i]);
+        } else if (argument == "-d" && i + 1 < argc) {
+            options.m_duration = std::strtod(argv[++i], nullptr);
+        } else if (argument == "-j" && i + 1 < argc) {
+            options.m_jsonPath = argv[++i];
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.m_sizes.empty() || options.m_connectionCounts.empty() || !(options.m_duration > 0.0)) {
+        PrintUsage();
+        return 1;
+    }
+
+    WS::RaiseFileDescriptorLimit();
+
+    BenchReport report;
+    bool        bSucceeded = true;
+
+    if (options.m_bTcp) {
+        for (const size_t nConnections : options.m_connectionCounts)
+            bSucceeded &= RunConnect(nConnections, options, report);
+
+        for (const size_t size : options.m_sizes)
+            for (const size_t nConnections : options.m_connectionCounts)
+                bSucceeded &= RunLatency<WS::SocketProtocol::TCP>(size, nConnections, options, report);
+
+        for (const size_t size : options.m_sizes)
+            for (const size_t nConnections : options.m_connectionCounts)
+                bSucceeded &= RunStream<WS::SocketProtocol::TCP>(size, nConnections, options, report);
+    }
+
+    if (options.m_bUdp) {
+        // Larger messages don't fit in a datagram
+        for (const size_t size : options.m_sizes)
+            for (const size_t nConnections : options.m_connectionCounts)
+                if (size <= MAX_DATAGRAM_SIZE)
+                    bSucceeded &= RunLatency<WS::SocketProtocol::UDP>(size, nConnections, options, report);
+
+        for (const size_t size : options.m_sizes)
+            for (const size_t nConnections : options.m_connectionCounts)
+                if (size <= MAX_DATAGRAM_SIZE)
+                    bSucceeded &= RunStream<WS::SocketProtocol::UDP>(size, nConnections, options, report);
+    }
+
+    const std::string json = report.ToJson(options);
+
+    if (options.m_jsonPath == "-") {
+        std::cout << json;
+    } else {
+        std::ofstream file(options.m_jsonPath);
+        file << json;
+
+        if (!file) {
+            WS::Print("Failed to write ", options.m_jsonPath);
+            return 1;
+        }
+
+        WS::Print("Results written to ", options.m_jsonPath);
+    }
+
+    return bSucceeded ? 0 : 1;
+}
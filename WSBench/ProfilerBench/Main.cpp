@@ -0,0 +1,182 @@
+#include <WSBench/WSBench.h>
+
+/*
+ * WeissProfilerBench [options]
+ *
+ * Measures the cost of a profiling zone outside of a capture, during one (with fresh & reused buffers) & nested,
+ * from several threads at once, then exports a capture of simulated frames as Chrome trace events.
+ *
+ * Options :
+ *   -n <zones>     Zones per measurement (defaults to 1000000, at most WS_PROFILER_BLOCK_SIZE * WS_PROFILER_MAX_BLOCKS are kept per thread)
+ *   -j <threads>   Recording threads of the concurrent measurement (defaults to one per hardware thread)
+ *   -o <file>      Chrome trace of the simulated frames (defaults to WeissProfilerBench.json)
+ */
+
+struct BenchOptions {
+    size_t      m_nZones   = 1000000u;
+    size_t      m_nThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::string m_output   = "WeissProfilerBench.json";
+};
+
+static void PrintUsage() noexcept
+{
+    WS::Print("Usage : WeissProfilerBench [-n <zones>] [-j <threads>] [-o <file>]");
+}
+
+static volatile uint32_t s_sink = 0u;
+
+// Kept out of line so that the zone isn't optimized across iterations
+[[gnu::noinline]] static void EmptyZone() noexcept
+{
+    WS_PROFILE_SCOPE("EmptyZone");
+}
+
+[[gnu::noinline]] static void NestedZones() noexcept
+{
+    WS_PROFILE_SCOPE("Outer");
+    {
+        WS_PROFILE_SCOPE("Middle");
+        {
+            WS_PROFILE_SCOPE("Inner");
+            s_sink = s_sink + 1u;
+        }
+    }
+}
+
+// Average nanoseconds per zone, adds the hardware counters of the measurement to "counters"
+template <typename _F>
+static double MeasureZone(const size_t nZones, const size_t zonesPerCall, const _F& function, WS::PerfCounterValues& counters) noexcept
+{
+    const WS::PerfScope scope(WS::GetBenchCounters(), counters);
+    const uint64_t      start = WS::GetBenchTimestamp();
+
+    for (size_t i = 0u; i < nZones / zonesPerCall; i++)
+        function();
+
+    return static_cast<double>(WS::GetBenchTimestamp() - start) / static_cast<double>(nZones);
+}
+
+// Spins for about "microseconds"
+static void Work(const uint64_t microseconds) noexcept
+{
+    const uint64_t end = WS::GetBenchTimestamp() + microseconds * 1000u;
+
+    volatile uint32_t counter = 0u;
+    while (WS::GetBenchTimestamp() < end)
+        counter = counter + 1u;
+}
+
+int WS::EntryPoint(int argc, char** argv) {
+    BenchOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-n" && i + 1 < argc) {
+            options.m_nZones = std::max<size_t>(3u, std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "-j" && i + 1 < argc) {
+            options.m_nThreads = std::max<size_t>(1u, std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "-o" && i + 1 < argc) {
+            options.m_output = argv[++i];
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+#ifdef __WEISS__DISABLE_PROFILER
+    WS::Print("The profiler is compiled out (__WEISS__DISABLE_PROFILER), zones cost nothing");
+#endif
+
+    WS::Profiler& profiler = WS::Profiler::Get();
+    profiler.SetThreadName("Main");
+
+    WS::Print("Counters             : ", WS::GetBenchCounters().Describe());
+
+    // ---------- Single Thread ---------- //
+
+    WS::PerfCounterValues idleCounters, freshCounters, reusedCounters, nestedCounters;
+
+    const double idleTime = MeasureZone(options.m_nZones, 1u, EmptyZone, idleCounters);
+
+    profiler.StartCapture();
+    const double freshTime = MeasureZone(options.m_nZones, 1u, EmptyZone, freshCounters);
+    profiler.StopCapture();
+
+    profiler.StartCapture();
+    const double reusedTime = MeasureZone(options.m_nZones, 1u, EmptyZone, reusedCounters);
+    profiler.StopCapture();
+
+    profiler.StartCapture();
+    const double nestedTime = MeasureZone(options.m_nZones, 3u, NestedZones, nestedCounters);
+    profiler.StopCapture();
+
+    WS::Print(std::fixed, std::setprecision(1),
+              "Outside of a capture : ", idleTime, " ns/zone", WS::FormatPerfCounters(idleCounters, options.m_nZones, "zone"), "\n",
+              "Capturing (fresh)    : ", freshTime, " ns/zone", WS::FormatPerfCounters(freshCounters, options.m_nZones, "zone"), "\n",
+              "Capturing (reused)   : ", reusedTime, " ns/zone", WS::FormatPerfCounters(reusedCounters, options.m_nZones, "zone"), "\n",
+              "Capturing (nested)   : ", nestedTime, " ns/zone", WS::FormatPerfCounters(nestedCounters, options.m_nZones, "zone"), "\n",
+              "Dropped              : ", profiler.GetDroppedCount(), " zone(s)",
+              std::defaultfloat, std::setprecision(6));
+
+    // ---------- Concurrent Threads ---------- //
+
+    std::vector<double> threadTimes(options.m_nThreads);
+
+    profiler.StartCapture();
+    {
+        std::vector<std::thread> threads;
+
+        for (size_t t = 0u; t < options.m_nThreads; t++)
+            threads.emplace_back([&threadTimes, &options, t]() {
+                WS::PerfCounterValues counters;
+                threadTimes[t] = MeasureZone(options.m_nZones / options.m_nThreads, 1u, EmptyZone, counters);
+            });
+
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+    profiler.StopCapture();
+
+    WS::Print(std::fixed, std::setprecision(1), options.m_nThreads, " thread(s)          : ",
+              std::accumulate(threadTimes.begin(), threadTimes.end(), 0.0) / static_cast<double>(options.m_nThreads), " ns/zone",
+              std::defaultfloat, std::setprecision(6));
+
+    // ---------- Trace ---------- //
+
+    profiler.StartCapture();
+    {
+        WS::ThreadPool pool(std::min<size_t>(options.m_nThreads, 4u));
+
+        for (uint32_t frame = 0u; frame < 10u; frame++) {
+            WS_PROFILE_FRAME();
+            WS_PROFILE_SCOPE("Frame");
+
+            {
+                WS_PROFILE_SCOPE("Update");
+                Work(500u);
+            }
+
+            for (uint32_t job = 0u; job < 8u; job++)
+                pool.Submit([]() { WS_PROFILE_SCOPE("Job"); Work(200u); });
+
+            pool.WaitIdle();
+
+            WS_PROFILE_SCOPE("Render");
+            Work(1000u);
+        }
+    }
+    profiler.StopCapture();
+
+    size_t nZones = 0u;
+    profiler.ForEachZone([&nZones](const uint32_t, const WS::Profiler::Zone&) { nZones++; });
+
+    if (!profiler.ExportChromeTrace(options.m_output.c_str())) {
+        WS::Print(options.m_output, " : could not write the trace");
+        return 1;
+    }
+
+    WS::Print("Trace                : ", nZones, " zones & 10 frames written to ", options.m_output);
+
+    return 0;
+}
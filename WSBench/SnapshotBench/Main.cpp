@@ -0,0 +1,253 @@
+#include <WSBench/WSBench.h>
+
+#include <random>
+
+/*
+ * WeissSnapshotBench [options]
+ *
+ * Replicates a world of randomly moving entities from a SnapshotServer to clients over loopback UDP,
+ * at a simulated 60 Hz, & reports the cost of encoding & decoding the snapshots & the bandwidth per client.
+ * Random rotations are first sent through a full encode & decode at the default & the maximum rotation bits to check their error.
+ *
+ * Options :
+ *   -n <entities>  Entities in the world (defaults to 10000)
+ *   -m <percent>   Entities that move & rotate every tick (defaults to 10)
+ *   -c <clients>   Clients (defaults to 4)
+ *   -t <ticks>     Measured ticks (defaults to 600, 10 s of simulated time)
+ */
+
+struct BenchOptions {
+    size_t m_nEntities      = 10000u;
+    double m_movingFraction = 0.1;
+    size_t m_nClients       = 4u;
+    size_t m_nTicks         = 600u;
+};
+
+constexpr const double TICK_RATE = 60.0;
+
+static void PrintUsage() noexcept
+{
+    WS::Print("Usage : WeissSnapshotBench [-n <entities>] [-m <percent>] [-c <clients>] [-t <ticks>]");
+}
+
+// Average microseconds "function" takes over "iterations" calls, adds the hardware counters of the calls to "counters"
+template <typename _F>
+static double MeasureMicroseconds(const size_t iterations, const _F& function, WS::PerfCounterValues& counters) noexcept
+{
+    const WS::PerfScope scope(WS::GetBenchCounters(), counters);
+    const uint64_t      start = WS::GetBenchTimestamp();
+
+    for (size_t i = 0u; i < iterations; i++)
+        function();
+
+    return static_cast<double>(WS::GetBenchTimestamp() - start) / 1000.0 / static_cast<double>(iterations);
+}
+
+static void MoveEntities(std::vector<WS::EntityState>& entities, const double movingFraction, std::mt19937& random) noexcept
+{
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::uniform_real_distribution<float> step(-0.25f, 0.25f);
+
+    for (WS::EntityState& entity : entities) {
+        if (unit(random) >= movingFraction)
+            continue;
+
+        entity.m_position = WS::Vecf32(entity.m_position.x + step(random), entity.m_position.y + step(random) * 0.1f, entity.m_position.z + step(random));
+
+        const float angle = unit(random) * static_cast<float>(M_PI);
+        entity.m_rotation = WS::Vecf32(0.0f, std::sin(angle), 0.0f, std::cos(angle));
+    }
+}
+
+// Largest angle, in degrees, between random rotations & what they decode to after a full encode at "rotationBits"
+[[nodiscard]] static double MeasureRotationError(const uint8_t rotationBits, std::mt19937& random) noexcept
+{
+    WS::SnapshotQuantization quantization;
+    quantization.m_rotationBits = rotationBits;
+
+    const WS::SnapshotCodec codec(quantization);
+    std::normal_distribution<float> gaussian;
+
+    std::vector<WS::EntityState> entities(4096u);
+    for (size_t i = 0u; i < entities.size(); i++) {
+        entities[i].m_id       = static_cast<uint32_t>(i + 1u);
+        entities[i].m_rotation = WS::Vecf32(gaussian(random), gaussian(random), gaussian(random), gaussian(random));
+    }
+
+    std::vector<WS::QuantizedEntity> snapshot, decoded;
+    std::vector<uint8_t>             encoded;
+
+    codec.Quantize(entities.data(), entities.size(), snapshot);
+    codec.Encode(nullptr, snapshot, encoded);
+
+    if (!codec.Decode(nullptr, encoded.data(), encoded.size(), decoded) || decoded.size() != entities.size())
+        return 180.0;
+
+    double maxError = 0.0;
+
+    for (size_t i = 0u; i < entities.size(); i++) {
+        const WS::Vecf32 a = entities[i].m_rotation;
+        const WS::Vecf32 b = codec.Dequantize(decoded[i]).m_rotation;
+
+        const double length = std::sqrt(double(a.x) * a.x + double(a.y) * a.y + double(a.z) * a.z + double(a.w) * a.w);
+        double same = 0.0, opposite = 0.0;
+
+        // q & -q are the same rotation, the angle between two rotations is 4 asin(|q1 - q2| / 2) for the closer sign
+        for (size_t c = 0u; c < 4u; c++) {
+            const double ca = a.m_arr[c] / length;
+
+            same     += (ca - b.m_arr[c]) * (ca - b.m_arr[c]);
+            opposite += (ca + b.m_arr[c]) * (ca + b.m_arr[c]);
+        }
+
+        const double distance = std::sqrt(std::min(same, opposite));
+        maxError = std::max(maxError, 4.0 * std::asin(std::min(1.0, distance / 2.0)) * 180.0 / M_PI);
+    }
+
+    return maxError;
+}
+
+int WS::EntryPoint(int argc, char** argv) {
+    BenchOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-n" && i + 1 < argc) {
+            options.m_nEntities = std::strtoul(argv[++i], nullptr, 10);
+        } else if (argument == "-m" && i + 1 < argc) {
+            options.m_movingFraction = std::clamp(std::strtod(argv[++i], nullptr) / 100.0, 0.0, 1.0);
+        } else if (argument == "-c" && i + 1 < argc) {
+            options.m_nClients = std::max<size_t>(1u, std::strtoul(argv[++i], nullptr, 10));
+        } else if (argument == "-t" && i + 1 < argc) {
+            options.m_nTicks = std::max<size_t>(1u, std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    std::mt19937 random(42u);
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+
+    std::vector<WS::EntityState> entities(options.m_nEntities);
+    for (size_t i = 0u; i < entities.size(); i++) {
+        entities[i].m_id       = static_cast<uint32_t>(i + 1u);
+        entities[i].m_position = WS::Vecf32(coordinate(random), coordinate(random) * 0.05f, coordinate(random));
+    }
+
+    WS::Print(options.m_nEntities, " entities, ", options.m_movingFraction * 100.0, " % moving per tick, ", options.m_nClients, " client(s), ", options.m_nTicks, " ticks");
+
+    // ---------- Rotations ---------- //
+
+    for (const uint8_t rotationBits : { WS::SnapshotQuantization().m_rotationBits, uint8_t(15u) }) {
+        // A component is off by at most half a step of sqrt(2) / (2^bits - 1), which bounds the angle well below this
+        const double bound = 10.0 / (M_SQRT2 * static_cast<double>((1u << rotationBits) - 1u)) * 180.0 / M_PI;
+        const double error = MeasureRotationError(rotationBits, random);
+
+        WS::Print("Rotation : ", static_cast<uint32_t>(rotationBits), " bits, max error ", error, " degrees", (error <= bound) ? "" : " (ROTATIONS DON'T ROUND TRIP)");
+    }
+
+    // ---------- Codec ---------- //
+
+    const WS::SnapshotCodec          codec;
+    std::vector<WS::QuantizedEntity> baseline, snapshot, decoded;
+    std::vector<uint8_t>             encoded;
+
+    codec.Quantize(entities.data(), entities.size(), baseline);
+    MoveEntities(entities, options.m_movingFraction, random);
+    codec.Quantize(entities.data(), entities.size(), snapshot);
+
+    const size_t iterations = std::max<size_t>(10u, 2000000u / std::max<size_t>(1u, options.m_nEntities));
+
+    WS::PerfCounterValues quantizeCounters, fullCounters, deltaCounters, decodeCounters;
+
+    const double quantizeTime = MeasureMicroseconds(iterations, [&]() { codec.Quantize(entities.data(), entities.size(), snapshot); }, quantizeCounters);
+    const double fullTime     = MeasureMicroseconds(iterations, [&]() { encoded.clear(); codec.Encode(nullptr, snapshot, encoded); }, fullCounters);
+    const size_t fullSize     = encoded.size();
+    const double deltaTime    = MeasureMicroseconds(iterations, [&]() { encoded.clear(); codec.Encode(&baseline, snapshot, encoded); }, deltaCounters);
+    const size_t deltaSize    = encoded.size();
+    const double decodeTime   = MeasureMicroseconds(iterations, [&]() { (void)codec.Decode(&baseline, encoded.data(), encoded.size(), decoded); }, decodeCounters);
+
+    // Counters are reported per entity processed
+    const size_t nProcessed = iterations * options.m_nEntities;
+
+    WS::Print("Counters : ", WS::GetBenchCounters().Describe());
+
+    WS::Print(std::fixed, std::setprecision(1),
+              "Quantize : ", quantizeTime, " us", WS::FormatPerfCounters(quantizeCounters, nProcessed, "entity"), "\n",
+              "Encode   : full ", fullTime, " us (", fullSize, " bytes)", WS::FormatPerfCounters(fullCounters, nProcessed, "entity"), "\n",
+              "           delta ", deltaTime, " us (", deltaSize, " bytes)", WS::FormatPerfCounters(deltaCounters, nProcessed, "entity"), "\n",
+              "Decode   : delta ", decodeTime, " us", WS::FormatPerfCounters(decodeCounters, nProcessed, "entity"),
+              std::defaultfloat, std::setprecision(6));
+
+    // ---------- Replication ---------- //
+
+    WS::ServerSocket<WS::SocketProtocol::UDP> serverSocket;
+    if (!serverSocket.Bind(static_cast<uint16_t>(0u)) || !serverSocket.SetNonBlocking(true) || !serverSocket.SetBufferSizes(1 << 22, 1 << 22))
+        return 1;
+
+    const WS::SocketAddress serverAddress("127.0.0.1", serverSocket.GetPort());
+
+    WS::SnapshotServer server;
+    std::vector<WS::ServerSocket<WS::SocketProtocol::UDP>> clientSockets(options.m_nClients);
+    std::vector<WS::SnapshotClient>                        clients(options.m_nClients);
+    std::vector<uint32_t>                                  clientIds;
+
+    for (WS::ServerSocket<WS::SocketProtocol::UDP>& socket : clientSockets) {
+        if (!socket.Bind(static_cast<uint16_t>(0u)) || !socket.SetNonBlocking(true) || !socket.SetBufferSizes(1 << 22, 1 << 22))
+            return 1;
+
+        clientIds.push_back(server.AddClient(WS::SocketAddress("127.0.0.1", socket.GetPort())));
+    }
+
+    std::vector<uint8_t> datagram(WS_SNAPSHOT_FRAGMENT_SIZE + 64u);
+    WS::SocketAddress    from;
+    WS::LatencySamples   tickTimes;
+    size_t               nDecoded = 0u;
+
+    tickTimes.Reserve(options.m_nTicks);
+
+    for (size_t tick = 0u; tick < options.m_nTicks; tick++) {
+        MoveEntities(entities, options.m_movingFraction, random);
+
+        const uint64_t start = WS::GetBenchTimestamp();
+
+        server.Capture(entities.data(), entities.size());
+        if (server.Send(serverSocket) < 0)
+            return 1;
+
+        tickTimes.Add(WS::GetBenchTimestamp() - start);
+
+        for (size_t c = 0u; c < clients.size(); c++) {
+            int64_t size;
+            while ((size = clientSockets[c].ReceiveFrom(datagram.data(), datagram.size(), from)) > 0)
+                if (clients[c].OnDatagram(datagram.data(), static_cast<size_t>(size))) {
+                    nDecoded++;
+                    (void)clients[c].SendAck(clientSockets[c], serverAddress);
+                }
+        }
+
+        int64_t size;
+        while ((size = serverSocket.ReceiveFrom(datagram.data(), datagram.size(), from)) > 0)
+            server.OnDatagram(from, datagram.data(), static_cast<size_t>(size));
+    }
+
+    uint64_t bytesSent = 0u, fullSnapshots = 0u;
+    for (const uint32_t clientId : clientIds) {
+        const WS::SnapshotServer::ClientStats* pStats = server.GetClientStats(clientId);
+
+        bytesSent     += pStats->m_bytesSent;
+        fullSnapshots += pStats->m_fullSnapshots;
+    }
+
+    const double bytesPerTick = static_cast<double>(bytesSent) / static_cast<double>(options.m_nClients * options.m_nTicks);
+
+    WS::Print(std::fixed, std::setprecision(1),
+              "Server   : capture & send p50 ", tickTimes.GetPercentile(50.0), " us, p99 ", tickTimes.GetPercentile(99.0), " us per tick\n",
+              "Clients  : ", nDecoded, " / ", options.m_nClients * options.m_nTicks, " snapshots decoded, ", fullSnapshots, " sent in full\n",
+              "Traffic  : ", bytesPerTick, " bytes per client per tick, ", bytesPerTick * 8.0 * TICK_RATE / 1000.0, " kbit/s per client at 60 Hz",
+              std::defaultfloat, std::setprecision(6));
+
+    return 0;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <WSCore/WSInclude.h>
+
+/*
+ * Helpers shared by the benchmarks
+ */
+
+namespace WS {
+
+    // Monotonic nanoseconds, comparable across threads of the same process
+    [[nodiscard]] inline uint64_t GetBenchTimestamp() noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Hardware counters of the calling thread, opened on first use, see PerfCounterGroup
+    [[nodiscard]] inline const PerfCounterGroup& GetBenchCounters() noexcept
+    {
+        static thread_local const PerfCounterGroup s_counters;
+
+        return s_counters;
+    }
+
+    // ", 2.31 IPC, 0.02 cache misses/op, 0.00 branch misses/op" for the counters measured, empty without hardware counters
+    [[nodiscard]] inline std::string FormatPerfCounters(const PerfCounterValues& values, const size_t nElements, const char* unit = "op") noexcept
+    {
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(2);
+
+        const double elements = static_cast<double>(std::max<size_t>(nElements, 1u));
+
+        if (values.Has(PerfCounter::CYCLES) && values.Has(PerfCounter::INSTRUCTIONS))
+            stream << ", " << values.GetIPC() << " IPC";
+
+        if (values.Has(PerfCounter::CACHE_MISSES))
+            stream << ", " << static_cast<double>(values.Get(PerfCounter::CACHE_MISSES)) / elements << " cache misses/" << unit;
+
+        if (values.Has(PerfCounter::BRANCH_MISSES))
+            stream << ", " << static_cast<double>(values.Get(PerfCounter::BRANCH_MISSES)) / elements << " branch misses/" << unit;
+
+        return stream.str();
+    }
+
+    // Latencies in nanoseconds, percentiles are computed on demand
+    class LatencySamples {
+    private:
+        std::vector<uint64_t> m_samples;
+        bool                  m_bSorted = true;
+
+    public:
+        inline void Reserve(const size_t count) noexcept { this->m_samples.reserve(count); }
+
+        inline void Add(const uint64_t nanoseconds) noexcept
+        {
+            this->m_samples.push_back(nanoseconds);
+            this->m_bSorted = false;
+        }
+
+        inline void Clear() noexcept { this->m_samples.clear(); this->m_bSorted = true; }
+
+        [[nodiscard]] inline size_t GetCount() const noexcept { return this->m_samples.size(); }
+
+        // "percentile" in [0, 100], returned in microseconds
+        [[nodiscard]] inline double GetPercentile(const double percentile) noexcept
+        {
+            if (this->m_samples.empty())
+                return 0.0;
+
+            if (!this->m_bSorted) {
+                std::sort(this->m_samples.begin(), this->m_samples.end());
+                this->m_bSorted = true;
+            }
+
+            const size_t index = std::min(this->m_samples.size() - 1u, static_cast<size_t>(percentile / 100.0 * static_cast<double>(this->m_samples.size())));
+
+            return static_cast<double>(this->m_samples[index]) / 1000.0;
+        }
+    };
+
+}; // WS
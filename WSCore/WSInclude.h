@@ -3,6 +3,13 @@
 #include "misc/WSPch.h"
 #include "misc/WSMain.h"
 #include "misc/WSBitLogic.h"
+#include "misc/WSBitStream.h"
+#include "misc/WSChecksum.h"
+#include "misc/WSCpuFeatures.h"
+#include "misc/WSParallel.h"
+#include "misc/WSThreadPool.h"
+#include "misc/WSMappedFile.h"
+#include "misc/WSTask.h"
 
 #include "math/WSSimd.h"
 #include "math/WSVector.h"
@@ -11,10 +18,30 @@
 
 #include "media/WSAudio.h"
 #include "media/WSImage.h"
+#include "media/WSColorSpace.h"
+#include "media/WSImageLoader.h"
+#include "media/WSTextureFile.h"
+#include "media/WSBlockCompression.h"
+#include "media/WSCompositing.h"
+#include "media/WSFilters.h"
+
+#include "misc/WSSerialization.h"
 
 #include "debugging/WSLog.h"
+#include "debugging/WSLogger.h"
+#include "debugging/WSProfiler.h"
+#include "debugging/WSMetrics.h"
+#include "debugging/WSPerfCounters.h"
 
 #include "window/WSWindow.h"
 #include "window/WSPeripheral.h"
 
-#include "networking/WSSocket.h"
\ No newline at end of file
+#include "networking/WSSocket.h"
+#include "networking/WSIoUring.h"
+#include "networking/WSEventLoop.h"
+#include "networking/WSPacketRing.h"
+#include "networking/WSZeroCopy.h"
+#include "networking/WSFramedStream.h"
+#include "networking/WSAsyncSocket.h"
+#include "networking/WSSharedMemory.h"
+#include "networking/WSSnapshot.h"
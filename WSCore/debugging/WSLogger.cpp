@@ -0,0 +1,820 @@
+#include "WSLogger.h"
+
+namespace WS {
+
+	const char* GetLogLevelName(const LogLevel level) noexcept
+	{
+		switch (level) {
+		case LogLevel::TRACE:   return "TRACE";
+		case LogLevel::DEBUG:   return "DEBUG";
+		case LogLevel::INFO:    return "INFO";
+		case LogLevel::SUCCESS: return "SUCCESS";
+		case LogLevel::WARNING: return "WARNING";
+		case LogLevel::ERR:     return "ERROR";
+		}
+
+		return "UNKNOWN";
+	}
+
+	bool ParseLogLevel(const std::string_view name, LogLevel& level) noexcept
+	{
+		for (int i = WS_LOG_LEVEL_TRACE; i <= WS_LOG_LEVEL_ERROR; i++) {
+			const std::string_view candidate = GetLogLevelName(static_cast<LogLevel>(i));
+
+			if (std::equal(name.begin(), name.end(), candidate.begin(), candidate.end(), [](const char a, const char b) { return std::toupper(static_cast<unsigned char>(a)) == b; })) {
+				level = static_cast<LogLevel>(i);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	// ---------- Categories ---------- //
+
+	LogCategory::LogCategory(const char* name, const LogLevel level) noexcept
+		: m_name(name), m_level(level)
+	{
+		const std::lock_guard<std::mutex> lock(s_registryMutex);
+
+		this->m_pNext = s_pFirst;
+		s_pFirst      = this;
+	}
+
+	LogCategory* LogCategory::Find(const std::string_view name) noexcept
+	{
+		const std::lock_guard<std::mutex> lock(s_registryMutex);
+
+		for (LogCategory* pCategory = s_pFirst; pCategory != nullptr; pCategory = pCategory->m_pNext)
+			if (name == pCategory->m_name)
+				return pCategory;
+
+		return nullptr;
+	}
+
+	bool LogCategory::Configure(const std::string_view levels) noexcept
+	{
+		constexpr auto trim = [](std::string_view text) {
+			while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1u);
+			while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())))  text.remove_suffix(1u);
+
+			return text;
+		};
+
+		bool bValid = true;
+
+		for (size_t start = 0u; start <= levels.size();) {
+			const size_t           end   = std::min(levels.find(',', start), levels.size());
+			const std::string_view entry = trim(levels.substr(start, end - start));
+			start = end + 1u;
+
+			if (entry.empty())
+				continue;
+
+			const size_t equal = entry.find('=');
+			LogLevel     level;
+
+			if (equal == std::string_view::npos || !ParseLogLevel(trim(entry.substr(equal + 1u)), level)) {
+				bValid = false;
+				continue;
+			}
+
+			const std::string_view name = trim(entry.substr(0u, equal));
+
+			if (name == "*") {
+				const std::lock_guard<std::mutex> lock(s_registryMutex);
+
+				for (LogCategory* pCategory = s_pFirst; pCategory != nullptr; pCategory = pCategory->m_pNext)
+					pCategory->SetLevel(level);
+			} else if (LogCategory* pCategory = LogCategory::Find(name); pCategory != nullptr) {
+				pCategory->SetLevel(level);
+			} else {
+				bValid = false;
+			}
+		}
+
+		return bValid;
+	}
+
+	// ---------- Binary Arguments ---------- //
+
+	template <typename _T>
+	[[nodiscard]] static inline bool ReadLogValue(const uint8_t*& pData, const uint8_t* pEnd, _T& value) noexcept
+	{
+		if (static_cast<size_t>(pEnd - pData) < sizeof(_T))
+			return false;
+
+		std::memcpy(&value, pData, sizeof(_T));
+		pData += sizeof(_T);
+
+		return true;
+	}
+
+	template <typename _T>
+	[[nodiscard]] static inline bool DecodeLogValue(const uint8_t*& pArgument, const uint8_t* pEnd, std::ostream& stream) noexcept
+	{
+		_T value;
+		if (!ReadLogValue(pArgument, pEnd, value))
+			return false;
+
+		stream << value;
+
+		return true;
+	}
+
+	[[nodiscard]] static inline bool ReadLogString(const uint8_t*& pData, const uint8_t* pEnd, std::string_view& value) noexcept
+	{
+		uint32_t size;
+		if (!ReadLogValue(pData, pEnd, size) || static_cast<size_t>(pEnd - pData) < size)
+			return false;
+
+		value  = std::string_view(reinterpret_cast<const char*>(pData), size);
+		pData += size;
+
+		return true;
+	}
+
+	bool DecodeLogArgument(const LogArgumentCode code, const uint8_t*& pArgument, const uint8_t* pEnd, std::ostream& stream) noexcept
+	{
+		switch (code) {
+		case LogArgumentCode::BOOL:    return DecodeLogValue<bool>(pArgument, pEnd, stream);
+		case LogArgumentCode::CHAR:    return DecodeLogValue<char>(pArgument, pEnd, stream);
+		case LogArgumentCode::INT8:    return DecodeLogValue<int8_t>(pArgument, pEnd, stream);
+		case LogArgumentCode::UINT8:   return DecodeLogValue<uint8_t>(pArgument, pEnd, stream);
+		case LogArgumentCode::INT16:   return DecodeLogValue<int16_t>(pArgument, pEnd, stream);
+		case LogArgumentCode::UINT16:  return DecodeLogValue<uint16_t>(pArgument, pEnd, stream);
+		case LogArgumentCode::INT32:   return DecodeLogValue<int32_t>(pArgument, pEnd, stream);
+		case LogArgumentCode::UINT32:  return DecodeLogValue<uint32_t>(pArgument, pEnd, stream);
+		case LogArgumentCode::INT64:   return DecodeLogValue<int64_t>(pArgument, pEnd, stream);
+		case LogArgumentCode::UINT64:  return DecodeLogValue<uint64_t>(pArgument, pEnd, stream);
+		case LogArgumentCode::FLOAT32: return DecodeLogValue<float>(pArgument, pEnd, stream);
+		case LogArgumentCode::FLOAT64: return DecodeLogValue<double>(pArgument, pEnd, stream);
+		case LogArgumentCode::STRING: {
+			std::string_view value;
+			if (!ReadLogString(pArgument, pEnd, value))
+				return false;
+
+			stream << value;
+			return true;
+		}
+		case LogArgumentCode::POINTER: {
+			uint64_t address;
+			if (!ReadLogValue(pArgument, pEnd, address))
+				return false;
+
+			stream << reinterpret_cast<const void*>(static_cast<uintptr_t>(address));
+			return true;
+		}
+		}
+
+		return false;
+	}
+
+	// Bytes taken by the arguments of a record of "site", 0 if they don't fit in "maxSize"
+	[[nodiscard]] static size_t GetLogArgumentsSize(const LogSite& site, const uint8_t* pArguments, const size_t maxSize) noexcept
+	{
+		const uint8_t* pArgument = pArguments;
+		const uint8_t* pEnd      = pArguments + maxSize;
+
+		for (uint32_t i = 0u; i < site.m_nArguments; i++) {
+			size_t size;
+
+			switch (site.m_pArgumentCodes[i]) {
+			case LogArgumentCode::BOOL: case LogArgumentCode::CHAR: case LogArgumentCode::INT8: case LogArgumentCode::UINT8: size = 1u; break;
+			case LogArgumentCode::INT16: case LogArgumentCode::UINT16:                                                       size = 2u; break;
+			case LogArgumentCode::INT32: case LogArgumentCode::UINT32: case LogArgumentCode::FLOAT32:                        size = 4u; break;
+			case LogArgumentCode::STRING: {
+				uint32_t length;
+				if (!ReadLogValue(pArgument, pEnd, length))
+					return 0u;
+
+				size = length;
+				break;
+			}
+			default: size = 8u; break;
+			}
+
+			if (static_cast<size_t>(pEnd - pArgument) < size)
+				return 0u;
+
+			pArgument += size;
+		}
+
+		return static_cast<size_t>(pArgument - pArguments);
+	}
+
+	bool FormatLogMessage(const LogSite& site, const uint8_t* pArguments, const size_t size, std::ostream& stream) noexcept
+	{
+		const uint8_t* pArgument = pArguments;
+		const uint8_t* pEnd      = pArguments + size;
+		uint32_t       i         = 0u;
+
+		// Without a format, the arguments are written one after the other
+		if (site.m_format.empty()) {
+			for (; i < site.m_nArguments; i++)
+				if (!DecodeLogArgument(site.m_pArgumentCodes[i], pArgument, pEnd, stream))
+					return false;
+
+			return true;
+		}
+
+		size_t written = 0u;
+		for (size_t c = 0u; c + 1u < site.m_format.size(); c++) {
+			if (site.m_format[c] != '{' || site.m_format[c + 1u] != '}')
+				continue;
+
+			stream << site.m_format.substr(written, c - written);
+			written = c + 2u;
+			c++;
+
+			if (i >= site.m_nArguments || !DecodeLogArgument(site.m_pArgumentCodes[i++], pArgument, pEnd, stream))
+				return false;
+		}
+
+		stream << site.m_format.substr(written);
+
+		return true;
+	}
+
+	// ---------- Lines ---------- //
+
+	// Formats records as "2021-01-01 12:00:00.000000 INFO    [T0] [Category] message\n", the category is omitted for "General"
+	class LogLineFormatter {
+	private:
+		std::ostringstream& m_stream;
+		std::string&        m_line;
+
+		// The local time is only recomputed when the second changes
+		time_t m_lastSecond      = static_cast<time_t>(-1);
+		char   m_secondText[32u] = {};
+
+	public:
+		LogLineFormatter(std::ostringstream& stream, std::string& line) noexcept : m_stream(stream), m_line(line) {  }
+
+		[[nodiscard]] std::string_view Format(const LogRecord& record, const std::string_view category) noexcept
+		{
+			const time_t second = static_cast<time_t>(record.m_timestamp / 1000000000u);
+
+			if (second != this->m_lastSecond) {
+				std::tm localTime{};
+
+#ifdef __WEISS__OS_WINDOWS
+				localtime_s(&localTime, &second);
+#else
+				localtime_r(&second, &localTime);
+#endif
+
+				std::strftime(this->m_secondText, sizeof(this->m_secondText), "%Y-%m-%d %H:%M:%S", &localTime);
+				this->m_lastSecond = second;
+			}
+
+			char prefix[64u];
+			std::snprintf(prefix, sizeof(prefix), "%s.%06u %-7s [", this->m_secondText, static_cast<unsigned>((record.m_timestamp / 1000u) % 1000000u), GetLogLevelName(record.m_level));
+
+			this->m_stream.str(std::string());
+			this->m_stream.clear();
+			(void)FormatLogMessage(*record.m_pSite, record.m_pArguments, record.m_argumentsSize, this->m_stream);
+
+			this->m_line.assign(prefix);
+			this->m_line.append(record.m_threadName);
+			this->m_line.append("] ");
+
+			if (!category.empty() && category != "General") {
+				this->m_line.push_back('[');
+				this->m_line.append(category);
+				this->m_line.append("] ");
+			}
+
+			this->m_line.append(this->m_stream.view());
+			this->m_line.push_back('\n');
+
+			return this->m_line;
+		}
+	};
+
+	// ---------- Sinks ---------- //
+
+	void ConsoleSink::Write(const LogLevel level, const std::string_view line) noexcept
+	{
+#ifdef __WEISS__OS_LINUX
+
+		const char* color = nullptr;
+		if (this->m_bColors)
+			color = (level == LogLevel::ERR) ? "\x1B[1;31m" : (level == LogLevel::WARNING) ? "\x1B[1;33m" : (level == LogLevel::SUCCESS) ? "\x1B[1;32m" : nullptr;
+
+		if (color != nullptr) {
+			this->m_buffer.append(color);
+			this->m_buffer.append(line.substr(0u, line.size() - 1u));
+			this->m_buffer.append("\x1B[0m\n");
+			return;
+		}
+
+#else
+
+		(void)level;
+
+#endif
+
+		this->m_buffer.append(line);
+	}
+
+	void ConsoleSink::Flush() noexcept
+	{
+		if (this->m_buffer.empty())
+			return;
+
+		std::fwrite(this->m_buffer.data(), 1u, this->m_buffer.size(), stdout);
+		std::fflush(stdout);
+
+		this->m_buffer.clear();
+	}
+
+	FileSink::FileSink(const char* path) noexcept
+		: m_pFile(std::fopen(path, "ab"))
+	{
+
+	}
+
+	void FileSink::Write(const LogLevel, const std::string_view line) noexcept
+	{
+		if (this->m_pFile != nullptr)
+			std::fwrite(line.data(), 1u, line.size(), this->m_pFile);
+	}
+
+	void FileSink::Flush() noexcept
+	{
+		if (this->m_pFile != nullptr)
+			std::fflush(this->m_pFile);
+	}
+
+	FileSink::~FileSink() noexcept
+	{
+		if (this->m_pFile != nullptr)
+			std::fclose(this->m_pFile);
+	}
+
+	/*
+	 * Binary log layout (little endian) : "WSLOG", a version byte & 2 reserved bytes, then entries starting with their type.
+	 *   SITE   : index (u32), line (u32), argument count (u32) & codes (u8 each), format, file & category (u32 length & bytes each)
+	 *   THREAD : index (u32) & name, written before the thread's first record & when it's renamed
+	 *   RECORD : level (u8), site index (u32), thread index (u32), timestamp (u64), arguments size (u32) & arguments
+	 */
+	static constexpr const char    BINARY_LOG_MAGIC[5u]  = { 'W', 'S', 'L', 'O', 'G' };
+	static constexpr const uint8_t BINARY_LOG_VERSION    = 1u;
+	static constexpr const size_t  BINARY_LOG_HEADER_SIZE = 8u;
+
+	enum class BinaryLogEntry : uint8_t { SITE, THREAD, RECORD };
+
+	template <typename _T>
+	static inline void WriteLogValue(std::vector<uint8_t>& buffer, const _T& value) noexcept
+	{
+		const size_t offset = buffer.size();
+		buffer.resize(offset + sizeof(_T));
+		std::memcpy(buffer.data() + offset, &value, sizeof(_T));
+	}
+
+	static inline void WriteLogString(std::vector<uint8_t>& buffer, const std::string_view value) noexcept
+	{
+		WriteLogValue(buffer, static_cast<uint32_t>(value.size()));
+		buffer.insert(buffer.end(), value.begin(), value.end());
+	}
+
+	BinaryFileSink::BinaryFileSink(const char* path) noexcept
+		: m_pFile(std::fopen(path, "wb"))
+	{
+		if (this->m_pFile == nullptr)
+			return;
+
+		uint8_t header[BINARY_LOG_HEADER_SIZE] = {};
+		std::memcpy(header, BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+		header[sizeof(BINARY_LOG_MAGIC)] = BINARY_LOG_VERSION;
+
+		std::fwrite(header, 1u, sizeof(header), this->m_pFile);
+	}
+
+	void BinaryFileSink::WriteRecord(const LogRecord& record) noexcept
+	{
+		if (this->m_pFile == nullptr)
+			return;
+
+		std::vector<uint8_t>& buffer = this->m_buffer;
+
+		const auto [siteIterator, bNewSite] = this->m_siteIndices.try_emplace(record.m_pSite, static_cast<uint32_t>(this->m_siteIndices.size()));
+
+		if (bNewSite) {
+			const LogSite& site = *record.m_pSite;
+
+			WriteLogValue(buffer, BinaryLogEntry::SITE);
+			WriteLogValue(buffer, siteIterator->second);
+			WriteLogValue(buffer, site.m_line);
+			WriteLogValue(buffer, site.m_nArguments);
+			buffer.insert(buffer.end(), reinterpret_cast<const uint8_t*>(site.m_pArgumentCodes), reinterpret_cast<const uint8_t*>(site.m_pArgumentCodes + site.m_nArguments));
+			WriteLogString(buffer, site.m_format);
+			WriteLogString(buffer, site.m_file);
+			WriteLogString(buffer, (site.m_pCategory != nullptr) ? site.m_pCategory->GetName() : "");
+		}
+
+		const auto [threadIterator, bNewThread] = this->m_threadNames.try_emplace(record.m_threadIndex, record.m_threadName);
+
+		if (bNewThread || threadIterator->second != record.m_threadName) {
+			threadIterator->second = record.m_threadName;
+
+			WriteLogValue(buffer, BinaryLogEntry::THREAD);
+			WriteLogValue(buffer, record.m_threadIndex);
+			WriteLogString(buffer, record.m_threadName);
+		}
+
+		WriteLogValue(buffer, BinaryLogEntry::RECORD);
+		WriteLogValue(buffer, record.m_level);
+		WriteLogValue(buffer, siteIterator->second);
+		WriteLogValue(buffer, record.m_threadIndex);
+		WriteLogValue(buffer, record.m_timestamp);
+		WriteLogValue(buffer, static_cast<uint32_t>(record.m_argumentsSize));
+		buffer.insert(buffer.end(), record.m_pArguments, record.m_pArguments + record.m_argumentsSize);
+	}
+
+	void BinaryFileSink::Flush() noexcept
+	{
+		if (this->m_pFile == nullptr || this->m_buffer.empty())
+			return;
+
+		std::fwrite(this->m_buffer.data(), 1u, this->m_buffer.size(), this->m_pFile);
+		std::fflush(this->m_pFile);
+
+		this->m_buffer.clear();
+	}
+
+	BinaryFileSink::~BinaryFileSink() noexcept
+	{
+		if (this->m_pFile != nullptr) {
+			this->Flush();
+			std::fclose(this->m_pFile);
+		}
+	}
+
+	bool DecodeBinaryLog(const uint8_t* data, const size_t size, const std::function<void(const LogLevel, const std::string_view)>& onLine) noexcept
+	{
+		struct DecodedSite {
+			LogSite                      m_site;
+			std::vector<LogArgumentCode> m_codes;
+			std::string_view             m_category;
+		};
+
+		if (size < BINARY_LOG_HEADER_SIZE || std::memcmp(data, BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC)) != 0 || data[sizeof(BINARY_LOG_MAGIC)] != BINARY_LOG_VERSION)
+			return false;
+
+		std::vector<DecodedSite>  sites;
+		std::vector<std::string>  threadNames;
+		std::ostringstream        stream;
+		std::string               line;
+		LogLineFormatter          formatter(stream, line);
+
+		const uint8_t* pData = data + BINARY_LOG_HEADER_SIZE;
+		const uint8_t* pEnd  = data + size;
+
+		while (pData < pEnd) {
+			BinaryLogEntry type;
+			if (!ReadLogValue(pData, pEnd, type))
+				return false;
+
+			switch (type) {
+			case BinaryLogEntry::SITE: {
+				DecodedSite      decoded;
+				uint32_t         index;
+				std::string_view file;
+
+				if (!ReadLogValue(pData, pEnd, index) || !ReadLogValue(pData, pEnd, decoded.m_site.m_line) || !ReadLogValue(pData, pEnd, decoded.m_site.m_nArguments))
+					return false;
+
+				// Sites are written in the order of their indices
+				if (index != sites.size() || static_cast<size_t>(pEnd - pData) < decoded.m_site.m_nArguments)
+					return false;
+
+				decoded.m_codes.assign(reinterpret_cast<const LogArgumentCode*>(pData), reinterpret_cast<const LogArgumentCode*>(pData + decoded.m_site.m_nArguments));
+				pData += decoded.m_site.m_nArguments;
+
+				if (!ReadLogString(pData, pEnd, decoded.m_site.m_format) || !ReadLogString(pData, pEnd, file) || !ReadLogString(pData, pEnd, decoded.m_category))
+					return false;
+
+				// Points into "data", which outlives the sites
+				decoded.m_site.m_file      = nullptr;
+				decoded.m_site.m_pCategory = nullptr;
+
+				sites.push_back(std::move(decoded));
+				sites.back().m_site.m_pArgumentCodes = sites.back().m_codes.data();
+				break;
+			}
+			case BinaryLogEntry::THREAD: {
+				uint32_t         index;
+				std::string_view name;
+
+				if (!ReadLogValue(pData, pEnd, index) || !ReadLogString(pData, pEnd, name))
+					return false;
+
+				if (index >= threadNames.size())
+					threadNames.resize(static_cast<size_t>(index) + 1u);
+
+				threadNames[index] = name;
+				break;
+			}
+			case BinaryLogEntry::RECORD: {
+				LogRecord record;
+				uint32_t  siteIndex, argumentsSize;
+
+				if (!ReadLogValue(pData, pEnd, record.m_level) || !ReadLogValue(pData, pEnd, siteIndex) || !ReadLogValue(pData, pEnd, record.m_threadIndex) ||
+				    !ReadLogValue(pData, pEnd, record.m_timestamp) || !ReadLogValue(pData, pEnd, argumentsSize))
+					return false;
+
+				if (siteIndex >= sites.size() || record.m_threadIndex >= threadNames.size() || static_cast<size_t>(pEnd - pData) < argumentsSize)
+					return false;
+
+				record.m_pSite         = &sites[siteIndex].m_site;
+				record.m_threadName    = threadNames[record.m_threadIndex];
+				record.m_pArguments    = pData;
+				record.m_argumentsSize = argumentsSize;
+				pData += argumentsSize;
+
+				onLine(record.m_level, formatter.Format(record, sites[siteIndex].m_category));
+				break;
+			}
+			default:
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// ---------- Logger ---------- //
+
+	static_assert((WS_LOG_RING_SIZE & (WS_LOG_RING_SIZE - 1u)) == 0u, "WS_LOG_RING_SIZE Must Be A Power Of Two");
+
+	thread_local Logger::ThreadRingOwner Logger::s_threadRing;
+
+	Logger::ThreadRingOwner::~ThreadRingOwner() noexcept
+	{
+		if (this->m_pRing != nullptr)
+			this->m_pRing->m_bRetired.store(true, std::memory_order_release);
+	}
+
+	Logger::Logger() noexcept
+	{
+		this->m_thread = std::thread([this]() { this->Run(); });
+	}
+
+	Logger& Logger::Get() noexcept
+	{
+		static Logger logger;
+
+		return logger;
+	}
+
+	Logger::ThreadRing& Logger::GetThreadRing() noexcept
+	{
+		if (s_threadRing.m_pRing != nullptr)
+			return *s_threadRing.m_pRing;
+
+		std::unique_ptr<ThreadRing> pRing = std::make_unique<ThreadRing>();
+		pRing->m_data = std::make_unique<uint8_t[]>(WS_LOG_RING_SIZE);
+
+		const std::lock_guard<std::mutex> lock(this->m_ringsMutex);
+
+		pRing->m_index = this->m_nextThreadIndex++;
+		pRing->m_name  = "T" + std::to_string(pRing->m_index);
+		s_threadRing.m_pRing = pRing.get();
+		this->m_rings.push_back(std::move(pRing));
+
+		return *s_threadRing.m_pRing;
+	}
+
+	uint8_t* Logger::Reserve(const size_t size, ThreadRing*& pRing) noexcept
+	{
+		constexpr const uint64_t mask = WS_LOG_RING_SIZE - 1u;
+
+		// A record larger than half the ring could wait forever for room
+		const uint64_t recordSize = (static_cast<uint64_t>(size) + 7u) & ~uint64_t(7u);
+		if (recordSize > WS_LOG_RING_SIZE / 2u || this->m_bStopped.load(std::memory_order_relaxed)) {
+			this->m_nDropped.fetch_add(1u, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		ThreadRing&    ring    = this->GetThreadRing();
+		const uint64_t head    = ring.m_head.load(std::memory_order_relaxed);
+		const uint64_t offset  = head & mask;
+		const uint64_t padding = (offset + recordSize > WS_LOG_RING_SIZE) ? WS_LOG_RING_SIZE - offset : 0u;
+		const uint64_t end     = head + padding + recordSize;
+
+		if (end - ring.m_cachedTail > WS_LOG_RING_SIZE) {
+			ring.m_cachedTail = ring.m_tail.load(std::memory_order_acquire);
+
+			while (end - ring.m_cachedTail > WS_LOG_RING_SIZE) {
+				this->Wake();
+
+				if (this->m_overflowPolicy.load(std::memory_order_relaxed) == LogOverflowPolicy::DROP || this->m_bStopped.load(std::memory_order_relaxed)) {
+					this->m_nDropped.fetch_add(1u, std::memory_order_relaxed);
+					return nullptr;
+				}
+
+				std::this_thread::yield();
+				ring.m_cachedTail = ring.m_tail.load(std::memory_order_acquire);
+			}
+		}
+
+		// Past half full, the background thread is woken up rather than waiting for its next batch
+		if (end - ring.m_cachedTail > WS_LOG_RING_SIZE / 2u) {
+			ring.m_cachedTail = ring.m_tail.load(std::memory_order_acquire);
+
+			if (end - ring.m_cachedTail > WS_LOG_RING_SIZE / 2u)
+				this->Wake();
+		}
+
+		// Marks the end of the ring, records are 8 byte aligned so there's always room for the size
+		if (padding > 0u)
+			*reinterpret_cast<uint32_t*>(&ring.m_data[offset]) = 0u;
+
+		uint8_t* pRecord = &ring.m_data[(head + padding) & mask];
+		reinterpret_cast<RecordHeader*>(pRecord)->m_size = static_cast<uint32_t>(recordSize);
+
+		ring.m_pendingHead = end;
+		pRing              = &ring;
+
+		return pRecord;
+	}
+
+	void Logger::Wake() noexcept
+	{
+		// Only the first request since the last batch notifies
+		if (!this->m_bWakeRequested.exchange(true, std::memory_order_relaxed))
+			this->m_wake.notify_one();
+	}
+
+	void Logger::Run() noexcept
+	{
+		std::ostringstream stream;
+		std::string        line;
+
+		std::unique_lock<std::mutex> lock(this->m_wakeMutex);
+
+		while (true) {
+			this->m_wake.wait_for(lock, std::chrono::milliseconds(WS_LOG_FLUSH_INTERVAL_MS), [this]() {
+				return this->m_bWakeRequested.load(std::memory_order_relaxed) || this->m_flushRequests != this->m_flushesDone || this->m_bStopping;
+			});
+
+			const bool     bStopping     = this->m_bStopping;
+			const uint64_t flushRequests = this->m_flushRequests;
+
+			this->m_bWakeRequested.store(false, std::memory_order_relaxed);
+			lock.unlock();
+
+			this->Drain(stream, line);
+
+			lock.lock();
+
+			if (this->m_flushesDone != flushRequests) {
+				this->m_flushesDone = flushRequests;
+				this->m_flushed.notify_all();
+			}
+
+			if (bStopping)
+				break;
+		}
+	}
+
+	void Logger::Drain(std::ostringstream& stream, std::string& line) noexcept
+	{
+		constexpr const uint64_t mask = WS_LOG_RING_SIZE - 1u;
+
+		const std::lock_guard<std::mutex> ringsLock(this->m_ringsMutex);
+
+		this->m_batch.clear();
+		this->m_batchHeads.resize(this->m_rings.size());
+
+		size_t nRetired = 0u;
+
+		for (size_t r = 0u; r < this->m_rings.size(); r++) {
+			ThreadRing& ring = *this->m_rings[r];
+
+			// Read before the head : nothing is committed to a ring after it's retired
+			const bool bRetired = ring.m_bRetired.load(std::memory_order_acquire);
+			nRetired += bRetired ? 1u : 0u;
+
+			const uint64_t head = ring.m_head.load(std::memory_order_acquire);
+			this->m_batchHeads[r] = bRetired ? ~uint64_t(0u) : head;
+
+			for (uint64_t position = ring.m_tail.load(std::memory_order_relaxed); position != head;) {
+				const RecordHeader* pHeader = reinterpret_cast<const RecordHeader*>(&ring.m_data[position & mask]);
+
+				if (pHeader->m_size == 0u) {
+					position += WS_LOG_RING_SIZE - (position & mask);
+					continue;
+				}
+
+				this->m_batch.emplace_back(pHeader, &ring);
+				position += pHeader->m_size;
+			}
+		}
+
+		if (!this->m_batch.empty()) {
+			std::stable_sort(this->m_batch.begin(), this->m_batch.end(), [](const auto& a, const auto& b) { return a.first->m_timestamp < b.first->m_timestamp; });
+
+			const std::lock_guard<std::mutex> sinksLock(this->m_sinksMutex);
+
+			if (this->m_sinks.empty())
+				this->m_sinks.push_back(std::make_unique<ConsoleSink>());
+
+			// Records are only formatted if a sink wants lines
+			const bool bLines = std::any_of(this->m_sinks.begin(), this->m_sinks.end(), [](const std::unique_ptr<LogSink>& pSink) { return pSink->WantsLines(); });
+
+			LogLineFormatter formatter(stream, line);
+
+			for (const auto& [pHeader, pRing] : this->m_batch) {
+				const uint8_t* pArguments = reinterpret_cast<const uint8_t*>(pHeader) + sizeof(RecordHeader);
+
+				const LogRecord record = {
+					pHeader->m_level, pHeader->m_timestamp, pHeader->m_pSite, pRing->m_index, pRing->m_name,
+					pArguments, GetLogArgumentsSize(*pHeader->m_pSite, pArguments, pHeader->m_size - sizeof(RecordHeader))
+				};
+
+				if (bLines) {
+					const std::string_view text = formatter.Format(record, pHeader->m_pSite->m_pCategory->GetName());
+
+					for (const std::unique_ptr<LogSink>& pSink : this->m_sinks)
+						if (pSink->WantsLines())
+							pSink->Write(record.m_level, text);
+				}
+
+				for (const std::unique_ptr<LogSink>& pSink : this->m_sinks)
+					pSink->WriteRecord(record);
+			}
+
+			for (const std::unique_ptr<LogSink>& pSink : this->m_sinks)
+				pSink->Flush();
+		}
+
+		// Once formatted, the records' room can be reused
+		for (size_t r = 0u; r < this->m_rings.size(); r++)
+			if (this->m_batchHeads[r] != ~uint64_t(0u))
+				this->m_rings[r]->m_tail.store(this->m_batchHeads[r], std::memory_order_release);
+
+		if (nRetired > 0u) {
+			size_t r = 0u;
+			std::erase_if(this->m_rings, [this, &r](const std::unique_ptr<ThreadRing>&) { return this->m_batchHeads[r++] == ~uint64_t(0u); });
+		}
+	}
+
+	void Logger::AddSink(std::unique_ptr<LogSink> pSink) noexcept
+	{
+		const std::lock_guard<std::mutex> lock(this->m_sinksMutex);
+
+		this->m_sinks.push_back(std::move(pSink));
+	}
+
+	void Logger::SetThreadName(const std::string_view name) noexcept
+	{
+		ThreadRing& ring = this->GetThreadRing();
+
+		// The background thread reads names while holding the same lock
+		const std::lock_guard<std::mutex> lock(this->m_ringsMutex);
+
+		ring.m_name = name;
+	}
+
+	void Logger::Flush() noexcept
+	{
+		std::unique_lock<std::mutex> lock(this->m_wakeMutex);
+
+		if (this->m_bStopping)
+			return;
+
+		const uint64_t request = ++this->m_flushRequests;
+		this->m_wake.notify_one();
+
+		this->m_flushed.wait(lock, [this, request]() { return this->m_flushesDone >= request || this->m_bStopping; });
+	}
+
+	void Logger::Stop() noexcept
+	{
+		{
+			const std::lock_guard<std::mutex> lock(this->m_wakeMutex);
+
+			if (this->m_bStopping)
+				return;
+
+			this->m_bStopped.store(true, std::memory_order_relaxed);
+			this->m_bStopping = true;
+		}
+
+		this->m_wake.notify_one();
+		this->m_thread.join();
+
+		const std::lock_guard<std::mutex> lock(this->m_wakeMutex);
+		this->m_flushesDone = this->m_flushRequests;
+		this->m_flushed.notify_all();
+	}
+
+	Logger::~Logger() noexcept
+	{
+		this->Stop();
+	}
+
+}; // WS
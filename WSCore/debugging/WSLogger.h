@@ -0,0 +1,541 @@
+#pragma once
+
+#include "WSLog.h"
+#include "../misc/WSPch.h"
+
+#define WS_LOG_RING_SIZE         (1u << 16u) // Bytes of each thread's ring, a power of two
+#define WS_LOG_FLUSH_INTERVAL_MS 2u          // Longest a record waits before the logging thread writes it, unless a ring fills up
+
+#define WS_LOG_LEVEL_TRACE   0
+#define WS_LOG_LEVEL_DEBUG   1
+#define WS_LOG_LEVEL_INFO    2
+#define WS_LOG_LEVEL_SUCCESS 3
+#define WS_LOG_LEVEL_WARNING 4
+#define WS_LOG_LEVEL_ERROR   5
+#define WS_LOG_LEVEL_OFF     6
+
+// The WS_LOG_* macros below this level compile to nothing & don't evaluate their arguments
+#ifndef WS_LOG_MIN_LEVEL
+	#ifdef __WEISS__DEBUG_MODE
+		#define WS_LOG_MIN_LEVEL WS_LOG_LEVEL_TRACE
+	#else
+		#define WS_LOG_MIN_LEVEL WS_LOG_LEVEL_INFO
+	#endif
+#endif
+
+namespace WS {
+
+	enum class LogLevel : uint8_t {
+		TRACE   = WS_LOG_LEVEL_TRACE,
+		DEBUG   = WS_LOG_LEVEL_DEBUG,
+		INFO    = WS_LOG_LEVEL_INFO,
+		SUCCESS = WS_LOG_LEVEL_SUCCESS,
+		WARNING = WS_LOG_LEVEL_WARNING,
+		ERR     = WS_LOG_LEVEL_ERROR // ERROR is a macro of <windows.h>
+	};
+
+	[[nodiscard]] const char* GetLogLevelName(const LogLevel level) noexcept;
+
+	// Parses a level name as returned by GetLogLevelName(), case insensitive
+	[[nodiscard]] bool ParseLogLevel(const std::string_view name, LogLevel& level) noexcept;
+
+	// What a thread does when its ring is full
+	enum class LogOverflowPolicy : uint8_t {
+		DROP, // The record is lost & counted (see Logger::GetDroppedCount), logging never waits
+		BLOCK // The thread waits for the logging thread to make room
+	};
+
+	/*
+	 * A named group of log sites whose level is filtered at runtime, on top of WS_LOG_MIN_LEVEL.
+	 * Categories are defined with WS_DEFINE_LOG_CATEGORY & live as long as the program.
+	 */
+	class LogCategory {
+	private:
+		static inline std::mutex   s_registryMutex;
+		static inline LogCategory* s_pFirst = nullptr;
+
+		const char*           m_name;
+		std::atomic<LogLevel> m_level;
+		LogCategory*          m_pNext;
+
+	public:
+		explicit LogCategory(const char* name, const LogLevel level = LogLevel::TRACE) noexcept;
+
+		LogCategory(const LogCategory&) = delete;
+		LogCategory& operator=(const LogCategory&) = delete;
+
+		[[nodiscard]] inline const char* GetName() const noexcept { return this->m_name; }
+
+		[[nodiscard]] inline bool IsEnabled(const LogLevel level) const noexcept { return level >= this->m_level.load(std::memory_order_relaxed); }
+
+		[[nodiscard]] inline LogLevel GetLevel() const noexcept { return this->m_level.load(std::memory_order_relaxed); }
+
+		inline void SetLevel(const LogLevel level) noexcept { this->m_level.store(level, std::memory_order_relaxed); }
+
+		// Null if no category has this name
+		[[nodiscard]] static LogCategory* Find(const std::string_view name) noexcept;
+
+		/*
+		 * Sets levels from a list such as "Networking=WARNING,Renderer=DEBUG", "*" names every category.
+		 * Returns false if a name or a level is unknown, the valid entries are still applied.
+		 */
+		static bool Configure(const std::string_view levels) noexcept;
+	};
+
+}; // WS
+
+// Defines the category "name" in the current namespace, the WS_LOG_* macros refer to it by its name
+#define WS_DEFINE_LOG_CATEGORY(name, ...) inline ::WS::LogCategory WSLogCategory_##name(#name __VA_OPT__(,) __VA_ARGS__)
+
+// Records logged without a category (i.e with WS::Log) belong to "General"
+WS_DEFINE_LOG_CATEGORY(General);
+
+namespace WS {
+
+	// ---------- Binary Arguments ---------- //
+
+	// How the arguments of a record are stored, decoding only needs the codes of its site
+	enum class LogArgumentCode : uint8_t {
+		BOOL, CHAR, INT8, UINT8, INT16, UINT16, INT32, UINT32, INT64, UINT64, FLOAT32, FLOAT64,
+		STRING, // Length (u32) & bytes
+		POINTER
+	};
+
+	template <typename _T>
+	[[nodiscard]] constexpr LogArgumentCode GetArithmeticLogArgumentCode() noexcept
+	{
+		static_assert(!std::is_floating_point_v<_T> || sizeof(_T) <= 8u, "[WS] long double Can't Be Logged");
+
+		if constexpr (std::is_same_v<_T, bool>)            return LogArgumentCode::BOOL;
+		else if constexpr (std::is_same_v<_T, char>)       return LogArgumentCode::CHAR;
+		else if constexpr (std::is_floating_point_v<_T>)    return (sizeof(_T) == 4u) ? LogArgumentCode::FLOAT32 : LogArgumentCode::FLOAT64;
+		else if constexpr (sizeof(_T) == 1u)                return std::is_signed_v<_T> ? LogArgumentCode::INT8  : LogArgumentCode::UINT8;
+		else if constexpr (sizeof(_T) == 2u)                return std::is_signed_v<_T> ? LogArgumentCode::INT16 : LogArgumentCode::UINT16;
+		else if constexpr (sizeof(_T) == 4u)                return std::is_signed_v<_T> ? LogArgumentCode::INT32 : LogArgumentCode::UINT32;
+		else                                                return std::is_signed_v<_T> ? LogArgumentCode::INT64 : LogArgumentCode::UINT64;
+	}
+
+	/*
+	 * How a logged value travels through a ring : arithmetic values & pointers are copied as is, enums as their value,
+	 * strings with their length. Anything else that can be written to a std::ostream is formatted to a string first.
+	 * The background thread decodes & writes values to a stream like WS::Print would.
+	 */
+	template <typename _T, typename = void>
+	struct LogArgument {
+		// Formatted eagerly, the only case that allocates on the calling thread
+		[[nodiscard]] static inline std::string Format(const _T& value) noexcept
+		{
+			std::ostringstream stream;
+			stream << value;
+
+			return stream.str();
+		}
+	};
+
+	template <typename _T>
+	struct LogArgument<_T, std::enable_if_t<std::is_arithmetic_v<_T>>> {
+		static constexpr const LogArgumentCode CODE = GetArithmeticLogArgumentCode<_T>();
+
+		[[nodiscard]] static constexpr size_t GetSize(const _T&) noexcept { return sizeof(_T); }
+
+		static inline void Encode(uint8_t*& pDst, const _T& value) noexcept { std::memcpy(pDst, &value, sizeof(_T)); pDst += sizeof(_T); }
+	};
+
+	// Logged as their value, promoted like the unary + does
+	template <typename _T>
+	struct LogArgument<_T, std::enable_if_t<std::is_enum_v<_T>>> {
+		using ValueType = std::conditional_t<std::is_signed_v<std::underlying_type_t<_T>>, int64_t, uint64_t>;
+
+		static constexpr const LogArgumentCode CODE = GetArithmeticLogArgumentCode<ValueType>();
+
+		[[nodiscard]] static constexpr size_t GetSize(const _T&) noexcept { return sizeof(ValueType); }
+
+		static inline void Encode(uint8_t*& pDst, const _T& value) noexcept
+		{
+			const ValueType converted = static_cast<ValueType>(value);
+			std::memcpy(pDst, &converted, sizeof(converted));
+			pDst += sizeof(converted);
+		}
+	};
+
+	template <>
+	struct LogArgument<std::string_view> {
+		static constexpr const LogArgumentCode CODE = LogArgumentCode::STRING;
+
+		[[nodiscard]] static inline size_t GetSize(const std::string_view value) noexcept { return sizeof(uint32_t) + value.size(); }
+
+		static inline void Encode(uint8_t*& pDst, const std::string_view value) noexcept
+		{
+			const uint32_t size = static_cast<uint32_t>(value.size());
+			std::memcpy(pDst, &size, sizeof(size));
+			std::memcpy(pDst + sizeof(size), value.data(), size);
+			pDst += sizeof(size) + size;
+		}
+	};
+
+	template <typename _T>
+	struct LogArgument<_T*, std::enable_if_t<!std::is_same_v<std::remove_cv_t<_T>, char>>> {
+		static constexpr const LogArgumentCode CODE = LogArgumentCode::POINTER;
+
+		[[nodiscard]] static constexpr size_t GetSize(const _T*) noexcept { return sizeof(uint64_t); }
+
+		static inline void Encode(uint8_t*& pDst, const _T* value) noexcept
+		{
+			const uint64_t address = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value));
+			std::memcpy(pDst, &address, sizeof(address));
+			pDst += sizeof(address);
+		}
+	};
+
+	template <typename _T>
+	concept BinaryLogArgument = requires(const _T& value, uint8_t*& pDst) { LogArgument<_T>::Encode(pDst, value); };
+
+	// How an argument is encoded : strings (& the text of types without a binary form) are viewed, not copied, until then
+	template <typename _T>
+	using LogArgumentType = std::conditional_t<BinaryLogArgument<std::decay_t<_T>> && !std::is_convertible_v<const _T&, std::string_view>, std::decay_t<_T>, std::string_view>;
+
+	// The value to encode, or the text it's formatted to, which lives until the end of the logging call
+	template <typename _T>
+	[[nodiscard]] inline auto ToLogArgument(const _T& value) noexcept
+	{
+		if constexpr (std::is_pointer_v<std::decay_t<_T>> && std::is_convertible_v<const _T&, std::string_view>)
+			return (value != nullptr) ? std::string_view(value) : std::string_view("(null)");
+		else if constexpr (std::is_convertible_v<const _T&, std::string_view>)
+			return std::string_view(value);
+		else if constexpr (BinaryLogArgument<std::decay_t<_T>>)
+			return static_cast<std::decay_t<_T>>(value);
+		else
+			return LogArgument<_T>::Format(value);
+	}
+
+	// Writes the argument at "pArgument" (of at most "pEnd") to "stream" & moves past it, false if it doesn't fit
+	[[nodiscard]] bool DecodeLogArgument(const LogArgumentCode code, const uint8_t*& pArgument, const uint8_t* pEnd, std::ostream& stream) noexcept;
+
+	// ---------- Sites ---------- //
+
+	// Number of "{}" in a format
+	[[nodiscard]] constexpr size_t CountLogPlaceholders(const std::string_view format) noexcept
+	{
+		size_t count = 0u;
+		for (size_t i = 0u; i + 1u < format.size(); i++)
+			if (format[i] == '{' && format[i + 1u] == '}')
+				count++, i++;
+
+		return count;
+	}
+
+	/*
+	 * What every record of a call site shares, built at compile time : records only carry a pointer to it & their arguments.
+	 * "m_format"'s "{}" are replaced by the arguments in order, an empty format writes them one after the other like WS::Print.
+	 */
+	struct LogSite {
+		std::string_view       m_format;
+		const char*            m_file;
+		uint32_t               m_line;
+		const LogCategory*     m_pCategory;
+		const LogArgumentCode* m_pArgumentCodes;
+		uint32_t               m_nArguments;
+	};
+
+	// What a WS_LOG_* macro knows about its call site
+	struct LogSiteInfo {
+		std::string_view   m_format;
+		const char*        m_file;
+		uint32_t           m_line;
+		const LogCategory* m_pCategory;
+	};
+
+	template <typename ..._Args>
+	inline constexpr std::array<LogArgumentCode, sizeof...(_Args)> LOG_ARGUMENT_CODES = { LogArgument<_Args>::CODE... };
+
+	// The site of the WS::Log calls with these argument types
+	template <typename ..._Args>
+	inline constexpr LogSite LOG_CONCATENATION_SITE = { std::string_view(), "", 0u, &WSLogCategory_General, LOG_ARGUMENT_CODES<_Args...>.data(), sizeof...(_Args) };
+
+	/*
+	 * Formats "format" with the arguments of a record, at most "size" bytes starting at "pArguments".
+	 * Returns false (after writing what could be decoded) if they don't fit.
+	 */
+	[[nodiscard]] bool FormatLogMessage(const LogSite& site, const uint8_t* pArguments, const size_t size, std::ostream& stream) noexcept;
+
+	// ---------- Sinks ---------- //
+
+	// A record as the sinks see it
+	struct LogRecord {
+		LogLevel         m_level;
+		uint64_t         m_timestamp; // Nanoseconds since the epoch
+		const LogSite*   m_pSite;
+		uint32_t         m_threadIndex;
+		std::string_view m_threadName;
+		const uint8_t*   m_pArguments;
+		size_t           m_argumentsSize;
+	};
+
+	/*
+	 * Receives the records of every batch from the logging thread only, then a Flush() at its end.
+	 * Text sinks get each record formatted as a line (ending with '\n'), binary ones get it as is.
+	 * Sinks should buffer what they get & write it all at once in Flush().
+	 */
+	class LogSink {
+	public:
+		// Records aren't formatted unless a sink wants lines
+		[[nodiscard]] virtual bool WantsLines() const noexcept { return true; }
+
+		virtual void Write(const LogLevel, const std::string_view) noexcept {  }
+		virtual void WriteRecord(const LogRecord&) noexcept {  }
+		virtual void Flush() noexcept = 0;
+
+		virtual ~LogSink() = default;
+	};
+
+	// Writes to the standard output, errors in red, warnings in yellow & successes in green when "bColors" is set
+	class ConsoleSink : public LogSink {
+	private:
+		std::string m_buffer;
+		bool        m_bColors;
+
+	public:
+		explicit ConsoleSink(const bool bColors = true) noexcept : m_bColors(bColors) {  }
+
+		void Write(const LogLevel level, const std::string_view line) noexcept override;
+		void Flush() noexcept override;
+	};
+
+	// Appends lines to a file, once per batch
+	class FileSink : public LogSink {
+	private:
+		std::FILE* m_pFile;
+
+	public:
+		explicit FileSink(const char* path) noexcept;
+
+		[[nodiscard]] inline bool IsOpen() const noexcept { return this->m_pFile != nullptr; }
+
+		void Write(const LogLevel level, const std::string_view line) noexcept override;
+		void Flush() noexcept override;
+
+		~FileSink() noexcept override;
+	};
+
+	/*
+	 * Writes records in binary form : each site's format, file & argument codes once, then only the site's index & the raw
+	 * arguments per record. Nothing is formatted, DecodeBinaryLog() (or the WeissLogDecode tool) turns the file into text.
+	 */
+	class BinaryFileSink : public LogSink {
+	private:
+		std::FILE*                                   m_pFile;
+		std::vector<uint8_t>                         m_buffer;
+		std::unordered_map<const LogSite*, uint32_t> m_siteIndices;
+		std::unordered_map<uint32_t, std::string>    m_threadNames; // As last written, by thread index
+
+	public:
+		// Truncates the file
+		explicit BinaryFileSink(const char* path) noexcept;
+
+		[[nodiscard]] inline bool IsOpen() const noexcept { return this->m_pFile != nullptr; }
+
+		[[nodiscard]] bool WantsLines() const noexcept override { return false; }
+
+		void WriteRecord(const LogRecord& record) noexcept override;
+		void Flush() noexcept override;
+
+		~BinaryFileSink() noexcept override;
+	};
+
+	/*
+	 * Turns what a BinaryFileSink wrote into the lines text sinks would have gotten, calling "onLine" for each.
+	 * Returns false if the data is malformed or truncated, the records before that point are still decoded.
+	 */
+	[[nodiscard]] bool DecodeBinaryLog(const uint8_t* data, const size_t size, const std::function<void(const LogLevel, const std::string_view)>& onLine) noexcept;
+
+	// ---------- Logger ---------- //
+
+	/*
+	 * Asynchronous logger : every logging thread encodes its records (level, timestamp, site & arguments in binary form) into a
+	 * lock free single producer / single consumer ring of its own, a background thread formats them & writes them to the sinks in batches.
+	 * Logging takes no lock & makes no system call, unless the ring is full & the policy is BLOCK.
+	 * Lines are ordered within a thread, & across threads within a batch by timestamp.
+	 */
+	class Logger {
+	private:
+		// Records are contiguous & 8 byte aligned, one that would wrap around the end of a ring starts over at its beginning
+		struct RecordHeader {
+			uint32_t          m_size;      // Header & padding included, 0 marks the end of the ring
+			LogLevel          m_level;
+			uint64_t          m_timestamp; // Nanoseconds since the epoch
+			const LogSite*    m_pSite;
+		};
+
+		struct ThreadRing {
+			alignas(64) std::atomic<uint64_t> m_head = 0u; // Bytes written so far, only moved by the logging thread
+			alignas(64) std::atomic<uint64_t> m_tail = 0u; // Bytes read so far, only moved by the background thread
+
+			// Logging thread's side
+			alignas(64) uint64_t m_cachedTail  = 0u;
+			uint64_t             m_pendingHead = 0u; // Head once the reserved record is committed
+
+			std::atomic<bool>          m_bRetired = false; // The thread exited, the ring is freed once drained
+			uint32_t                   m_index    = 0u;
+			std::string                m_name;
+			std::unique_ptr<uint8_t[]> m_data;
+		};
+
+		// Retires the calling thread's ring when the thread exits
+		struct ThreadRingOwner {
+			ThreadRing* m_pRing = nullptr;
+
+			~ThreadRingOwner() noexcept;
+		};
+
+		static thread_local ThreadRingOwner s_threadRing;
+
+		std::mutex                               m_ringsMutex;
+		std::vector<std::unique_ptr<ThreadRing>> m_rings;
+		uint32_t                                 m_nextThreadIndex = 0u;
+
+		std::mutex                            m_sinksMutex; // Held by the background thread while it writes
+		std::vector<std::unique_ptr<LogSink>> m_sinks;
+
+		std::atomic<LogOverflowPolicy> m_overflowPolicy = LogOverflowPolicy::DROP;
+		std::atomic<uint64_t>          m_nDropped       = 0u;
+
+		std::thread             m_thread;
+		std::mutex              m_wakeMutex;
+		std::condition_variable m_wake;
+		std::condition_variable m_flushed;
+		uint64_t                m_flushRequests = 0u; // Guarded by "m_wakeMutex"
+		uint64_t                m_flushesDone   = 0u;
+		std::atomic<bool>       m_bWakeRequested = false;
+		std::atomic<bool>       m_bStopped       = false; // Set with "m_bStopping", read by the logging threads
+		bool                    m_bStopping      = false;
+
+		// Background thread's scratch buffers : the records of a batch & where each ring's batch ends
+		std::vector<std::pair<const RecordHeader*, const ThreadRing*>> m_batch;
+		std::vector<uint64_t>                                          m_batchHeads;
+
+	private:
+		Logger() noexcept;
+
+		[[nodiscard]] ThreadRing& GetThreadRing() noexcept;
+
+		// Room for a record of "size" bytes in the calling thread's ring, null if the record is dropped
+		[[nodiscard]] uint8_t* Reserve(const size_t size, ThreadRing*& pRing) noexcept;
+
+		inline void Commit(ThreadRing& ring) noexcept { ring.m_head.store(ring.m_pendingHead, std::memory_order_release); }
+
+		void Wake() noexcept;
+
+		void Run() noexcept;
+
+		// Formats & writes every committed record, then frees the rings of exited threads
+		void Drain(std::ostringstream& stream, std::string& line) noexcept;
+
+	public:
+		Logger(const Logger&) = delete;
+		Logger& operator=(const Logger&) = delete;
+
+		// The process' logger, its background thread starts on first use & stops (after writing everything) at exit
+		[[nodiscard]] static Logger& Get() noexcept;
+
+		// Without any sink, records are written to a ConsoleSink
+		void AddSink(std::unique_ptr<LogSink> pSink) noexcept;
+
+		inline void SetOverflowPolicy(const LogOverflowPolicy policy) noexcept { this->m_overflowPolicy.store(policy, std::memory_order_relaxed); }
+
+		[[nodiscard]] inline uint64_t GetDroppedCount() const noexcept { return this->m_nDropped.load(std::memory_order_relaxed); }
+
+		// Shown in the calling thread's lines instead of its index
+		void SetThreadName(const std::string_view name) noexcept;
+
+		// Blocks until every record logged before the call is written & the sinks are flushed
+		void Flush() noexcept;
+
+		// Writes what's left & stops the background thread, later records are dropped
+		void Stop() noexcept;
+
+		// Writes the arguments one after the other, in the "General" category
+		template <typename ..._Args>
+		inline void Log(const LogLevel level, const _Args&... args) noexcept
+		{
+			if (WSLogCategory_General.IsEnabled(level))
+				this->LogArguments<LogArgumentType<_Args>...>(level, LOG_CONCATENATION_SITE<LogArgumentType<_Args>...>, ToLogArgument(args)...);
+		}
+
+		// "args" must be of the types the site was built for
+		template <typename ..._Args>
+		void LogArguments(const LogLevel level, const LogSite& site, const _Args&... args) noexcept;
+
+		~Logger() noexcept;
+	};
+
+	template <typename ..._Args>
+	void Logger::LogArguments(const LogLevel level, const LogSite& site, const _Args&... args) noexcept
+	{
+		const size_t size = sizeof(RecordHeader) + (size_t(0u) + ... + LogArgument<_Args>::GetSize(args));
+
+		ThreadRing* pRing;
+		uint8_t*    pRecord = this->Reserve(size, pRing);
+
+		if (pRecord == nullptr)
+			return;
+
+		RecordHeader* pHeader = reinterpret_cast<RecordHeader*>(pRecord);
+		pHeader->m_level      = level;
+		pHeader->m_timestamp  = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+		pHeader->m_pSite      = &site;
+
+		uint8_t* pArguments = pRecord + sizeof(RecordHeader);
+		(LogArgument<_Args>::Encode(pArguments, args), ...);
+
+		this->Commit(*pRing);
+	}
+
+	// Logs through the process' logger, see Logger
+	template <typename ..._Args>
+	inline void Log(const LogLevel level, const _Args&... args) noexcept { Logger::Get().Log(level, args...); }
+
+	template <typename ..._Args>
+	inline void LogInfo(const _Args&... args) noexcept { Logger::Get().Log(LogLevel::INFO, args...); }
+
+	template <typename ..._Args>
+	inline void LogWarning(const _Args&... args) noexcept { Logger::Get().Log(LogLevel::WARNING, args...); }
+
+	template <typename ..._Args>
+	inline void LogError(const _Args&... args) noexcept { Logger::Get().Log(LogLevel::ERR, args...); }
+
+	// Logs a record of the site built at compile time from "siteInfo" (a lambda returning a LogSiteInfo), see WS_LOG
+	template <typename _SiteInfo, typename ..._Args>
+	inline void LogAtSite(const LogLevel level, const _SiteInfo&, const _Args&... args) noexcept
+	{
+		static constexpr const LogSiteInfo info = _SiteInfo{}();
+		static_assert(CountLogPlaceholders(info.m_format) == sizeof...(_Args), "[WS] A Log Format Must Have As Many {} As Arguments");
+
+		static constexpr const LogSite site = { info.m_format, info.m_file, info.m_line, info.m_pCategory,
+		                                        LOG_ARGUMENT_CODES<LogArgumentType<_Args>...>.data(), sizeof...(_Args) };
+
+		Logger::Get().LogArguments<LogArgumentType<_Args>...>(level, site, ToLogArgument(args)...);
+	}
+
+}; // WS
+
+/*
+ * WS_LOG_INFO(category, "format with {} placeholders", arguments...) logs through the process' logger (see Logger) :
+ * the format (checked against the number of arguments at compile time) stays in the binary, records only carry its site & the arguments.
+ * Levels below WS_LOG_MIN_LEVEL compile to nothing, the others are filtered at runtime by the category (see WS_DEFINE_LOG_CATEGORY).
+ */
+#define WS_LOG(level, category, format, ...)                                                                                       \
+	do {                                                                                                                           \
+		if constexpr (static_cast<int>(::WS::LogLevel::level) >= WS_LOG_MIN_LEVEL) {                                               \
+			if (WSLogCategory_##category.IsEnabled(::WS::LogLevel::level))                                                         \
+				::WS::LogAtSite(::WS::LogLevel::level,                                                                             \
+				                []() { return ::WS::LogSiteInfo{ format, __FILE__, __LINE__, &WSLogCategory_##category }; }        \
+				                __VA_OPT__(,) __VA_ARGS__);                                                                        \
+		}                                                                                                                          \
+	} while (false)
+
+#define WS_LOG_TRACE(category, format, ...)   WS_LOG(TRACE,   category, format __VA_OPT__(,) __VA_ARGS__)
+#define WS_LOG_DEBUG(category, format, ...)   WS_LOG(DEBUG,   category, format __VA_OPT__(,) __VA_ARGS__)
+#define WS_LOG_INFO(category, format, ...)    WS_LOG(INFO,    category, format __VA_OPT__(,) __VA_ARGS__)
+#define WS_LOG_SUCCESS(category, format, ...) WS_LOG(SUCCESS, category, format __VA_OPT__(,) __VA_ARGS__)
+#define WS_LOG_WARNING(category, format, ...) WS_LOG(WARNING, category, format __VA_OPT__(,) __VA_ARGS__)
+#define WS_LOG_ERROR(category, format, ...)   WS_LOG(ERR,     category, format __VA_OPT__(,) __VA_ARGS__)
@@ -0,0 +1,275 @@
+#include "WSMetrics.h"
+
+namespace WS {
+
+	// ---------- Metrics ---------- //
+
+	uint64_t Counter::GetValue() const noexcept
+	{
+		return MetricsRegistry::Get().ReadCounter(this->m_index);
+	}
+
+	uint64_t HistogramSnapshot::GetPercentile(const double percentile) const noexcept
+	{
+		if (this->m_count == 0u)
+			return 0u;
+
+		const double   fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+		const uint64_t rank     = std::clamp<uint64_t>(static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(this->m_count))), 1u, this->m_count);
+
+		uint64_t seen = 0u;
+		for (uint32_t i = 0u; i < this->m_buckets.size(); i++) {
+			seen += this->m_buckets[i];
+
+			if (seen >= rank)
+				return std::clamp(Histogram::GetBucketUpperBound(i), this->m_min, this->m_max);
+		}
+
+		return this->m_max;
+	}
+
+	Histogram::Histogram(const std::string_view name) noexcept
+		: m_name(name), m_buckets(std::make_unique<std::atomic<uint64_t>[]>(BUCKET_COUNT))
+	{
+
+	}
+
+	void Histogram::Record(const uint64_t value) noexcept
+	{
+		this->m_buckets[GetBucketIndex(value)].fetch_add(1u, std::memory_order_relaxed);
+		this->m_count.fetch_add(1u, std::memory_order_relaxed);
+		this->m_sum.fetch_add(value, std::memory_order_relaxed);
+
+		// Rarely changes once a few values are recorded
+		for (uint64_t min = this->m_min.load(std::memory_order_relaxed); value < min && !this->m_min.compare_exchange_weak(min, value, std::memory_order_relaxed);) {  }
+		for (uint64_t max = this->m_max.load(std::memory_order_relaxed); value > max && !this->m_max.compare_exchange_weak(max, value, std::memory_order_relaxed);) {  }
+	}
+
+	HistogramSnapshot Histogram::TakeSnapshot() const noexcept
+	{
+		HistogramSnapshot snapshot;
+		snapshot.m_buckets.resize(BUCKET_COUNT);
+
+		// The count is the sum of the buckets read, so that percentiles stay consistent with concurrent records
+		for (uint32_t i = 0u; i < BUCKET_COUNT; i++) {
+			snapshot.m_buckets[i] = this->m_buckets[i].load(std::memory_order_relaxed);
+			snapshot.m_count     += snapshot.m_buckets[i];
+		}
+
+		snapshot.m_sum = this->m_sum.load(std::memory_order_relaxed);
+		snapshot.m_min = (snapshot.m_count > 0u) ? this->m_min.load(std::memory_order_relaxed) : 0u;
+		snapshot.m_max = this->m_max.load(std::memory_order_relaxed);
+
+		return snapshot;
+	}
+
+	// ---------- Registry ---------- //
+
+	thread_local MetricsRegistry::ThreadSlotsOwner MetricsRegistry::s_threadSlotsOwner;
+
+	MetricsRegistry::ThreadSlotsOwner::~ThreadSlotsOwner() noexcept
+	{
+		if (s_pThreadSlots != nullptr)
+			MetricsRegistry::Get().RetireThread();
+	}
+
+	MetricsRegistry& MetricsRegistry::Get() noexcept
+	{
+		static MetricsRegistry* pRegistry = new MetricsRegistry();
+
+		return *pRegistry;
+	}
+
+	std::atomic<uint64_t>* MetricsRegistry::RegisterThread() noexcept
+	{
+		std::unique_ptr<CounterSlots> pSlots = std::make_unique<CounterSlots>();
+
+		// Constructs the owner, which retires the slots when the thread exits
+		(void)&s_threadSlotsOwner;
+
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		s_pThreadSlots = pSlots->m_values;
+		this->m_threadSlots.push_back(std::move(pSlots));
+
+		return s_pThreadSlots;
+	}
+
+	void MetricsRegistry::RetireThread() noexcept
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		const auto it = std::find_if(this->m_threadSlots.begin(), this->m_threadSlots.end(), [](const std::unique_ptr<CounterSlots>& pSlots) { return pSlots->m_values == s_pThreadSlots; });
+
+		if (it != this->m_threadSlots.end()) {
+			for (uint32_t i = 0u; i < WS_METRICS_MAX_COUNTERS; i++)
+				this->m_retiredSlots[i] += (*it)->m_values[i].load(std::memory_order_relaxed);
+
+			this->m_threadSlots.erase(it);
+		}
+
+		s_pThreadSlots = nullptr;
+	}
+
+	uint64_t MetricsRegistry::ReadCounter(const uint32_t index) const noexcept
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		if (index >= WS_METRICS_MAX_COUNTERS)
+			return 0u;
+
+		uint64_t value = this->m_retiredSlots[index];
+		for (const std::unique_ptr<CounterSlots>& pSlots : this->m_threadSlots)
+			value += pSlots->m_values[index].load(std::memory_order_relaxed);
+
+		return value;
+	}
+
+	Counter& MetricsRegistry::GetCounter(const std::string_view name) noexcept
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		const auto it = this->m_counters.find(name);
+		if (it != this->m_counters.end())
+			return *it->second;
+
+		// Past the limit, counters share the slot that's never read
+		const uint32_t index = static_cast<uint32_t>(std::min<size_t>(this->m_counters.size(), WS_METRICS_MAX_COUNTERS));
+
+		return *this->m_counters.emplace(std::string(name), std::unique_ptr<Counter>(new Counter(name, index))).first->second;
+	}
+
+	Gauge& MetricsRegistry::GetGauge(const std::string_view name) noexcept
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		const auto it = this->m_gauges.find(name);
+		if (it != this->m_gauges.end())
+			return *it->second;
+
+		return *this->m_gauges.emplace(std::string(name), std::unique_ptr<Gauge>(new Gauge(name))).first->second;
+	}
+
+	Histogram& MetricsRegistry::GetHistogram(const std::string_view name) noexcept
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		const auto it = this->m_histograms.find(name);
+		if (it != this->m_histograms.end())
+			return *it->second;
+
+		return *this->m_histograms.emplace(std::string(name), std::unique_ptr<Histogram>(new Histogram(name))).first->second;
+	}
+
+	MetricsSnapshot MetricsRegistry::TakeSnapshot() const noexcept
+	{
+		MetricsSnapshot snapshot;
+
+		std::vector<std::pair<std::string, const Histogram*>> histograms;
+
+		{
+			const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+			for (const auto& [name, pCounter] : this->m_counters) {
+				uint64_t value = 0u;
+
+				if (pCounter->m_index < WS_METRICS_MAX_COUNTERS) {
+					value = this->m_retiredSlots[pCounter->m_index];
+
+					for (const std::unique_ptr<CounterSlots>& pSlots : this->m_threadSlots)
+						value += pSlots->m_values[pCounter->m_index].load(std::memory_order_relaxed);
+				}
+
+				snapshot.m_counters.emplace_back(name, value);
+			}
+
+			for (const auto& [name, pGauge] : this->m_gauges)
+				snapshot.m_gauges.emplace_back(name, pGauge->GetValue());
+
+			for (const auto& [name, pHistogram] : this->m_histograms)
+				histograms.emplace_back(name, pHistogram.get());
+		}
+
+		// Histograms are never destroyed, their buckets are copied without holding the lock
+		for (const auto& [name, pHistogram] : histograms)
+			snapshot.m_histograms.emplace_back(name, pHistogram->TakeSnapshot());
+
+		return snapshot;
+	}
+
+	// ---------- Export ---------- //
+
+	static void WriteJsonString(std::ostream& stream, const std::string_view text) noexcept
+	{
+		stream << '"';
+
+		for (const char c : text) {
+			if (c == '"' || c == '\\') {
+				stream << '\\' << c;
+			} else if (static_cast<unsigned char>(c) < 0x20u) {
+				char escaped[8u];
+				std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+				stream << escaped;
+			} else {
+				stream << c;
+			}
+		}
+
+		stream << '"';
+	}
+
+	static constexpr const std::pair<const char*, double> EXPORTED_PERCENTILES[] = { { "p50", 50.0 }, { "p90", 90.0 }, { "p99", 99.0 }, { "p999", 99.9 } };
+
+	void MetricsSnapshot::WriteText(std::ostream& stream) const noexcept
+	{
+		for (const auto& [name, value] : this->m_counters)
+			stream << "counter " << name << ' ' << value << '\n';
+
+		for (const auto& [name, value] : this->m_gauges)
+			stream << "gauge " << name << ' ' << value << '\n';
+
+		for (const auto& [name, histogram] : this->m_histograms) {
+			stream << "histogram " << name << " count=" << histogram.m_count << " mean=" << histogram.GetMean() << " min=" << histogram.m_min;
+
+			for (const auto& [label, percentile] : EXPORTED_PERCENTILES)
+				stream << ' ' << label << '=' << histogram.GetPercentile(percentile);
+
+			stream << " max=" << histogram.m_max << '\n';
+		}
+	}
+
+	void MetricsSnapshot::WriteJson(std::ostream& stream) const noexcept
+	{
+		stream << "{\"counters\":{";
+		for (size_t i = 0u; i < this->m_counters.size(); i++) {
+			stream << ((i > 0u) ? "," : "");
+			WriteJsonString(stream, this->m_counters[i].first);
+			stream << ':' << this->m_counters[i].second;
+		}
+
+		// JSON has no infinity nor NaN
+		stream << "},\"gauges\":{";
+		for (size_t i = 0u; i < this->m_gauges.size(); i++) {
+			stream << ((i > 0u) ? "," : "");
+			WriteJsonString(stream, this->m_gauges[i].first);
+			stream << ':' << (std::isfinite(this->m_gauges[i].second) ? this->m_gauges[i].second : 0.0);
+		}
+
+		stream << "},\"histograms\":{";
+		for (size_t i = 0u; i < this->m_histograms.size(); i++) {
+			const HistogramSnapshot& histogram = this->m_histograms[i].second;
+
+			stream << ((i > 0u) ? "," : "");
+			WriteJsonString(stream, this->m_histograms[i].first);
+			stream << ":{\"count\":" << histogram.m_count << ",\"mean\":" << histogram.GetMean() << ",\"min\":" << histogram.m_min;
+
+			for (const auto& [label, percentile] : EXPORTED_PERCENTILES)
+				stream << ",\"" << label << "\":" << histogram.GetPercentile(percentile);
+
+			stream << ",\"max\":" << histogram.m_max << '}';
+		}
+
+		stream << "}}\n";
+	}
+
+}; // WS
@@ -0,0 +1,206 @@
+#pragma once
+
+#include "../misc/WSPch.h"
+
+#define WS_METRICS_MAX_COUNTERS       256u // Counters of the process, later ones share a slot that's never read
+#define WS_METRICS_HISTOGRAM_SUB_BITS 5u   // 2^5 linear buckets per power of two, values are kept within about 3 %
+
+namespace WS {
+
+	class MetricsRegistry;
+
+	/*
+	 * Monotonic sum : each thread adds to a slot of its own without any atomic read-modify-write,
+	 * reading the value merges the slots of every thread (including exited ones).
+	 */
+	class Counter {
+		friend class MetricsRegistry;
+
+	private:
+		std::string m_name;
+		uint32_t    m_index;
+
+	private:
+		Counter(const std::string_view name, const uint32_t index) noexcept : m_name(name), m_index(index) {  }
+
+	public:
+		Counter(const Counter&) = delete;
+		Counter& operator=(const Counter&) = delete;
+
+		[[nodiscard]] inline const std::string& GetName() const noexcept { return this->m_name; }
+
+		inline void Add(const uint64_t value = 1u) noexcept;
+
+		[[nodiscard]] uint64_t GetValue() const noexcept;
+	};
+
+	// Current value of a quantity, set or adjusted by any thread
+	class Gauge {
+		friend class MetricsRegistry;
+
+	private:
+		std::string         m_name;
+		std::atomic<double> m_value = 0.0;
+
+	private:
+		explicit Gauge(const std::string_view name) noexcept : m_name(name) {  }
+
+	public:
+		Gauge(const Gauge&) = delete;
+		Gauge& operator=(const Gauge&) = delete;
+
+		[[nodiscard]] inline const std::string& GetName() const noexcept { return this->m_name; }
+
+		inline void Set(const double value) noexcept { this->m_value.store(value, std::memory_order_relaxed); }
+		inline void Add(const double value) noexcept { this->m_value.fetch_add(value, std::memory_order_relaxed); }
+
+		[[nodiscard]] inline double GetValue() const noexcept { return this->m_value.load(std::memory_order_relaxed); }
+	};
+
+	// A copy of a histogram's buckets, see Histogram::TakeSnapshot
+	struct HistogramSnapshot {
+		uint64_t              m_count = 0u;
+		uint64_t              m_sum   = 0u;
+		uint64_t              m_min   = 0u;
+		uint64_t              m_max   = 0u;
+		std::vector<uint64_t> m_buckets;
+
+		[[nodiscard]] inline double GetMean() const noexcept { return (this->m_count > 0u) ? static_cast<double>(this->m_sum) / static_cast<double>(this->m_count) : 0.0; }
+
+		// "percentile" in [0, 100], the highest value of the bucket holding it (0 without any value)
+		[[nodiscard]] uint64_t GetPercentile(const double percentile) const noexcept;
+	};
+
+	/*
+	 * Log-linear (HDR style) histogram of unsigned values such as latencies in nanoseconds : values below 2^SUB_BITS have a bucket each,
+	 * every power of two above is split in 2^SUB_BITS linear buckets, so percentiles are within about 3 % over the whole 64 bit range.
+	 */
+	class Histogram {
+		friend class MetricsRegistry;
+
+	public:
+		static constexpr const uint32_t SUB_BUCKETS  = 1u << WS_METRICS_HISTOGRAM_SUB_BITS;
+		static constexpr const uint32_t BUCKET_COUNT = (65u - WS_METRICS_HISTOGRAM_SUB_BITS) * SUB_BUCKETS;
+
+	private:
+		std::string                              m_name;
+		std::unique_ptr<std::atomic<uint64_t>[]> m_buckets;
+		std::atomic<uint64_t>                    m_count = 0u;
+		std::atomic<uint64_t>                    m_sum   = 0u;
+		std::atomic<uint64_t>                    m_min   = ~uint64_t(0u);
+		std::atomic<uint64_t>                    m_max   = 0u;
+
+	private:
+		explicit Histogram(const std::string_view name) noexcept;
+
+	public:
+		Histogram(const Histogram&) = delete;
+		Histogram& operator=(const Histogram&) = delete;
+
+		[[nodiscard]] static constexpr uint32_t GetBucketIndex(const uint64_t value) noexcept
+		{
+			if (value < SUB_BUCKETS)
+				return static_cast<uint32_t>(value);
+
+			const uint32_t shift = static_cast<uint32_t>(std::bit_width(value)) - 1u - WS_METRICS_HISTOGRAM_SUB_BITS;
+
+			return (shift + 1u) * SUB_BUCKETS + static_cast<uint32_t>(value >> shift) - SUB_BUCKETS;
+		}
+
+		// Highest value of a bucket
+		[[nodiscard]] static constexpr uint64_t GetBucketUpperBound(const uint32_t index) noexcept
+		{
+			if (index < SUB_BUCKETS)
+				return index;
+
+			const uint32_t shift    = index / SUB_BUCKETS - 1u;
+			const uint64_t mantissa = index % SUB_BUCKETS + SUB_BUCKETS;
+
+			return ((mantissa + 1u) << shift) - 1u; // Wraps around to the largest value for the last bucket
+		}
+
+		[[nodiscard]] inline const std::string& GetName() const noexcept { return this->m_name; }
+
+		void Record(const uint64_t value) noexcept;
+
+		[[nodiscard]] HistogramSnapshot TakeSnapshot() const noexcept;
+	};
+
+	// Every metric of the process at a point in time, sorted by name
+	struct MetricsSnapshot {
+		std::vector<std::pair<std::string, uint64_t>>          m_counters;
+		std::vector<std::pair<std::string, double>>            m_gauges;
+		std::vector<std::pair<std::string, HistogramSnapshot>> m_histograms;
+
+		// One metric per line, "counter <name> <value>", "gauge <name> <value>", "histogram <name> count=... p50=... p99=..."
+		void WriteText(std::ostream& stream) const noexcept;
+
+		// { "counters": { name: value }, "gauges": { name: value }, "histograms": { name: { "count", "mean", "min", "p50", "p90", "p99", "p999", "max" } } }
+		void WriteJson(std::ostream& stream) const noexcept;
+	};
+
+	/*
+	 * Owns the metrics of the process, which are created on first use & live as long as the program :
+	 * callers keep the references, i.e. "static WS::Counter& s_counter = WS::MetricsRegistry::Get().GetCounter("name");"
+	 */
+	class MetricsRegistry {
+		friend class Counter;
+
+	private:
+		struct CounterSlots {
+			std::atomic<uint64_t> m_values[WS_METRICS_MAX_COUNTERS + 1u] = {};
+		};
+
+		// Merges the calling thread's slots into "m_retiredSlots" when the thread exits
+		struct ThreadSlotsOwner {
+			~ThreadSlotsOwner() noexcept;
+		};
+
+		static inline thread_local std::atomic<uint64_t>* s_pThreadSlots = nullptr;
+		static thread_local ThreadSlotsOwner              s_threadSlotsOwner;
+
+		mutable std::mutex                                             m_mutex;
+		std::map<std::string, std::unique_ptr<Counter>, std::less<>>   m_counters;
+		std::map<std::string, std::unique_ptr<Gauge>, std::less<>>     m_gauges;
+		std::map<std::string, std::unique_ptr<Histogram>, std::less<>> m_histograms;
+
+		std::vector<std::unique_ptr<CounterSlots>> m_threadSlots;                           // Of the running threads
+		uint64_t                                   m_retiredSlots[WS_METRICS_MAX_COUNTERS] = {}; // Sums of the exited threads
+
+	private:
+		MetricsRegistry() noexcept = default;
+
+		[[nodiscard]] std::atomic<uint64_t>* RegisterThread() noexcept;
+
+		void RetireThread() noexcept;
+
+		[[nodiscard]] uint64_t ReadCounter(const uint32_t index) const noexcept;
+
+	public:
+		MetricsRegistry(const MetricsRegistry&) = delete;
+		MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+		// Never destroyed, metrics can be updated by exiting threads & static destructors
+		[[nodiscard]] static MetricsRegistry& Get() noexcept;
+
+		// Returns the metric named "name", creating it if needed
+		[[nodiscard]] Counter&   GetCounter(const std::string_view name) noexcept;
+		[[nodiscard]] Gauge&     GetGauge(const std::string_view name) noexcept;
+		[[nodiscard]] Histogram& GetHistogram(const std::string_view name) noexcept;
+
+		[[nodiscard]] MetricsSnapshot TakeSnapshot() const noexcept;
+	};
+
+	inline void Counter::Add(const uint64_t value) noexcept
+	{
+		std::atomic<uint64_t>* pSlots = MetricsRegistry::s_pThreadSlots;
+
+		if (pSlots == nullptr)
+			pSlots = MetricsRegistry::Get().RegisterThread();
+
+		// Only this thread writes to its slot
+		std::atomic<uint64_t>& slot = pSlots[this->m_index];
+		slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+	}
+
+}; // WS
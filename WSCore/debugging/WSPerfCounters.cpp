@@ -0,0 +1,246 @@
+#include "WSPerfCounters.h"
+
+namespace WS {
+
+	const char* GetPerfCounterName(const PerfCounter counter) noexcept
+	{
+		switch (counter) {
+		case PerfCounter::CYCLES:           return "cycles";
+		case PerfCounter::INSTRUCTIONS:     return "instructions";
+		case PerfCounter::CACHE_REFERENCES: return "cache references";
+		case PerfCounter::CACHE_MISSES:     return "cache misses";
+		case PerfCounter::BRANCHES:         return "branches";
+		case PerfCounter::BRANCH_MISSES:    return "branch misses";
+		case PerfCounter::PAGE_FAULTS:      return "page faults";
+		case PerfCounter::CONTEXT_SWITCHES: return "context switches";
+		default:                            return "unknown";
+		}
+	}
+
+	static std::vector<PerfCounter> GetHardwarePerfCounters() noexcept
+	{
+		std::vector<PerfCounter> counters;
+
+		for (uint32_t i = 0u; i < static_cast<uint32_t>(PerfCounter::PAGE_FAULTS); i++)
+			counters.push_back(static_cast<PerfCounter>(i));
+
+		return counters;
+	}
+
+	PerfCounterGroup::PerfCounterGroup() noexcept
+		: PerfCounterGroup(GetHardwarePerfCounters())
+	{
+
+	}
+
+#ifdef __WEISS__HAS_PERF_EVENTS
+
+	static void SetPerfEventType(const PerfCounter counter, perf_event_attr& attributes) noexcept
+	{
+		attributes.type = PERF_TYPE_HARDWARE;
+
+		switch (counter) {
+		case PerfCounter::CYCLES:           attributes.config = PERF_COUNT_HW_CPU_CYCLES;          break;
+		case PerfCounter::INSTRUCTIONS:     attributes.config = PERF_COUNT_HW_INSTRUCTIONS;        break;
+		case PerfCounter::CACHE_REFERENCES: attributes.config = PERF_COUNT_HW_CACHE_REFERENCES;    break;
+		case PerfCounter::CACHE_MISSES:     attributes.config = PERF_COUNT_HW_CACHE_MISSES;        break;
+		case PerfCounter::BRANCHES:         attributes.config = PERF_COUNT_HW_BRANCH_INSTRUCTIONS; break;
+		case PerfCounter::BRANCH_MISSES:    attributes.config = PERF_COUNT_HW_BRANCH_MISSES;       break;
+		case PerfCounter::PAGE_FAULTS:      attributes.config = PERF_COUNT_SW_PAGE_FAULTS;       attributes.type = PERF_TYPE_SOFTWARE; break;
+		case PerfCounter::CONTEXT_SWITCHES: attributes.config = PERF_COUNT_SW_CONTEXT_SWITCHES;  attributes.type = PERF_TYPE_SOFTWARE; break;
+		default:                            attributes.config = 0u;                              break;
+		}
+	}
+
+	PerfCounterGroup::PerfCounterGroup(const std::vector<PerfCounter>& counters) noexcept
+	{
+		// Hardware events first, software ones can join a hardware group but not the other way around
+		std::vector<PerfCounter> ordered = counters;
+		std::stable_partition(ordered.begin(), ordered.end(), [](const PerfCounter counter) { return counter != PerfCounter::PAGE_FAULTS && counter != PerfCounter::CONTEXT_SWITCHES; });
+
+		for (const PerfCounter counter : ordered) {
+			if (counter >= PerfCounter::COUNT || this->IsAvailable(counter))
+				continue;
+
+			perf_event_attr attributes{};
+			attributes.size           = sizeof(attributes);
+			attributes.exclude_kernel = 1;
+			attributes.exclude_hv     = 1;
+			attributes.read_format    = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			SetPerfEventType(counter, attributes);
+
+			// The calling thread on any CPU, counting from now on
+			const int leader = this->m_events.empty() ? -1 : this->m_events.front().m_fd;
+			const int fd     = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, leader, PERF_FLAG_FD_CLOEXEC));
+
+			if (fd < 0)
+				continue;
+
+			this->m_events.push_back({ fd, counter, nullptr });
+			this->m_availableMask |= 1u << static_cast<uint32_t>(counter);
+		}
+
+#ifdef __WEISS__PERF_USES_RDPMC
+
+		// Software events are never on the PMU, every event has to be readable for rdpmc to replace read()
+		this->m_bUsesRdpmc = !this->m_events.empty();
+
+		const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+		for (Event& event : this->m_events) {
+			void* pPage = mmap(nullptr, pageSize, PROT_READ, MAP_SHARED, event.m_fd, 0);
+
+			if (pPage == MAP_FAILED) {
+				this->m_bUsesRdpmc = false;
+				continue;
+			}
+
+			event.m_pPage = pPage;
+
+			if (!static_cast<const perf_event_mmap_page*>(pPage)->cap_user_rdpmc)
+				this->m_bUsesRdpmc = false;
+		}
+
+#endif // __WEISS__PERF_USES_RDPMC
+	}
+
+	bool PerfCounterGroup::ReadWithRdpmc(PerfCounterValues& values) const noexcept
+	{
+#ifdef __WEISS__PERF_USES_RDPMC
+
+		for (const Event& event : this->m_events) {
+			const volatile perf_event_mmap_page* pPage = static_cast<const volatile perf_event_mmap_page*>(event.m_pPage);
+
+			uint32_t sequence;
+			uint64_t count;
+
+			// The kernel updates the page under a sequence lock, reads are retried when it changed meanwhile
+			do {
+				sequence = pPage->lock;
+				std::atomic_signal_fence(std::memory_order_seq_cst);
+
+				const uint32_t index = pPage->index;
+
+				if (index == 0u || pPage->time_enabled != pPage->time_running)
+					return false;
+
+				const uint32_t width = pPage->pmc_width;
+				int64_t        pmc   = static_cast<int64_t>(__rdpmc(static_cast<int>(index - 1u)));
+
+				// The counter is "width" bits wide, sign extended before being added to the kernel's offset
+				pmc   = static_cast<int64_t>(static_cast<uint64_t>(pmc) << (64u - width)) >> (64u - width);
+				count = static_cast<uint64_t>(pPage->offset) + static_cast<uint64_t>(pmc);
+
+				std::atomic_signal_fence(std::memory_order_seq_cst);
+			} while (pPage->lock != sequence);
+
+			values.m_values[static_cast<size_t>(event.m_counter)] = count;
+		}
+
+		values.m_availableMask = this->m_availableMask;
+
+		return true;
+
+#else
+
+		static_cast<void>(values);
+
+		return false;
+
+#endif // __WEISS__PERF_USES_RDPMC
+	}
+
+	PerfCounterValues PerfCounterGroup::Read() const noexcept
+	{
+		PerfCounterValues values;
+
+		if (this->m_events.empty())
+			return values;
+
+		if (this->m_bUsesRdpmc && this->ReadWithRdpmc(values))
+			return values;
+
+		// { nr, time_enabled, time_running, value[nr] } in the order the events joined the group
+		uint64_t buffer[3u + static_cast<size_t>(PerfCounter::COUNT)];
+
+		const ssize_t size = read(this->m_events.front().m_fd, buffer, sizeof(buffer));
+
+		if (size < static_cast<ssize_t>((3u + this->m_events.size()) * sizeof(uint64_t)) || buffer[0] != this->m_events.size())
+			return values;
+
+		const uint64_t enabled = buffer[1];
+		const uint64_t running = buffer[2];
+
+		for (size_t i = 0u; i < this->m_events.size(); i++) {
+			uint64_t value = buffer[3u + i];
+
+			// Counted part of the time only, extrapolated to the whole of it
+			if (running > 0u && running < enabled)
+				value = static_cast<uint64_t>(static_cast<double>(value) * static_cast<double>(enabled) / static_cast<double>(running));
+
+			values.m_values[static_cast<size_t>(this->m_events[i].m_counter)] = value;
+		}
+
+		values.m_availableMask = this->m_availableMask;
+
+		return values;
+	}
+
+	PerfCounterGroup::~PerfCounterGroup() noexcept
+	{
+		const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+		// Siblings before the leader
+		for (auto it = this->m_events.rbegin(); it != this->m_events.rend(); ++it) {
+			if (it->m_pPage != nullptr)
+				munmap(it->m_pPage, pageSize);
+
+			close(it->m_fd);
+		}
+	}
+
+#else
+
+	PerfCounterGroup::PerfCounterGroup(const std::vector<PerfCounter>& counters) noexcept
+	{
+		static_cast<void>(counters);
+	}
+
+	bool PerfCounterGroup::ReadWithRdpmc(PerfCounterValues& values) const noexcept
+	{
+		static_cast<void>(values);
+
+		return false;
+	}
+
+	PerfCounterValues PerfCounterGroup::Read() const noexcept
+	{
+		return PerfCounterValues();
+	}
+
+	PerfCounterGroup::~PerfCounterGroup() noexcept
+	{
+
+	}
+
+#endif // __WEISS__HAS_PERF_EVENTS
+
+	std::string PerfCounterGroup::Describe() const noexcept
+	{
+		if (this->m_events.empty()) {
+#ifdef __WEISS__HAS_PERF_EVENTS
+			return "none (perf_event_open refused every counter, no PMU is exposed or perf_event_paranoid forbids it)";
+#else
+			return "none (only available on linux)";
+#endif
+		}
+
+		std::string description;
+
+		for (const Event& event : this->m_events)
+			description += (description.empty() ? "" : ", ") + std::string(GetPerfCounterName(event.m_counter));
+
+		return description + (this->m_bUsesRdpmc ? " (rdpmc)" : " (read)");
+	}
+
+}; // WS
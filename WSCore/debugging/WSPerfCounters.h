@@ -0,0 +1,137 @@
+#pragma once
+
+#include "../misc/WSPch.h"
+
+#if defined(__WEISS__HAS_PERF_EVENTS) && (defined(__x86_64__) || defined(__i386__))
+
+	#define __WEISS__PERF_USES_RDPMC
+
+	#include <x86intrin.h>
+
+#endif
+
+namespace WS {
+
+	enum class PerfCounter : uint32_t {
+		CYCLES,           // Core cycles
+		INSTRUCTIONS,     // Retired instructions
+		CACHE_REFERENCES, // Last level cache accesses
+		CACHE_MISSES,     // Last level cache misses
+		BRANCHES,         // Retired branch instructions
+		BRANCH_MISSES,    // Mispredicted branches
+		PAGE_FAULTS,      // Software event, available without a PMU but always read with read()
+		CONTEXT_SWITCHES, // Software event, available without a PMU but always read with read()
+
+		COUNT
+	};
+
+	[[nodiscard]] const char* GetPerfCounterName(const PerfCounter counter) noexcept;
+
+	// Counts of a group, only the counters of "m_availableMask" (bit i for PerfCounter i) are meaningful
+	struct PerfCounterValues {
+		uint64_t m_values[static_cast<size_t>(PerfCounter::COUNT)] = {};
+		uint32_t m_availableMask = 0u;
+
+		[[nodiscard]] inline bool     Has(const PerfCounter counter) const noexcept { return (this->m_availableMask >> static_cast<uint32_t>(counter)) & 1u; }
+		[[nodiscard]] inline uint64_t Get(const PerfCounter counter) const noexcept { return this->m_values[static_cast<size_t>(counter)]; }
+
+		// Instructions per cycle, 0 without both counters
+		[[nodiscard]] inline double GetIPC() const noexcept
+		{
+			if (!this->Has(PerfCounter::CYCLES) || !this->Has(PerfCounter::INSTRUCTIONS) || this->Get(PerfCounter::CYCLES) == 0u)
+				return 0.0;
+
+			return static_cast<double>(this->Get(PerfCounter::INSTRUCTIONS)) / static_cast<double>(this->Get(PerfCounter::CYCLES));
+		}
+
+		// Counts between two reads of the same group
+		[[nodiscard]] inline PerfCounterValues operator-(const PerfCounterValues& other) const noexcept
+		{
+			PerfCounterValues difference;
+			difference.m_availableMask = this->m_availableMask & other.m_availableMask;
+
+			for (size_t i = 0u; i < static_cast<size_t>(PerfCounter::COUNT); i++)
+				difference.m_values[i] = this->m_values[i] - other.m_values[i];
+
+			return difference;
+		}
+
+		inline PerfCounterValues& operator+=(const PerfCounterValues& other) noexcept
+		{
+			// Empty values take the counters of the first addition
+			this->m_availableMask = (this->m_availableMask == 0u) ? other.m_availableMask : this->m_availableMask & other.m_availableMask;
+
+			for (size_t i = 0u; i < static_cast<size_t>(PerfCounter::COUNT); i++)
+				this->m_values[i] += other.m_values[i];
+
+			return *this;
+		}
+	};
+
+	/*
+	 * Counts hardware & software events of the calling thread in user space (perf_event_open, linux only), as a single group
+	 * so that the counters cover the same instructions. Counters the CPU, the kernel or perf_event_paranoid don't allow are left out.
+	 * Counters are read with rdpmc without any system call when the kernel permits it & none is multiplexed,
+	 * otherwise with a single read() of the group. A group must only be read by the thread that created it.
+	 */
+	class PerfCounterGroup {
+	private:
+		struct Event {
+			int         m_fd = -1;
+			PerfCounter m_counter;
+			void*       m_pPage = nullptr; // perf_event_mmap_page, for rdpmc
+		};
+
+		std::vector<Event> m_events; // The group leader first
+		uint32_t           m_availableMask = 0u;
+		bool               m_bUsesRdpmc    = false;
+
+	private:
+		// false when an event isn't on the PMU right now or has been multiplexed, the group is then read with read()
+		[[nodiscard]] bool ReadWithRdpmc(PerfCounterValues& values) const noexcept;
+
+	public:
+		// The hardware counters, software ones would keep the group from being read with rdpmc
+		PerfCounterGroup() noexcept;
+
+		explicit PerfCounterGroup(const std::vector<PerfCounter>& counters) noexcept;
+
+		PerfCounterGroup(const PerfCounterGroup&) = delete;
+		PerfCounterGroup& operator=(const PerfCounterGroup&) = delete;
+
+		[[nodiscard]] inline bool     IsValid()          const noexcept { return !this->m_events.empty(); }
+		[[nodiscard]] inline bool     IsUsingRdpmc()     const noexcept { return this->m_bUsesRdpmc;      }
+		[[nodiscard]] inline uint32_t GetAvailableMask() const noexcept { return this->m_availableMask;   }
+
+		[[nodiscard]] inline bool IsAvailable(const PerfCounter counter) const noexcept { return (this->m_availableMask >> static_cast<uint32_t>(counter)) & 1u; }
+
+		// "cycles, instructions, ... (rdpmc)", or why nothing is counted
+		[[nodiscard]] std::string Describe() const noexcept;
+
+		// Running totals since the group was opened, scaled when the kernel had to multiplex it
+		[[nodiscard]] PerfCounterValues Read() const noexcept;
+
+		~PerfCounterGroup() noexcept;
+	};
+
+	// Adds the counts between its construction & destruction to "values", to wrap any scope
+	class PerfScope {
+	private:
+		const PerfCounterGroup& m_group;
+		PerfCounterValues&      m_values;
+		PerfCounterValues       m_start;
+
+	public:
+		inline PerfScope(const PerfCounterGroup& group, PerfCounterValues& values) noexcept
+			: m_group(group), m_values(values), m_start(group.Read())
+		{
+
+		}
+
+		PerfScope(const PerfScope&) = delete;
+		PerfScope& operator=(const PerfScope&) = delete;
+
+		inline ~PerfScope() noexcept { this->m_values += this->m_group.Read() - this->m_start; }
+	};
+
+}; // WS
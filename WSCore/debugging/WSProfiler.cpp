@@ -0,0 +1,268 @@
+#include "WSProfiler.h"
+
+namespace WS {
+
+	Profiler::ThreadBuffer::~ThreadBuffer() noexcept
+	{
+		for (Block* pBlock = this->m_pFirst; pBlock != nullptr;) {
+			Block* pNext = pBlock->m_pNext.load(std::memory_order_relaxed);
+			delete pBlock;
+			pBlock = pNext;
+		}
+	}
+
+	Profiler& Profiler::Get() noexcept
+	{
+		static Profiler profiler;
+
+		return profiler;
+	}
+
+	Profiler::ThreadBuffer& Profiler::GetThreadBuffer() noexcept
+	{
+		if (s_pThreadBuffer != nullptr)
+			return *s_pThreadBuffer;
+
+		std::unique_ptr<ThreadBuffer> pBuffer = std::make_unique<ThreadBuffer>();
+		pBuffer->m_pFirst   = new Block();
+		pBuffer->m_pCurrent = pBuffer->m_pFirst;
+
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		pBuffer->m_index = static_cast<uint32_t>(this->m_threadBuffers.size());
+		s_pThreadBuffer  = pBuffer.get();
+		this->m_threadBuffers.push_back(std::move(pBuffer));
+
+		return *s_pThreadBuffer;
+	}
+
+	void Profiler::RecordSlow(const char* name, const uint64_t start, const uint64_t end, const uint32_t capture) noexcept
+	{
+		ThreadBuffer& buffer = this->GetThreadBuffer();
+
+		// The first zone of the thread in this capture, its blocks are reused
+		if (buffer.m_capture.load(std::memory_order_relaxed) != capture) {
+			for (Block* pBlock = buffer.m_pFirst; pBlock != nullptr; pBlock = pBlock->m_pNext.load(std::memory_order_relaxed))
+				pBlock->m_count.store(0u, std::memory_order_relaxed);
+
+			buffer.m_pCurrent = buffer.m_pFirst;
+			buffer.m_nBlocks  = 1u;
+			buffer.m_capture.store(capture, std::memory_order_release);
+		}
+
+		if (buffer.m_pCurrent->m_count.load(std::memory_order_relaxed) == WS_PROFILER_BLOCK_SIZE) {
+			Block* pNext = buffer.m_pCurrent->m_pNext.load(std::memory_order_relaxed);
+
+			if (pNext == nullptr) {
+				if (buffer.m_nBlocks == WS_PROFILER_MAX_BLOCKS) {
+					this->m_nDropped.fetch_add(1u, std::memory_order_relaxed);
+					return;
+				}
+
+				pNext = new Block();
+				buffer.m_pCurrent->m_pNext.store(pNext, std::memory_order_release);
+			}
+
+			buffer.m_pCurrent = pNext;
+			buffer.m_nBlocks++;
+		}
+
+		Block*         pBlock = buffer.m_pCurrent;
+		const uint32_t count  = pBlock->m_count.load(std::memory_order_relaxed);
+
+		pBlock->m_zones[count] = { name, start, end };
+		pBlock->m_count.store(count + 1u, std::memory_order_release);
+	}
+
+	void Profiler::StartCapture() noexcept
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		// 0 is reserved for "no capture"
+		this->m_lastCapture = (this->m_lastCapture == ~uint32_t(0u)) ? 1u : this->m_lastCapture + 1u;
+
+		this->m_frames.clear();
+		this->m_nDropped.store(0u, std::memory_order_relaxed);
+
+		this->m_startTime      = std::chrono::steady_clock::now();
+		this->m_startTimestamp = ReadProfilerTimestamp();
+		this->m_stopTime       = this->m_startTime;
+		this->m_stopTimestamp  = this->m_startTimestamp;
+		this->m_endTimestamp   = this->m_startTimestamp;
+
+		s_capture.store(this->m_lastCapture, std::memory_order_relaxed);
+	}
+
+	void Profiler::StopCapture() noexcept
+	{
+		const uint64_t endTimestamp = ReadProfilerTimestamp();
+		uint32_t       capture;
+
+		{
+			const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+			capture = s_capture.exchange(0u, std::memory_order_relaxed);
+			if (capture == 0u)
+				return;
+
+			this->m_endTimestamp = endTimestamp;
+		}
+
+#ifdef __WEISS__PROFILER_USES_TSC
+
+		// A short capture would give a poor estimate of the counter's frequency
+		const std::chrono::steady_clock::time_point calibrationEnd = this->m_startTime + std::chrono::milliseconds(10);
+		while (std::chrono::steady_clock::now() < calibrationEnd)
+			std::this_thread::yield();
+
+#endif // __WEISS__PROFILER_USES_TSC
+
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		if (this->m_lastCapture == capture) {
+			this->m_stopTimestamp = ReadProfilerTimestamp();
+			this->m_stopTime      = std::chrono::steady_clock::now();
+		}
+	}
+
+	void Profiler::SetThreadName(const std::string_view name) noexcept
+	{
+		ThreadBuffer& buffer = this->GetThreadBuffer();
+
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		buffer.m_name = name;
+	}
+
+	void Profiler::MarkFrame() noexcept
+	{
+		if (GetCapture() == 0u)
+			return;
+
+		const uint64_t timestamp = ReadProfilerTimestamp();
+
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		this->m_frames.push_back(timestamp);
+	}
+
+	void Profiler::ForEachZone(const std::function<void(const uint32_t, const Zone&)>& onZone) const noexcept
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		for (const std::unique_ptr<ThreadBuffer>& pBuffer : this->m_threadBuffers) {
+			if (pBuffer->m_capture.load(std::memory_order_acquire) != this->m_lastCapture)
+				continue;
+
+			for (const Block* pBlock = pBuffer->m_pFirst; pBlock != nullptr; pBlock = pBlock->m_pNext.load(std::memory_order_acquire)) {
+				const uint32_t count = pBlock->m_count.load(std::memory_order_acquire);
+
+				for (uint32_t i = 0u; i < count; i++)
+					onZone(pBuffer->m_index, pBlock->m_zones[i]);
+			}
+		}
+	}
+
+	double Profiler::ToMicroseconds(const uint64_t timestamp) const noexcept
+	{
+		const double elapsed = static_cast<double>(static_cast<int64_t>(timestamp - this->m_startTimestamp));
+
+#ifdef __WEISS__PROFILER_USES_TSC
+
+		const double microseconds = std::chrono::duration<double, std::micro>(this->m_stopTime - this->m_startTime).count();
+		const double ticks        = static_cast<double>(this->m_stopTimestamp - this->m_startTimestamp);
+
+		return (ticks > 0.0) ? elapsed * microseconds / ticks : 0.0;
+
+#else
+
+		return elapsed / 1000.0;
+
+#endif // __WEISS__PROFILER_USES_TSC
+	}
+
+	static void WriteJsonString(std::ostream& stream, const std::string_view text) noexcept
+	{
+		stream << '"';
+
+		for (const char c : text) {
+			if (c == '"' || c == '\\') {
+				stream << '\\' << c;
+			} else if (static_cast<unsigned char>(c) < 0x20u) {
+				char escaped[8u];
+				std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+				stream << escaped;
+			} else {
+				stream << c;
+			}
+		}
+
+		stream << '"';
+	}
+
+	void Profiler::WriteChromeTrace(std::ostream& stream) const noexcept
+	{
+		struct ThreadZone {
+			uint32_t m_thread;
+			Zone     m_zone;
+		};
+
+		std::vector<ThreadZone> zones;
+		this->ForEachZone([&zones](const uint32_t thread, const Zone& zone) { zones.push_back({ thread, zone }); });
+
+		// Outer zones first, so that viewers nest zones starting at the same time correctly
+		std::sort(zones.begin(), zones.end(), [](const ThreadZone& a, const ThreadZone& b) {
+			return (a.m_thread != b.m_thread) ? a.m_thread < b.m_thread : (a.m_zone.m_start != b.m_zone.m_start) ? a.m_zone.m_start < b.m_zone.m_start : a.m_zone.m_end > b.m_zone.m_end;
+		});
+
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		const std::ios::fmtflags flags     = stream.flags();
+		const std::streamsize    precision = stream.precision();
+		stream << std::fixed << std::setprecision(3);
+
+		// Frames are on track 0, threads on their index + 1
+		stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+		stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Frames\"}}";
+
+		for (const std::unique_ptr<ThreadBuffer>& pBuffer : this->m_threadBuffers) {
+			stream << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << (pBuffer->m_index + 1u) << ",\"args\":{\"name\":";
+			WriteJsonString(stream, pBuffer->m_name.empty() ? "Thread " + std::to_string(pBuffer->m_index) : pBuffer->m_name);
+			stream << "}}";
+			stream << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << (pBuffer->m_index + 1u) << ",\"args\":{\"sort_index\":" << (pBuffer->m_index + 1u) << "}}";
+		}
+
+		// The last frame ends with the capture
+		for (size_t i = 0u; i < this->m_frames.size(); i++) {
+			const uint64_t end = (i + 1u < this->m_frames.size()) ? this->m_frames[i + 1u] : this->m_endTimestamp;
+			const double   ts  = this->ToMicroseconds(this->m_frames[i]);
+
+			stream << ",\n{\"name\":\"Frame " << i << "\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":" << ts << ",\"dur\":" << (this->ToMicroseconds(end) - ts) << '}';
+		}
+
+		for (const ThreadZone& zone : zones) {
+			const double ts = this->ToMicroseconds(zone.m_zone.m_start);
+
+			stream << ",\n{\"name\":";
+			WriteJsonString(stream, zone.m_zone.m_name);
+			stream << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << (zone.m_thread + 1u) << ",\"ts\":" << ts << ",\"dur\":" << (this->ToMicroseconds(zone.m_zone.m_end) - ts) << '}';
+		}
+
+		stream << "\n]}\n";
+
+		stream.flags(flags);
+		stream.precision(precision);
+	}
+
+	bool Profiler::ExportChromeTrace(const char* filepath) const noexcept
+	{
+		std::ofstream file(filepath, std::ios::binary);
+		if (!file)
+			return false;
+
+		this->WriteChromeTrace(file);
+
+		return static_cast<bool>(file);
+	}
+
+}; // WS
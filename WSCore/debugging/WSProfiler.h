@@ -0,0 +1,194 @@
+#pragma once
+
+#include "../misc/WSPch.h"
+
+#define WS_PROFILER_BLOCK_SIZE 4096u // Zones per block of a thread's buffer
+#define WS_PROFILER_MAX_BLOCKS 256u  // Blocks per thread & capture, later zones are dropped & counted
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+	#define __WEISS__PROFILER_USES_TSC
+
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+
+#endif
+
+namespace WS {
+
+	// Time stamp counter ticks, or steady clock nanoseconds without one, converted to time when a capture is exported
+	[[nodiscard]] inline uint64_t ReadProfilerTimestamp() noexcept
+	{
+#ifdef __WEISS__PROFILER_USES_TSC
+		return __rdtsc();
+#else
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+	}
+
+	/*
+	 * Records zones (see WS_PROFILE_SCOPE) while a capture runs, into buffers of their threads that are never shared while recording,
+	 * & exports them as Chrome trace events (JSON, viewable in Perfetto or chrome://tracing).
+	 * Outside of a capture, a zone costs a relaxed load. Captures should be exported after StopCapture() & before the next StartCapture().
+	 */
+	class Profiler {
+	public:
+		struct Zone {
+			const char* m_name; // Lives as long as the program, usually a string literal
+			uint64_t    m_start;
+			uint64_t    m_end;
+		};
+
+	private:
+		struct Block {
+			Zone                  m_zones[WS_PROFILER_BLOCK_SIZE];
+			std::atomic<uint32_t> m_count  = 0u; // Published by the recording thread
+			std::atomic<Block*>   m_pNext  = nullptr;
+		};
+
+		// Kept once their thread exits so that captures still export its zones
+		struct ThreadBuffer {
+			std::atomic<uint32_t> m_capture  = 0u; // The capture its zones belong to
+			Block*                m_pFirst   = nullptr;
+			Block*                m_pCurrent = nullptr;
+			uint32_t              m_nBlocks  = 0u; // Used by the capture
+			uint32_t              m_index    = 0u;
+			std::string           m_name;          // Guarded by "m_mutex"
+
+			~ThreadBuffer() noexcept;
+		};
+
+		static inline std::atomic<uint32_t>      s_capture       = 0u; // 0 outside of captures
+		static inline thread_local ThreadBuffer* s_pThreadBuffer = nullptr;
+
+		mutable std::mutex                         m_mutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> m_threadBuffers;
+		uint32_t                                   m_lastCapture = 0u;
+		std::atomic<uint64_t>                      m_nDropped    = 0u;
+
+		// Frame markers of the capture, guarded by "m_mutex"
+		std::vector<uint64_t> m_frames;
+
+		// Matches timestamps to the steady clock, from the start of the capture to at least 10 ms later
+		uint64_t                              m_startTimestamp = 0u, m_stopTimestamp = 0u;
+		std::chrono::steady_clock::time_point m_startTime,         m_stopTime;
+		uint64_t                              m_endTimestamp   = 0u; // When the capture stopped
+
+	private:
+		Profiler() noexcept = default;
+
+		[[nodiscard]] ThreadBuffer& GetThreadBuffer() noexcept;
+
+		// Creates the thread's buffer, starts it over for a new capture or moves to its next block
+		void RecordSlow(const char* name, const uint64_t start, const uint64_t end, const uint32_t capture) noexcept;
+
+	public:
+		Profiler(const Profiler&) = delete;
+		Profiler& operator=(const Profiler&) = delete;
+
+		[[nodiscard]] static Profiler& Get() noexcept;
+
+		// 0 outside of captures
+		[[nodiscard]] static inline uint32_t GetCapture() noexcept { return s_capture.load(std::memory_order_relaxed); }
+
+		static inline void Record(const char* name, const uint64_t start, const uint64_t end, const uint32_t capture) noexcept
+		{
+			ThreadBuffer* pBuffer = s_pThreadBuffer;
+
+			if (pBuffer != nullptr && pBuffer->m_capture.load(std::memory_order_relaxed) == capture) {
+				Block*         pBlock = pBuffer->m_pCurrent;
+				const uint32_t count  = pBlock->m_count.load(std::memory_order_relaxed);
+
+				if (count < WS_PROFILER_BLOCK_SIZE) {
+					pBlock->m_zones[count] = { name, start, end };
+					pBlock->m_count.store(count + 1u, std::memory_order_release);
+					return;
+				}
+			}
+
+			Profiler::Get().RecordSlow(name, start, end, capture);
+		}
+
+		// Discards the zones of the previous capture
+		void StartCapture() noexcept;
+
+		void StopCapture() noexcept;
+
+		[[nodiscard]] inline bool IsCapturing() const noexcept { return GetCapture() != 0u; }
+
+		// Zones lost to full buffers during the last capture
+		[[nodiscard]] inline uint64_t GetDroppedCount() const noexcept { return this->m_nDropped.load(std::memory_order_relaxed); }
+
+		// Names the calling thread's track, its index otherwise
+		void SetThreadName(const std::string_view name) noexcept;
+
+		// Marks the beginning of a frame, frames are exported as zones of a track of their own
+		void MarkFrame() noexcept;
+
+		// Zones of the last capture, calls "onZone" with the index of their thread
+		void ForEachZone(const std::function<void(const uint32_t, const Zone&)>& onZone) const noexcept;
+
+		// Microseconds between the start of the last capture & "timestamp"
+		[[nodiscard]] double ToMicroseconds(const uint64_t timestamp) const noexcept;
+
+		// Writes the last capture as Chrome trace events
+		void WriteChromeTrace(std::ostream& stream) const noexcept;
+
+		bool ExportChromeTrace(const char* filepath) const noexcept;
+	};
+
+	// Records the time between its construction & destruction, see WS_PROFILE_SCOPE
+	class ProfileZone {
+	private:
+		const char* m_name;
+		uint64_t    m_start = 0u;
+		uint32_t    m_capture;
+
+	public:
+		explicit inline ProfileZone(const char* name) noexcept
+			: m_name(name), m_capture(Profiler::GetCapture())
+		{
+			if (this->m_capture != 0u)
+				this->m_start = ReadProfilerTimestamp();
+		}
+
+		ProfileZone(const ProfileZone&) = delete;
+		ProfileZone& operator=(const ProfileZone&) = delete;
+
+		inline ~ProfileZone() noexcept
+		{
+			// Zones that span the end of their capture are dropped
+			if (this->m_capture != 0u) {
+				const uint64_t end = ReadProfilerTimestamp();
+
+				if (Profiler::GetCapture() == this->m_capture)
+					Profiler::Record(this->m_name, this->m_start, end, this->m_capture);
+			}
+		}
+	};
+
+}; // WS
+
+/*
+ * WS_PROFILE_SCOPE("name") records a zone from this point to the end of the scope, "name" must live as long as the program.
+ * Defining __WEISS__DISABLE_PROFILER compiles every zone & frame marker out.
+ */
+#ifndef __WEISS__DISABLE_PROFILER
+
+	#define WS_PROFILE_CONCATENATE_(a, b) a##b
+	#define WS_PROFILE_CONCATENATE(a, b)  WS_PROFILE_CONCATENATE_(a, b)
+
+	#define WS_PROFILE_SCOPE(name) const ::WS::ProfileZone WS_PROFILE_CONCATENATE(wsProfileZone, __LINE__)(name)
+	#define WS_PROFILE_FUNCTION()  WS_PROFILE_SCOPE(__func__)
+	#define WS_PROFILE_FRAME()     ::WS::Profiler::Get().MarkFrame()
+
+#else
+
+	#define WS_PROFILE_SCOPE(name) static_cast<void>(0)
+	#define WS_PROFILE_FUNCTION()  static_cast<void>(0)
+	#define WS_PROFILE_FRAME()     static_cast<void>(0)
+
+#endif // __WEISS__DISABLE_PROFILER
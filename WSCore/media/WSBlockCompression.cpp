@@ -0,0 +1,826 @@
+#include "WSBlockCompression.h"
+#include "../misc/WSParallel.h"
+
+// Number of block rows from which encoding & decoding are multithreaded
+#define WS_BLOCK_COMPRESSION_PARALLEL_ROWS 8u
+
+namespace WS {
+
+	// ---------- Block Helpers ---------- //
+
+	// Gathers a 4x4 block (row major), replicating the last row & column past the image's edges
+	static void LoadBlock(const Image& image, const uint32_t blockX, const uint32_t blockY, Coloru8 block[16u]) noexcept
+	{
+		const WS::Coloru8* pPixels = image.GetBuffer();
+
+		for (uint32_t y = 0u; y < 4u; y++) {
+			const uint32_t sy = std::min(blockY * 4u + y, image.GetHeight() - 1u);
+
+			for (uint32_t x = 0u; x < 4u; x++) {
+				const uint32_t sx = std::min(blockX * 4u + x, image.GetWidth() - 1u);
+
+				block[y * 4u + x] = pPixels[static_cast<size_t>(sy) * image.GetWidth() + sx];
+			}
+		}
+	}
+
+	static void StoreBlock(Image& image, const uint32_t blockX, const uint32_t blockY, const Coloru8 block[16u]) noexcept
+	{
+		for (uint32_t y = 0u; y < 4u && blockY * 4u + y < image.GetHeight(); y++)
+			for (uint32_t x = 0u; x < 4u && blockX * 4u + x < image.GetWidth(); x++)
+				image.SetPixelColor(blockX * 4u + x, blockY * 4u + y, block[y * 4u + x]);
+	}
+
+	static inline uint32_t ColorToUint32(const Coloru8& color) noexcept
+	{
+		uint32_t value;
+		std::memcpy(&value, &color, sizeof(uint32_t));
+		return value;
+	}
+
+	static inline Coloru8 Uint32ToColor(const uint32_t value) noexcept
+	{
+		Coloru8 color;
+		std::memcpy(color.m_arr, &value, sizeof(uint32_t));
+		return color;
+	}
+
+	// ---------- SIMD Endpoint Search ---------- //
+
+	static inline void ComputeBoundingBox(const Coloru8 block[16u], Coloru8& minColor, Coloru8& maxColor) noexcept
+	{
+#ifndef __WEISS__DISABLE_SIMD
+		const __m128i row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block +  0u));
+		const __m128i row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block +  4u));
+		const __m128i row2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block +  8u));
+		const __m128i row3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 12u));
+
+		__m128i mn = _mm_min_epu8(_mm_min_epu8(row0, row1), _mm_min_epu8(row2, row3));
+		__m128i mx = _mm_max_epu8(_mm_max_epu8(row0, row1), _mm_max_epu8(row2, row3));
+
+		// Reduce the 4 pixels of each register
+		mn = _mm_min_epu8(mn, _mm_shuffle_epi32(mn, _MM_SHUFFLE(1, 0, 3, 2)));
+		mn = _mm_min_epu8(mn, _mm_shuffle_epi32(mn, _MM_SHUFFLE(2, 3, 0, 1)));
+		mx = _mm_max_epu8(mx, _mm_shuffle_epi32(mx, _MM_SHUFFLE(1, 0, 3, 2)));
+		mx = _mm_max_epu8(mx, _mm_shuffle_epi32(mx, _MM_SHUFFLE(2, 3, 0, 1)));
+
+		minColor = Uint32ToColor(static_cast<uint32_t>(_mm_cvtsi128_si32(mn)));
+		maxColor = Uint32ToColor(static_cast<uint32_t>(_mm_cvtsi128_si32(mx)));
+#else
+		minColor = block[0];
+		maxColor = block[0];
+
+		for (size_t i = 1u; i < 16u; i++) {
+			for (size_t c = 0u; c < 4u; c++) {
+				minColor.m_arr[c] = std::min(minColor.m_arr[c], block[i].m_arr[c]);
+				maxColor.m_arr[c] = std::max(maxColor.m_arr[c], block[i].m_arr[c]);
+			}
+		}
+#endif // #ifndef __WEISS__DISABLE_SIMD
+	}
+
+	// Squared distances between the 16 pixels of a block and "color", alpha is ignored unless "bIncludeAlpha"
+	static inline void ComputeSquaredDistances(const Coloru8 block[16u], const Coloru8& color, const bool bIncludeAlpha, int32_t distances[16u]) noexcept
+	{
+#ifndef __WEISS__DISABLE_SIMD
+		const __m128i zero    = _mm_setzero_si128();
+		const __m128i color16 = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(ColorToUint32(color))), zero);
+		const __m128i mask    = bIncludeAlpha ? _mm_set1_epi16(-1) : _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+
+		for (size_t row = 0u; row < 4u; row++) {
+			const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + row * 4u));
+			const __m128i dLo    = _mm_and_si128(_mm_sub_epi16(_mm_unpacklo_epi8(pixels, zero), color16), mask);
+			const __m128i dHi    = _mm_and_si128(_mm_sub_epi16(_mm_unpackhi_epi8(pixels, zero), color16), mask);
+
+			// madd gives (r² + g², b² + a²) per pixel, adding the swapped pairs gives each pixel's total twice
+			__m128i sqLo = _mm_madd_epi16(dLo, dLo);
+			__m128i sqHi = _mm_madd_epi16(dHi, dHi);
+			sqLo = _mm_add_epi32(sqLo, _mm_shuffle_epi32(sqLo, _MM_SHUFFLE(2, 3, 0, 1)));
+			sqHi = _mm_add_epi32(sqHi, _mm_shuffle_epi32(sqHi, _MM_SHUFFLE(2, 3, 0, 1)));
+
+			const __m128 packed = _mm_shuffle_ps(_mm_castsi128_ps(sqLo), _mm_castsi128_ps(sqHi), _MM_SHUFFLE(2, 0, 2, 0));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(distances + row * 4u), _mm_castps_si128(packed));
+		}
+#else
+		const size_t nChannels = bIncludeAlpha ? 4u : 3u;
+
+		for (size_t i = 0u; i < 16u; i++) {
+			distances[i] = 0;
+
+			for (size_t c = 0u; c < nChannels; c++) {
+				const int32_t d = static_cast<int32_t>(block[i].m_arr[c]) - static_cast<int32_t>(color.m_arr[c]);
+				distances[i] += d * d;
+			}
+		}
+#endif // #ifndef __WEISS__DISABLE_SIMD
+	}
+
+	// Picks the closest palette entry of every pixel and returns the block's total squared error
+	static inline int64_t FindBestIndices(const Coloru8 block[16u], const Coloru8* palette, const size_t paletteSize,
+	                                      const bool bIncludeAlpha, uint8_t indices[16u]) noexcept
+	{
+		int32_t best[16u];
+		int32_t distances[16u];
+
+		ComputeSquaredDistances(block, palette[0], bIncludeAlpha, best);
+		std::fill_n(indices, 16u, static_cast<uint8_t>(0u));
+
+		for (size_t e = 1u; e < paletteSize; e++) {
+			ComputeSquaredDistances(block, palette[e], bIncludeAlpha, distances);
+
+			for (size_t i = 0u; i < 16u; i++) {
+				if (distances[i] < best[i]) {
+					best[i]    = distances[i];
+					indices[i] = static_cast<uint8_t>(e);
+				}
+			}
+		}
+
+		int64_t error = 0;
+		for (size_t i = 0u; i < 16u; i++)
+			error += best[i];
+
+		return error;
+	}
+
+	/*
+	 * Least squares endpoints for fixed indices : minimizes sum(|a_i * e0 + (1 - a_i) * e1 - p_i|²)
+	 * where "a_i" is the weight of endpoint 0 for pixel i's index
+	 * Returns false when every pixel uses the same weight (the system is singular)
+	 */
+	static bool SolveLeastSquaresEndpoints(const Coloru8 block[16u], const uint8_t indices[16u], const float* weights0,
+	                                       const size_t nChannels, float e0[4u], float e1[4u]) noexcept
+	{
+		float aa = 0.f, bb = 0.f, ab = 0.f;
+		float ap[4u] = { 0.f }, bp[4u] = { 0.f };
+
+		for (size_t i = 0u; i < 16u; i++) {
+			const float a = weights0[indices[i]];
+			const float b = 1.f - a;
+
+			aa += a * a;
+			bb += b * b;
+			ab += a * b;
+
+			for (size_t c = 0u; c < nChannels; c++) {
+				ap[c] += a * block[i].m_arr[c];
+				bp[c] += b * block[i].m_arr[c];
+			}
+		}
+
+		const float determinant = aa * bb - ab * ab;
+		if (std::abs(determinant) < 1e-6f)
+			return false;
+
+		for (size_t c = 0u; c < nChannels; c++) {
+			e0[c] = std::clamp((ap[c] * bb - bp[c] * ab) / determinant, 0.f, 255.f);
+			e1[c] = std::clamp((bp[c] * aa - ap[c] * ab) / determinant, 0.f, 255.f);
+		}
+
+		return true;
+	}
+
+	// ---------- BC1 ---------- //
+
+	static inline uint16_t PackRGB565(const float r, const float g, const float b) noexcept
+	{
+		const uint32_t r5 = static_cast<uint32_t>(std::clamp(r, 0.f, 255.f) * 31.f / 255.f + 0.5f);
+		const uint32_t g6 = static_cast<uint32_t>(std::clamp(g, 0.f, 255.f) * 63.f / 255.f + 0.5f);
+		const uint32_t b5 = static_cast<uint32_t>(std::clamp(b, 0.f, 255.f) * 31.f / 255.f + 0.5f);
+
+		return static_cast<uint16_t>((r5 << 11u) | (g6 << 5u) | b5);
+	}
+
+	static inline Coloru8 UnpackRGB565(const uint16_t value) noexcept
+	{
+		const uint32_t r5 = (value >> 11u) & 31u;
+		const uint32_t g6 = (value >> 5u)  & 63u;
+		const uint32_t b5 = value & 31u;
+
+		return Coloru8(static_cast<uint8_t>((r5 << 3u) | (r5 >> 2u)),
+		               static_cast<uint8_t>((g6 << 2u) | (g6 >> 4u)),
+		               static_cast<uint8_t>((b5 << 3u) | (b5 >> 2u)), 255u);
+	}
+
+	// "bFourColors" is the 4 color mode which BC3 always uses, BC1 uses it when c0 > c1
+	static inline void GetBC1Palette(const uint16_t c0, const uint16_t c1, const bool bFourColors, Coloru8 palette[4u]) noexcept
+	{
+		palette[0] = UnpackRGB565(c0);
+		palette[1] = UnpackRGB565(c1);
+
+		for (size_t c = 0u; c < 3u; c++) {
+			const uint32_t v0 = palette[0].m_arr[c];
+			const uint32_t v1 = palette[1].m_arr[c];
+
+			if (bFourColors) {
+				palette[2].m_arr[c] = static_cast<uint8_t>((2u * v0 + v1 + 1u) / 3u);
+				palette[3].m_arr[c] = static_cast<uint8_t>((v0 + 2u * v1 + 1u) / 3u);
+			} else {
+				palette[2].m_arr[c] = static_cast<uint8_t>((v0 + v1 + 1u) / 2u);
+				palette[3].m_arr[c] = 0u;
+			}
+		}
+
+		palette[2].a = 255u;
+		palette[3].a = bFourColors ? 255u : 0u;
+	}
+
+	/*
+	 * Solid blocks : a 565 endpoint alone is up to 4 levels off, so every 8 bit value gets the pair of 5 (or 6) bit endpoints
+	 * whose 2/3 - 1/3 interpolation (palette entry 2) decodes closest to it, ties going to the closest pair.
+	 */
+	struct BC1SingleColorTable {
+		uint8_t m_endpoints5[256u][2u];
+		uint8_t m_endpoints6[256u][2u];
+	};
+
+	template <uint32_t _BITS>
+	static void FillBC1SingleColorEndpoints(uint8_t endpoints[256u][2u]) noexcept
+	{
+		constexpr const uint32_t nValues = 1u << _BITS;
+
+		for (int32_t value = 0; value < 256; value++) {
+			int32_t bestError = std::numeric_limits<int32_t>::max();
+
+			for (uint32_t q0 = 0u; q0 < nValues; q0++) {
+				for (uint32_t q1 = 0u; q1 < nValues; q1++) {
+					// Same expansion & rounding as UnpackRGB565 & GetBC1Palette
+					const int32_t v0 = static_cast<int32_t>((q0 << (8u - _BITS)) | (q0 >> (2u * _BITS - 8u)));
+					const int32_t v1 = static_cast<int32_t>((q1 << (8u - _BITS)) | (q1 >> (2u * _BITS - 8u)));
+
+					const int32_t error = std::abs((2 * v0 + v1 + 1) / 3 - value) * 256 + std::abs(v0 - v1);
+
+					if (error < bestError) {
+						bestError = error;
+						endpoints[value][0] = static_cast<uint8_t>(q0);
+						endpoints[value][1] = static_cast<uint8_t>(q1);
+					}
+				}
+			}
+		}
+	}
+
+	[[nodiscard]] static const BC1SingleColorTable& GetBC1SingleColorTable() noexcept
+	{
+		static const BC1SingleColorTable s_table = []() {
+			BC1SingleColorTable table;
+			FillBC1SingleColorEndpoints<5u>(table.m_endpoints5);
+			FillBC1SingleColorEndpoints<6u>(table.m_endpoints6);
+
+			return table;
+		}();
+
+		return s_table;
+	}
+
+	// Endpoints & indices of a block of varying colors, "c0" & "c1" may be in either order
+	static void FindBC1Endpoints(const Coloru8 block[16u], Coloru8 minColor, Coloru8 maxColor, uint16_t& c0, uint16_t& c1, uint8_t indices[16u]) noexcept
+	{
+		static constexpr float INDEX_WEIGHTS[4u] = { 1.f, 0.f, 2.f / 3.f, 1.f / 3.f };
+
+		// The bounding box diagonal only follows the colors if r & b vary along with g (the widest channel)
+		{
+			const float mean[3u] = { (minColor.r + maxColor.r) * 0.5f, (minColor.g + maxColor.g) * 0.5f, (minColor.b + maxColor.b) * 0.5f };
+
+			float covRG = 0.f, covBG = 0.f;
+			for (size_t i = 0u; i < 16u; i++) {
+				covRG += (block[i].r - mean[0]) * (block[i].g - mean[1]);
+				covBG += (block[i].b - mean[2]) * (block[i].g - mean[1]);
+			}
+
+			if (covRG < 0.f) std::swap(minColor.r, maxColor.r);
+			if (covBG < 0.f) std::swap(minColor.b, maxColor.b);
+		}
+
+		// Inset the endpoints by 1/16th of the range to reduce the error of the outermost colors
+		float e0[4u], e1[4u];
+		for (size_t c = 0u; c < 3u; c++) {
+			const float inset = (static_cast<float>(maxColor.m_arr[c]) - static_cast<float>(minColor.m_arr[c])) / 16.f;
+
+			e0[c] = maxColor.m_arr[c] - inset;
+			e1[c] = minColor.m_arr[c] + inset;
+		}
+
+		c0 = PackRGB565(e0[0], e0[1], e0[2]);
+		c1 = PackRGB565(e1[0], e1[1], e1[2]);
+
+		Coloru8 palette[4u];
+
+		GetBC1Palette(c0, c1, true, palette);
+		const int64_t error = FindBestIndices(block, palette, 4u, false, indices);
+
+		// One least squares refinement pass
+		if (error > 0 && SolveLeastSquaresEndpoints(block, indices, INDEX_WEIGHTS, 3u, e0, e1)) {
+			const uint16_t r0 = PackRGB565(e0[0], e0[1], e0[2]);
+			const uint16_t r1 = PackRGB565(e1[0], e1[1], e1[2]);
+
+			uint8_t refinedIndices[16u];
+			GetBC1Palette(r0, r1, true, palette);
+			const int64_t refinedError = FindBestIndices(block, palette, 4u, false, refinedIndices);
+
+			if (refinedError < error) {
+				c0 = r0;
+				c1 = r1;
+				std::memcpy(indices, refinedIndices, 16u);
+			}
+		}
+	}
+
+	static void EncodeBC1ColorBlock(const Coloru8 block[16u], uint8_t* dst) noexcept
+	{
+		Coloru8 minColor, maxColor;
+		ComputeBoundingBox(block, minColor, maxColor);
+
+		uint16_t c0, c1;
+		uint8_t  indices[16u];
+
+		if (minColor.r == maxColor.r && minColor.g == maxColor.g && minColor.b == maxColor.b) {
+			const BC1SingleColorTable& table = GetBC1SingleColorTable();
+
+			c0 = static_cast<uint16_t>((table.m_endpoints5[minColor.r][0] << 11u) | (table.m_endpoints6[minColor.g][0] << 5u) | table.m_endpoints5[minColor.b][0]);
+			c1 = static_cast<uint16_t>((table.m_endpoints5[minColor.r][1] << 11u) | (table.m_endpoints6[minColor.g][1] << 5u) | table.m_endpoints5[minColor.b][1]);
+
+			std::fill_n(indices, 16u, static_cast<uint8_t>(2u));
+		} else {
+			FindBC1Endpoints(block, minColor, maxColor, c0, c1, indices);
+		}
+
+		// The 4 color mode requires c0 > c1 : swapping the endpoints swaps indices 0 <-> 1 & 2 <-> 3
+		if (c0 < c1) {
+			std::swap(c0, c1);
+
+			for (size_t i = 0u; i < 16u; i++)
+				indices[i] ^= 1u;
+		} else if (c0 == c1) {
+			std::fill_n(indices, 16u, static_cast<uint8_t>(0u));
+		}
+
+		uint32_t packedIndices = 0u;
+		for (size_t i = 0u; i < 16u; i++)
+			packedIndices |= static_cast<uint32_t>(indices[i]) << (2u * i);
+
+		const uint16_t c0LE = WS::FromLittleEndian(c0);
+		const uint16_t c1LE = WS::FromLittleEndian(c1);
+		const uint32_t idLE = WS::FromLittleEndian(packedIndices);
+
+		std::memcpy(dst + 0u, &c0LE, 2u);
+		std::memcpy(dst + 2u, &c1LE, 2u);
+		std::memcpy(dst + 4u, &idLE, 4u);
+	}
+
+	static void DecodeBC1ColorBlock(const uint8_t* src, const bool bForceFourColors, Coloru8 block[16u]) noexcept
+	{
+		uint16_t c0, c1;
+		uint32_t packedIndices;
+
+		std::memcpy(&c0, src + 0u, 2u);
+		std::memcpy(&c1, src + 2u, 2u);
+		std::memcpy(&packedIndices, src + 4u, 4u);
+
+		c0            = WS::FromLittleEndian(c0);
+		c1            = WS::FromLittleEndian(c1);
+		packedIndices = WS::FromLittleEndian(packedIndices);
+
+		Coloru8 palette[4u];
+		GetBC1Palette(c0, c1, bForceFourColors || c0 > c1, palette);
+
+		for (size_t i = 0u; i < 16u; i++)
+			block[i] = palette[(packedIndices >> (2u * i)) & 3u];
+	}
+
+	// ---------- BC3 Alpha ---------- //
+
+	static void EncodeBC3AlphaBlock(const Coloru8 block[16u], uint8_t* dst) noexcept
+	{
+		uint8_t minAlpha = 255u, maxAlpha = 0u;
+		for (size_t i = 0u; i < 16u; i++) {
+			minAlpha = std::min(minAlpha, block[i].a);
+			maxAlpha = std::max(maxAlpha, block[i].a);
+		}
+
+		dst[0] = maxAlpha;
+		dst[1] = minAlpha;
+
+		// 8 value mode (a0 > a1) : 0 -> a0, 1 -> a1, 2..7 -> ((8 - i) * a0 + (i - 1) * a1) / 7
+		uint64_t packedIndices = 0u;
+		if (maxAlpha > minAlpha) {
+			const float range = static_cast<float>(maxAlpha - minAlpha);
+
+			for (size_t i = 0u; i < 16u; i++) {
+				const uint32_t step  = static_cast<uint32_t>((maxAlpha - block[i].a) * 7.f / range + 0.5f);
+				const uint64_t index = (step == 0u) ? 0u : ((step == 7u) ? 1u : step + 1u);
+
+				packedIndices |= index << (3u * i);
+			}
+		}
+
+		for (size_t b = 0u; b < 6u; b++)
+			dst[2u + b] = static_cast<uint8_t>(packedIndices >> (8u * b));
+	}
+
+	static void DecodeBC3AlphaBlock(const uint8_t* src, Coloru8 block[16u]) noexcept
+	{
+		const uint32_t a0 = src[0];
+		const uint32_t a1 = src[1];
+
+		uint8_t palette[8u] = { static_cast<uint8_t>(a0), static_cast<uint8_t>(a1) };
+		if (a0 > a1) {
+			for (uint32_t i = 2u; i < 8u; i++)
+				palette[i] = static_cast<uint8_t>(((8u - i) * a0 + (i - 1u) * a1 + 3u) / 7u);
+		} else {
+			for (uint32_t i = 2u; i < 6u; i++)
+				palette[i] = static_cast<uint8_t>(((6u - i) * a0 + (i - 1u) * a1 + 2u) / 5u);
+
+			palette[6] = 0u;
+			palette[7] = 255u;
+		}
+
+		uint64_t packedIndices = 0u;
+		for (size_t b = 0u; b < 6u; b++)
+			packedIndices |= static_cast<uint64_t>(src[2u + b]) << (8u * b);
+
+		for (size_t i = 0u; i < 16u; i++)
+			block[i].a = palette[(packedIndices >> (3u * i)) & 7u];
+	}
+
+	// ---------- BC7 Mode 6 ---------- //
+
+	static constexpr uint32_t BC7_WEIGHTS_4[16u] = { 0u, 4u, 9u, 13u, 17u, 21u, 26u, 30u, 34u, 38u, 43u, 47u, 51u, 55u, 60u, 64u };
+
+	// Writes & reads the 128 bits of a block, least significant bit first
+	struct BC7BlockBits {
+		uint64_t m_bits[2u] = { 0u, 0u };
+		uint32_t m_position = 0u;
+
+		inline void Write(const uint32_t value, const uint32_t nBits) noexcept
+		{
+			for (uint32_t i = 0u; i < nBits; i++, this->m_position++)
+				this->m_bits[this->m_position / 64u] |= static_cast<uint64_t>((value >> i) & 1u) << (this->m_position % 64u);
+		}
+
+		inline uint32_t Read(const uint32_t nBits) noexcept
+		{
+			uint32_t value = 0u;
+			for (uint32_t i = 0u; i < nBits; i++, this->m_position++)
+				value |= static_cast<uint32_t>((this->m_bits[this->m_position / 64u] >> (this->m_position % 64u)) & 1u) << i;
+
+			return value;
+		}
+	};
+
+	struct BC7Mode6Endpoints {
+		uint8_t m_quantized[2u][4u]; // 7 bits per channel
+		uint8_t m_pBits[2u];
+	};
+
+	static inline Coloru8 GetBC7EndpointColor(const BC7Mode6Endpoints& endpoints, const size_t e) noexcept
+	{
+		Coloru8 color;
+		for (size_t c = 0u; c < 4u; c++)
+			color.m_arr[c] = static_cast<uint8_t>((endpoints.m_quantized[e][c] << 1u) | endpoints.m_pBits[e]);
+
+		return color;
+	}
+
+	static inline void GetBC7Palette(const BC7Mode6Endpoints& endpoints, Coloru8 palette[16u]) noexcept
+	{
+		const Coloru8 e0 = GetBC7EndpointColor(endpoints, 0u);
+		const Coloru8 e1 = GetBC7EndpointColor(endpoints, 1u);
+
+		for (size_t i = 0u; i < 16u; i++)
+			for (size_t c = 0u; c < 4u; c++)
+				palette[i].m_arr[c] = static_cast<uint8_t>((e0.m_arr[c] * (64u - BC7_WEIGHTS_4[i]) + e1.m_arr[c] * BC7_WEIGHTS_4[i] + 32u) >> 6u);
+	}
+
+	static inline void QuantizeBC7Endpoint(const float value[4u], const uint8_t pBit, uint8_t quantized[4u]) noexcept
+	{
+		for (size_t c = 0u; c < 4u; c++)
+			quantized[c] = static_cast<uint8_t>(std::clamp((value[c] - pBit) * 0.5f + 0.5f, 0.f, 127.f));
+	}
+
+	// Picks the p-bit that best reproduces the endpoint on its own
+	static inline void QuantizeBC7EndpointBestPBit(const float value[4u], uint8_t quantized[4u], uint8_t& pBit) noexcept
+	{
+		// Kept when no candidate compares better, i.e for NaN values
+		pBit = 0u;
+		QuantizeBC7Endpoint(value, 0u, quantized);
+
+		float bestError = std::numeric_limits<float>::max();
+
+		for (uint8_t p = 0u; p < 2u; p++) {
+			uint8_t candidate[4u];
+			QuantizeBC7Endpoint(value, p, candidate);
+
+			float error = 0.f;
+			for (size_t c = 0u; c < 4u; c++) {
+				const float d = value[c] - static_cast<float>((candidate[c] << 1u) | p);
+				error += d * d;
+			}
+
+			if (error < bestError) {
+				bestError = error;
+				pBit      = p;
+				std::memcpy(quantized, candidate, 4u);
+			}
+		}
+	}
+
+	// Principal axis of the block's RGBA distribution (power iteration on the covariance matrix)
+	static void ComputePrincipalAxisEndpoints(const Coloru8 block[16u], const Coloru8& minColor, const Coloru8& maxColor,
+	                                          float e0[4u], float e1[4u]) noexcept
+	{
+		float mean[4u] = { 0.f };
+		for (size_t i = 0u; i < 16u; i++)
+			for (size_t c = 0u; c < 4u; c++)
+				mean[c] += block[i].m_arr[c] / 16.f;
+
+		float covariance[4u][4u] = { { 0.f } };
+		for (size_t i = 0u; i < 16u; i++)
+			for (size_t r = 0u; r < 4u; r++)
+				for (size_t c = 0u; c < 4u; c++)
+					covariance[r][c] += (block[i].m_arr[r] - mean[r]) * (block[i].m_arr[c] - mean[c]);
+
+		float axis[4u];
+		for (size_t c = 0u; c < 4u; c++)
+			axis[c] = static_cast<float>(maxColor.m_arr[c]) - static_cast<float>(minColor.m_arr[c]);
+
+		for (size_t iteration = 0u; iteration < 8u; iteration++) {
+			float next[4u] = { 0.f };
+			for (size_t r = 0u; r < 4u; r++)
+				for (size_t c = 0u; c < 4u; c++)
+					next[r] += covariance[r][c] * axis[c];
+
+			const float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2] + next[3] * next[3]);
+			if (length < 1e-6f)
+				break;
+
+			for (size_t c = 0u; c < 4u; c++)
+				axis[c] = next[c] / length;
+		}
+
+		float minProjection = std::numeric_limits<float>::max(), maxProjection = -std::numeric_limits<float>::max();
+		for (size_t i = 0u; i < 16u; i++) {
+			float projection = 0.f;
+			for (size_t c = 0u; c < 4u; c++)
+				projection += (block[i].m_arr[c] - mean[c]) * axis[c];
+
+			minProjection = std::min(minProjection, projection);
+			maxProjection = std::max(maxProjection, projection);
+		}
+
+		for (size_t c = 0u; c < 4u; c++) {
+			e0[c] = std::clamp(mean[c] + axis[c] * minProjection, 0.f, 255.f);
+			e1[c] = std::clamp(mean[c] + axis[c] * maxProjection, 0.f, 255.f);
+		}
+	}
+
+	static int64_t EvaluateBC7Mode6(const Coloru8 block[16u], const BC7Mode6Endpoints& endpoints, uint8_t indices[16u]) noexcept
+	{
+		Coloru8 palette[16u];
+		GetBC7Palette(endpoints, palette);
+
+		return FindBestIndices(block, palette, 16u, true, indices);
+	}
+
+	static void EncodeBC7Block(const Coloru8 block[16u], const BC7Quality quality, uint8_t* dst) noexcept
+	{
+		Coloru8 minColor, maxColor;
+		ComputeBoundingBox(block, minColor, maxColor);
+
+		float e0[4u], e1[4u];
+		if (quality == BC7Quality::FAST) {
+			for (size_t c = 0u; c < 4u; c++) {
+				e0[c] = minColor.m_arr[c];
+				e1[c] = maxColor.m_arr[c];
+			}
+		} else {
+			ComputePrincipalAxisEndpoints(block, minColor, maxColor, e0, e1);
+		}
+
+		BC7Mode6Endpoints endpoints;
+		QuantizeBC7EndpointBestPBit(e0, endpoints.m_quantized[0], endpoints.m_pBits[0]);
+		QuantizeBC7EndpointBestPBit(e1, endpoints.m_quantized[1], endpoints.m_pBits[1]);
+
+		uint8_t indices[16u];
+		int64_t error = EvaluateBC7Mode6(block, endpoints, indices);
+
+		if (quality == BC7Quality::SLOW) {
+			float weights0[16u];
+			for (size_t i = 0u; i < 16u; i++)
+				weights0[i] = 1.f - BC7_WEIGHTS_4[i] / 64.f;
+
+			for (size_t iteration = 0u; iteration < 2u && error > 0; iteration++) {
+				if (!SolveLeastSquaresEndpoints(block, indices, weights0, 4u, e0, e1))
+					break;
+
+				bool bImproved = false;
+
+				// Try every p-bit combination for the refined endpoints
+				for (uint8_t p = 0u; p < 4u; p++) {
+					BC7Mode6Endpoints candidate;
+					candidate.m_pBits[0] = p & 1u;
+					candidate.m_pBits[1] = p >> 1u;
+					QuantizeBC7Endpoint(e0, candidate.m_pBits[0], candidate.m_quantized[0]);
+					QuantizeBC7Endpoint(e1, candidate.m_pBits[1], candidate.m_quantized[1]);
+
+					uint8_t candidateIndices[16u];
+					const int64_t candidateError = EvaluateBC7Mode6(block, candidate, candidateIndices);
+
+					if (candidateError < error) {
+						error     = candidateError;
+						endpoints = candidate;
+						bImproved = true;
+						std::memcpy(indices, candidateIndices, 16u);
+					}
+				}
+
+				if (!bImproved)
+					break;
+			}
+		}
+
+		// The anchor (pixel 0) index is stored with 3 bits : its msb must be 0
+		if (indices[0] >= 8u) {
+			std::swap(endpoints.m_quantized[0][0], endpoints.m_quantized[1][0]);
+			std::swap(endpoints.m_quantized[0][1], endpoints.m_quantized[1][1]);
+			std::swap(endpoints.m_quantized[0][2], endpoints.m_quantized[1][2]);
+			std::swap(endpoints.m_quantized[0][3], endpoints.m_quantized[1][3]);
+			std::swap(endpoints.m_pBits[0], endpoints.m_pBits[1]);
+
+			for (size_t i = 0u; i < 16u; i++)
+				indices[i] = static_cast<uint8_t>(15u - indices[i]);
+		}
+
+		BC7BlockBits bits;
+		bits.Write(1u << 6u, 7u); // Mode 6
+
+		for (size_t c = 0u; c < 4u; c++) {
+			bits.Write(endpoints.m_quantized[0][c], 7u);
+			bits.Write(endpoints.m_quantized[1][c], 7u);
+		}
+
+		bits.Write(endpoints.m_pBits[0], 1u);
+		bits.Write(endpoints.m_pBits[1], 1u);
+
+		bits.Write(indices[0], 3u);
+		for (size_t i = 1u; i < 16u; i++)
+			bits.Write(indices[i], 4u);
+
+		for (size_t w = 0u; w < 2u; w++) {
+			const uint64_t word = WS::FromLittleEndian(bits.m_bits[w]);
+			std::memcpy(dst + w * 8u, &word, 8u);
+		}
+	}
+
+	static void DecodeBC7Block(const uint8_t* src, Coloru8 block[16u]) noexcept
+	{
+		BC7BlockBits bits;
+		std::memcpy(bits.m_bits, src, 16u);
+		bits.m_bits[0] = WS::FromLittleEndian(bits.m_bits[0]);
+		bits.m_bits[1] = WS::FromLittleEndian(bits.m_bits[1]);
+
+		if (bits.Read(7u) != (1u << 6u)) {
+			std::fill_n(block, 16u, Coloru8(255u, 0u, 255u, 255u));
+			return;
+		}
+
+		BC7Mode6Endpoints endpoints;
+		for (size_t c = 0u; c < 4u; c++) {
+			endpoints.m_quantized[0][c] = static_cast<uint8_t>(bits.Read(7u));
+			endpoints.m_quantized[1][c] = static_cast<uint8_t>(bits.Read(7u));
+		}
+
+		endpoints.m_pBits[0] = static_cast<uint8_t>(bits.Read(1u));
+		endpoints.m_pBits[1] = static_cast<uint8_t>(bits.Read(1u));
+
+		Coloru8 palette[16u];
+		GetBC7Palette(endpoints, palette);
+
+		block[0] = palette[bits.Read(3u)];
+		for (size_t i = 1u; i < 16u; i++)
+			block[i] = palette[bits.Read(4u)];
+	}
+
+	// ---------- Public Interface ---------- //
+
+	static inline size_t GetBlockSize(const TextureFormat format) noexcept
+	{
+		return (format == TextureFormat::BC1) ? 8u : 16u;
+	}
+
+	void EncodeBlocks(const Image& image, const TextureFormat format, uint8_t* dst, const BC7Quality bc7Quality) WS_NOEXCEPT
+	{
+		if (format == TextureFormat::RGBA8) {
+			WS_THROW("[WS] RGBA8 Isn't A Block Compressed Format");
+			return;
+		}
+
+		const uint32_t nBlocksX  = (image.GetWidth()  + 3u) / 4u;
+		const uint32_t nBlocksY  = (image.GetHeight() + 3u) / 4u;
+		const size_t   blockSize = GetBlockSize(format);
+
+		WS::ParallelFor(nBlocksY, WS_BLOCK_COMPRESSION_PARALLEL_ROWS, [&](const size_t beginRow, const size_t endRow) {
+			Coloru8 block[16u];
+
+			for (size_t by = beginRow; by < endRow; by++) {
+				for (uint32_t bx = 0u; bx < nBlocksX; bx++) {
+					uint8_t* pBlock = dst + (by * nBlocksX + bx) * blockSize;
+
+					LoadBlock(image, bx, static_cast<uint32_t>(by), block);
+
+					switch (format) {
+					case TextureFormat::BC1:
+						EncodeBC1ColorBlock(block, pBlock);
+						break;
+					case TextureFormat::BC3:
+						EncodeBC3AlphaBlock(block, pBlock);
+						EncodeBC1ColorBlock(block, pBlock + 8u);
+						break;
+					case TextureFormat::BC7:
+						EncodeBC7Block(block, bc7Quality, pBlock);
+						break;
+					default:
+						break;
+					}
+				}
+			}
+		});
+	}
+
+	std::vector<uint8_t> EncodeBlocks(const Image& image, const TextureFormat format, const BC7Quality bc7Quality) WS_NOEXCEPT
+	{
+		std::vector<uint8_t> blocks(GetTextureLevelSize(format, image.GetWidth(), image.GetHeight()));
+		WS::EncodeBlocks(image, format, blocks.data(), bc7Quality);
+
+		return blocks;
+	}
+
+	Image DecodeBlocks(const uint8_t* src, const TextureFormat format, const uint32_t width, const uint32_t height) WS_NOEXCEPT
+	{
+		if (format == TextureFormat::RGBA8) {
+			WS_THROW("[WS] RGBA8 Isn't A Block Compressed Format");
+			return Image();
+		}
+
+		Image image(width, height);
+
+		const uint32_t nBlocksX  = (width  + 3u) / 4u;
+		const uint32_t nBlocksY  = (height + 3u) / 4u;
+		const size_t   blockSize = GetBlockSize(format);
+
+		WS::ParallelFor(nBlocksY, WS_BLOCK_COMPRESSION_PARALLEL_ROWS, [&](const size_t beginRow, const size_t endRow) {
+			Coloru8 block[16u];
+
+			for (size_t by = beginRow; by < endRow; by++) {
+				for (uint32_t bx = 0u; bx < nBlocksX; bx++) {
+					const uint8_t* pBlock = src + (by * nBlocksX + bx) * blockSize;
+
+					switch (format) {
+					case TextureFormat::BC1:
+						DecodeBC1ColorBlock(pBlock, false, block);
+						break;
+					case TextureFormat::BC3:
+						DecodeBC1ColorBlock(pBlock + 8u, true, block);
+						DecodeBC3AlphaBlock(pBlock, block);
+						break;
+					case TextureFormat::BC7:
+						DecodeBC7Block(pBlock, block);
+						break;
+					default:
+						break;
+					}
+
+					StoreBlock(image, bx, static_cast<uint32_t>(by), block);
+				}
+			}
+		});
+
+		return image;
+	}
+
+	double ComputePSNR(const Image& reference, const Image& test, const bool bIncludeAlpha) WS_NOEXCEPT
+	{
+		if (reference.GetWidth() != test.GetWidth() || reference.GetHeight() != test.GetHeight()) {
+			WS_THROW("[WS] PSNR Requires Images Of The Same Size");
+			return 0.0;
+		}
+
+		const size_t nChannels = bIncludeAlpha ? 4u : 3u;
+
+		uint64_t squaredError = 0u;
+		for (uint64_t i = 0u; i < reference.GetPixelCount(); i++) {
+			for (size_t c = 0u; c < nChannels; c++) {
+				const int32_t d = static_cast<int32_t>(reference.GetBuffer()[i].m_arr[c]) - static_cast<int32_t>(test.GetBuffer()[i].m_arr[c]);
+				squaredError += static_cast<uint64_t>(d * d);
+			}
+		}
+
+		if (squaredError == 0u)
+			return std::numeric_limits<double>::infinity();
+
+		const double meanSquaredError = static_cast<double>(squaredError) / static_cast<double>(reference.GetPixelCount() * nChannels);
+
+		return 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+	}
+
+}; // WS
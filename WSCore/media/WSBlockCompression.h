@@ -0,0 +1,31 @@
+#pragma once
+
+#include "WSImage.h"
+#include "WSTextureFile.h"
+#include "../misc/WSPch.h"
+
+namespace WS {
+
+	/*
+	 * CPU block compression of RGBA8 images into 4x4 pixel blocks
+	 *
+	 * BC1 : opaque RGB565 endpoints + 2 bit indices (8 bytes per block), alpha is dropped
+	 * BC3 : BC1 color block + interpolated 8 bit alpha block (16 bytes per block)
+	 * BC7 : mode 6 only, RGBA 7.7.7.7 endpoints with a p-bit + 4 bit indices (16 bytes per block)
+	 *
+	 * Block rows are encoded in parallel, images whose dimensions aren't multiples of 4
+	 * are padded by replicating their last row & column.
+	 */
+
+	// "dst" must hold GetTextureLevelSize(format, image.GetWidth(), image.GetHeight()) bytes, "format" can't be RGBA8
+	void EncodeBlocks(const Image& image, const TextureFormat format, uint8_t* dst, const BC7Quality bc7Quality = BC7Quality::NORMAL) WS_NOEXCEPT;
+
+	[[nodiscard]] std::vector<uint8_t> EncodeBlocks(const Image& image, const TextureFormat format, const BC7Quality bc7Quality = BC7Quality::NORMAL) WS_NOEXCEPT;
+
+	// Decodes the blocks produced by "EncodeBlocks" (BC7 blocks using another mode than 6 decode to opaque magenta)
+	[[nodiscard]] Image DecodeBlocks(const uint8_t* src, const TextureFormat format, const uint32_t width, const uint32_t height) WS_NOEXCEPT;
+
+	// Peak signal to noise ratio in dB between two images of the same size, infinity when they are identical
+	[[nodiscard]] double ComputePSNR(const Image& reference, const Image& test, const bool bIncludeAlpha = true) WS_NOEXCEPT;
+
+}; // WS
@@ -0,0 +1,501 @@
+#include "WSColorSpace.h"
+#include "../misc/WSParallel.h"
+#include "../misc/WSCpuFeatures.h"
+
+namespace WS {
+
+	// ---------- Lookup Tables ---------- //
+
+	static inline float SRGBChannelToLinear(const float c) noexcept
+	{
+		return (c <= 0.04045f) ? (c / 12.92f) : std::pow((c + 0.055f) / 1.055f, 2.4f);
+	}
+
+	// [0, 256) : sRGB channel -> linear, [256, 512) : alpha -> alpha / 255, so that a whole pixel is 4 lookups
+	static const std::array<float, 512u>& GetSRGBToLinearTable() noexcept
+	{
+		static const std::array<float, 512u> table = []() {
+			std::array<float, 512u> t;
+			for (size_t i = 0u; i < 256u; i++) {
+				t[i]        = SRGBChannelToLinear(static_cast<float>(i) / 255.f);
+				t[256u + i] = static_cast<float>(i) * (1.f / 255.f);
+			}
+			return t;
+		}();
+
+		return table;
+	}
+
+	// 255 / a for every alpha value, 0 for a == 0
+	static const std::array<float, 256u>& GetUnpremultiplyTable() noexcept
+	{
+		static const std::array<float, 256u> table = []() {
+			std::array<float, 256u> t;
+			t[0] = 0.f;
+			for (size_t i = 1u; i < 256u; i++)
+				t[i] = 255.f / static_cast<float>(i);
+			return t;
+		}();
+
+		return table;
+	}
+
+	// ---------- Scalar Kernels (Tails & __WEISS__DISABLE_SIMD) ---------- //
+
+	static inline uint8_t FloatToUnorm8(const float f) noexcept
+	{
+		return static_cast<uint8_t>(std::clamp(f, 0.f, 1.f) * 255.f + 0.5f);
+	}
+
+	static inline float LinearChannelToSRGB(float c) noexcept
+	{
+		c = std::clamp(c, 0.f, 1.f);
+
+		if (c <= 0.0031308f)
+			return c * 12.92f;
+
+		const float s1 = std::sqrt(c);
+		const float s2 = std::sqrt(s1);
+		const float s3 = std::sqrt(s2);
+
+		return 0.585122381f * s1 + 0.783140355f * s2 - 0.368262736f * s3;
+	}
+
+	static void SRGBToLinearScalar(const Coloru8* src, Colorf32* dst, const size_t count) noexcept
+	{
+		const std::array<float, 512u>& table = GetSRGBToLinearTable();
+
+		for (size_t i = 0u; i < count; i++)
+			dst[i].Set(table[src[i].r], table[src[i].g], table[src[i].b], table[256u + src[i].a]);
+	}
+
+	static void LinearToSRGBScalar(const Colorf32* src, Coloru8* dst, const size_t count) noexcept
+	{
+		for (size_t i = 0u; i < count; i++)
+			dst[i].Set(FloatToUnorm8(LinearChannelToSRGB(src[i].r)), FloatToUnorm8(LinearChannelToSRGB(src[i].g)),
+			           FloatToUnorm8(LinearChannelToSRGB(src[i].b)), FloatToUnorm8(src[i].a));
+	}
+
+	static void ConvertColorsScalar(const Coloru8* src, Colorf32* dst, const size_t count) noexcept
+	{
+		for (size_t i = 0u; i < count; i++)
+			dst[i].Set(src[i].r * (1.f / 255.f), src[i].g * (1.f / 255.f), src[i].b * (1.f / 255.f), src[i].a * (1.f / 255.f));
+	}
+
+	static void ConvertColorsScalar(const Colorf32* src, Coloru8* dst, const size_t count) noexcept
+	{
+		for (size_t i = 0u; i < count; i++)
+			dst[i].Set(FloatToUnorm8(src[i].r), FloatToUnorm8(src[i].g), FloatToUnorm8(src[i].b), FloatToUnorm8(src[i].a));
+	}
+
+	static void PremultiplyAlphaScalar(Coloru8* pixels, const size_t count) noexcept
+	{
+		for (size_t i = 0u; i < count; i++) {
+			const uint32_t a = pixels[i].a;
+
+			for (size_t c = 0u; c < 3u; c++) {
+				const uint32_t t = pixels[i].m_arr[c] * a + 128u;
+				pixels[i].m_arr[c] = static_cast<uint8_t>((t + (t >> 8u)) >> 8u);
+			}
+		}
+	}
+
+	static void PremultiplyAlphaScalar(Colorf32* pixels, const size_t count) noexcept
+	{
+		for (size_t i = 0u; i < count; i++)
+			pixels[i].Set(pixels[i].r * pixels[i].a, pixels[i].g * pixels[i].a, pixels[i].b * pixels[i].a, pixels[i].a);
+	}
+
+	static void UnpremultiplyAlphaScalar(Coloru8* pixels, const size_t count) noexcept
+	{
+		const std::array<float, 256u>& table = GetUnpremultiplyTable();
+
+		for (size_t i = 0u; i < count; i++) {
+			const float factor = table[pixels[i].a];
+
+			for (size_t c = 0u; c < 3u; c++)
+				pixels[i].m_arr[c] = static_cast<uint8_t>(std::min(pixels[i].m_arr[c] * factor + 0.5f, 255.f));
+		}
+	}
+
+	static void UnpremultiplyAlphaScalar(Colorf32* pixels, const size_t count) noexcept
+	{
+		for (size_t i = 0u; i < count; i++) {
+			const float factor = (pixels[i].a > 0.f) ? (1.f / pixels[i].a) : 0.f;
+
+			pixels[i].Set(pixels[i].r * factor, pixels[i].g * factor, pixels[i].b * factor, pixels[i].a);
+		}
+	}
+
+	static void SwizzleRGBAToBGRAScalar(Coloru8* pixels, const size_t count) noexcept
+	{
+		for (size_t i = 0u; i < count; i++)
+			std::swap(pixels[i].r, pixels[i].b);
+	}
+
+	// ---------- SIMD Kernels ---------- //
+	/*
+	 * Every kernel processes 4 pixels (16 bytes of RGBA8) per iteration and returns
+	 * the number of pixels it handled so that the scalar kernel can finish the tail
+	 */
+
+#ifndef __WEISS__DISABLE_SIMD
+
+	static inline __m128 LinearToSRGBSIMD(__m128 c) noexcept
+	{
+		c = _mm_min_ps(_mm_max_ps(c, _mm_setzero_ps()), _mm_set1_ps(1.f));
+
+		const __m128 s1 = _mm_sqrt_ps(c);
+		const __m128 s2 = _mm_sqrt_ps(s1);
+		const __m128 s3 = _mm_sqrt_ps(s2);
+
+		const __m128 curve  = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(0.585122381f), s1),
+		                                            _mm_mul_ps(_mm_set1_ps(0.783140355f), s2)),
+		                                 _mm_mul_ps(_mm_set1_ps(0.368262736f), s3));
+		const __m128 linear = _mm_mul_ps(c, _mm_set1_ps(12.92f));
+		const __m128 mask   = _mm_cmple_ps(c, _mm_set1_ps(0.0031308f));
+
+		return _mm_or_ps(_mm_and_ps(mask, linear), _mm_andnot_ps(mask, curve));
+	}
+
+	// Scales [0, 1] floats to [0, 255] and rounds them to 32 bit integers
+	static inline __m128i FloatToUnorm8SIMD(const __m128 c) noexcept
+	{
+		const __m128 clamped = _mm_min_ps(_mm_max_ps(c, _mm_setzero_ps()), _mm_set1_ps(1.f));
+
+		return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(clamped, _mm_set1_ps(255.f)), _mm_set1_ps(0.5f)));
+	}
+
+	static inline void StorePackedPixels(Coloru8* dst, const __m128i p0, const __m128i p1, const __m128i p2, const __m128i p3) noexcept
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3)));
+	}
+
+	static inline __m128 GetAlphaLaneMask() noexcept
+	{
+		return _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+	}
+
+	static size_t LinearToSRGBSIMD(const Colorf32* src, Coloru8* dst, const size_t count) noexcept
+	{
+		const __m128 alphaMask = GetAlphaLaneMask();
+
+		size_t i = 0u;
+		for (; i + 4u <= count; i += 4u) {
+			__m128i packed[4u];
+
+			for (size_t p = 0u; p < 4u; p++) {
+				const __m128 linear = src[i + p].m_sseVector;
+				const __m128 srgb   = _mm_or_ps(_mm_and_ps(alphaMask, linear), _mm_andnot_ps(alphaMask, LinearToSRGBSIMD(linear)));
+
+				packed[p] = FloatToUnorm8SIMD(srgb);
+			}
+
+			StorePackedPixels(dst + i, packed[0], packed[1], packed[2], packed[3]);
+		}
+
+		return i;
+	}
+
+#ifdef __WEISS__RUNTIME_DISPATCH
+
+	// 4 pixels are loaded at once & widened to table indices, alpha offset into the table's second half : a gather per 2 pixels
+	WS_TARGET("avx2")
+	static size_t SRGBToLinearAVX2(const Coloru8* src, Colorf32* dst, const size_t count, const float* table) noexcept
+	{
+		const __m256i alphaOffset = _mm256_setr_epi32(0, 0, 0, 256, 0, 0, 0, 256);
+
+		size_t i = 0u;
+		for (; i + 4u <= count; i += 4u) {
+			const __m128i bytes    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			const __m256i indices0 = _mm256_add_epi32(_mm256_cvtepu8_epi32(bytes), alphaOffset);
+			const __m256i indices1 = _mm256_add_epi32(_mm256_cvtepu8_epi32(_mm_unpackhi_epi64(bytes, bytes)), alphaOffset);
+
+			_mm256_storeu_ps(reinterpret_cast<float*>(dst + i),      _mm256_i32gather_ps(table, indices0, 4));
+			_mm256_storeu_ps(reinterpret_cast<float*>(dst + i + 2u), _mm256_i32gather_ps(table, indices1, 4));
+		}
+
+		return i;
+	}
+
+	[[nodiscard]] static bool HasAVX2() noexcept
+	{
+		static const bool s_bAVX2 = HasCpuFeature(CpuFeature::AVX2);
+
+		return s_bAVX2;
+	}
+
+#endif // __WEISS__RUNTIME_DISPATCH
+
+	static size_t SRGBToLinearSIMD(const Coloru8* src, Colorf32* dst, const size_t count) noexcept
+	{
+#ifdef __WEISS__RUNTIME_DISPATCH
+
+		if (HasAVX2())
+			return SRGBToLinearAVX2(src, dst, count, GetSRGBToLinearTable().data());
+
+#endif // __WEISS__RUNTIME_DISPATCH
+
+		// SSE2 has no gather : the scalar kernel's 4 lookups per pixel beat assembling every pixel in a register
+		return 0u;
+	}
+
+	static size_t ConvertColorsSIMD(const Coloru8* src, Colorf32* dst, const size_t count) noexcept
+	{
+		const __m128i zero  = _mm_setzero_si128();
+		const __m128  scale = _mm_set1_ps(1.f / 255.f);
+
+		size_t i = 0u;
+		for (; i + 4u <= count; i += 4u) {
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			const __m128i lo    = _mm_unpacklo_epi8(bytes, zero);
+			const __m128i hi    = _mm_unpackhi_epi8(bytes, zero);
+
+			dst[i + 0u].m_sseVector = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale);
+			dst[i + 1u].m_sseVector = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale);
+			dst[i + 2u].m_sseVector = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale);
+			dst[i + 3u].m_sseVector = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale);
+		}
+
+		return i;
+	}
+
+	static size_t ConvertColorsSIMD(const Colorf32* src, Coloru8* dst, const size_t count) noexcept
+	{
+		size_t i = 0u;
+		for (; i + 4u <= count; i += 4u) {
+			StorePackedPixels(dst + i, FloatToUnorm8SIMD(src[i + 0u].m_sseVector), FloatToUnorm8SIMD(src[i + 1u].m_sseVector),
+			                           FloatToUnorm8SIMD(src[i + 2u].m_sseVector), FloatToUnorm8SIMD(src[i + 3u].m_sseVector));
+		}
+
+		return i;
+	}
+
+	// Computes (c * m + 128 + ((c * m + 128) >> 8)) >> 8 on 16 bit lanes which is round(c * m / 255) for c, m <= 255
+	static inline __m128i MulDiv255Epu16(const __m128i c, const __m128i m) noexcept
+	{
+		const __m128i t = _mm_add_epi16(_mm_mullo_epi16(c, m), _mm_set1_epi16(128));
+
+		return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+	}
+
+	// Broadcasts the alpha of both pixels held in 16 bit lanes and replaces the alpha lanes' factor by 255
+	static inline __m128i GetPremultiplyFactors(const __m128i pixels16) noexcept
+	{
+		const __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+
+		return _mm_or_si128(_mm_and_si128(alpha, _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1)), _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0));
+	}
+
+	static size_t PremultiplyAlphaSIMD(Coloru8* pixels, const size_t count) noexcept
+	{
+		const __m128i zero = _mm_setzero_si128();
+
+		size_t i = 0u;
+		for (; i + 4u <= count; i += 4u) {
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+			const __m128i lo    = _mm_unpacklo_epi8(bytes, zero);
+			const __m128i hi    = _mm_unpackhi_epi8(bytes, zero);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i),
+			                 _mm_packus_epi16(MulDiv255Epu16(lo, GetPremultiplyFactors(lo)), MulDiv255Epu16(hi, GetPremultiplyFactors(hi))));
+		}
+
+		return i;
+	}
+
+	static size_t PremultiplyAlphaSIMD(Colorf32* pixels, const size_t count) noexcept
+	{
+		const __m128 alphaMask = GetAlphaLaneMask();
+		const __m128 one       = _mm_set1_ps(1.f);
+
+		for (size_t i = 0u; i < count; i++) {
+			const __m128 c      = pixels[i].m_sseVector;
+			const __m128 alpha  = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+			const __m128 factor = _mm_or_ps(_mm_andnot_ps(alphaMask, alpha), _mm_and_ps(alphaMask, one));
+
+			pixels[i].m_sseVector = _mm_mul_ps(c, factor);
+		}
+
+		return count;
+	}
+
+	static size_t UnpremultiplyAlphaSIMD(Coloru8* pixels, const size_t count) noexcept
+	{
+		const std::array<float, 256u>& table = GetUnpremultiplyTable();
+
+		const __m128i zero      = _mm_setzero_si128();
+		const __m128  alphaMask = GetAlphaLaneMask();
+		const __m128  one       = _mm_set1_ps(1.f);
+		const __m128  half      = _mm_set1_ps(0.5f);
+		const __m128  max       = _mm_set1_ps(255.f);
+
+		size_t i = 0u;
+		for (; i + 4u <= count; i += 4u) {
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+			const __m128i lo    = _mm_unpacklo_epi8(bytes, zero);
+			const __m128i hi    = _mm_unpackhi_epi8(bytes, zero);
+			const __m128i words[4u] = { _mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero),
+			                            _mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero) };
+
+			__m128i packed[4u];
+			for (size_t p = 0u; p < 4u; p++) {
+				const __m128 factor = _mm_or_ps(_mm_andnot_ps(alphaMask, _mm_set1_ps(table[pixels[i + p].a])), _mm_and_ps(alphaMask, one));
+				const __m128 result = _mm_min_ps(_mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(words[p]), factor), half), max);
+
+				packed[p] = _mm_cvttps_epi32(result);
+			}
+
+			StorePackedPixels(pixels + i, packed[0], packed[1], packed[2], packed[3]);
+		}
+
+		return i;
+	}
+
+	static size_t UnpremultiplyAlphaSIMD(Colorf32* pixels, const size_t count) noexcept
+	{
+		const __m128 alphaMask = GetAlphaLaneMask();
+		const __m128 one       = _mm_set1_ps(1.f);
+
+		for (size_t i = 0u; i < count; i++) {
+			const __m128 c       = pixels[i].m_sseVector;
+			const __m128 alpha   = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+			const __m128 nonZero = _mm_cmpgt_ps(alpha, _mm_setzero_ps());
+			const __m128 inverse = _mm_and_ps(nonZero, _mm_div_ps(one, alpha));
+			const __m128 factor  = _mm_or_ps(_mm_andnot_ps(alphaMask, inverse), _mm_and_ps(alphaMask, one));
+
+			pixels[i].m_sseVector = _mm_mul_ps(c, factor);
+		}
+
+		return count;
+	}
+
+	static size_t SwizzleRGBAToBGRASIMD(Coloru8* pixels, const size_t count) noexcept
+	{
+#ifdef __SSSE3__
+		const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+#else
+		const __m128i agMask = _mm_set1_epi32(0xFF00FF00);
+#endif // __SSSE3__
+
+		size_t i = 0u;
+		for (; i + 4u <= count; i += 4u) {
+			const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+
+#ifdef __SSSE3__
+			const __m128i swizzled = _mm_shuffle_epi8(bytes, shuffle);
+#else
+			// r and b sit 16 bits apart in every 32 bit pixel : rotating the rb pair by 16 swaps them
+			const __m128i rb       = _mm_andnot_si128(agMask, bytes);
+			const __m128i swizzled = _mm_or_si128(_mm_and_si128(agMask, bytes),
+			                                      _mm_or_si128(_mm_slli_epi32(rb, 16), _mm_srli_epi32(rb, 16)));
+#endif // __SSSE3__
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), swizzled);
+		}
+
+		return i;
+	}
+
+#endif // #ifndef __WEISS__DISABLE_SIMD
+
+	/*
+	 * Runs "simdKernel" then "scalarKernel" on the pixels the SIMD kernel left over,
+	 * for every chunk of the span handed out by WS::ParallelFor
+	 */
+#ifndef __WEISS__DISABLE_SIMD
+	#define WS_DISPATCH_COLOR_KERNEL(simdKernel, scalarKernel, count, srcArg, dstArg)                                   \
+		WS::ParallelFor(count, WS_COLOR_SPACE_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {           \
+			const size_t handled = simdKernel(srcArg + begin, dstArg + begin, end - begin);                             \
+			scalarKernel(srcArg + begin + handled, dstArg + begin + handled, end - begin - handled);                    \
+		})
+	#define WS_DISPATCH_COLOR_KERNEL_INPLACE(simdKernel, scalarKernel, count, pixelsArg)                                \
+		WS::ParallelFor(count, WS_COLOR_SPACE_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {           \
+			const size_t handled = simdKernel(pixelsArg + begin, end - begin);                                          \
+			scalarKernel(pixelsArg + begin + handled, end - begin - handled);                                           \
+		})
+#else
+	#define WS_DISPATCH_COLOR_KERNEL(simdKernel, scalarKernel, count, srcArg, dstArg)                                   \
+		WS::ParallelFor(count, WS_COLOR_SPACE_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {           \
+			scalarKernel(srcArg + begin, dstArg + begin, end - begin);                                                  \
+		})
+	#define WS_DISPATCH_COLOR_KERNEL_INPLACE(simdKernel, scalarKernel, count, pixelsArg)                                \
+		WS::ParallelFor(count, WS_COLOR_SPACE_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {           \
+			scalarKernel(pixelsArg + begin, end - begin);                                                               \
+		})
+#endif // #ifndef __WEISS__DISABLE_SIMD
+
+	void SRGBToLinear(const Coloru8* src, Colorf32* dst, const size_t count) noexcept
+	{
+		WS_DISPATCH_COLOR_KERNEL(SRGBToLinearSIMD, SRGBToLinearScalar, count, src, dst);
+	}
+
+	void LinearToSRGB(const Colorf32* src, Coloru8* dst, const size_t count) noexcept
+	{
+		WS_DISPATCH_COLOR_KERNEL(LinearToSRGBSIMD, LinearToSRGBScalar, count, src, dst);
+	}
+
+	void ConvertColors(const Coloru8* src, Colorf32* dst, const size_t count) noexcept
+	{
+		WS_DISPATCH_COLOR_KERNEL(ConvertColorsSIMD, ConvertColorsScalar, count, src, dst);
+	}
+
+	void ConvertColors(const Colorf32* src, Coloru8* dst, const size_t count) noexcept
+	{
+		WS_DISPATCH_COLOR_KERNEL(ConvertColorsSIMD, ConvertColorsScalar, count, src, dst);
+	}
+
+	void PremultiplyAlpha(Coloru8* pixels, const size_t count) noexcept
+	{
+		WS_DISPATCH_COLOR_KERNEL_INPLACE(PremultiplyAlphaSIMD, PremultiplyAlphaScalar, count, pixels);
+	}
+
+	void PremultiplyAlpha(Colorf32* pixels, const size_t count) noexcept
+	{
+		WS_DISPATCH_COLOR_KERNEL_INPLACE(PremultiplyAlphaSIMD, PremultiplyAlphaScalar, count, pixels);
+	}
+
+	void UnpremultiplyAlpha(Coloru8* pixels, const size_t count) noexcept
+	{
+		WS_DISPATCH_COLOR_KERNEL_INPLACE(UnpremultiplyAlphaSIMD, UnpremultiplyAlphaScalar, count, pixels);
+	}
+
+	void UnpremultiplyAlpha(Colorf32* pixels, const size_t count) noexcept
+	{
+		WS_DISPATCH_COLOR_KERNEL_INPLACE(UnpremultiplyAlphaSIMD, UnpremultiplyAlphaScalar, count, pixels);
+	}
+
+	void SwizzleRGBAToBGRA(Coloru8* pixels, const size_t count) noexcept
+	{
+		WS_DISPATCH_COLOR_KERNEL_INPLACE(SwizzleRGBAToBGRASIMD, SwizzleRGBAToBGRAScalar, count, pixels);
+	}
+
+#undef WS_DISPATCH_COLOR_KERNEL
+#undef WS_DISPATCH_COLOR_KERNEL_INPLACE
+
+	void SRGBToLinear(const Image& image, Colorf32* dst) noexcept
+	{
+		WS::SRGBToLinear(image.GetBuffer(), dst, image.GetPixelCount());
+	}
+
+	void LinearToSRGB(const Colorf32* src, Image& image) noexcept
+	{
+		WS::LinearToSRGB(src, image.GetBuffer(), image.GetPixelCount());
+	}
+
+	void PremultiplyAlpha(Image& image) noexcept
+	{
+		WS::PremultiplyAlpha(image.GetBuffer(), image.GetPixelCount());
+	}
+
+	void UnpremultiplyAlpha(Image& image) noexcept
+	{
+		WS::UnpremultiplyAlpha(image.GetBuffer(), image.GetPixelCount());
+	}
+
+	void SwizzleRGBAToBGRA(Image& image) noexcept
+	{
+		WS::SwizzleRGBAToBGRA(image.GetBuffer(), image.GetPixelCount());
+	}
+
+}; // WS
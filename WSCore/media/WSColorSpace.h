@@ -0,0 +1,55 @@
+#pragma once
+
+#include "WSImage.h"
+#include "../misc/WSPch.h"
+#include "../math/WSVector.h"
+
+namespace WS {
+
+	/*
+	 * Bulk pixel converters over spans of "Coloru8" (RGBA8) and "Colorf32" (RGBA32F).
+	 * Alpha is always linear : only the r, g, b channels go through the sRGB transfer function.
+	 * Every span function splits its work across threads once "count" reaches WS_COLOR_SPACE_PARALLEL_THRESHOLD.
+	 * "src" and "dst" spans must not overlap unless the function works in place.
+	 */
+
+	// Number of pixels from which conversions are multithreaded
+	constexpr const size_t WS_COLOR_SPACE_PARALLEL_THRESHOLD = 1u << 16u;
+
+	// sRGB encoded RGBA8 -> linear RGBA32F (lookup table, gathered 2 pixels at a time with AVX2 when the CPU has it)
+	void SRGBToLinear(const Coloru8* src, Colorf32* dst, const size_t count) noexcept;
+
+	// Linear RGBA32F -> sRGB encoded RGBA8 (piecewise sRGB curve, its power segment fitted on sqrt(x), x^(1/4) & x^(1/8) :
+	// within 0.41 / 255 of the exact curve before rounding, so rounded channels are at most one level off)
+	void LinearToSRGB(const Colorf32* src, Coloru8* dst, const size_t count) noexcept;
+
+	// RGBA8 -> RGBA32F in [0, 1] without any transfer function
+	void ConvertColors(const Coloru8* src, Colorf32* dst, const size_t count) noexcept;
+
+	// RGBA32F -> RGBA8, values are clamped to [0, 1] and rounded
+	void ConvertColors(const Colorf32* src, Coloru8* dst, const size_t count) noexcept;
+
+	// In place : (r, g, b, a) -> (r * a, g * a, b * a, a)
+	void PremultiplyAlpha(Coloru8*  pixels, const size_t count) noexcept;
+	void PremultiplyAlpha(Colorf32* pixels, const size_t count) noexcept;
+
+	// In place : (r, g, b, a) -> (r / a, g / a, b / a, a), fully transparent pixels become (0, 0, 0, 0)
+	void UnpremultiplyAlpha(Coloru8*  pixels, const size_t count) noexcept;
+	void UnpremultiplyAlpha(Colorf32* pixels, const size_t count) noexcept;
+
+	// In place : RGBA <-> BGRA (the swap is its own inverse)
+	void SwizzleRGBAToBGRA(Coloru8* pixels, const size_t count) noexcept;
+
+	// Whole Image Helpers
+
+	// "dst" must hold at least image.GetPixelCount() colors
+	void SRGBToLinear(const Image& image, Colorf32* dst) noexcept;
+
+	// "src" must hold at least image.GetPixelCount() colors
+	void LinearToSRGB(const Colorf32* src, Image& image) noexcept;
+
+	void PremultiplyAlpha(Image& image)   noexcept;
+	void UnpremultiplyAlpha(Image& image) noexcept;
+	void SwizzleRGBAToBGRA(Image& image)  noexcept;
+
+}; // WS
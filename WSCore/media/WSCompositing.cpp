@@ -0,0 +1,304 @@
+#include "WSCompositing.h"
+#include "../misc/WSParallel.h"
+
+namespace WS {
+
+	// ---------- Scalar Kernels (Tails & __WEISS__DISABLE_SIMD) ---------- //
+	/*
+	 * The RGBA8 scalar kernels round exactly like the SIMD ones so that
+	 * a pixel's result doesn't depend on where it lands in a span
+	 */
+
+	// round(c * m / 255) for c, m <= 255
+	static inline uint32_t MulDiv255(const uint32_t c, const uint32_t m) noexcept
+	{
+		const uint32_t t = c * m + 128u;
+
+		return (t + (t >> 8u)) >> 8u;
+	}
+
+	template <BlendMode _M>
+	static inline uint8_t BlendChannel(const uint32_t s, const uint32_t d, const uint32_t sa, const uint32_t da) noexcept
+	{
+		if constexpr (_M == BlendMode::SOURCE_OVER)
+			return static_cast<uint8_t>(std::min(s + MulDiv255(d, 255u - sa), 255u));
+		else if constexpr (_M == BlendMode::ADDITIVE)
+			return static_cast<uint8_t>(std::min(s + d, 255u));
+		else if constexpr (_M == BlendMode::MULTIPLY)
+			return static_cast<uint8_t>(std::min(MulDiv255(s, d) + MulDiv255(s, 255u - da) + MulDiv255(d, 255u - sa), 255u));
+		else
+			return static_cast<uint8_t>(std::min(s + d - MulDiv255(s, d), 255u));
+	}
+
+	template <BlendMode _M, bool _bOpacity>
+	static void BlendColorsScalar(const Coloru8* src, Coloru8* dst, const size_t count, const uint8_t opacity) noexcept
+	{
+		for (size_t i = 0u; i < count; i++) {
+			Coloru8 s = src[i];
+			if constexpr (_bOpacity) {
+				for (size_t c = 0u; c < 4u; c++)
+					s.m_arr[c] = static_cast<uint8_t>(MulDiv255(s.m_arr[c], opacity));
+			}
+
+			const uint32_t sa = s.a;
+			const uint32_t da = dst[i].a;
+
+			for (size_t c = 0u; c < 4u; c++)
+				dst[i].m_arr[c] = BlendChannel<_M>(s.m_arr[c], dst[i].m_arr[c], sa, da);
+		}
+	}
+
+	template <BlendMode _M, bool _bOpacity>
+	static void BlendColorsScalar(const Colorf32* src, Colorf32* dst, const size_t count, const float opacity) noexcept
+	{
+		for (size_t i = 0u; i < count; i++) {
+			const float sa = _bOpacity ? src[i].a * opacity : src[i].a;
+			const float da = dst[i].a;
+
+			for (size_t c = 0u; c < 4u; c++) {
+				const float s = _bOpacity ? src[i].m_arr[c] * opacity : src[i].m_arr[c];
+				const float d = dst[i].m_arr[c];
+
+				if constexpr (_M == BlendMode::SOURCE_OVER)
+					dst[i].m_arr[c] = s + d * (1.f - sa);
+				else if constexpr (_M == BlendMode::ADDITIVE)
+					dst[i].m_arr[c] = (c == 3u) ? std::min(s + d, 1.f) : s + d;
+				else if constexpr (_M == BlendMode::MULTIPLY)
+					dst[i].m_arr[c] = s * d + s * (1.f - da) + d * (1.f - sa);
+				else
+					dst[i].m_arr[c] = s + d - s * d;
+			}
+		}
+	}
+
+	// ---------- SIMD Kernels ---------- //
+	/*
+	 * RGBA8 kernels blend 4 pixels per iteration in 16 bit lanes, float kernels blend one pixel per register.
+	 * Every kernel returns the number of pixels it handled so that the scalar kernel can finish the tail.
+	 */
+
+#ifndef __WEISS__DISABLE_SIMD
+
+	// Computes (c * m + 128 + ((c * m + 128) >> 8)) >> 8 on 16 bit lanes which is round(c * m / 255) for c, m <= 255
+	static inline __m128i MulDiv255Epu16(const __m128i c, const __m128i m) noexcept
+	{
+		const __m128i t = _mm_add_epi16(_mm_mullo_epi16(c, m), _mm_set1_epi16(128));
+
+		return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+	}
+
+	// Broadcasts the alpha of both pixels held in 16 bit lanes to their 4 lanes
+	static inline __m128i BroadcastAlphaEpu16(const __m128i pixels16) noexcept
+	{
+		return _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+	}
+
+	// Blends two pixels held in 16 bit lanes, the result may exceed 255 and is saturated when packed
+	template <BlendMode _M>
+	static inline __m128i BlendEpu16(const __m128i s, const __m128i d) noexcept
+	{
+		const __m128i max = _mm_set1_epi16(255);
+
+		if constexpr (_M == BlendMode::SOURCE_OVER) {
+			return _mm_add_epi16(s, MulDiv255Epu16(d, _mm_sub_epi16(max, BroadcastAlphaEpu16(s))));
+		} else if constexpr (_M == BlendMode::MULTIPLY) {
+			const __m128i sd = MulDiv255Epu16(s, d);
+			const __m128i s1 = MulDiv255Epu16(s, _mm_sub_epi16(max, BroadcastAlphaEpu16(d)));
+			const __m128i d1 = MulDiv255Epu16(d, _mm_sub_epi16(max, BroadcastAlphaEpu16(s)));
+
+			return _mm_add_epi16(_mm_add_epi16(sd, s1), d1);
+		} else {
+			return _mm_sub_epi16(_mm_add_epi16(s, d), MulDiv255Epu16(s, d));
+		}
+	}
+
+	template <BlendMode _M, bool _bOpacity>
+	static size_t BlendColorsSIMD(const Coloru8* src, Coloru8* dst, const size_t count, const uint8_t opacity) noexcept
+	{
+		const __m128i zero       = _mm_setzero_si128();
+		const __m128i opacity16  = _mm_set1_epi16(opacity);
+		const __m128i alphaBytes = _mm_set1_epi32(static_cast<int32_t>(0xFF000000u));
+
+		size_t i = 0u;
+		for (; i + 4u <= count; i += 4u) {
+			__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+			if constexpr (_bOpacity)
+				s = _mm_packus_epi16(MulDiv255Epu16(_mm_unpacklo_epi8(s, zero), opacity16),
+				                     MulDiv255Epu16(_mm_unpackhi_epi8(s, zero), opacity16));
+
+			if constexpr (_M == BlendMode::SOURCE_OVER) {
+				// Runs of fully opaque or fully transparent pixels (typical of UI layers) don't need any math
+				if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(s, alphaBytes), alphaBytes)) == 0xFFFF) {
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), s);
+					continue;
+				}
+
+				if (_mm_movemask_epi8(_mm_cmpeq_epi8(s, zero)) == 0xFFFF)
+					continue;
+			}
+
+			const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+
+			if constexpr (_M == BlendMode::ADDITIVE) {
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_adds_epu8(s, d));
+			} else {
+				const __m128i lo = BlendEpu16<_M>(_mm_unpacklo_epi8(s, zero), _mm_unpacklo_epi8(d, zero));
+				const __m128i hi = BlendEpu16<_M>(_mm_unpackhi_epi8(s, zero), _mm_unpackhi_epi8(d, zero));
+
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+			}
+		}
+
+		return i;
+	}
+
+	template <BlendMode _M, bool _bOpacity>
+	static size_t BlendColorsSIMD(const Colorf32* src, Colorf32* dst, const size_t count, const float opacity) noexcept
+	{
+		const __m128 one      = _mm_set1_ps(1.f);
+		const __m128 opacity4 = _mm_set1_ps(opacity);
+		const __m128 limit    = _mm_set_ps(1.f, INFINITY, INFINITY, INFINITY); // Only the alpha channel is clamped
+
+		for (size_t i = 0u; i < count; i++) {
+			__m128 s = src[i].m_sseVector;
+			if constexpr (_bOpacity)
+				s = _mm_mul_ps(s, opacity4);
+
+			const __m128 d  = dst[i].m_sseVector;
+			const __m128 sa = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 3));
+
+			if constexpr (_M == BlendMode::SOURCE_OVER) {
+				dst[i].m_sseVector = _mm_add_ps(s, _mm_mul_ps(d, _mm_sub_ps(one, sa)));
+			} else if constexpr (_M == BlendMode::ADDITIVE) {
+				dst[i].m_sseVector = _mm_min_ps(_mm_add_ps(s, d), limit);
+			} else if constexpr (_M == BlendMode::MULTIPLY) {
+				const __m128 da = _mm_shuffle_ps(d, d, _MM_SHUFFLE(3, 3, 3, 3));
+
+				dst[i].m_sseVector = _mm_add_ps(_mm_add_ps(_mm_mul_ps(s, d), _mm_mul_ps(s, _mm_sub_ps(one, da))),
+				                                _mm_mul_ps(d, _mm_sub_ps(one, sa)));
+			} else {
+				dst[i].m_sseVector = _mm_sub_ps(_mm_add_ps(s, d), _mm_mul_ps(s, d));
+			}
+		}
+
+		return count;
+	}
+
+#endif // #ifndef __WEISS__DISABLE_SIMD
+
+	// ---------- Kernel Selection ---------- //
+
+	template <typename _C, typename _O>
+	using BlendKernel = void (*)(const _C*, _C*, const size_t, const _O);
+
+	template <BlendMode _M, bool _bOpacity, typename _C, typename _O>
+	static void BlendColorsKernel(const _C* src, _C* dst, const size_t count, const _O opacity) noexcept
+	{
+#ifndef __WEISS__DISABLE_SIMD
+		const size_t handled = BlendColorsSIMD<_M, _bOpacity>(src, dst, count, opacity);
+#else
+		const size_t handled = 0u;
+#endif // #ifndef __WEISS__DISABLE_SIMD
+
+		BlendColorsScalar<_M, _bOpacity>(src + handled, dst + handled, count - handled, opacity);
+	}
+
+	// Resolves the blend mode & the opacity path once instead of once per pixel
+	template <typename _C, typename _O>
+	static BlendKernel<_C, _O> GetBlendKernel(const BlendMode mode, const bool bOpaque) noexcept
+	{
+		switch (mode) {
+		case BlendMode::SOURCE_OVER: return bOpaque ? &BlendColorsKernel<BlendMode::SOURCE_OVER, false, _C, _O> : &BlendColorsKernel<BlendMode::SOURCE_OVER, true, _C, _O>;
+		case BlendMode::ADDITIVE:    return bOpaque ? &BlendColorsKernel<BlendMode::ADDITIVE,    false, _C, _O> : &BlendColorsKernel<BlendMode::ADDITIVE,    true, _C, _O>;
+		case BlendMode::MULTIPLY:    return bOpaque ? &BlendColorsKernel<BlendMode::MULTIPLY,    false, _C, _O> : &BlendColorsKernel<BlendMode::MULTIPLY,    true, _C, _O>;
+		case BlendMode::SCREEN:      return bOpaque ? &BlendColorsKernel<BlendMode::SCREEN,      false, _C, _O> : &BlendColorsKernel<BlendMode::SCREEN,      true, _C, _O>;
+		}
+
+		return nullptr;
+	}
+
+	// ---------- Spans & Layers ---------- //
+
+	template <typename _C, typename _O>
+	static void BlendSpan(const _C* src, _C* dst, const size_t count, const BlendKernel<_C, _O> kernel, const _O opacity) noexcept
+	{
+		WS::ParallelFor(count, WS_COMPOSITING_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {
+			kernel(src + begin, dst + begin, end - begin, opacity);
+		});
+	}
+
+	template <typename _C, typename _O>
+	static void CompositeLayer(const _C* src, const uint32_t srcWidth, const uint32_t srcHeight,
+	                           _C* dst, const uint32_t dstWidth, const uint32_t dstHeight,
+	                           const int32_t dstX, const int32_t dstY, const BlendKernel<_C, _O> kernel,
+	                           const _O opacity, const ImageRect* pClipRect) noexcept
+	{
+		// Destination space bounds of the blended area
+		int64_t x0 = std::max<int64_t>(dstX, 0);
+		int64_t y0 = std::max<int64_t>(dstY, 0);
+		int64_t x1 = std::min<int64_t>(static_cast<int64_t>(dstX) + srcWidth,  dstWidth);
+		int64_t y1 = std::min<int64_t>(static_cast<int64_t>(dstY) + srcHeight, dstHeight);
+
+		if (pClipRect != nullptr) {
+			x0 = std::max<int64_t>(x0, pClipRect->m_x);
+			y0 = std::max<int64_t>(y0, pClipRect->m_y);
+			x1 = std::min<int64_t>(x1, static_cast<int64_t>(pClipRect->m_x) + pClipRect->m_width);
+			y1 = std::min<int64_t>(y1, static_cast<int64_t>(pClipRect->m_y) + pClipRect->m_height);
+		}
+
+		if (x0 >= x1 || y0 >= y1)
+			return;
+
+		const size_t width = static_cast<size_t>(x1 - x0);
+		const size_t nRows = static_cast<size_t>(y1 - y0);
+
+		WS::ParallelFor(nRows, std::max<size_t>(1u, WS_COMPOSITING_PARALLEL_THRESHOLD / width), [&](const size_t begin, const size_t end) {
+			for (size_t row = begin; row < end; row++) {
+				const int64_t y = y0 + static_cast<int64_t>(row);
+
+				kernel(src + (y - dstY) * srcWidth + (x0 - dstX), dst + y * dstWidth + x0, width, opacity);
+			}
+		});
+	}
+
+	void BlendColors(const Coloru8* src, Coloru8* dst, const size_t count, const BlendMode mode, const uint8_t opacity) noexcept
+	{
+		if (opacity == 0u)
+			return;
+
+		WS::BlendSpan<Coloru8, uint8_t>(src, dst, count, WS::GetBlendKernel<Coloru8, uint8_t>(mode, opacity == 255u), opacity);
+	}
+
+	void BlendColors(const Colorf32* src, Colorf32* dst, const size_t count, const BlendMode mode, const float opacity) noexcept
+	{
+		if (opacity <= 0.f)
+			return;
+
+		WS::BlendSpan<Colorf32, float>(src, dst, count, WS::GetBlendKernel<Colorf32, float>(mode, opacity == 1.f), opacity);
+	}
+
+	void Composite(const Colorf32* src, const uint32_t srcWidth, const uint32_t srcHeight,
+	               Colorf32* dst, const uint32_t dstWidth, const uint32_t dstHeight,
+	               const int32_t dstX, const int32_t dstY, const BlendMode mode,
+	               const float opacity, const ImageRect* pClipRect) noexcept
+	{
+		if (opacity <= 0.f)
+			return;
+
+		WS::CompositeLayer<Colorf32, float>(src, srcWidth, srcHeight, dst, dstWidth, dstHeight, dstX, dstY,
+		                                    WS::GetBlendKernel<Colorf32, float>(mode, opacity == 1.f), opacity, pClipRect);
+	}
+
+	void Composite(const Image& src, Image& dst, const int32_t dstX, const int32_t dstY, const BlendMode mode,
+	               const uint8_t opacity, const ImageRect* pClipRect) noexcept
+	{
+		if (opacity == 0u)
+			return;
+
+		WS::CompositeLayer<Coloru8, uint8_t>(src.GetBuffer(), src.GetWidth(), src.GetHeight(),
+		                                     dst.GetBuffer(), dst.GetWidth(), dst.GetHeight(), dstX, dstY,
+		                                     WS::GetBlendKernel<Coloru8, uint8_t>(mode, opacity == 255u), opacity, pClipRect);
+	}
+
+}; // WS
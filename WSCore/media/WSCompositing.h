@@ -0,0 +1,56 @@
+#pragma once
+
+#include "WSImage.h"
+#include "../misc/WSPch.h"
+#include "../math/WSVector.h"
+
+namespace WS {
+
+	/*
+	 * Layer compositing over spans & images of premultiplied alpha colors.
+	 * Every mode is applied to all four channels (the alpha channel always ends up as sa + da - sa * da) :
+	 *
+	 * SOURCE_OVER : d = s + d * (1 - sa)
+	 * ADDITIVE    : d = min(s + d, 1)                         (float colors are only clamped in their alpha channel)
+	 * MULTIPLY    : d = s * d + s * (1 - da) + d * (1 - sa)
+	 * SCREEN      : d = s + d - s * d
+	 *
+	 * "opacity" scales the whole source color before blending, a fully opaque layer skips that step entirely.
+	 * Images are split into bands of rows blended on multiple threads once they reach WS_COMPOSITING_PARALLEL_THRESHOLD pixels.
+	 */
+
+	// Number of pixels from which image compositing is multithreaded
+	constexpr const size_t WS_COMPOSITING_PARALLEL_THRESHOLD = 1u << 16u;
+
+	enum class BlendMode : uint8_t {
+		SOURCE_OVER,
+		ADDITIVE,
+		MULTIPLY,
+		SCREEN
+	};
+
+	// A rectangle of pixels, i.e a clipping rectangle in destination coordinates
+	struct ImageRect {
+		int32_t  m_x      = 0;
+		int32_t  m_y      = 0;
+		uint32_t m_width  = 0u;
+		uint32_t m_height = 0u;
+	};
+
+	// Blends "count" colors of "src" onto "dst" (the spans must not overlap)
+	void BlendColors(const Coloru8*  src, Coloru8*  dst, const size_t count, const BlendMode mode, const uint8_t opacity = 255u) noexcept;
+	void BlendColors(const Colorf32* src, Colorf32* dst, const size_t count, const BlendMode mode, const float   opacity = 1.f)  noexcept;
+
+	/*
+	 * Blends the "srcWidth" x "srcHeight" layer "src" onto "dst" with its top left corner at (dstX, dstY).
+	 * The blended area is clipped to the destination and to "pClipRect" when there is one.
+	 */
+	void Composite(const Colorf32* src, const uint32_t srcWidth, const uint32_t srcHeight,
+	               Colorf32* dst, const uint32_t dstWidth, const uint32_t dstHeight,
+	               const int32_t dstX, const int32_t dstY, const BlendMode mode,
+	               const float opacity = 1.f, const ImageRect* pClipRect = nullptr) noexcept;
+
+	void Composite(const Image& src, Image& dst, const int32_t dstX, const int32_t dstY, const BlendMode mode,
+	               const uint8_t opacity = 255u, const ImageRect* pClipRect = nullptr) noexcept;
+
+}; // WS
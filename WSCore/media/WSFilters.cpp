@@ -0,0 +1,515 @@
+#include "WSFilters.h"
+#include "../misc/WSParallel.h"
+
+#define WS_FILTER_WEIGHT_SHIFT       14 // 2.14 fixed point weights
+#define WS_FILTER_INTERMEDIATE_SHIFT 5  // 11.5 fixed point intermediates
+
+namespace WS {
+
+	/*
+	 * Quantizes "weights" to fixed point and pads them to an even count so that
+	 * the SIMD kernels can always consume taps by pairs (the padding tap weighs 0).
+	 * The rounding error is folded into the center tap so that flat areas stay flat.
+	 */
+	static std::vector<int16_t> QuantizeWeights(const std::vector<float>& weights) noexcept
+	{
+		std::vector<int16_t> quantized(weights.size() + (weights.size() & 1u), 0);
+
+		float   sum          = 0.f;
+		int32_t quantizedSum = 0;
+		for (size_t i = 0u; i < weights.size(); i++) {
+			quantized[i]  = static_cast<int16_t>(std::lround(weights[i] * (1 << WS_FILTER_WEIGHT_SHIFT)));
+			sum          += weights[i];
+			quantizedSum += quantized[i];
+		}
+
+		const int32_t center = quantized[weights.size() / 2u] + static_cast<int32_t>(std::lround(sum * (1 << WS_FILTER_WEIGHT_SHIFT))) - quantizedSum;
+		quantized[weights.size() / 2u] = static_cast<int16_t>(std::clamp(center, -32768, 32767));
+
+		return quantized;
+	}
+
+	// ---------- Scalar Kernels (Tails & __WEISS__DISABLE_SIMD) ---------- //
+
+	// dst[x] = sum(weights[k] * src[x + k]) for "count" pixels, "src" holds count + nTaps - 1 pixels
+	static void ConvolveRowScalar(const Coloru8* src, int16_t* dst, const size_t count, const int16_t* weights, const size_t nTaps) noexcept
+	{
+		for (size_t x = 0u; x < count; x++) {
+			for (size_t c = 0u; c < 4u; c++) {
+				int32_t acc = 0;
+				for (size_t k = 0u; k < nTaps; k++)
+					acc += weights[k] * src[x + k].m_arr[c];
+
+				const int32_t value = (acc + (1 << (WS_FILTER_WEIGHT_SHIFT - WS_FILTER_INTERMEDIATE_SHIFT - 1))) >> (WS_FILTER_WEIGHT_SHIFT - WS_FILTER_INTERMEDIATE_SHIFT);
+				dst[x * 4u + c] = static_cast<int16_t>(std::clamp(value, -32768, 32767));
+			}
+		}
+	}
+
+	// dst[i] = sum(weights[k] * rows[k][i]) for "count" channel values
+	static void ConvolveColumnScalar(const int16_t* const* rows, uint8_t* dst, const size_t begin, const size_t count, const int16_t* weights, const size_t nTaps) noexcept
+	{
+		for (size_t i = begin; i < count; i++) {
+			int32_t acc = 0;
+			for (size_t k = 0u; k < nTaps; k++)
+				acc += weights[k] * rows[k][i];
+
+			const int32_t value = (acc + (1 << (WS_FILTER_WEIGHT_SHIFT + WS_FILTER_INTERMEDIATE_SHIFT - 1))) >> (WS_FILTER_WEIGHT_SHIFT + WS_FILTER_INTERMEDIATE_SHIFT);
+			dst[i] = static_cast<uint8_t>(std::clamp(value, 0, 255));
+		}
+	}
+
+#ifdef __WEISS__DISABLE_SIMD
+
+	// Running sum over a row, dst holds the averages in 8.8 fixed point (BoxRowSIMD handles whole rows, there is no tail)
+	static void BoxRowScalar(const Coloru8* src, uint16_t* dst, const int64_t width, const int64_t radius) noexcept
+	{
+		const float scale = 256.f / static_cast<float>(2 * radius + 1);
+
+		for (size_t c = 0u; c < 4u; c++) {
+			uint32_t sum = 0u;
+			for (int64_t k = -radius; k <= radius; k++)
+				sum += src[std::clamp<int64_t>(k, 0, width - 1)].m_arr[c];
+
+			for (int64_t x = 0; x < width; x++) {
+				dst[x * 4 + c] = static_cast<uint16_t>(std::lrint(static_cast<float>(sum) * scale));
+
+				sum += src[std::min(x + radius + 1, width - 1)].m_arr[c];
+				sum -= src[std::max<int64_t>(x - radius, 0)].m_arr[c];
+			}
+		}
+	}
+
+#endif // #ifdef __WEISS__DISABLE_SIMD
+
+	static void BoxColumnScalar(const uint32_t* sums, uint8_t* dst, const size_t begin, const size_t count, const float scale) noexcept
+	{
+		for (size_t i = begin; i < count; i++)
+			dst[i] = static_cast<uint8_t>(std::min(std::lrint(static_cast<float>(sums[i]) * scale), 255l));
+	}
+
+	static void SharpenScalar(const Coloru8* src, const Coloru8* blurred, Coloru8* dst, const size_t begin, const size_t count, const int16_t amount) noexcept
+	{
+		for (size_t i = begin; i < count; i++) {
+			for (size_t c = 0u; c < 3u; c++) {
+				const int32_t diff = src[i].m_arr[c] - blurred[i].m_arr[c];
+
+				dst[i].m_arr[c] = static_cast<uint8_t>(std::clamp((diff * amount + src[i].m_arr[c] * 256 + 128) >> 8, 0, 255));
+			}
+
+			dst[i].a = src[i].a;
+		}
+	}
+
+	// ---------- SIMD Kernels ---------- //
+	/*
+	 * Taps are consumed by pairs : two 16 bit sources interleaved with their two weights
+	 * make a single _mm_madd_epi16 produce a 32 bit partial sum per channel.
+	 * Every kernel returns the number of values it handled so that the scalar kernel can finish the tail.
+	 */
+
+#ifndef __WEISS__DISABLE_SIMD
+
+	static inline __m128i GetWeightPair(const int16_t* weights) noexcept
+	{
+		return _mm_set1_epi32(static_cast<int32_t>((static_cast<uint32_t>(static_cast<uint16_t>(weights[1])) << 16u) | static_cast<uint16_t>(weights[0])));
+	}
+
+	// 4 pixels per iteration, "nTaps" is even
+	static size_t ConvolveRowSIMD(const Coloru8* src, int16_t* dst, const size_t count, const int16_t* weights, const size_t nTaps) noexcept
+	{
+		const __m128i zero  = _mm_setzero_si128();
+		const __m128i round = _mm_set1_epi32(1 << (WS_FILTER_WEIGHT_SHIFT - WS_FILTER_INTERMEDIATE_SHIFT - 1));
+
+		size_t x = 0u;
+		for (; x + 4u <= count; x += 4u) {
+			__m128i acc[4u] = { zero, zero, zero, zero };
+
+			for (size_t k = 0u; k < nTaps; k += 2u) {
+				const __m128i w = GetWeightPair(weights + k);
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x + k));
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x + k + 1u));
+
+				const __m128i aLo = _mm_unpacklo_epi8(a, zero), aHi = _mm_unpackhi_epi8(a, zero);
+				const __m128i bLo = _mm_unpacklo_epi8(b, zero), bHi = _mm_unpackhi_epi8(b, zero);
+
+				acc[0u] = _mm_add_epi32(acc[0u], _mm_madd_epi16(_mm_unpacklo_epi16(aLo, bLo), w));
+				acc[1u] = _mm_add_epi32(acc[1u], _mm_madd_epi16(_mm_unpackhi_epi16(aLo, bLo), w));
+				acc[2u] = _mm_add_epi32(acc[2u], _mm_madd_epi16(_mm_unpacklo_epi16(aHi, bHi), w));
+				acc[3u] = _mm_add_epi32(acc[3u], _mm_madd_epi16(_mm_unpackhi_epi16(aHi, bHi), w));
+			}
+
+			for (size_t p = 0u; p < 4u; p++)
+				acc[p] = _mm_srai_epi32(_mm_add_epi32(acc[p], round), WS_FILTER_WEIGHT_SHIFT - WS_FILTER_INTERMEDIATE_SHIFT);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4u),      _mm_packs_epi32(acc[0u], acc[1u]));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x * 4u + 8u), _mm_packs_epi32(acc[2u], acc[3u]));
+		}
+
+		return x;
+	}
+
+	// 16 channel values (4 pixels) per iteration, "nTaps" is even
+	static size_t ConvolveColumnSIMD(const int16_t* const* rows, uint8_t* dst, const size_t count, const int16_t* weights, const size_t nTaps) noexcept
+	{
+		const __m128i zero  = _mm_setzero_si128();
+		const __m128i round = _mm_set1_epi32(1 << (WS_FILTER_WEIGHT_SHIFT + WS_FILTER_INTERMEDIATE_SHIFT - 1));
+
+		size_t i = 0u;
+		for (; i + 16u <= count; i += 16u) {
+			__m128i acc[4u] = { zero, zero, zero, zero };
+
+			for (size_t k = 0u; k < nTaps; k += 2u) {
+				const __m128i w  = GetWeightPair(weights + k);
+				const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k] + i));
+				const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k] + i + 8u));
+				const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k + 1u] + i));
+				const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[k + 1u] + i + 8u));
+
+				acc[0u] = _mm_add_epi32(acc[0u], _mm_madd_epi16(_mm_unpacklo_epi16(a0, b0), w));
+				acc[1u] = _mm_add_epi32(acc[1u], _mm_madd_epi16(_mm_unpackhi_epi16(a0, b0), w));
+				acc[2u] = _mm_add_epi32(acc[2u], _mm_madd_epi16(_mm_unpacklo_epi16(a1, b1), w));
+				acc[3u] = _mm_add_epi32(acc[3u], _mm_madd_epi16(_mm_unpackhi_epi16(a1, b1), w));
+			}
+
+			for (size_t p = 0u; p < 4u; p++)
+				acc[p] = _mm_srai_epi32(_mm_add_epi32(acc[p], round), WS_FILTER_WEIGHT_SHIFT + WS_FILTER_INTERMEDIATE_SHIFT);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+			                 _mm_packus_epi16(_mm_packs_epi32(acc[0u], acc[1u]), _mm_packs_epi32(acc[2u], acc[3u])));
+		}
+
+		return i;
+	}
+
+	// A pixel's 4 channel sums live in one register, the row is inherently serial
+	static void BoxRowSIMD(const Coloru8* src, uint16_t* dst, const int64_t width, const int64_t radius) noexcept
+	{
+		const __m128  scale = _mm_set1_ps(256.f / static_cast<float>(2 * radius + 1));
+		const __m128i zero  = _mm_setzero_si128();
+		const __m128i bias  = _mm_set1_epi32(32768);
+
+		const auto loadPixel = [&](const int64_t x) {
+			int32_t pixel;
+			std::memcpy(&pixel, src + x, sizeof(int32_t));
+
+			const __m128i p = _mm_cvtsi32_si128(pixel);
+
+			return _mm_unpacklo_epi16(_mm_unpacklo_epi8(p, zero), zero);
+		};
+
+		__m128i sum = zero;
+		for (int64_t k = -radius; k <= radius; k++)
+			sum = _mm_add_epi32(sum, loadPixel(std::clamp<int64_t>(k, 0, width - 1)));
+
+		for (int64_t x = 0; x < width; x++) {
+			// There is no unsigned 32 -> 16 bit saturating pack in SSE2, values are biased into the signed range instead
+			const __m128i average = _mm_sub_epi32(_mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(sum), scale)), bias);
+			const __m128i packed  = _mm_xor_si128(_mm_packs_epi32(average, average), _mm_set1_epi16(static_cast<int16_t>(0x8000)));
+
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x * 4), packed);
+
+			sum = _mm_add_epi32(sum, loadPixel(std::min(x + radius + 1, width - 1)));
+			sum = _mm_sub_epi32(sum, loadPixel(std::max<int64_t>(x - radius, 0)));
+		}
+	}
+
+	// 16 channel values per iteration
+	static size_t BoxColumnSIMD(const uint32_t* sums, uint8_t* dst, const size_t count, const float scale) noexcept
+	{
+		const __m128 scale4 = _mm_set1_ps(scale);
+
+		size_t i = 0u;
+		for (; i + 16u <= count; i += 16u) {
+			__m128i values[4u];
+			for (size_t p = 0u; p < 4u; p++)
+				values[p] = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(sums + i + p * 4u))), scale4));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+			                 _mm_packus_epi16(_mm_packs_epi32(values[0u], values[1u]), _mm_packs_epi32(values[2u], values[3u])));
+		}
+
+		return i;
+	}
+
+	// Running column sums : sums[i] += add[i] - sub[i]
+	static size_t UpdateColumnSumsSIMD(uint32_t* sums, const uint16_t* add, const uint16_t* sub, const size_t count) noexcept
+	{
+		const __m128i zero = _mm_setzero_si128();
+
+		size_t i = 0u;
+		for (; i + 8u <= count; i += 8u) {
+			const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(add + i));
+			const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sub + i));
+
+			__m128i* pLo = reinterpret_cast<__m128i*>(sums + i);
+			__m128i* pHi = reinterpret_cast<__m128i*>(sums + i + 4u);
+
+			_mm_storeu_si128(pLo, _mm_sub_epi32(_mm_add_epi32(_mm_loadu_si128(pLo), _mm_unpacklo_epi16(a, zero)), _mm_unpacklo_epi16(s, zero)));
+			_mm_storeu_si128(pHi, _mm_sub_epi32(_mm_add_epi32(_mm_loadu_si128(pHi), _mm_unpackhi_epi16(a, zero)), _mm_unpackhi_epi16(s, zero)));
+		}
+
+		return i;
+	}
+
+	// 4 pixels per iteration, computes (diff * amount + src * 256 + 128) >> 8 with a single madd per 2 pixels
+	static size_t SharpenSIMD(const Coloru8* src, const Coloru8* blurred, Coloru8* dst, const size_t count, const int16_t amount) noexcept
+	{
+		const __m128i zero    = _mm_setzero_si128();
+		const __m128i round   = _mm_set1_epi32(128);
+		const __m128i weights = _mm_set_epi16(256, 0, 256, amount, 256, amount, 256, amount); // The alpha channel is copied
+
+		size_t i = 0u;
+		for (; i + 4u <= count; i += 4u) {
+			const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blurred + i));
+
+			const __m128i sLo = _mm_unpacklo_epi8(s, zero), sHi = _mm_unpackhi_epi8(s, zero);
+			const __m128i dLo = _mm_sub_epi16(sLo, _mm_unpacklo_epi8(b, zero));
+			const __m128i dHi = _mm_sub_epi16(sHi, _mm_unpackhi_epi8(b, zero));
+
+			__m128i values[4u] = { _mm_madd_epi16(_mm_unpacklo_epi16(dLo, sLo), weights), _mm_madd_epi16(_mm_unpackhi_epi16(dLo, sLo), weights),
+			                       _mm_madd_epi16(_mm_unpacklo_epi16(dHi, sHi), weights), _mm_madd_epi16(_mm_unpackhi_epi16(dHi, sHi), weights) };
+
+			for (size_t p = 0u; p < 4u; p++)
+				values[p] = _mm_srai_epi32(_mm_add_epi32(values[p], round), 8);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+			                 _mm_packus_epi16(_mm_packs_epi32(values[0u], values[1u]), _mm_packs_epi32(values[2u], values[3u])));
+		}
+
+		return i;
+	}
+
+#endif // #ifndef __WEISS__DISABLE_SIMD
+
+	// ---------- Passes ---------- //
+
+	static void ConvolveRow(const Coloru8* src, int16_t* dst, const size_t count, const int16_t* weights, const size_t nTaps) noexcept
+	{
+#ifndef __WEISS__DISABLE_SIMD
+		const size_t handled = ConvolveRowSIMD(src, dst, count, weights, nTaps);
+#else
+		const size_t handled = 0u;
+#endif // #ifndef __WEISS__DISABLE_SIMD
+
+		ConvolveRowScalar(src + handled, dst + handled * 4u, count - handled, weights, nTaps);
+	}
+
+	static void ConvolveColumn(const int16_t* const* rows, uint8_t* dst, const size_t count, const int16_t* weights, const size_t nTaps) noexcept
+	{
+#ifndef __WEISS__DISABLE_SIMD
+		const size_t handled = ConvolveColumnSIMD(rows, dst, count, weights, nTaps);
+#else
+		const size_t handled = 0u;
+#endif // #ifndef __WEISS__DISABLE_SIMD
+
+		ConvolveColumnScalar(rows, dst, handled, count, weights, nTaps);
+	}
+
+	/*
+	 * Filters the output rows [y0, y1) tile by tile :
+	 * the horizontal pass fills (tile height + vertical taps - 1) intermediate rows of the tile,
+	 * which the vertical pass consumes while they're still in cache
+	 */
+	static void ConvolveBand(const Image& image, Image& result, const uint32_t y0, const uint32_t y1,
+	                         const std::vector<int16_t>& hWeights, const size_t hRadius,
+	                         const std::vector<int16_t>& vWeights, const size_t vRadius) noexcept
+	{
+		const int64_t width  = image.GetWidth();
+		const int64_t height = image.GetHeight();
+		const size_t  nRows  = WS_FILTER_TILE_HEIGHT + vWeights.size() - 1u;
+
+		std::vector<Coloru8>        segment(WS_FILTER_TILE_WIDTH + hWeights.size());
+		std::vector<int16_t>        intermediate(nRows * WS_FILTER_TILE_WIDTH * 4u);
+		std::vector<const int16_t*> rows(vWeights.size());
+
+		for (uint32_t tileY = y0; tileY < y1; tileY += WS_FILTER_TILE_HEIGHT) {
+			const uint32_t tileHeight = std::min(WS_FILTER_TILE_HEIGHT, y1 - tileY);
+
+			for (uint32_t tileX = 0u; tileX < width; tileX += WS_FILTER_TILE_WIDTH) {
+				const size_t tileWidth = std::min<size_t>(WS_FILTER_TILE_WIDTH, width - tileX);
+				const size_t nSegment  = tileWidth + hWeights.size() - 1u;
+
+				// Horizontal pass, source rows & columns are clamped to the image
+				for (size_t r = 0u; r < tileHeight + vWeights.size() - 1u; r++) {
+					const int64_t      y    = std::clamp<int64_t>(static_cast<int64_t>(tileY) + r - vRadius, 0, height - 1);
+					const Coloru8*     pRow = image.GetBuffer() + y * width;
+					const int64_t      x0   = static_cast<int64_t>(tileX) - hRadius;
+
+					for (size_t s = 0u; s < nSegment; s++)
+						segment[s] = pRow[std::clamp<int64_t>(x0 + s, 0, width - 1)];
+
+					WS::ConvolveRow(segment.data(), intermediate.data() + r * WS_FILTER_TILE_WIDTH * 4u, tileWidth, hWeights.data(), hWeights.size());
+				}
+
+				// Vertical pass
+				for (size_t r = 0u; r < tileHeight; r++) {
+					for (size_t k = 0u; k < vWeights.size(); k++)
+						rows[k] = intermediate.data() + (r + k) * WS_FILTER_TILE_WIDTH * 4u;
+
+					uint8_t* pDst = reinterpret_cast<uint8_t*>(result.GetBuffer() + (tileY + r) * width + tileX);
+					WS::ConvolveColumn(rows.data(), pDst, tileWidth * 4u, vWeights.data(), vWeights.size());
+				}
+			}
+		}
+	}
+
+	// Splits the image into bands of whole tile rows and filters them in parallel
+	template <typename _F>
+	static void ForEachBand(const Image& image, _F&& function) noexcept
+	{
+		const size_t nBands         = (image.GetHeight() + WS_FILTER_TILE_HEIGHT - 1u) / WS_FILTER_TILE_HEIGHT;
+		const size_t pixelsPerBand  = static_cast<size_t>(image.GetWidth()) * WS_FILTER_TILE_HEIGHT;
+
+		WS::ParallelFor(nBands, std::max<size_t>(1u, WS_FILTER_PARALLEL_THRESHOLD / std::max<size_t>(1u, pixelsPerBand)), [&](const size_t begin, const size_t end) {
+			function(static_cast<uint32_t>(begin * WS_FILTER_TILE_HEIGHT),
+			         static_cast<uint32_t>(std::min<size_t>(end * WS_FILTER_TILE_HEIGHT, image.GetHeight())));
+		});
+	}
+
+	Image ConvolveSeparable(const Image& image, const std::vector<float>& horizontalWeights,
+	                        const std::vector<float>& verticalWeights) WS_NOEXCEPT
+	{
+		if (horizontalWeights.size() % 2u == 0u || verticalWeights.size() % 2u == 0u) {
+			WS_THROW("[WS] Separable Kernels Must Have An Odd Number Of Weights");
+			return image;
+		}
+
+		const auto isInRange = [](const float weight) { return weight > -2.f && weight < 2.f; };
+		if (!std::all_of(horizontalWeights.begin(), horizontalWeights.end(), isInRange) ||
+		    !std::all_of(verticalWeights.begin(),   verticalWeights.end(),   isInRange)) {
+			WS_THROW("[WS] Separable Kernel Weights Must Lie In ]-2, 2[");
+			return image;
+		}
+
+		Image result(image.GetWidth(), image.GetHeight());
+		if (image.GetPixelCount() == 0u)
+			return result;
+
+		const std::vector<int16_t> hWeights = WS::QuantizeWeights(horizontalWeights);
+		const std::vector<int16_t> vWeights = WS::QuantizeWeights(verticalWeights);
+
+		WS::ForEachBand(image, [&](const uint32_t y0, const uint32_t y1) {
+			WS::ConvolveBand(image, result, y0, y1, hWeights, horizontalWeights.size() / 2u, vWeights, verticalWeights.size() / 2u);
+		});
+
+		return result;
+	}
+
+	std::vector<float> GetGaussianWeights(const float sigma) noexcept
+	{
+		if (sigma <= 0.f)
+			return { 1.f };
+
+		const int32_t radius = static_cast<int32_t>(std::ceil(3.f * sigma));
+
+		std::vector<float> weights(2u * radius + 1u);
+
+		float sum = 0.f;
+		for (int32_t i = -radius; i <= radius; i++) {
+			weights[i + radius] = std::exp(-static_cast<float>(i * i) / (2.f * sigma * sigma));
+			sum += weights[i + radius];
+		}
+
+		for (float& weight : weights)
+			weight /= sum;
+
+		return weights;
+	}
+
+	Image GaussianBlur(const Image& image, const float sigma) WS_NOEXCEPT
+	{
+		const std::vector<float> weights = WS::GetGaussianWeights(sigma);
+
+		return WS::ConvolveSeparable(image, weights, weights);
+	}
+
+	Image BoxBlur(const Image& image, const uint32_t radius) noexcept
+	{
+		const int64_t width  = image.GetWidth();
+		const int64_t height = image.GetHeight();
+		const int64_t r      = std::min<int64_t>(radius, 16383);
+
+		Image result(image.GetWidth(), image.GetHeight());
+		if (image.GetPixelCount() == 0u)
+			return result;
+
+		// Horizontal running sums into 8.8 fixed point averages
+		std::vector<uint16_t> horizontal(image.GetPixelCount() * 4u);
+
+		WS::ParallelFor(static_cast<size_t>(height), std::max<size_t>(1u, WS_FILTER_PARALLEL_THRESHOLD / width), [&](const size_t begin, const size_t end) {
+			for (size_t y = begin; y < end; y++) {
+#ifndef __WEISS__DISABLE_SIMD
+				WS::BoxRowSIMD(image.GetBuffer() + y * width, horizontal.data() + y * width * 4u, width, r);
+#else
+				WS::BoxRowScalar(image.GetBuffer() + y * width, horizontal.data() + y * width * 4u, width, r);
+#endif // #ifndef __WEISS__DISABLE_SIMD
+			}
+		});
+
+		// Vertical running sums, each band starts its own sums over the rows surrounding its first row
+		const size_t nValues = static_cast<size_t>(width) * 4u;
+		const float  scale   = 1.f / (256.f * static_cast<float>(2 * r + 1));
+
+		WS::ForEachBand(image, [&](const uint32_t y0, const uint32_t y1) {
+			std::vector<uint32_t> sums(nValues, 0u);
+
+			const auto getRow = [&](const int64_t y) { return horizontal.data() + std::clamp<int64_t>(y, 0, height - 1) * nValues; };
+
+			for (int64_t k = static_cast<int64_t>(y0) - r; k <= static_cast<int64_t>(y0) + r; k++) {
+				const uint16_t* pRow = getRow(k);
+				for (size_t i = 0u; i < nValues; i++)
+					sums[i] += pRow[i];
+			}
+
+			for (int64_t y = y0; y < y1; y++) {
+				uint8_t* pDst = reinterpret_cast<uint8_t*>(result.GetBuffer() + y * width);
+
+#ifndef __WEISS__DISABLE_SIMD
+				const size_t handled = WS::BoxColumnSIMD(sums.data(), pDst, nValues, scale);
+#else
+				const size_t handled = 0u;
+#endif // #ifndef __WEISS__DISABLE_SIMD
+
+				WS::BoxColumnScalar(sums.data(), pDst, handled, nValues, scale);
+
+				const uint16_t* pAdd = getRow(y + r + 1);
+				const uint16_t* pSub = getRow(y - r);
+
+#ifndef __WEISS__DISABLE_SIMD
+				size_t i = WS::UpdateColumnSumsSIMD(sums.data(), pAdd, pSub, nValues);
+#else
+				size_t i = 0u;
+#endif // #ifndef __WEISS__DISABLE_SIMD
+
+				for (; i < nValues; i++)
+					sums[i] = sums[i] + pAdd[i] - pSub[i];
+			}
+		});
+
+		return result;
+	}
+
+	Image Sharpen(const Image& image, const float amount, const float sigma) WS_NOEXCEPT
+	{
+		const Image blurred = WS::GaussianBlur(image, sigma);
+
+		Image result(image.GetWidth(), image.GetHeight());
+
+		const int16_t amountQ8 = static_cast<int16_t>(std::lround(std::clamp(amount, 0.f, 127.f) * 256.f));
+
+		WS::ParallelFor(image.GetPixelCount(), WS_FILTER_PARALLEL_THRESHOLD, [&](const size_t begin, const size_t end) {
+#ifndef __WEISS__DISABLE_SIMD
+			const size_t handled = WS::SharpenSIMD(image.GetBuffer() + begin, blurred.GetBuffer() + begin, result.GetBuffer() + begin, end - begin, amountQ8);
+#else
+			const size_t handled = 0u;
+#endif // #ifndef __WEISS__DISABLE_SIMD
+
+			WS::SharpenScalar(image.GetBuffer() + begin, blurred.GetBuffer() + begin, result.GetBuffer() + begin, handled, end - begin, amountQ8);
+		});
+
+		return result;
+	}
+
+}; // WS
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "WSImage.h"
+#include "../misc/WSPch.h"
+
+namespace WS {
+
+	/*
+	 * Convolution filters over RGBA8 images, every channel (alpha included) is filtered.
+	 * Pixels outside of the image are clamped to its edges.
+	 *
+	 * Separable kernels run a horizontal then a vertical pass over tiles of
+	 * WS_FILTER_TILE_WIDTH x WS_FILTER_TILE_HEIGHT pixels so that the 16 bit intermediate
+	 * rows stay in cache, and bands of tiles are filtered on multiple threads.
+	 * Weights are quantized to 2.14 fixed point, intermediates to 11.5 fixed point.
+	 */
+
+	constexpr const uint32_t WS_FILTER_TILE_WIDTH  = 256u;
+	constexpr const uint32_t WS_FILTER_TILE_HEIGHT = 64u;
+
+	// Number of pixels from which filters are multithreaded
+	constexpr const size_t WS_FILTER_PARALLEL_THRESHOLD = 1u << 16u;
+
+	/*
+	 * Convolves "image" by the column vector "verticalWeights" times the row vector "horizontalWeights".
+	 * Both weight counts must be odd (the kernel is centered), every weight must lie in ]-2, 2[ and
+	 * the absolute weights of each vector must sum to less than 4. Intermediate values are saturated to [-1023, 1023].
+	 */
+	[[nodiscard]] Image ConvolveSeparable(const Image& image, const std::vector<float>& horizontalWeights,
+	                                      const std::vector<float>& verticalWeights) WS_NOEXCEPT;
+
+	// Normalized gaussian weights of standard deviation "sigma" over a radius of ceil(3 * sigma)
+	[[nodiscard]] std::vector<float> GetGaussianWeights(const float sigma) noexcept;
+
+	[[nodiscard]] Image GaussianBlur(const Image& image, const float sigma) WS_NOEXCEPT;
+
+	// Averages (2 * radius + 1)^2 pixels with running sums, the cost per pixel doesn't depend on "radius" (at most 16383)
+	[[nodiscard]] Image BoxBlur(const Image& image, const uint32_t radius) noexcept;
+
+	// Unsharp mask : image + amount * (image - GaussianBlur(image, sigma)) on the color channels, "amount" is clamped to [0, 127]
+	[[nodiscard]] Image Sharpen(const Image& image, const float amount, const float sigma = 1.f) WS_NOEXCEPT;
+
+}; // WS
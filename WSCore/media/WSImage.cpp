@@ -1,24 +1,59 @@
 #include "WSImage.h"
+#include "../misc/WSChecksum.h"
 
 namespace WS {
 
 	Image::Image(Image&& other) noexcept
 		: m_width(other.m_width), m_height(other.m_height), m_nPixels(other.m_nPixels)
 	{
-		this->m_pBuff = std::move(other.m_pBuff);
+		this->m_pBuff          = std::move(other.m_pBuff);
+		this->m_pPixels        = std::exchange(other.m_pPixels, nullptr);
+		this->m_pExternalOwner = std::move(other.m_pExternalOwner);
 	}
 
+	// Copies always own their pixels, even when "other" wraps external memory
 	Image::Image(const Image& other) noexcept
 		: m_width(other.m_width), m_height(other.m_height), m_nPixels(other.m_nPixels)
 	{
-		size_t bufferSize = this->m_nPixels * sizeof(WS::Coloru8);
+		this->m_pBuff   = std::make_unique<WS::Coloru8[]>(this->m_nPixels);
+		this->m_pPixels = this->m_pBuff.get();
 
-		this->m_pBuff = std::make_unique<WS::Coloru8[]>(bufferSize);
-		std::memcpy(this->m_pBuff.get(), other.m_pBuff.get(), bufferSize);
+		std::memcpy(this->m_pPixels, other.m_pPixels, this->m_nPixels * sizeof(WS::Coloru8));
+	}
+
+	Image& Image::operator=(Image&& other) noexcept
+	{
+		if (this != &other) {
+			this->m_width          = other.m_width;
+			this->m_height         = other.m_height;
+			this->m_nPixels        = other.m_nPixels;
+			this->m_pBuff          = std::move(other.m_pBuff);
+			this->m_pPixels        = std::exchange(other.m_pPixels, nullptr);
+			this->m_pExternalOwner = std::move(other.m_pExternalOwner);
+		}
+
+		return *this;
+	}
+
+	Image& Image::operator=(const Image& other) noexcept
+	{
+		if (this != &other) {
+			this->m_width   = other.m_width;
+			this->m_height  = other.m_height;
+			this->m_nPixels = other.m_nPixels;
+
+			this->m_pBuff   = std::make_unique<WS::Coloru8[]>(this->m_nPixels);
+			this->m_pPixels = this->m_pBuff.get();
+			this->m_pExternalOwner.reset();
+
+			std::memcpy(this->m_pPixels, other.m_pPixels, this->m_nPixels * sizeof(WS::Coloru8));
+		}
+
+		return *this;
 	}
 
 	Image::Image(const uint32_t width, const uint32_t height, const Coloru8& fillColor)
-		: m_width(width), m_height(height), m_nPixels(width * height)
+		: m_width(width), m_height(height), m_nPixels(static_cast<uint64_t>(width) * height)
 	{
 #ifdef __WEISS__DEBUG_MODE
 
@@ -26,40 +61,66 @@ namespace WS {
 
 #endif // __WEISS__DEBUG_MODE
 
-		size_t bufferSize = this->m_nPixels * sizeof(WS::Coloru8);
-		this->m_pBuff = std::make_unique<WS::Coloru8[]>(bufferSize);
-		std::fill_n(this->m_pBuff.get(), this->m_nPixels, WS::Coloru8{0u, 0u, 0u, 255u});
+		this->m_pBuff   = std::make_unique<WS::Coloru8[]>(this->m_nPixels);
+		this->m_pPixels = this->m_pBuff.get();
+		std::fill_n(this->m_pPixels, this->m_nPixels, fillColor);
+	}
+
+	Image::Image(const uint32_t width, const uint32_t height, WS::Coloru8* pixels, std::shared_ptr<const void> owner) noexcept
+		: m_pPixels(pixels), m_pExternalOwner(std::move(owner)),
+		  m_width(width), m_height(height), m_nPixels(static_cast<uint64_t>(width) * height)
+	{
+
 	}
 
 	Image::Image(const char* filepath) WS_NOEXCEPT
 	{
+		std::string error;
+		if (!this->Load(filepath, &error))
+			WS_THROW(error);
+	}
+
+	bool Image::Load(const char* filepath, std::string* pError) noexcept
+	{
+		WS_PROFILE_SCOPE("Image::Decode");
+
+		*this = Image();
+
+		const auto Fail = [this, pError](const char* error) noexcept {
+			if (pError != nullptr)
+				*pError = error;
+
+			*this = Image();
+			return false;
+		};
+
 		// Step #0: Read Input File Into Buffer
-		uint8_t* fileBuffer; // Dynamic #0
-		uint8_t* filePosition;
+		std::vector<uint8_t> fileBuffer;
 		{
 			std::ifstream file(filepath, std::ios::binary | std::ios::ate);
 			if (!file.is_open())
-				WS_THROW("[WS] Could Not Read/Open Image File");
+				return Fail("[WS] Could Not Read/Open Image File");
 
 			// Create the buffer
-			const size_t fileSize = file.tellg();
-			fileBuffer = new uint8_t[fileSize];
+			fileBuffer.resize(static_cast<size_t>(file.tellg()));
 
 			// Read File Into The Buffer
 			file.seekg(0, std::ios::beg);
 
-			if (!file.read((char*)fileBuffer, fileSize))
-				WS_THROW("[WS] Could Not Read Image File Into Buffer");
-
-			filePosition = fileBuffer;
+			if (!file.read(reinterpret_cast<char*>(fileBuffer.data()), fileBuffer.size()))
+				return Fail("[WS] Could Not Read Image File Into Buffer");
 		}
-		
+
+		const uint8_t* const fileData = fileBuffer.data();
+		const size_t         fileSize = fileBuffer.size();
+		size_t               position = 0u;
+
 		{ // Step #1: Check PNG Header
 			const uint64_t standardPngHeader = 0x0A1A0A0D474E5089; // swap_endian(0x89504E470D0A1A0A)
-			if (*(uint64_t*)fileBuffer != standardPngHeader)
-				WS_THROW("[WS] Input Image Did Not Have The Standard PNG Header");
-			
-			filePosition += sizeof(standardPngHeader);
+			if (fileSize < sizeof(standardPngHeader) || WS::ReadLittleEndian<uint64_t>(fileData) != standardPngHeader)
+				return Fail("[WS] Input Image Did Not Have The Standard PNG Header");
+
+			position += sizeof(standardPngHeader);
 		}
 		
 		struct {
@@ -69,18 +130,35 @@ namespace WS {
 		{ // Step #2: Read PNG Chunks
 			bool bLastChunk = false;
 
-			do {
+			while (!bLastChunk) {
+				// 12u is the size in bytes of the fixed sized part of any png chunk (length, name & CRC)
+				const size_t remainingSize = fileSize - position;
+
+				if (remainingSize < 12u)
+					return Fail("[WS] PNG File Ends Before Its IEND Chunk");
+
 				 // Read Chunk Metadata
-				const uint32_t chunkDataLength = WS::FromBigEndian(*(uint32_t*)(filePosition));
-				const uint32_t chunkName       = WS::FromLittleEndian(*(uint32_t*)(filePosition + 4u));
+				const uint8_t* const chunk           = fileData + position;
+				const uint32_t       chunkDataLength = WS::ReadBigEndian<uint32_t>(chunk);
+				const uint32_t       chunkName       = WS::ReadBigEndian<uint32_t>(chunk + 4u);
+
+				if (chunkDataLength > remainingSize - 12u)
+					return Fail("[WS] PNG Chunk Goes Past The End Of The File");
+
+				// The CRC follows the data & covers the chunk's name & data
+				const uint32_t chunkCrc = WS::ReadBigEndian<uint32_t>(chunk + 8u + chunkDataLength);
+
+				if (WS::Crc32(chunk + 4u, 4u + chunkDataLength) != chunkCrc)
+					return Fail("[WS] PNG Chunk Has An Invalid CRC");
 
 				// Parse Chunks
 				switch (chunkName) {
 				case WS_PNG_IHDR_CHUNK_NAME_RAW:
-					this->m_width  = WS::FromBigEndian(*(uint32_t*)(filePosition + 8u));
-					this->m_height = WS::FromBigEndian(*(uint32_t*)(filePosition + 12u));
+					if (chunkDataLength < 8u)
+						return Fail("[WS] PNG IHDR Chunk Is Too Short");
 
-					std::cout << this->m_width << " " << this->m_height << '\n';
+					this->m_width  = WS::ReadBigEndian<uint32_t>(chunk + 8u);
+					this->m_height = WS::ReadBigEndian<uint32_t>(chunk + 12u);
 					break;
 				case WS_PNG_IDAT_CHUNK_NAME_RAW:
 					break;
@@ -89,13 +167,12 @@ namespace WS {
 					break;
 				}
 
-				/* 12u is the size in bytes of the fixed sized part of any png chunk header
-				 * chunkDataLength is the size in bytes of the dynamic sized part of any png chunk header */
-				filePosition += 12u + chunkDataLength;
-			} while (!bLastChunk);
+				// chunkDataLength is the size in bytes of the dynamic sized part of any png chunk
+				position += 12u + chunkDataLength;
+			}
 		}
 
-		delete[] fileBuffer; // Dynamic #0
+		return true;
     }
 
     void Image::Write(const char* filepath) WS_NOEXCEPT
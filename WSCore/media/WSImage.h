@@ -3,6 +3,7 @@
 #include "../misc/WSPch.h"
 #include "../math/WSVector.h"
 #include "../misc/WSBitLogic.h"
+#include "../debugging/WSProfiler.h"
 
 #define WS_PNG_IHDR_CHUNK_NAME_RAW 0x49484452
 #define WS_PNG_IDAT_CHUNK_NAME_RAW 0x49444154
@@ -12,10 +13,13 @@ namespace WS {
 
 	/*
 	 * The "Image" class represents a 4 byte per pixel image (r, g, b, a)
+	 * Its pixels are either owned or wrap external memory (i.e a mapped texture file) kept alive by a shared owner
 	 */
 	class Image {
 	private:
-		std::unique_ptr<WS::Coloru8[]> m_pBuff;
+		std::unique_ptr<WS::Coloru8[]> m_pBuff;             // Owned pixels, null when wrapping external memory
+		WS::Coloru8*                   m_pPixels = nullptr; // Points to either m_pBuff or the external memory
+		std::shared_ptr<const void>    m_pExternalOwner;    // Keeps the external memory alive
 
 		uint32_t m_width   = 0, m_height = 0;
 		uint64_t m_nPixels = 0;
@@ -26,14 +30,30 @@ namespace WS {
 		Image(Image&& other) noexcept;
 		Image(const Image& other) noexcept;
 
+		Image& operator=(Image&& other) noexcept;
+		Image& operator=(const Image& other) noexcept;
+
+		// WS_THROWs when the file can't be read or decoded, see "Load" for a non throwing version
 		Image(const char* filepath) WS_NOEXCEPT;
 
 		Image(const uint32_t width, const uint32_t height, const Coloru8& fillColor = { 0, 0, 0, 255 });
 
+		// Wraps "pixels" without copying them, "owner" is kept alive as long as the image (or one of its moved-to images) lives
+		Image(const uint32_t width, const uint32_t height, WS::Coloru8* pixels, std::shared_ptr<const void> owner) noexcept;
+
+		// Replaces the image with the decoded file, returns false and leaves the image empty if it can't be read or decoded
+		// "pError" (optional) receives the reason of the failure
+		[[nodiscard]] bool Load(const char* filepath, std::string* pError = nullptr) noexcept;
+
+		[[nodiscard]] inline bool IsWrappingExternalMemory() const noexcept { return this->m_pExternalOwner != nullptr; }
+
 		[[nodiscard]] inline uint32_t GetWidth()      const noexcept { return this->m_width;   }
 		[[nodiscard]] inline uint32_t GetHeight()     const noexcept { return this->m_height;  }
 		[[nodiscard]] inline uint64_t GetPixelCount() const noexcept { return this->m_nPixels; }
 
+		[[nodiscard]] inline       WS::Coloru8* GetBuffer()       noexcept { return this->m_pPixels; }
+		[[nodiscard]] inline const WS::Coloru8* GetBuffer() const noexcept { return this->m_pPixels; }
+
 		inline void SetPixelColor(const uint32_t x, const uint32_t y, const WS::Coloru8& color) WS_NOEXCEPT
 		{
 #ifdef __WEISS__DEBUG_MODE
@@ -42,7 +62,7 @@ namespace WS {
 		
 #endif // __WEISS__DEBUG_MODE
 
-			this->m_pBuff[y * this->m_width + x] = color;
+			this->m_pPixels[y * this->m_width + x] = color;
 		}
 
 		[[nodiscard]] inline WS::Coloru8 SamplePixelColor(const uint32_t x, const uint32_t y) WS_NOEXCEPT
@@ -53,7 +73,7 @@ namespace WS {
 		
 #endif // __WEISS__DEBUG_MODE
 
-			return this->m_pBuff[y * this->m_width + x];
+			return this->m_pPixels[y * this->m_width + x];
 		}
 
 		void Write(const char* filepath) WS_NOEXCEPT;
@@ -0,0 +1,59 @@
+#include "WSImageLoader.h"
+
+namespace WS {
+
+	ImageLoader::ImageLoader(const size_t nDecodeThreads) noexcept
+		: m_pool(nDecodeThreads)
+	{
+
+	}
+
+	ImageLoadHandle ImageLoader::LoadImageAsync(const char* filepath, const TaskPriority priority) noexcept
+	{
+		ImageLoadHandle handle;
+		handle.m_pState = std::make_shared<ImageLoadHandle::SharedState>();
+		handle.m_pState->m_path = filepath;
+
+		// Requests cancelled before they start are dropped by the pool, the task never runs
+		this->m_pool.Submit([this, handle]() mutable {
+			static Counter&   s_decoded    = MetricsRegistry::Get().GetCounter("image.decoded");
+			static Counter&   s_failures   = MetricsRegistry::Get().GetCounter("image.decode_failures");
+			static Histogram& s_decodeTime = MetricsRegistry::Get().GetHistogram("image.decode_time_ns");
+
+			ImageLoadHandle::SharedState& state = *handle.m_pState;
+			ImageLoadStatus status = ImageLoadStatus::COMPLETED;
+
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+			// The PNG decoder doesn't inflate IDAT yet, a header only decode isn't delivered as an image
+			if (!state.m_image.Load(state.m_path.c_str(), &state.m_error)) {
+				status = ImageLoadStatus::FAILED;
+			} else if (state.m_image.GetPixelCount() == 0u) {
+				state.m_image = Image();
+				state.m_error = "[WS] The Image Has No Decoded Pixels";
+				status = ImageLoadStatus::FAILED;
+			}
+
+			if (status == ImageLoadStatus::COMPLETED)
+				s_decoded.Add();
+			else
+				s_failures.Add();
+
+			s_decodeTime.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+
+			if (state.m_token.IsCancelled()) {
+				state.m_image = Image();
+				state.m_status.store(ImageLoadStatus::CANCELLED, std::memory_order_release);
+				return;
+			}
+
+			state.m_status.store(status, std::memory_order_release);
+
+			std::lock_guard<std::mutex> lock(this->m_completedMutex);
+			this->m_completed.push_back(std::move(handle));
+		}, priority, handle.m_pState->m_token);
+
+		return handle;
+	}
+
+}; // WS
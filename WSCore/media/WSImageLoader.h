@@ -0,0 +1,116 @@
+#pragma once
+
+#include "WSImage.h"
+#include "../misc/WSPch.h"
+#include "../misc/WSThreadPool.h"
+#include "../debugging/WSMetrics.h"
+
+namespace WS {
+
+	enum class ImageLoadStatus : uint8_t {
+		PENDING,   // Queued, not started
+		COMPLETED, // The image was read & decoded
+		FAILED,    // The file couldn't be read or decoded, see GetError()
+		CANCELLED  // Cancelled before it was delivered
+	};
+
+	/*
+	 * Handle to an image being loaded by an "ImageLoader".
+	 * Handles are cheap to copy and all copies refer to the same request.
+	 */
+	class ImageLoadHandle {
+		friend class ImageLoader;
+
+	private:
+		struct SharedState {
+			std::string                  m_path;
+			CancellationToken            m_token;
+			std::atomic<ImageLoadStatus> m_status = ImageLoadStatus::PENDING;
+			Image                        m_image;
+			std::string                  m_error;
+		};
+
+		std::shared_ptr<SharedState> m_pState;
+
+	public:
+		ImageLoadHandle() = default;
+
+		[[nodiscard]] inline bool IsValid() const noexcept { return this->m_pState != nullptr; }
+
+		[[nodiscard]] inline ImageLoadStatus GetStatus() const noexcept
+		{
+			const ImageLoadStatus status = this->m_pState->m_status.load(std::memory_order_acquire);
+
+			// Requests cancelled while still queued are never picked up by a worker
+			if (status == ImageLoadStatus::PENDING && this->m_pState->m_token.IsCancelled())
+				return ImageLoadStatus::CANCELLED;
+
+			return status;
+		}
+
+		[[nodiscard]] inline bool IsDone() const noexcept { return this->GetStatus() != ImageLoadStatus::PENDING; }
+
+		[[nodiscard]] inline const std::string& GetPath() const noexcept { return this->m_pState->m_path; }
+
+		// Only valid once the status is FAILED
+		[[nodiscard]] inline const std::string& GetError() const noexcept { return this->m_pState->m_error; }
+
+		// Only valid once the status is COMPLETED, moves the image out of the request
+		[[nodiscard]] inline Image TakeImage() noexcept { return std::move(this->m_pState->m_image); }
+
+		// A request cancelled before its decode starts never touches the disk
+		// A request cancelled during its decode is discarded and never delivered
+		inline void Cancel() noexcept { this->m_pState->m_token.Cancel(); }
+	};
+
+	/*
+	 * Reads & decodes images on a bounded pool of worker threads.
+	 * Finished requests are pushed to a completion queue that the main thread drains
+	 * with "PollCompleted", typically right after "Window::Update()".
+	 */
+	class ImageLoader {
+	private:
+		std::mutex                  m_completedMutex;
+		std::deque<ImageLoadHandle> m_completed;
+
+		// Declared last so that it is destroyed first : its workers are joined while the completion queue still exists
+		ThreadPool m_pool;
+
+	public:
+		// nDecodeThreads == 0 uses one thread per hardware thread
+		ImageLoader(const size_t nDecodeThreads = 0u) noexcept;
+
+		ImageLoader(const ImageLoader&) = delete;
+		ImageLoader& operator=(const ImageLoader&) = delete;
+
+		[[nodiscard]] ImageLoadHandle LoadImageAsync(const char* filepath, const TaskPriority priority = TaskPriority::NORMAL) noexcept;
+
+		/*
+		 * Calls "onCompleted(ImageLoadHandle&)" for at most "maxResults" finished requests (completed or failed)
+		 * on the calling thread and returns how many were delivered
+		 */
+		template <typename _F>
+		size_t PollCompleted(_F&& onCompleted, const size_t maxResults = std::numeric_limits<size_t>::max()) noexcept
+		{
+			std::deque<ImageLoadHandle> ready;
+
+			{
+				std::lock_guard<std::mutex> lock(this->m_completedMutex);
+
+				const size_t nReady = std::min(maxResults, this->m_completed.size());
+				ready.insert(ready.end(), std::make_move_iterator(this->m_completed.begin()),
+				                          std::make_move_iterator(this->m_completed.begin() + nReady));
+				this->m_completed.erase(this->m_completed.begin(), this->m_completed.begin() + nReady);
+			}
+
+			for (ImageLoadHandle& handle : ready)
+				onCompleted(handle);
+
+			return ready.size();
+		}
+
+		// Blocks until every submitted request was processed
+		inline void WaitIdle() noexcept { this->m_pool.WaitIdle(); }
+	};
+
+}; // WS
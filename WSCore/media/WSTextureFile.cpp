@@ -0,0 +1,245 @@
+#include "WSTextureFile.h"
+#include "WSColorSpace.h"
+#include "WSBlockCompression.h"
+
+namespace WS {
+
+	static inline uint64_t AlignUp(const uint64_t value, const uint64_t alignment) noexcept
+	{
+		return (value + alignment - 1u) / alignment * alignment;
+	}
+
+	uint64_t GetTextureLevelSize(const TextureFormat format, const uint32_t width, const uint32_t height) noexcept
+	{
+		// Neither count can overflow : (2^32 - 1)^2 pixels & 2^30 x 2^30 blocks both fit 64 bits
+		const uint64_t nPixels = static_cast<uint64_t>(width) * height;
+		const uint64_t nBlocks = ((static_cast<uint64_t>(width) + 3u) / 4u) * ((static_cast<uint64_t>(height) + 3u) / 4u);
+
+		uint64_t nUnits, unitSize;
+
+		switch (format) {
+		case TextureFormat::RGBA8: nUnits = nPixels; unitSize = sizeof(WS::Coloru8); break;
+		case TextureFormat::BC1:   nUnits = nBlocks; unitSize = 8u;  break;
+		case TextureFormat::BC3:   nUnits = nBlocks; unitSize = 16u; break;
+		case TextureFormat::BC7:   nUnits = nBlocks; unitSize = 16u; break;
+		default:                   return 0u;
+		}
+
+		if (nUnits > std::numeric_limits<uint64_t>::max() / unitSize)
+			return std::numeric_limits<uint64_t>::max();
+
+		return nUnits * unitSize;
+	}
+
+	Image DownsampleImage(const Image& image, const bool bSRGB) noexcept
+	{
+		const uint32_t srcWidth  = image.GetWidth();
+		const uint32_t srcHeight = image.GetHeight();
+		const uint32_t dstWidth  = std::max(1u, srcWidth  / 2u);
+		const uint32_t dstHeight = std::max(1u, srcHeight / 2u);
+
+		// Filtering has to happen in linear space, averaging sRGB values darkens the result
+		std::vector<Colorf32> linear(image.GetPixelCount());
+		if (bSRGB)
+			WS::SRGBToLinear(image, linear.data());
+		else
+			WS::ConvertColors(image.GetBuffer(), linear.data(), image.GetPixelCount());
+
+		std::vector<Colorf32> filtered(static_cast<size_t>(dstWidth) * dstHeight);
+		for (uint32_t y = 0u; y < dstHeight; y++) {
+			const uint32_t y0 = std::min(y * 2u, srcHeight - 1u);
+			const uint32_t y1 = std::min(y * 2u + 1u, srcHeight - 1u);
+
+			for (uint32_t x = 0u; x < dstWidth; x++) {
+				const uint32_t x0 = std::min(x * 2u, srcWidth - 1u);
+				const uint32_t x1 = std::min(x * 2u + 1u, srcWidth - 1u);
+
+				filtered[y * dstWidth + x] = (linear[y0 * srcWidth + x0] + linear[y0 * srcWidth + x1] +
+				                              linear[y1 * srcWidth + x0] + linear[y1 * srcWidth + x1]) * 0.25f;
+			}
+		}
+
+		Image result(dstWidth, dstHeight);
+		if (bSRGB)
+			WS::LinearToSRGB(filtered.data(), result);
+		else
+			WS::ConvertColors(filtered.data(), result.GetBuffer(), result.GetPixelCount());
+
+		return result;
+	}
+
+	bool WriteTextureFile(const char* filepath, const TextureFormat format, const uint32_t flags,
+	                      const uint32_t width, const uint32_t height,
+	                      const uint8_t* const* levels, const uint32_t levelCount) WS_NOEXCEPT
+	{
+		if (levelCount == 0u || levelCount > WS_TEXTURE_FILE_MAX_MIP_LEVELS) {
+			WS_THROW("[WS] Invalid Texture File Mip Level Count");
+			return false;
+		}
+
+		TextureFileHeader header{};
+		header.m_magic         = WS::FromLittleEndian<uint32_t>(WS_TEXTURE_FILE_MAGIC);
+		header.m_version       = WS_TEXTURE_FILE_VERSION;
+		header.m_format        = format;
+		header.m_flags         = flags;
+		header.m_width         = width;
+		header.m_height        = height;
+		header.m_mipCount      = levelCount;
+		header.m_dataAlignment = WS_TEXTURE_FILE_DATA_ALIGNMENT;
+
+		uint64_t offset = AlignUp(sizeof(TextureFileHeader), WS_TEXTURE_FILE_DATA_ALIGNMENT);
+		for (uint32_t i = 0u; i < levelCount; i++) {
+			TextureMipLevel& mip = header.m_mips[i];
+
+			mip.m_width  = std::max(1u, width  >> i);
+			mip.m_height = std::max(1u, height >> i);
+			mip.m_size   = GetTextureLevelSize(format, mip.m_width, mip.m_height);
+			mip.m_offset = offset;
+
+			offset = AlignUp(offset + mip.m_size, WS_TEXTURE_FILE_DATA_ALIGNMENT);
+		}
+
+		std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			WS_THROW("[WS] Could Not Open Texture File For Writing");
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(TextureFileHeader));
+
+		for (uint32_t i = 0u; i < levelCount; i++) {
+			const TextureMipLevel& mip = header.m_mips[i];
+
+			// Pad up to the level's aligned offset
+			const std::streamoff padding = static_cast<std::streamoff>(mip.m_offset) - file.tellp();
+			for (std::streamoff p = 0; p < padding; p++)
+				file.put('\0');
+
+			file.write(reinterpret_cast<const char*>(levels[i]), static_cast<std::streamsize>(mip.m_size));
+		}
+
+		if (!file) {
+			WS_THROW("[WS] Could Not Write Texture File");
+			return false;
+		}
+
+		return true;
+	}
+
+	bool WriteTextureFile(const char* filepath, const Image& image, const TextureFileWriteOptions& options) WS_NOEXCEPT
+	{
+		std::vector<Image> mips;
+		if (options.m_bGenerateMips) {
+			while ((mips.empty() ? image : mips.back()).GetWidth()  > 1u ||
+			       (mips.empty() ? image : mips.back()).GetHeight() > 1u) {
+				if (mips.size() + 1u >= WS_TEXTURE_FILE_MAX_MIP_LEVELS)
+					break;
+
+				mips.push_back(WS::DownsampleImage(mips.empty() ? image : mips.back(), options.m_bSRGB));
+			}
+		}
+
+		std::vector<const Image*> images = { &image };
+		for (const Image& mip : mips)
+			images.push_back(&mip);
+
+		std::vector<const uint8_t*>       levels;
+		std::vector<std::vector<uint8_t>> encodedLevels;
+
+		if (options.m_format == TextureFormat::RGBA8) {
+			for (const Image* pImage : images)
+				levels.push_back(reinterpret_cast<const uint8_t*>(pImage->GetBuffer()));
+		} else {
+			for (const Image* pImage : images)
+				encodedLevels.push_back(WS::EncodeBlocks(*pImage, options.m_format, options.m_bc7Quality));
+
+			for (const std::vector<uint8_t>& encodedLevel : encodedLevels)
+				levels.push_back(encodedLevel.data());
+		}
+
+		const uint32_t flags = options.m_bSRGB ? WS_TEXTURE_FILE_FLAG_SRGB : 0u;
+
+		return WS::WriteTextureFile(filepath, options.m_format, flags, image.GetWidth(), image.GetHeight(),
+		                            levels.data(), static_cast<uint32_t>(levels.size()));
+	}
+
+	TextureFile::TextureFile(const char* filepath) WS_NOEXCEPT
+	{
+		if constexpr (std::endian::native != std::endian::little) {
+			WS_THROW("[WS] Texture Files Can Only Be Mapped On Little Endian Hosts");
+			return;
+		}
+
+		std::shared_ptr<MappedFile> pMapping = std::make_shared<MappedFile>(filepath);
+
+		if (!pMapping->IsMapped() || pMapping->GetSize() < sizeof(TextureFileHeader)) {
+			WS_THROW("[WS] Texture File Is Too Small");
+			return;
+		}
+
+		const TextureFileHeader* pHeader = reinterpret_cast<const TextureFileHeader*>(pMapping->GetData());
+
+		if (pHeader->m_magic != WS_TEXTURE_FILE_MAGIC || pHeader->m_version != WS_TEXTURE_FILE_VERSION) {
+			WS_THROW("[WS] Not A Texture File Or Unsupported Texture File Version");
+			return;
+		}
+
+		if (pHeader->m_mipCount == 0u || pHeader->m_mipCount > WS_TEXTURE_FILE_MAX_MIP_LEVELS) {
+			WS_THROW("[WS] Invalid Texture File Mip Level Count");
+			return;
+		}
+
+		if (pHeader->m_width == 0u || pHeader->m_height == 0u || GetTextureLevelSize(pHeader->m_format, 1u, 1u) == 0u) {
+			WS_THROW("[WS] Invalid Texture File Dimensions Or Format");
+			return;
+		}
+
+		// Validate every level once here so that accessors never have to
+		for (uint32_t i = 0u; i < pHeader->m_mipCount; i++) {
+			const TextureMipLevel& mip = pHeader->m_mips[i];
+
+			if (mip.m_width != std::max(1u, pHeader->m_width >> i) || mip.m_height != std::max(1u, pHeader->m_height >> i)) {
+				WS_THROW("[WS] Texture File Mip Level Has Invalid Dimensions");
+				return;
+			}
+
+			// Sizes that overflow are saturated, no file is large enough to hold them
+			if (mip.m_size != GetTextureLevelSize(pHeader->m_format, mip.m_width, mip.m_height) ||
+			    mip.m_offset % WS_TEXTURE_FILE_DATA_ALIGNMENT != 0u ||
+			    mip.m_offset > pMapping->GetSize() || mip.m_size > pMapping->GetSize() - mip.m_offset) {
+				WS_THROW("[WS] Texture File Mip Level Is Out Of Bounds");
+				return;
+			}
+		}
+
+		this->m_pMapping = std::move(pMapping);
+		this->m_pHeader  = pHeader;
+	}
+
+	const uint8_t* TextureFile::GetMipData(const uint32_t level) const noexcept
+	{
+		if (level >= this->m_pHeader->m_mipCount)
+			return nullptr;
+
+		return this->m_pMapping->GetData() + this->m_pHeader->m_mips[level].m_offset;
+	}
+
+	Image TextureFile::GetMipImage(const uint32_t level) const WS_NOEXCEPT
+	{
+		if (this->m_pHeader->m_format != TextureFormat::RGBA8) {
+			WS_THROW("[WS] Only RGBA8 Texture Files Can Be Wrapped By An Image");
+			return Image();
+		}
+
+		if (level >= this->m_pHeader->m_mipCount) {
+			WS_THROW("[WS] Texture File Mip Level Does Not Exist");
+			return Image();
+		}
+
+		const TextureMipLevel& mip = this->m_pHeader->m_mips[level];
+		WS::Coloru8* pPixels = reinterpret_cast<WS::Coloru8*>(this->m_pMapping->GetData() + mip.m_offset);
+
+		return Image(mip.m_width, mip.m_height, pPixels, this->m_pMapping);
+	}
+
+}; // WS
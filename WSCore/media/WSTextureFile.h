@@ -0,0 +1,121 @@
+#pragma once
+
+#include "WSImage.h"
+#include "../misc/WSPch.h"
+#include "../misc/WSMappedFile.h"
+
+#define WS_TEXTURE_FILE_MAGIC          0x58545357u // "WSTX" read as a little endian uint32_t
+#define WS_TEXTURE_FILE_VERSION        1u
+#define WS_TEXTURE_FILE_MAX_MIP_LEVELS 16u
+#define WS_TEXTURE_FILE_DATA_ALIGNMENT 256u        // Every mip level starts on a multiple of this offset
+
+#define WS_TEXTURE_FILE_FLAG_SRGB 0x1u
+
+namespace WS {
+
+	/*
+	 * Weiss' native texture container (".wstex")
+	 *
+	 * |--------------------------------|
+	 * | TextureFileHeader (fixed size) |
+	 * | padding                        |
+	 * | mip level 0 (aligned)          |
+	 * | padding                        |
+	 * | mip level 1 (aligned)          |
+	 * | ...                            |
+	 * |--------------------------------|
+	 *
+	 * Everything is stored little endian & pre-decoded so a mapped file can be used in place :
+	 * loading one is a validation of the header, there is no parsing and no copy.
+	 */
+
+	enum class TextureFormat : uint32_t {
+		RGBA8 = 0u, // 4 bytes per pixel, WS::Coloru8
+		BC1   = 1u, // 8 bytes per 4x4 block
+		BC3   = 2u, // 16 bytes per 4x4 block
+		BC7   = 3u  // 16 bytes per 4x4 block
+	};
+
+	// Speed / quality trade-off of the CPU BC7 encoder (see WSBlockCompression.h)
+	enum class BC7Quality : uint8_t {
+		FAST,   // Bounding box endpoints
+		NORMAL, // Principal axis endpoints
+		SLOW    // Principal axis endpoints refined by least squares, every p-bit combination is tried
+	};
+
+	struct TextureMipLevel {
+		uint64_t m_offset; // From the start of the file
+		uint64_t m_size;   // In bytes
+		uint32_t m_width;
+		uint32_t m_height;
+	};
+
+	struct TextureFileHeader {
+		uint32_t      m_magic;
+		uint32_t      m_version;
+		TextureFormat m_format;
+		uint32_t      m_flags;
+		uint32_t      m_width;
+		uint32_t      m_height;
+		uint32_t      m_mipCount;
+		uint32_t      m_dataAlignment;
+
+		TextureMipLevel m_mips[WS_TEXTURE_FILE_MAX_MIP_LEVELS];
+	};
+
+	static_assert(sizeof(TextureFileHeader) == 32u + WS_TEXTURE_FILE_MAX_MIP_LEVELS * sizeof(TextureMipLevel));
+
+	// Size in bytes of a "width" x "height" level stored in "format", UINT64_MAX if it doesn't fit 64 bits, 0 for unknown formats
+	[[nodiscard]] uint64_t GetTextureLevelSize(const TextureFormat format, const uint32_t width, const uint32_t height) noexcept;
+
+	struct TextureFileWriteOptions {
+		bool          m_bGenerateMips = true;                 // Box filtered down to 1x1
+		bool          m_bSRGB         = true;                 // Mips are filtered in linear space & the file is flagged as sRGB
+		TextureFormat m_format        = TextureFormat::RGBA8; // Block compressed formats are encoded on the CPU
+		BC7Quality    m_bc7Quality    = BC7Quality::NORMAL;
+	};
+
+	// Halves an image's dimensions (rounding down, at least 1) with a 2x2 box filter
+	[[nodiscard]] Image DownsampleImage(const Image& image, const bool bSRGB) noexcept;
+
+	// Writes pre-encoded levels, "levels[i]" must hold GetTextureLevelSize(format, mipWidth, mipHeight) bytes
+	[[nodiscard]] bool WriteTextureFile(const char* filepath, const TextureFormat format, const uint32_t flags,
+	                                    const uint32_t width, const uint32_t height,
+	                                    const uint8_t* const* levels, const uint32_t levelCount) WS_NOEXCEPT;
+
+	// Writes a texture file from an RGBA8 image, encoding its levels to "options.m_format"
+	[[nodiscard]] bool WriteTextureFile(const char* filepath, const Image& image, const TextureFileWriteOptions& options = {}) WS_NOEXCEPT;
+
+	/*
+	 * A mapped ".wstex" file
+	 * Images returned by GetMipImage() wrap the mapping and keep it alive on their own
+	 */
+	class TextureFile {
+	private:
+		std::shared_ptr<MappedFile> m_pMapping;
+		const TextureFileHeader*    m_pHeader = nullptr;
+
+	public:
+		TextureFile() = default;
+
+		TextureFile(const char* filepath) WS_NOEXCEPT;
+
+		[[nodiscard]] inline bool IsValid() const noexcept { return this->m_pHeader != nullptr; }
+
+		[[nodiscard]] inline const TextureFileHeader& GetHeader() const noexcept { return *this->m_pHeader; }
+
+		[[nodiscard]] inline TextureFormat GetFormat()   const noexcept { return this->m_pHeader->m_format;   }
+		[[nodiscard]] inline uint32_t      GetWidth()    const noexcept { return this->m_pHeader->m_width;    }
+		[[nodiscard]] inline uint32_t      GetHeight()   const noexcept { return this->m_pHeader->m_height;   }
+		[[nodiscard]] inline uint32_t      GetMipCount() const noexcept { return this->m_pHeader->m_mipCount; }
+
+		[[nodiscard]] inline bool IsSRGB() const noexcept { return (this->m_pHeader->m_flags & WS_TEXTURE_FILE_FLAG_SRGB) != 0u; }
+
+		// Raw level bytes, i.e for a GPU upload, nullptr if "level" is past GetMipCount()
+		[[nodiscard]] const uint8_t* GetMipData(const uint32_t level) const noexcept;
+
+		// Wraps an RGBA8 level without copying it, writes to the image stay in memory (copy on write)
+		[[nodiscard]] Image GetMipImage(const uint32_t level) const WS_NOEXCEPT;
+	};
+
+}; // WS
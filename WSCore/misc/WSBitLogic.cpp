@@ -0,0 +1,226 @@
+#include "WSBitLogic.h"
+#include "WSCpuFeatures.h"
+
+namespace WS {
+
+#ifdef __WEISS__RUNTIME_DISPATCH
+
+	// pshufb control reversing the bytes of every "_SIZE" byte lane (1 : identity), repeated over 32 bytes
+	template <size_t _SIZE>
+	static constexpr std::array<uint8_t, 32u> MakeByteSwapShuffle() noexcept
+	{
+		std::array<uint8_t, 32u> lanes{};
+
+		for (size_t b = 0u; b < 32u; b++)
+			lanes[b] = static_cast<uint8_t>(((b & 15u) & ~(_SIZE - 1u)) + (_SIZE - 1u - (b & (_SIZE - 1u))));
+
+		return lanes;
+	}
+
+	template <size_t _SIZE>
+	alignas(32) static constexpr std::array<uint8_t, 32u> BYTE_SWAP_SHUFFLE = MakeByteSwapShuffle<_SIZE>();
+
+	// Reversed nibbles, in the low & high half of a byte, looked up 16 at a time by pshufb
+	alignas(16) static constexpr uint8_t REVERSED_LOW_NIBBLES[16]  = { 0x00, 0x80, 0x40, 0xC0, 0x20, 0xA0, 0x60, 0xE0, 0x10, 0x90, 0x50, 0xD0, 0x30, 0xB0, 0x70, 0xF0 };
+	alignas(16) static constexpr uint8_t REVERSED_HIGH_NIBBLES[16] = { 0x00, 0x08, 0x04, 0x0C, 0x02, 0x0A, 0x06, 0x0E, 0x01, 0x09, 0x05, 0x0D, 0x03, 0x0B, 0x07, 0x0F };
+
+	// ---------- SSSE3 & AVX2 Kernels ---------- //
+
+	// Each returns the number of values processed, the caller handles the rest
+
+	template <typename _T>
+	WS_TARGET("ssse3")
+	static size_t SwapEndianSSSE3(const uint8_t* src, uint8_t* dst, const size_t count) noexcept
+	{
+		const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_SWAP_SHUFFLE<sizeof(_T)>.data()));
+		constexpr const size_t perXmm = 16u / sizeof(_T);
+
+		size_t i = 0u;
+
+		for (; i + perXmm <= count; i += perXmm) {
+			const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * sizeof(_T)));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * sizeof(_T)), _mm_shuffle_epi8(values, shuffle));
+		}
+
+		return i;
+	}
+
+	template <typename _T>
+	WS_TARGET("avx2")
+	static size_t SwapEndianAVX2(const uint8_t* src, uint8_t* dst, const size_t count) noexcept
+	{
+		const __m256i shuffle = _mm256_load_si256(reinterpret_cast<const __m256i*>(BYTE_SWAP_SHUFFLE<sizeof(_T)>.data()));
+		constexpr const size_t perYmm = 32u / sizeof(_T);
+
+		size_t i = 0u;
+
+		for (; i + 2u * perYmm <= count; i += 2u * perYmm) {
+			const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * sizeof(_T)));
+			const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + (i + perYmm) * sizeof(_T)));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * sizeof(_T)),            _mm256_shuffle_epi8(a, shuffle));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + (i + perYmm) * sizeof(_T)), _mm256_shuffle_epi8(b, shuffle));
+		}
+
+		for (; i + perYmm <= count; i += perYmm) {
+			const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * sizeof(_T)));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * sizeof(_T)), _mm256_shuffle_epi8(values, shuffle));
+		}
+
+		return i;
+	}
+
+	// Every byte is reversed by looking its nibbles up, then the bytes of every value are swapped
+	template <typename _T>
+	WS_TARGET("ssse3")
+	static size_t ReverseBitsSSSE3(const uint8_t* src, uint8_t* dst, const size_t count) noexcept
+	{
+		const __m128i low     = _mm_load_si128(reinterpret_cast<const __m128i*>(REVERSED_LOW_NIBBLES));
+		const __m128i high    = _mm_load_si128(reinterpret_cast<const __m128i*>(REVERSED_HIGH_NIBBLES));
+		const __m128i mask    = _mm_set1_epi8(0x0F);
+		const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(BYTE_SWAP_SHUFFLE<sizeof(_T)>.data()));
+		constexpr const size_t perXmm = 16u / sizeof(_T);
+
+		size_t i = 0u;
+
+		for (; i + perXmm <= count; i += perXmm) {
+			const __m128i values   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * sizeof(_T)));
+			const __m128i reversed = _mm_or_si128(_mm_shuffle_epi8(low,  _mm_and_si128(values, mask)),
+			                                      _mm_shuffle_epi8(high, _mm_and_si128(_mm_srli_epi16(values, 4), mask)));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * sizeof(_T)), _mm_shuffle_epi8(reversed, shuffle));
+		}
+
+		return i;
+	}
+
+	template <typename _T>
+	WS_TARGET("avx2")
+	static size_t ReverseBitsAVX2(const uint8_t* src, uint8_t* dst, const size_t count) noexcept
+	{
+		const __m256i low     = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(REVERSED_LOW_NIBBLES)));
+		const __m256i high    = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(REVERSED_HIGH_NIBBLES)));
+		const __m256i mask    = _mm256_set1_epi8(0x0F);
+		const __m256i shuffle = _mm256_load_si256(reinterpret_cast<const __m256i*>(BYTE_SWAP_SHUFFLE<sizeof(_T)>.data()));
+		constexpr const size_t perYmm = 32u / sizeof(_T);
+
+		size_t i = 0u;
+
+		for (; i + perYmm <= count; i += perYmm) {
+			const __m256i values   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * sizeof(_T)));
+			const __m256i reversed = _mm256_or_si256(_mm256_shuffle_epi8(low,  _mm256_and_si256(values, mask)),
+			                                         _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(values, 4), mask)));
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * sizeof(_T)), _mm256_shuffle_epi8(reversed, shuffle));
+		}
+
+		return i;
+	}
+
+#endif // __WEISS__RUNTIME_DISPATCH
+
+	// ---------- Dispatch ---------- //
+
+	enum class ShuffleLevel : uint8_t { SCALAR, SSSE3, AVX2 };
+
+	[[nodiscard]] static ShuffleLevel GetShuffleLevel() noexcept
+	{
+		static const ShuffleLevel s_level = HasCpuFeature(CpuFeature::AVX2)  ? ShuffleLevel::AVX2  :
+		                                    HasCpuFeature(CpuFeature::SSSE3) ? ShuffleLevel::SSSE3 : ShuffleLevel::SCALAR;
+
+		return s_level;
+	}
+
+	const char* GetByteShuffleImplementation() noexcept
+	{
+		switch (GetShuffleLevel()) {
+		case ShuffleLevel::AVX2:  return "AVX2";
+		case ShuffleLevel::SSSE3: return "SSSE3";
+		default:                  return "scalar";
+		}
+	}
+
+	// ---------- Byte Swaps ---------- //
+
+	// The arrays may be unaligned (i.e inside an archive) : values are loaded & stored through memcpy
+	template <typename _T>
+	static void SwapEndianArrayOf(const void* src, void* dst, const size_t count) noexcept
+	{
+		const uint8_t* pSrc = reinterpret_cast<const uint8_t*>(src);
+		uint8_t*       pDst = reinterpret_cast<uint8_t*>(dst);
+
+		size_t i = 0u;
+
+#ifdef __WEISS__RUNTIME_DISPATCH
+
+		switch (GetShuffleLevel()) {
+		case ShuffleLevel::AVX2:  i = SwapEndianAVX2<_T>(pSrc, pDst, count);  break;
+		case ShuffleLevel::SSSE3: i = SwapEndianSSSE3<_T>(pSrc, pDst, count); break;
+		default:                  break;
+		}
+
+#endif // __WEISS__RUNTIME_DISPATCH
+
+		for (; i < count; i++) {
+			_T value;
+			std::memcpy(&value, pSrc + i * sizeof(_T), sizeof(_T));
+
+			value = WS::SwapEndian(value);
+			std::memcpy(pDst + i * sizeof(_T), &value, sizeof(_T));
+		}
+	}
+
+	void SwapEndianArray(const void* src, void* dst, const size_t count, const size_t elementSize) noexcept
+	{
+		switch (elementSize) {
+		case 2u: SwapEndianArrayOf<uint16_t>(src, dst, count); break;
+		case 4u: SwapEndianArrayOf<uint32_t>(src, dst, count); break;
+		case 8u: SwapEndianArrayOf<uint64_t>(src, dst, count); break;
+		default:
+			if (src != dst && count > 0u)
+				std::memcpy(dst, src, count * elementSize);
+		}
+	}
+
+	// ---------- Bit Reversal ---------- //
+
+	template <typename _T>
+	static void ReverseBitsArrayOf(const void* src, void* dst, const size_t count) noexcept
+	{
+		const uint8_t* pSrc = reinterpret_cast<const uint8_t*>(src);
+		uint8_t*       pDst = reinterpret_cast<uint8_t*>(dst);
+
+		size_t i = 0u;
+
+#ifdef __WEISS__RUNTIME_DISPATCH
+
+		switch (GetShuffleLevel()) {
+		case ShuffleLevel::AVX2:  i = ReverseBitsAVX2<_T>(pSrc, pDst, count);  break;
+		case ShuffleLevel::SSSE3: i = ReverseBitsSSSE3<_T>(pSrc, pDst, count); break;
+		default:                  break;
+		}
+
+#endif // __WEISS__RUNTIME_DISPATCH
+
+		for (; i < count; i++) {
+			_T value;
+			std::memcpy(&value, pSrc + i * sizeof(_T), sizeof(_T));
+
+			value = WS::ReverseBits(value);
+			std::memcpy(pDst + i * sizeof(_T), &value, sizeof(_T));
+		}
+	}
+
+	void ReverseBitsArray(const void* src, void* dst, const size_t count, const size_t elementSize) noexcept
+	{
+		switch (elementSize) {
+		case 1u: ReverseBitsArrayOf<uint8_t>(src, dst, count);  break;
+		case 2u: ReverseBitsArrayOf<uint16_t>(src, dst, count); break;
+		case 4u: ReverseBitsArrayOf<uint32_t>(src, dst, count); break;
+		case 8u: ReverseBitsArrayOf<uint64_t>(src, dst, count); break;
+		}
+	}
+
+}; // WS
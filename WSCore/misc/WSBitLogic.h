@@ -4,32 +4,85 @@
 
 namespace WS {
 
-    // https://stackoverflow.com/questions/105252/how-do-i-convert-between-big-endian-and-little-endian-values-in-c
-    template <typename _T>
-    inline _T SwapEndian(const _T& u) noexcept
+    // ---------- Scalar ---------- //
+
+    // Compiles to a single bswap / rev instruction, falls back to shifts in constant expressions on MSVC
+    [[nodiscard]] constexpr uint16_t ByteSwap16(const uint16_t value) noexcept
     {
-        union
-        {
-            _T u;
-            unsigned char u8[sizeof(_T)];
-        } source, dest;
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap16(value);
+#else
+        if (!std::is_constant_evaluated())
+            return _byteswap_ushort(value);
 
-        source.u = u;
+        return static_cast<uint16_t>((value << 8u) | (value >> 8u));
+#endif
+    }
 
-        for (size_t k = 0; k < sizeof(_T); k++)
-            dest.u8[k] = source.u8[sizeof(_T) - k - 1];
+    [[nodiscard]] constexpr uint32_t ByteSwap32(const uint32_t value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap32(value);
+#else
+        if (!std::is_constant_evaluated())
+            return _byteswap_ulong(value);
 
-        return dest.u;
+        return (value << 24u) | ((value << 8u) & 0x00FF0000u) | ((value >> 8u) & 0x0000FF00u) | (value >> 24u);
+#endif
     }
 
+    [[nodiscard]] constexpr uint64_t ByteSwap64(const uint64_t value) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap64(value);
+#else
+        if (!std::is_constant_evaluated())
+            return _byteswap_uint64(value);
+
+        return (static_cast<uint64_t>(ByteSwap32(static_cast<uint32_t>(value))) << 32u) | ByteSwap32(static_cast<uint32_t>(value >> 32u));
+#endif
+    }
+
+    // Reverses the bytes of any trivially copyable value (integers, floats, enums)
     template <typename _T>
-    inline _T ReverseBits(const _T& input) noexcept {
-        _T output;
+    [[nodiscard]] constexpr _T SwapEndian(const _T& value) noexcept
+    {
+        static_assert(std::is_trivially_copyable_v<_T>);
 
-        for (size_t i = 0u; i < sizeof(_T) * 8u; i++)
-            output |= ((input >> i) & 1) << (sizeof(_T) * 8u - i - 1u);
+        if constexpr (sizeof(_T) == 1u) {
+            return value;
+        } else if constexpr (sizeof(_T) == 2u) {
+            return std::bit_cast<_T>(ByteSwap16(std::bit_cast<uint16_t>(value)));
+        } else if constexpr (sizeof(_T) == 4u) {
+            return std::bit_cast<_T>(ByteSwap32(std::bit_cast<uint32_t>(value)));
+        } else if constexpr (sizeof(_T) == 8u) {
+            return std::bit_cast<_T>(ByteSwap64(std::bit_cast<uint64_t>(value)));
+        } else {
+            std::array<uint8_t, sizeof(_T)> bytes = std::bit_cast<std::array<uint8_t, sizeof(_T)>>(value);
+            std::reverse(bytes.begin(), bytes.end());
 
-        return output;
+            return std::bit_cast<_T>(bytes);
+        }
+    }
+
+    // Swaps nibbles, bit pairs & bits within every byte, then the bytes themselves
+    template <typename _T>
+    [[nodiscard]] constexpr _T ReverseBits(const _T& input) noexcept
+    {
+        static_assert(std::is_integral_v<_T>);
+
+        using _U = std::make_unsigned_t<_T>;
+
+        constexpr const _U nibbles = static_cast<_U>(0x0F0F0F0F0F0F0F0Full);
+        constexpr const _U pairs   = static_cast<_U>(0x3333333333333333ull);
+        constexpr const _U bits    = static_cast<_U>(0x5555555555555555ull);
+
+        _U value = static_cast<_U>(input);
+        value = static_cast<_U>(((value >> 4u) & nibbles) | ((value & nibbles) << 4u));
+        value = static_cast<_U>(((value >> 2u) & pairs)   | ((value & pairs)   << 2u));
+        value = static_cast<_U>(((value >> 1u) & bits)    | ((value & bits)    << 1u));
+
+        return static_cast<_T>(SwapEndian(value));
     }
 
     inline bool IsCharUppercase(const char character) noexcept {
@@ -37,7 +90,7 @@ namespace WS {
     }
 
     template <typename _T>
-    inline _T FromBigEndian(const _T& val) WS_NOEXCEPT {
+    [[nodiscard]] constexpr _T FromBigEndian(const _T& val) noexcept {
         if constexpr (std::endian::native == std::endian::big) {
             return val;
         } else if constexpr (std::endian::native == std::endian::little) {
@@ -48,7 +101,7 @@ namespace WS {
     }
 
     template <typename _T>
-    inline _T FromLittleEndian(const _T& val) WS_NOEXCEPT {
+    [[nodiscard]] constexpr _T FromLittleEndian(const _T& val) noexcept {
         if constexpr (std::endian::native == std::endian::big) {
             return WS::SwapEndian(val);
         } else if constexpr (std::endian::native == std::endian::little) {
@@ -58,4 +111,58 @@ namespace WS {
         }
     }
 
-}; // WS
\ No newline at end of file
+    // Loads a value stored in big / little endian at any address, i.e in the middle of a file or packet
+    template <typename _T>
+    [[nodiscard]] inline _T ReadBigEndian(const void* data) noexcept
+    {
+        _T value;
+        std::memcpy(&value, data, sizeof(_T));
+
+        return WS::FromBigEndian(value);
+    }
+
+    template <typename _T>
+    [[nodiscard]] inline _T ReadLittleEndian(const void* data) noexcept
+    {
+        _T value;
+        std::memcpy(&value, data, sizeof(_T));
+
+        return WS::FromLittleEndian(value);
+    }
+
+    // ---------- Bulk ---------- //
+
+    /*
+     * Reverses the bytes of "count" values of "elementSize" (2, 4 or 8) bytes, with SSSE3 / AVX2 byte shuffles when the CPU has them.
+     * "src" and "dst" may be the same array (in place) but must not partially overlap.
+     */
+    void SwapEndianArray(const void* src, void* dst, const size_t count, const size_t elementSize) noexcept;
+
+    inline void SwapEndianArray(void* data, const size_t count, const size_t elementSize) noexcept { SwapEndianArray(data, data, count, elementSize); }
+
+    // Reverses the bits of "count" values of "elementSize" (1, 2, 4 or 8) bytes, with SSSE3 / AVX2 nibble lookups when the CPU has them
+    void ReverseBitsArray(const void* src, void* dst, const size_t count, const size_t elementSize) noexcept;
+
+    // "AVX2", "SSSE3" or "scalar", what SwapEndianArray & ReverseBitsArray picked on the running CPU
+    [[nodiscard]] const char* GetByteShuffleImplementation() noexcept;
+
+    // Converts whole arrays, the conversions are their own inverse so they also convert to big / little endian
+    template <typename _T>
+    inline void FromBigEndianArray(const _T* src, _T* dst, const size_t count) noexcept
+    {
+        if constexpr (std::endian::native == std::endian::little)
+            WS::SwapEndianArray(src, dst, count, sizeof(_T));
+        else if (src != dst && count > 0u)
+            std::memcpy(dst, src, count * sizeof(_T));
+    }
+
+    template <typename _T>
+    inline void FromLittleEndianArray(const _T* src, _T* dst, const size_t count) noexcept
+    {
+        if constexpr (std::endian::native == std::endian::big)
+            WS::SwapEndianArray(src, dst, count, sizeof(_T));
+        else if (src != dst && count > 0u)
+            std::memcpy(dst, src, count * sizeof(_T));
+    }
+
+}; // WS
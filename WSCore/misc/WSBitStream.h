@@ -0,0 +1,196 @@
+#pragma once
+
+#include "WSPch.h"
+#include "WSBitLogic.h"
+
+namespace WS {
+
+	enum class BitOrder : uint8_t {
+		LSB_FIRST, // Deflate, snapshots : a byte's least significant bit comes first, values are stored from their least significant bit
+		MSB_FIRST  // JPEG, H.264 : a byte's most significant bit comes first, values are stored from their most significant bit
+	};
+
+	// Widest value a single Read / Peek / Write handles : a refill always leaves at least 56 bits in the buffer
+	constexpr const uint32_t WS_BIT_STREAM_MAX_BITS = 56u;
+
+	// Readable bytes unchecked readers need past the end of their data : refilling a full buffer loads up to 15 bytes past the last bit read
+	constexpr const size_t WS_BIT_STREAM_PADDING = 16u;
+
+	/*
+	 * Reads values of up to 56 bits from a 64 bit buffer, refilled 8 bytes at a time without a loop or a branch per byte.
+	 * Huffman decoders Refill() once, Peek() a code's worth of bits, look its length up & Consume() it.
+	 *
+	 * Checked readers never load past "size" bytes : zeroes are read past the end & HasOverrun() reports it.
+	 * Unchecked readers (trusted input) always load 8 bytes, "data" must be followed by WS_BIT_STREAM_PADDING readable bytes.
+	 */
+	template <BitOrder _ORDER, bool _CHECKED = true>
+	class BitReader {
+	private:
+		const uint8_t* m_pData;
+		size_t         m_size;
+		size_t         m_offset = 0u; // Next byte to load, passes "m_size" once zeroes are read past the end
+		uint64_t       m_bits   = 0u; // Next bit at bit 0 (LSB_FIRST) or bit 63 (MSB_FIRST)
+		uint32_t       m_count  = 0u; // Bits of "m_bits" that are loaded, the ones after them are either zeroes or the next bits
+
+	private:
+		[[nodiscard]] inline uint64_t LoadWord() const noexcept
+		{
+			uint64_t word = 0u;
+
+			if constexpr (_CHECKED) {
+				if (this->m_offset + 8u <= this->m_size)
+					std::memcpy(&word, this->m_pData + this->m_offset, 8u);
+				else if (this->m_offset < this->m_size)
+					std::memcpy(&word, this->m_pData + this->m_offset, this->m_size - this->m_offset);
+			} else {
+				std::memcpy(&word, this->m_pData + this->m_offset, 8u);
+			}
+
+			if constexpr (_ORDER == BitOrder::LSB_FIRST)
+				return WS::FromLittleEndian(word);
+			else
+				return WS::FromBigEndian(word);
+		}
+
+	public:
+		BitReader(const void* data, const size_t size) noexcept : m_pData(reinterpret_cast<const uint8_t*>(data)), m_size(size) {  }
+
+		/*
+		 * Tops the buffer up to 56 - 63 bits : the next 8 bytes are ORed in whole & only the bytes that fully fit are consumed,
+		 * the others are loaded again, at the same place, by the next refill.
+		 */
+		inline void Refill() noexcept
+		{
+			const uint64_t word = this->LoadWord();
+
+			if constexpr (_ORDER == BitOrder::LSB_FIRST)
+				this->m_bits |= word << this->m_count;
+			else
+				this->m_bits |= word >> this->m_count;
+
+			this->m_offset += (63u - this->m_count) >> 3u;
+			this->m_count  |= 56u;
+		}
+
+		// The next "count" (at most GetAvailableBits()) bits, without consuming them
+		[[nodiscard]] inline uint64_t Peek(const uint32_t count) const noexcept
+		{
+			if constexpr (_ORDER == BitOrder::LSB_FIRST)
+				return this->m_bits & ((uint64_t(1u) << count) - 1u);
+			else
+				return (this->m_bits >> 1u) >> (63u - count);
+		}
+
+		inline void Consume(const uint32_t count) noexcept
+		{
+			if constexpr (_ORDER == BitOrder::LSB_FIRST)
+				this->m_bits >>= count;
+			else
+				this->m_bits <<= count;
+
+			this->m_count -= count;
+		}
+
+		// "count" is at most WS_BIT_STREAM_MAX_BITS
+		[[nodiscard]] inline uint64_t Read(const uint32_t count) noexcept
+		{
+			if (this->m_count < count)
+				this->Refill();
+
+			const uint64_t value = this->Peek(count);
+			this->Consume(count);
+
+			return value;
+		}
+
+		[[nodiscard]] inline bool ReadBit() noexcept { return this->Read(1u) != 0u; }
+
+		// Skips to the next byte boundary, i.e before the raw bytes of a stored deflate block
+		inline void AlignToByte() noexcept { this->Consume(this->m_count & 7u); }
+
+		[[nodiscard]] inline uint32_t GetAvailableBits() const noexcept { return this->m_count; }
+		[[nodiscard]] inline size_t   GetBitPosition()   const noexcept { return this->m_offset * 8u - this->m_count; }
+
+		// Whether more bits were read than "size" bytes hold
+		[[nodiscard]] inline bool HasOverrun() const noexcept { return this->GetBitPosition() > this->m_size * 8u; }
+	};
+
+	/*
+	 * Appends values of up to 56 bits to a byte vector, gathered in a 64 bit buffer that is stored 8 bytes at a time.
+	 * The vector holds up to 8 bytes of slack for those stores until Flush(), which pads the last byte with zeroes.
+	 */
+	template <BitOrder _ORDER>
+	class BitWriter {
+	private:
+		std::vector<uint8_t>& m_output;
+		size_t                m_start;
+		size_t                m_size;         // Bytes stored, "m_output" is larger until Flush()
+		uint64_t              m_bits  = 0u;   // The last "m_count" bits, from bit 0 (LSB_FIRST) or ending at bit 0 (MSB_FIRST)
+		uint32_t              m_count = 0u;   // At most 63
+
+	private:
+		// Stores the whole bytes of the buffer
+		inline void Commit() noexcept
+		{
+			if (this->m_output.size() < this->m_size + 8u)
+				this->m_output.resize(std::max(this->m_size + 8u, this->m_output.size() * 2u));
+
+			// Both conversions are their own inverse
+			uint64_t word;
+
+			if constexpr (_ORDER == BitOrder::LSB_FIRST)
+				word = WS::FromLittleEndian(this->m_bits);
+			else
+				word = WS::FromBigEndian(this->m_bits << (64u - this->m_count));
+
+			std::memcpy(this->m_output.data() + this->m_size, &word, 8u);
+
+			const uint32_t nBytes = this->m_count >> 3u;
+
+			if constexpr (_ORDER == BitOrder::LSB_FIRST)
+				this->m_bits >>= nBytes * 8u;
+
+			this->m_size  += nBytes;
+			this->m_count &= 7u;
+		}
+
+	public:
+		explicit BitWriter(std::vector<uint8_t>& output) noexcept : m_output(output), m_start(output.size()), m_size(output.size()) {  }
+
+		// The "count" (at most WS_BIT_STREAM_MAX_BITS) low bits of "value"
+		inline void Write(const uint64_t value, const uint32_t count) noexcept
+		{
+			if (this->m_count + count > 63u)
+				this->Commit();
+
+			const uint64_t bits = value & ((uint64_t(1u) << count) - 1u);
+
+			if constexpr (_ORDER == BitOrder::LSB_FIRST)
+				this->m_bits |= bits << this->m_count;
+			else
+				this->m_bits = (this->m_bits << count) | bits;
+
+			this->m_count += count;
+		}
+
+		inline void WriteBit(const bool bit) noexcept { this->Write(bit ? 1u : 0u, 1u); }
+
+		inline void AlignToByte() noexcept { this->Write(0u, (8u - (this->m_count & 7u)) & 7u); }
+
+		// Bits written since the writer was created
+		[[nodiscard]] inline size_t GetBitCount() const noexcept { return (this->m_size - this->m_start) * 8u + this->m_count; }
+
+		// Pads to a whole byte & trims "m_output" to the bytes written, the writer can be used again afterwards
+		inline void Flush() noexcept
+		{
+			this->AlignToByte();
+
+			if (this->m_count > 0u)
+				this->Commit();
+
+			this->m_output.resize(this->m_size);
+			this->m_bits = 0u;
+		}
+	};
+
+}; // WS
@@ -0,0 +1,471 @@
+#include "WSChecksum.h"
+#include "WSBitLogic.h"
+#include "WSCpuFeatures.h"
+
+namespace WS {
+
+	constexpr const uint32_t CRC32_POLYNOMIAL  = 0xEDB88320u; // 0x04C11DB7 bit reversed
+	constexpr const uint32_t CRC32C_POLYNOMIAL = 0x82F63B78u; // 0x1EDC6F41 bit reversed
+
+	constexpr const uint32_t ADLER32_BASE = 65521u;
+	constexpr const size_t   ADLER32_NMAX = 5552u; // Bytes summed before the sums could overflow 32 bits & have to be reduced
+
+	// ---------- CRC Arithmetic ---------- //
+
+	/*
+	 * CRCs are remainders of polynomials over GF(2), bit reversed : bit 31 is x^0.
+	 * Multiplying a CRC register by x^(8 n) modulo the polynomial is what feeding it n zero bytes does,
+	 * which is all that combining CRCs of consecutive ranges needs.
+	 */
+	template <uint32_t _POLYNOMIAL>
+	[[nodiscard]] static constexpr uint32_t MultiplyModulo(uint32_t a, uint32_t b) noexcept
+	{
+		uint32_t product = 0u;
+
+		for (uint32_t m = 1u << 31u; m != 0u; m >>= 1u) {
+			if (a & m)
+				product ^= b;
+
+			b = (b & 1u) ? (b >> 1u) ^ _POLYNOMIAL : b >> 1u;
+		}
+
+		return product;
+	}
+
+	// x^(8 nBytes) modulo the polynomial, by squaring
+	template <uint32_t _POLYNOMIAL>
+	[[nodiscard]] static constexpr uint32_t GetZeroBytesOperator(size_t nBytes) noexcept
+	{
+		uint32_t power  = 1u << 31u; // x^0
+		uint32_t square = 1u << 23u; // x^8
+
+		for (; nBytes > 0u; nBytes >>= 1u) {
+			if (nBytes & 1u)
+				power = MultiplyModulo<_POLYNOMIAL>(square, power);
+
+			square = MultiplyModulo<_POLYNOMIAL>(square, square);
+		}
+
+		return power;
+	}
+
+	// Slicing by 8 : table i gives the CRC of a byte followed by i zero bytes
+	template <uint32_t _POLYNOMIAL>
+	[[nodiscard]] static constexpr std::array<std::array<uint32_t, 256u>, 8u> MakeCrcTables() noexcept
+	{
+		std::array<std::array<uint32_t, 256u>, 8u> tables{};
+
+		for (uint32_t b = 0u; b < 256u; b++) {
+			uint32_t crc = b;
+
+			for (uint32_t k = 0u; k < 8u; k++)
+				crc = (crc & 1u) ? (crc >> 1u) ^ _POLYNOMIAL : crc >> 1u;
+
+			tables[0][b] = crc;
+		}
+
+		for (size_t t = 1u; t < 8u; t++)
+			for (size_t b = 0u; b < 256u; b++)
+				tables[t][b] = (tables[t - 1u][b] >> 8u) ^ tables[0][tables[t - 1u][b] & 0xFFu];
+
+		return tables;
+	}
+
+	template <uint32_t _POLYNOMIAL>
+	alignas(64) static constexpr std::array<std::array<uint32_t, 256u>, 8u> CRC_TABLES = MakeCrcTables<_POLYNOMIAL>();
+
+	// The kernels take & return the CRC register, before the final inversion
+	template <uint32_t _POLYNOMIAL>
+	[[nodiscard]] static uint32_t CrcTables(const uint8_t* data, size_t size, uint32_t crc) noexcept
+	{
+		const std::array<std::array<uint32_t, 256u>, 8u>& tables = CRC_TABLES<_POLYNOMIAL>;
+
+		for (; size >= 8u; size -= 8u, data += 8u) {
+			const uint64_t word = WS::ReadLittleEndian<uint64_t>(data) ^ crc;
+
+			crc = tables[7][word & 0xFFu]         ^ tables[6][(word >> 8u) & 0xFFu]  ^ tables[5][(word >> 16u) & 0xFFu] ^ tables[4][(word >> 24u) & 0xFFu] ^
+			      tables[3][(word >> 32u) & 0xFFu] ^ tables[2][(word >> 40u) & 0xFFu] ^ tables[1][(word >> 48u) & 0xFFu] ^ tables[0][word >> 56u];
+		}
+
+		for (; size > 0u; size--)
+			crc = (crc >> 8u) ^ tables[0][(crc ^ *data++) & 0xFFu];
+
+		return crc;
+	}
+
+	// ---------- Adler-32 ---------- //
+
+	[[nodiscard]] static uint32_t Adler32Scalar(const uint8_t* data, size_t size, const uint32_t adler) noexcept
+	{
+		uint32_t s1 = adler & 0xFFFFu;
+		uint32_t s2 = adler >> 16u;
+
+		while (size > 0u) {
+			const size_t n = std::min(size, ADLER32_NMAX);
+
+			for (size_t i = 0u; i < n; i++) {
+				s1 += data[i];
+				s2 += s1;
+			}
+
+			s1 %= ADLER32_BASE;
+			s2 %= ADLER32_BASE;
+
+			data += n;
+			size -= n;
+		}
+
+		return (s2 << 16u) | s1;
+	}
+
+#ifdef __WEISS__RUNTIME_DISPATCH
+
+	// ---------- PCLMULQDQ CRC32 ---------- //
+
+	/*
+	 * Folds 4 x 128 bits at a time with carry-less multiplications by x^(512 +- 32) & x^(448 +- 32), then folds them into one,
+	 * then reduces it to 32 bits with a Barrett reduction. Constants of "Fast CRC Computation for Generic Polynomials
+	 * Using PCLMULQDQ Instruction" (Intel, 2009) for the bit reversed CRC32 polynomial.
+	 */
+	alignas(16) static constexpr uint64_t CRC32_FOLD_BY_4[2]  = { 0x0154442BD4u, 0x01C6E41596u };
+	alignas(16) static constexpr uint64_t CRC32_FOLD_BY_1[2]  = { 0x01751997D0u, 0x00CCAA009Eu };
+	alignas(16) static constexpr uint64_t CRC32_FOLD_TO_64[2] = { 0x0163CD6124u, 0x0000000000u };
+	alignas(16) static constexpr uint64_t CRC32_BARRETT[2]    = { 0x01DB710641u, 0x01F7011641u };
+
+	// A single stream of dependent folds leaves few loads in flight : without prefetches large buffers run at half speed
+	constexpr const size_t CRC32_PREFETCH_DISTANCE = 4096u;
+
+	WS_TARGET("pclmul,sse4.1")
+	[[nodiscard]] static uint32_t Crc32PCLMUL(const uint8_t* data, size_t size, uint32_t crc) noexcept
+	{
+		if (size < 64u)
+			return CrcTables<CRC32_POLYNOMIAL>(data, size, crc);
+
+		__m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		__m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16u));
+		__m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32u));
+		__m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48u));
+
+		x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+
+		data += 64u;
+		size -= 64u;
+
+		__m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(CRC32_FOLD_BY_4));
+
+		for (; size >= 64u; data += 64u, size -= 64u) {
+			_mm_prefetch(reinterpret_cast<const char*>(data + CRC32_PREFETCH_DISTANCE), _MM_HINT_T0);
+
+			const __m128i low1 = _mm_clmulepi64_si128(x1, k, 0x00);
+			const __m128i low2 = _mm_clmulepi64_si128(x2, k, 0x00);
+			const __m128i low3 = _mm_clmulepi64_si128(x3, k, 0x00);
+			const __m128i low4 = _mm_clmulepi64_si128(x4, k, 0x00);
+
+			x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), low1), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+			x2 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x2, k, 0x11), low2), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16u)));
+			x3 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x3, k, 0x11), low3), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32u)));
+			x4 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x4, k, 0x11), low4), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48u)));
+		}
+
+		// Folds the 4 registers & the remaining 16 byte blocks into one
+		k = _mm_load_si128(reinterpret_cast<const __m128i*>(CRC32_FOLD_BY_1));
+
+		x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), x2);
+		x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), x3);
+		x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), x4);
+
+		for (; size >= 16u; data += 16u, size -= 16u)
+			x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)),
+			                   _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)));
+
+		// 128 to 64 bits
+		const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+
+		x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), _mm_clmulepi64_si128(x1, k, 0x10));
+
+		k  = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(CRC32_FOLD_TO_64));
+		x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x00), _mm_srli_si128(x1, 4));
+
+		// 64 to 32 bits
+		k = _mm_load_si128(reinterpret_cast<const __m128i*>(CRC32_BARRETT));
+
+		__m128i quotient = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x10);
+		quotient = _mm_clmulepi64_si128(_mm_and_si128(quotient, mask32), k, 0x00);
+
+		crc = static_cast<uint32_t>(_mm_extract_epi32(_mm_xor_si128(x1, quotient), 1));
+
+		return CrcTables<CRC32_POLYNOMIAL>(data, size, crc);
+	}
+
+	// ---------- SSE4.2 CRC32C ---------- //
+
+	/*
+	 * crc32 has a latency of 3 cycles but a throughput of 1 : three lanes of a block are checksummed at once,
+	 * then the first two are shifted over the bytes that follow them, with tables of the x^(8 _LANE) multiplication.
+	 */
+	constexpr const size_t CRC32C_LONG_LANE  = 8192u;
+	constexpr const size_t CRC32C_SHORT_LANE = 256u;
+
+	template <size_t _LANE>
+	[[nodiscard]] static constexpr std::array<std::array<uint32_t, 256u>, 4u> MakeCrc32CShiftTables() noexcept
+	{
+		const uint32_t operation = GetZeroBytesOperator<CRC32C_POLYNOMIAL>(_LANE);
+
+		std::array<std::array<uint32_t, 256u>, 4u> tables{};
+
+		for (uint32_t t = 0u; t < 4u; t++)
+			for (uint32_t b = 0u; b < 256u; b++)
+				tables[t][b] = MultiplyModulo<CRC32C_POLYNOMIAL>(operation, b << (8u * t));
+
+		return tables;
+	}
+
+	template <size_t _LANE>
+	alignas(64) static constexpr std::array<std::array<uint32_t, 256u>, 4u> CRC32C_SHIFT_TABLES = MakeCrc32CShiftTables<_LANE>();
+
+	template <size_t _LANE>
+	[[nodiscard]] static inline uint32_t ShiftCrc32C(const uint32_t crc) noexcept
+	{
+		const std::array<std::array<uint32_t, 256u>, 4u>& tables = CRC32C_SHIFT_TABLES<_LANE>;
+
+		return tables[0][crc & 0xFFu] ^ tables[1][(crc >> 8u) & 0xFFu] ^ tables[2][(crc >> 16u) & 0xFFu] ^ tables[3][crc >> 24u];
+	}
+
+	// Consumes the blocks of 3 lanes of "data"
+	template <size_t _LANE>
+	WS_TARGET("sse4.2")
+	[[nodiscard]] static uint32_t Crc32CLanes(const uint8_t*& data, size_t& size, uint32_t crc) noexcept
+	{
+		for (; size >= 3u * _LANE; data += 3u * _LANE, size -= 3u * _LANE) {
+			uint64_t crc0 = crc, crc1 = 0u, crc2 = 0u;
+
+			for (size_t i = 0u; i < _LANE; i += 8u) {
+				crc0 = _mm_crc32_u64(crc0, WS::ReadLittleEndian<uint64_t>(data + i));
+				crc1 = _mm_crc32_u64(crc1, WS::ReadLittleEndian<uint64_t>(data + _LANE + i));
+				crc2 = _mm_crc32_u64(crc2, WS::ReadLittleEndian<uint64_t>(data + 2u * _LANE + i));
+			}
+
+			crc = ShiftCrc32C<_LANE>(ShiftCrc32C<_LANE>(static_cast<uint32_t>(crc0)) ^ static_cast<uint32_t>(crc1)) ^ static_cast<uint32_t>(crc2);
+		}
+
+		return crc;
+	}
+
+	WS_TARGET("sse4.2")
+	[[nodiscard]] static uint32_t Crc32CSSE42(const uint8_t* data, size_t size, uint32_t crc) noexcept
+	{
+		crc = Crc32CLanes<CRC32C_LONG_LANE>(data, size, crc);
+		crc = Crc32CLanes<CRC32C_SHORT_LANE>(data, size, crc);
+
+		uint64_t crc64 = crc;
+		for (; size >= 8u; data += 8u, size -= 8u)
+			crc64 = _mm_crc32_u64(crc64, WS::ReadLittleEndian<uint64_t>(data));
+
+		crc = static_cast<uint32_t>(crc64);
+		for (; size > 0u; size--)
+			crc = _mm_crc32_u8(crc, *data++);
+
+		return crc;
+	}
+
+	// ---------- SIMD Adler-32 ---------- //
+
+	/*
+	 * Per block of 32 bytes : s2 grows by 32 times s1 before the block plus the bytes weighted from 32 down to 1.
+	 * psadbw sums the bytes, pmaddubsw & pmaddwd weigh them, the sums of s1 before every block are kept apart & multiplied by 32 once.
+	 */
+	WS_TARGET("ssse3")
+	[[nodiscard]] static uint32_t Adler32SSSE3(const uint8_t* data, const size_t size, const uint32_t adler) noexcept
+	{
+		uint32_t s1      = adler & 0xFFFFu;
+		uint32_t s2      = adler >> 16u;
+		size_t   nBlocks = size / 32u;
+
+		const __m128i weights1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+		const __m128i weights2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1);
+		const __m128i ones     = _mm_set1_epi16(1);
+		const __m128i zero     = _mm_setzero_si128();
+
+		while (nBlocks > 0u) {
+			const size_t n = std::min(nBlocks, ADLER32_NMAX / 32u);
+			nBlocks -= n;
+
+			__m128i previousS1 = zero, vs1 = zero, vs2 = zero;
+
+			for (size_t b = 0u; b < n; b++, data += 32u) {
+				const __m128i bytes1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+				const __m128i bytes2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16u));
+
+				previousS1 = _mm_add_epi32(previousS1, vs1);
+
+				vs1 = _mm_add_epi32(vs1, _mm_add_epi32(_mm_sad_epu8(bytes1, zero), _mm_sad_epu8(bytes2, zero)));
+				vs2 = _mm_add_epi32(vs2, _mm_add_epi32(_mm_madd_epi16(_mm_maddubs_epi16(bytes1, weights1), ones),
+				                                       _mm_madd_epi16(_mm_maddubs_epi16(bytes2, weights2), ones)));
+			}
+
+			vs2 = _mm_add_epi32(vs2, _mm_slli_epi32(previousS1, 5));
+
+			vs1 = _mm_add_epi32(vs1, _mm_shuffle_epi32(vs1, _MM_SHUFFLE(1, 0, 3, 2)));
+			vs1 = _mm_add_epi32(vs1, _mm_shuffle_epi32(vs1, _MM_SHUFFLE(2, 3, 0, 1)));
+			vs2 = _mm_add_epi32(vs2, _mm_shuffle_epi32(vs2, _MM_SHUFFLE(1, 0, 3, 2)));
+			vs2 = _mm_add_epi32(vs2, _mm_shuffle_epi32(vs2, _MM_SHUFFLE(2, 3, 0, 1)));
+
+			const uint64_t sum2 = uint64_t(s2) + uint64_t(s1) * 32u * n + static_cast<uint32_t>(_mm_cvtsi128_si32(vs2));
+			const uint64_t sum1 = uint64_t(s1) + static_cast<uint32_t>(_mm_cvtsi128_si32(vs1));
+
+			s1 = static_cast<uint32_t>(sum1 % ADLER32_BASE);
+			s2 = static_cast<uint32_t>(sum2 % ADLER32_BASE);
+		}
+
+		return Adler32Scalar(data, size % 32u, (s2 << 16u) | s1);
+	}
+
+	WS_TARGET("avx2")
+	[[nodiscard]] static inline uint32_t HorizontalSum(const __m256i values) noexcept
+	{
+		__m128i sum = _mm_add_epi32(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1));
+
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+		sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+
+		return static_cast<uint32_t>(_mm_cvtsi128_si32(sum));
+	}
+
+	WS_TARGET("avx2")
+	[[nodiscard]] static uint32_t Adler32AVX2(const uint8_t* data, const size_t size, const uint32_t adler) noexcept
+	{
+		uint32_t s1      = adler & 0xFFFFu;
+		uint32_t s2      = adler >> 16u;
+		size_t   nBlocks = size / 32u;
+
+		const __m256i weights = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+		                                         16, 15, 14, 13, 12, 11, 10,  9,  8,  7,  6,  5,  4,  3,  2,  1);
+		const __m256i ones    = _mm256_set1_epi16(1);
+		const __m256i zero    = _mm256_setzero_si256();
+
+		while (nBlocks > 0u) {
+			const size_t n = std::min(nBlocks, ADLER32_NMAX / 32u);
+			nBlocks -= n;
+
+			__m256i previousS1 = zero, vs1 = zero, vs2 = zero;
+
+			for (size_t b = 0u; b < n; b++, data += 32u) {
+				const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+
+				previousS1 = _mm256_add_epi32(previousS1, vs1);
+
+				vs1 = _mm256_add_epi32(vs1, _mm256_sad_epu8(bytes, zero));
+				vs2 = _mm256_add_epi32(vs2, _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, weights), ones));
+			}
+
+			vs2 = _mm256_add_epi32(vs2, _mm256_slli_epi32(previousS1, 5));
+
+			const uint64_t sum2 = uint64_t(s2) + uint64_t(s1) * 32u * n + HorizontalSum(vs2);
+			const uint64_t sum1 = uint64_t(s1) + HorizontalSum(vs1);
+
+			s1 = static_cast<uint32_t>(sum1 % ADLER32_BASE);
+			s2 = static_cast<uint32_t>(sum2 % ADLER32_BASE);
+		}
+
+		return Adler32Scalar(data, size % 32u, (s2 << 16u) | s1);
+	}
+
+#endif // __WEISS__RUNTIME_DISPATCH
+
+	// ---------- Dispatch ---------- //
+
+	struct ChecksumFunctions {
+		uint32_t (*m_pCrc32)(const uint8_t*, size_t, uint32_t);
+		uint32_t (*m_pCrc32C)(const uint8_t*, size_t, uint32_t);
+		uint32_t (*m_pAdler32)(const uint8_t*, size_t, uint32_t);
+
+		const char* m_crc32Name;
+		const char* m_crc32CName;
+		const char* m_adler32Name;
+	};
+
+	[[nodiscard]] static ChecksumFunctions SelectChecksumFunctions() noexcept
+	{
+		ChecksumFunctions functions = { &CrcTables<CRC32_POLYNOMIAL>, &CrcTables<CRC32C_POLYNOMIAL>, &Adler32Scalar, "tables", "tables", "scalar" };
+
+#ifdef __WEISS__RUNTIME_DISPATCH
+
+		if (HasCpuFeature(CpuFeature::PCLMUL) && HasCpuFeature(CpuFeature::SSE41)) {
+			functions.m_pCrc32    = &Crc32PCLMUL;
+			functions.m_crc32Name = "PCLMULQDQ";
+		}
+
+		if (HasCpuFeature(CpuFeature::SSE42)) {
+			functions.m_pCrc32C    = &Crc32CSSE42;
+			functions.m_crc32CName = "SSE4.2";
+		}
+
+		if (HasCpuFeature(CpuFeature::AVX2)) {
+			functions.m_pAdler32    = &Adler32AVX2;
+			functions.m_adler32Name = "AVX2";
+		} else if (HasCpuFeature(CpuFeature::SSSE3)) {
+			functions.m_pAdler32    = &Adler32SSSE3;
+			functions.m_adler32Name = "SSSE3";
+		}
+
+#endif // __WEISS__RUNTIME_DISPATCH
+
+		return functions;
+	}
+
+	[[nodiscard]] static const ChecksumFunctions& GetChecksumFunctions() noexcept
+	{
+		static const ChecksumFunctions functions = SelectChecksumFunctions();
+
+		return functions;
+	}
+
+	// ---------- Public Interface ---------- //
+
+	uint32_t Crc32(const void* data, const size_t size, const uint32_t crc) noexcept
+	{
+		return ~GetChecksumFunctions().m_pCrc32(reinterpret_cast<const uint8_t*>(data), size, ~crc);
+	}
+
+	uint32_t Crc32C(const void* data, const size_t size, const uint32_t crc) noexcept
+	{
+		return ~GetChecksumFunctions().m_pCrc32C(reinterpret_cast<const uint8_t*>(data), size, ~crc);
+	}
+
+	uint32_t Adler32(const void* data, const size_t size, const uint32_t adler) noexcept
+	{
+		return GetChecksumFunctions().m_pAdler32(reinterpret_cast<const uint8_t*>(data), size, adler);
+	}
+
+	// The initial & final inversions of A's & B's CRCs cancel out : only A's CRC has to be shifted over B's bytes
+	uint32_t CombineCrc32(const uint32_t crcA, const uint32_t crcB, const size_t sizeB) noexcept
+	{
+		return MultiplyModulo<CRC32_POLYNOMIAL>(GetZeroBytesOperator<CRC32_POLYNOMIAL>(sizeB), crcA) ^ crcB;
+	}
+
+	uint32_t CombineCrc32C(const uint32_t crcA, const uint32_t crcB, const size_t sizeB) noexcept
+	{
+		return MultiplyModulo<CRC32C_POLYNOMIAL>(GetZeroBytesOperator<CRC32C_POLYNOMIAL>(sizeB), crcA) ^ crcB;
+	}
+
+	// B's sums started from s1 = 1 & s2 = 0 : A's s1 is added to every byte's s1 & to s2 once per byte
+	uint32_t CombineAdler32(const uint32_t adlerA, const uint32_t adlerB, const size_t sizeB) noexcept
+	{
+		const uint64_t remainder = sizeB % ADLER32_BASE;
+		const uint64_t s1A = adlerA & 0xFFFFu, s2A = adlerA >> 16u;
+		const uint64_t s1B = adlerB & 0xFFFFu, s2B = adlerB >> 16u;
+
+		const uint64_t s1 = (s1A + s1B + ADLER32_BASE - 1u) % ADLER32_BASE;
+		const uint64_t s2 = (s2A + s2B + remainder * s1A + ADLER32_BASE - remainder) % ADLER32_BASE;
+
+		return static_cast<uint32_t>((s2 << 16u) | s1);
+	}
+
+	std::string GetChecksumImplementations() noexcept
+	{
+		const ChecksumFunctions& functions = GetChecksumFunctions();
+
+		return std::string("CRC32 : ") + functions.m_crc32Name + ", CRC32C : " + functions.m_crc32CName + ", Adler-32 : " + functions.m_adler32Name;
+	}
+
+}; // WS
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "WSPch.h"
+
+namespace WS {
+
+	/*
+	 * Checksums of byte ranges, each picks its fastest implementation on the running CPU the first time it is called :
+	 *   CRC32    : zlib / PNG / gzip polynomial, folded with PCLMULQDQ (slicing by 8 tables otherwise)
+	 *   CRC32C   : Castagnoli polynomial (iSCSI, ext4), three interleaved SSE4.2 crc32 streams (tables otherwise)
+	 *   Adler-32 : zlib streams, AVX2 or SSSE3 sums of 32 bytes at a time (scalar otherwise)
+	 * Passing a previous result continues it over the next bytes, the defaults start a new checksum.
+	 */
+	[[nodiscard]] uint32_t Crc32(const void* data, const size_t size, const uint32_t crc = 0u) noexcept;
+	[[nodiscard]] uint32_t Crc32C(const void* data, const size_t size, const uint32_t crc = 0u) noexcept;
+	[[nodiscard]] uint32_t Adler32(const void* data, const size_t size, const uint32_t adler = 1u) noexcept;
+
+	/*
+	 * The checksum of A followed by B from the checksums of A & B & the size of B, so that parts of a buffer
+	 * can be checksummed on several threads. Costs O(log(sizeB)), independent of the data.
+	 */
+	[[nodiscard]] uint32_t CombineCrc32(const uint32_t crcA, const uint32_t crcB, const size_t sizeB) noexcept;
+	[[nodiscard]] uint32_t CombineCrc32C(const uint32_t crcA, const uint32_t crcB, const size_t sizeB) noexcept;
+	[[nodiscard]] uint32_t CombineAdler32(const uint32_t adlerA, const uint32_t adlerB, const size_t sizeB) noexcept;
+
+	// "CRC32 : PCLMULQDQ, CRC32C : SSE4.2, Adler-32 : AVX2", what the dispatch picked
+	[[nodiscard]] std::string GetChecksumImplementations() noexcept;
+
+}; // WS
@@ -0,0 +1,64 @@
+#include "WSCpuFeatures.h"
+
+#if defined(__WEISS__RUNTIME_DISPATCH) && !defined(__GNUC__) && !defined(__clang__)
+
+	#include <intrin.h>
+
+#endif
+
+namespace WS {
+
+	bool HasCpuFeature(const CpuFeature feature) noexcept
+	{
+#ifdef __WEISS__RUNTIME_DISPATCH
+
+	#if defined(__GNUC__) || defined(__clang__)
+
+		switch (feature) {
+		case CpuFeature::SSSE3:  return __builtin_cpu_supports("ssse3");
+		case CpuFeature::SSE41:  return __builtin_cpu_supports("sse4.1");
+		case CpuFeature::SSE42:  return __builtin_cpu_supports("sse4.2");
+		case CpuFeature::PCLMUL: return __builtin_cpu_supports("pclmul");
+		case CpuFeature::AVX2:   return __builtin_cpu_supports("avx2");
+		case CpuFeature::F16C:   return __builtin_cpu_supports("f16c");
+		default:                 return false;
+		}
+
+	#else
+
+		int info[4];
+		__cpuid(info, 1);
+
+		const uint32_t ecx = static_cast<uint32_t>(info[2]);
+
+		// The OS also has to save the ymm registers, F16C & AVX2 are VEX encoded
+		const bool bAVX = ((ecx >> 27u) & 1u) && ((ecx >> 28u) & 1u) && (_xgetbv(0) & 6u) == 6u;
+
+		switch (feature) {
+		case CpuFeature::SSSE3:  return (ecx >> 9u) & 1u;
+		case CpuFeature::SSE41:  return (ecx >> 19u) & 1u;
+		case CpuFeature::SSE42:  return (ecx >> 20u) & 1u;
+		case CpuFeature::PCLMUL: return (ecx >> 1u) & 1u;
+		case CpuFeature::F16C:   return bAVX && ((ecx >> 29u) & 1u);
+		case CpuFeature::AVX2:
+			if (!bAVX)
+				return false;
+
+			__cpuidex(info, 7, 0);
+			return (static_cast<uint32_t>(info[1]) >> 5u) & 1u;
+		default:
+			return false;
+		}
+
+	#endif
+
+#else
+
+		static_cast<void>(feature);
+
+		return false;
+
+#endif // __WEISS__RUNTIME_DISPATCH
+	}
+
+}; // WS
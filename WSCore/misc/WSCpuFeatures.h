@@ -0,0 +1,36 @@
+#pragma once
+
+#include "WSPch.h"
+
+/*
+ * The build enables no instruction set past the x86-64 baseline (SSE2) : kernels using a newer one are compiled
+ * for it alone with WS_TARGET("isa") & only called once HasCpuFeature() found it on the running CPU.
+ * MSVC compiles any intrinsic without flags, WS_TARGET is then empty.
+ */
+#if !defined(__WEISS__DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+
+	#define __WEISS__RUNTIME_DISPATCH
+
+	#if defined(__GNUC__) || defined(__clang__)
+		#define WS_TARGET(isa) __attribute__((target(isa)))
+	#else
+		#define WS_TARGET(isa)
+	#endif
+
+#endif
+
+namespace WS {
+
+	enum class CpuFeature : uint8_t {
+		SSSE3,
+		SSE41,
+		SSE42,
+		PCLMUL,
+		AVX2,
+		F16C
+	};
+
+	// Whether the running CPU (& OS, for the features using ymm registers) supports "feature", always false without __WEISS__RUNTIME_DISPATCH
+	[[nodiscard]] bool HasCpuFeature(const CpuFeature feature) noexcept;
+
+}; // WS
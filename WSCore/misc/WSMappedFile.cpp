@@ -0,0 +1,89 @@
+#include "WSMappedFile.h"
+
+namespace WS {
+
+#ifdef __WEISS__OS_WINDOWS
+
+	MappedFile::MappedFile(const char* filepath) WS_NOEXCEPT
+	{
+		this->m_fileHandle = CreateFileA(filepath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (this->m_fileHandle == INVALID_HANDLE_VALUE) {
+			WS_THROW("[WS] Could Not Open File To Map");
+			return;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(this->m_fileHandle, &fileSize)) {
+			WS_THROW("[WS] Could Not Get The Size Of The File To Map");
+			return;
+		}
+
+		this->m_size = static_cast<size_t>(fileSize.QuadPart);
+
+		this->m_mappingHandle = CreateFileMappingA(this->m_fileHandle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+		if (this->m_mappingHandle == NULL) {
+			WS_THROW("[WS] Could Not Create File Mapping");
+			return;
+		}
+
+		this->m_pData = static_cast<uint8_t*>(MapViewOfFile(this->m_mappingHandle, FILE_MAP_COPY, 0, 0, 0));
+		if (this->m_pData == nullptr)
+			WS_THROW("[WS] Could Not Map File");
+	}
+
+	MappedFile::~MappedFile() noexcept
+	{
+		if (this->m_pData != nullptr)
+			UnmapViewOfFile(this->m_pData);
+
+		if (this->m_mappingHandle != NULL)
+			CloseHandle(this->m_mappingHandle);
+
+		if (this->m_fileHandle != INVALID_HANDLE_VALUE)
+			CloseHandle(this->m_fileHandle);
+	}
+
+#elif defined(__WEISS__OS_LINUX)
+
+	MappedFile::MappedFile(const char* filepath) WS_NOEXCEPT
+	{
+		const int fd = open(filepath, O_RDONLY);
+		if (fd < 0) {
+			WS_THROW("[WS] Could Not Open File To Map");
+			return;
+		}
+
+		struct stat fileStat;
+		if (fstat(fd, &fileStat) < 0) {
+			close(fd);
+			WS_THROW("[WS] Could Not Get The Size Of The File To Map");
+			return;
+		}
+
+		this->m_size = static_cast<size_t>(fileStat.st_size);
+
+		// The mapping keeps its own reference to the file, the descriptor isn't needed afterwards
+		void* pData = mmap(nullptr, this->m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+		close(fd);
+
+		if (pData == MAP_FAILED) {
+			WS_THROW("[WS] Could Not Map File");
+			return;
+		}
+
+		this->m_pData = static_cast<uint8_t*>(pData);
+	}
+
+	MappedFile::~MappedFile() noexcept
+	{
+		if (this->m_pData != nullptr)
+			munmap(this->m_pData, this->m_size);
+	}
+
+#else
+
+	#error WSMappedFile Is Not Supported On Your Platform
+
+#endif
+
+}; // WS
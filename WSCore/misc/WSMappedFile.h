@@ -0,0 +1,42 @@
+#pragma once
+
+#include "WSPch.h"
+
+namespace WS {
+
+	/*
+	 * Maps a whole file in memory, copy-on-write :
+	 * the mapping can be written to but the changes never reach the file on disk.
+	 * Pages are only read from disk when they are first touched.
+	 */
+	class MappedFile {
+	private:
+		uint8_t* m_pData = nullptr;
+		size_t   m_size  = 0u;
+
+#ifdef __WEISS__OS_WINDOWS
+
+		HANDLE m_fileHandle    = INVALID_HANDLE_VALUE;
+		HANDLE m_mappingHandle = NULL;
+
+#endif // __WEISS__OS_WINDOWS
+
+	public:
+		MappedFile() = default;
+
+		MappedFile(const char* filepath) WS_NOEXCEPT;
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		[[nodiscard]] inline bool IsMapped() const noexcept { return this->m_pData != nullptr; }
+
+		[[nodiscard]] inline       uint8_t* GetData()       noexcept { return this->m_pData; }
+		[[nodiscard]] inline const uint8_t* GetData() const noexcept { return this->m_pData; }
+
+		[[nodiscard]] inline size_t GetSize() const noexcept { return this->m_size; }
+
+		~MappedFile() noexcept;
+	};
+
+}; // WS
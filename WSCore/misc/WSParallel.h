@@ -0,0 +1,39 @@
+#pragma once
+
+#include "WSPch.h"
+
+namespace WS {
+
+	/*
+	 * Splits the range [0, count) into one contiguous chunk per hardware thread
+	 * and calls "function(begin, end)" on each of them.
+	 * The calling thread processes the first chunk and waits for the others.
+	 * Ranges smaller than "minParallelCount" are processed entirely on the calling thread
+	 * since spawning threads would cost more than the work itself.
+	 */
+	template <typename _F>
+	inline void ParallelFor(const size_t count, const size_t minParallelCount, _F&& function)
+	{
+		const size_t nHardwareThreads = std::max<size_t>(1u, std::thread::hardware_concurrency());
+		const size_t nChunks          = std::min(nHardwareThreads, std::max<size_t>(1u, count / std::max<size_t>(1u, minParallelCount)));
+
+		if (count < minParallelCount || nChunks <= 1u) {
+			function(size_t(0u), count);
+			return;
+		}
+
+		const size_t chunkSize = (count + nChunks - 1u) / nChunks;
+
+		std::vector<std::thread> workers;
+		workers.reserve(nChunks - 1u);
+
+		for (size_t begin = chunkSize; begin < count; begin += chunkSize)
+			workers.emplace_back([&function, begin, end = std::min(begin + chunkSize, count)]() { function(begin, end); });
+
+		function(size_t(0u), std::min(chunkSize, count));
+
+		for (std::thread& worker : workers)
+			worker.join();
+	}
+
+}; // WS
@@ -74,12 +74,57 @@
 	// Vulkan
 	#define VK_USE_PLATFORM_XLIB_KHR
 
+	// Files & Memory Mapping
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <sys/resource.h>
+
+	// Thread Affinity
+	#include <sched.h>
+
 	// Sockets
 	#include <netdb.h>
 	#include <arpa/inet.h>
 	#include <sys/types.h>
 	#include <sys/socket.h>
+	#include <sys/un.h>
 	#include <netinet/in.h>
+	#include <netinet/tcp.h>
+	#include <netinet/udp.h>
+	#include <sys/uio.h>
+	#include <sys/sendfile.h>
+	#include <linux/filter.h>
+	#include <linux/errqueue.h>
+
+	// Event Notification
+	#include <poll.h>
+	#include <sys/epoll.h>
+	#include <sys/eventfd.h>
+
+	// Futexes (shared memory wakeups)
+	#include <sys/syscall.h>
+	#include <linux/futex.h>
+
+	// io_uring (used through raw system calls, optional)
+	#if __has_include(<linux/io_uring.h>)
+
+		#include <signal.h>
+		#include <sys/syscall.h>
+		#include <linux/io_uring.h>
+
+		#define __WEISS__HAS_IO_URING
+
+	#endif // __has_include(<linux/io_uring.h>)
+
+	// Hardware performance counters (used through raw system calls, optional)
+	#if __has_include(<linux/perf_event.h>)
+
+		#include <linux/perf_event.h>
+
+		#define __WEISS__HAS_PERF_EVENTS
+
+	#endif // __has_include(<linux/perf_event.h>)
 
 	// Bluetooth
 	#include <bluetooth/bluetooth.h>
@@ -139,13 +184,16 @@
 #include <list>
 #include <array>
 #include <queue>
+#include <deque>
 #include <mutex>
 #include <cmath>
 #include <future>
 #include <thread>
+#include <atomic>
 #include <chrono>
 #include <string>
 #include <vector>
+#include <utility>
 #include <memory>
 #include <bitset>
 #include <cassert>
@@ -157,9 +205,12 @@
 #include <sstream>
 #include <iostream>
 #include <optional>
+#include <coroutine>
 #include <exception>
 #include <algorithm>
 #include <functional>
+#include <unordered_map>
+#include <condition_variable>
 
 #ifndef __WEISS__DISABLE_SIMD
 
@@ -0,0 +1,410 @@
+#include "WSSerialization.h"
+#include "WSCpuFeatures.h"
+
+namespace WS {
+
+	// ---------- Half Precision & Quantization ---------- //
+
+	uint16_t FloatToHalf(const float value) noexcept
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+
+		const uint16_t sign = static_cast<uint16_t>((bits >> 16u) & 0x8000u);
+		uint32_t       abs  = bits & 0x7FFFFFFFu;
+
+		// Infinities & NaNs (kept quiet)
+		if (abs >= 0x7F800000u)
+			return sign | ((abs > 0x7F800000u) ? 0x7E00u : 0x7C00u);
+
+		// Rounds up to 65520 or more
+		if (abs >= 0x477FF000u)
+			return sign | 0x7C00u;
+
+		// Subnormal results : adding 0.5 makes the FPU shift & round the mantissa in place
+		if (abs < 0x38800000u) {
+			float shifted;
+			std::memcpy(&shifted, &abs, sizeof(shifted));
+			shifted += 0.5f;
+
+			uint32_t shiftedBits;
+			std::memcpy(&shiftedBits, &shifted, sizeof(shiftedBits));
+
+			return sign | static_cast<uint16_t>(shiftedBits - 0x3F000000u);
+		}
+
+		// Rebiases the exponent & rounds the 13 dropped mantissa bits to nearest even
+		abs += 0xC8000FFFu + ((abs >> 13u) & 1u);
+
+		return sign | static_cast<uint16_t>(abs >> 13u);
+	}
+
+	float HalfToFloat(const uint16_t value) noexcept
+	{
+		constexpr const uint32_t shiftedExponent = 0x7C00u << 13u;
+
+		uint32_t       bits     = (value & 0x7FFFu) << 13u;
+		const uint32_t exponent = bits & shiftedExponent;
+
+		bits += (127u - 15u) << 23u;
+
+		if (exponent == shiftedExponent) {
+			// Infinities & NaNs
+			bits += (128u - 16u) << 23u;
+		} else if (exponent == 0u) {
+			// Subnormals are renormalized by the FPU
+			constexpr const uint32_t magicBits = 113u << 23u;
+
+			float magic, result;
+			bits += 1u << 23u;
+			std::memcpy(&magic, &magicBits, sizeof(magic));
+			std::memcpy(&result, &bits, sizeof(result));
+			result -= magic;
+			std::memcpy(&bits, &result, sizeof(bits));
+		}
+
+		bits |= static_cast<uint32_t>(value & 0x8000u) << 16u;
+
+		float result;
+		std::memcpy(&result, &bits, sizeof(result));
+
+		return result;
+	}
+
+#ifdef __WEISS__RUNTIME_DISPATCH
+
+	// Each returns the number of values converted, the caller handles the rest
+	WS_TARGET("avx,f16c")
+	static size_t FloatsToHalvesF16C(const float* src, uint16_t* dst, const size_t count) noexcept
+	{
+		size_t i = 0u;
+
+		for (; i + 8u <= count; i += 8u)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+
+		return i;
+	}
+
+	WS_TARGET("avx,f16c")
+	static size_t HalvesToFloatsF16C(const uint16_t* src, float* dst, const size_t count) noexcept
+	{
+		size_t i = 0u;
+
+		for (; i + 8u <= count; i += 8u)
+			_mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+
+		return i;
+	}
+
+	[[nodiscard]] static bool HasF16C() noexcept
+	{
+		static const bool s_bF16C = HasCpuFeature(CpuFeature::F16C);
+
+		return s_bF16C;
+	}
+
+#endif // __WEISS__RUNTIME_DISPATCH
+
+	void FloatsToHalves(const float* src, uint16_t* dst, const size_t count) noexcept
+	{
+		size_t i = 0u;
+
+#ifdef __WEISS__RUNTIME_DISPATCH
+
+		if (HasF16C())
+			i = FloatsToHalvesF16C(src, dst, count);
+
+#endif // __WEISS__RUNTIME_DISPATCH
+
+		for (; i < count; i++)
+			dst[i] = FloatToHalf(src[i]);
+	}
+
+	void HalvesToFloats(const uint16_t* src, float* dst, const size_t count) noexcept
+	{
+		size_t i = 0u;
+
+#ifdef __WEISS__RUNTIME_DISPATCH
+
+		if (HasF16C())
+			i = HalvesToFloatsF16C(src, dst, count);
+
+#endif // __WEISS__RUNTIME_DISPATCH
+
+		for (; i < count; i++)
+			dst[i] = HalfToFloat(src[i]);
+	}
+
+	void QuantizeFloats(const float* src, uint16_t* dst, const size_t count, const float min, const float max) noexcept
+	{
+		const float scale = (max > min) ? 65535.0f / (max - min) : 0.0f;
+		size_t      i     = 0u;
+
+#ifndef __WEISS__DISABLE_SIMD
+
+		const __m128  minimum = _mm_set1_ps(min);
+		const __m128  factor  = _mm_set1_ps(scale);
+		const __m128  top     = _mm_set1_ps(65535.0f);
+		const __m128i bias    = _mm_set1_epi32(32768);
+
+		for (; i + 8u <= count; i += 8u) {
+			const __m128 lo = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(src + i),      minimum), factor), _mm_setzero_ps()), top);
+			const __m128 hi = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(src + i + 4u), minimum), factor), _mm_setzero_ps()), top);
+
+			// SSE2 only packs with signed saturation : values are shifted to [-32768, 32767] & shifted back by flipping the top bit
+			const __m128i packed = _mm_packs_epi32(_mm_sub_epi32(_mm_cvtps_epi32(lo), bias), _mm_sub_epi32(_mm_cvtps_epi32(hi), bias));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(packed, _mm_set1_epi16(static_cast<int16_t>(0x8000))));
+		}
+
+#endif // #ifndef __WEISS__DISABLE_SIMD
+
+		for (; i < count; i++)
+			dst[i] = static_cast<uint16_t>(std::nearbyint(std::clamp((src[i] - min) * scale, 0.0f, 65535.0f)));
+	}
+
+	void DequantizeFloats(const uint16_t* src, float* dst, const size_t count, const float min, const float max) noexcept
+	{
+		const float step = (max - min) / 65535.0f;
+		size_t      i    = 0u;
+
+#ifndef __WEISS__DISABLE_SIMD
+
+		const __m128 minimum = _mm_set1_ps(min);
+		const __m128 factor  = _mm_set1_ps(step);
+
+		for (; i + 8u <= count; i += 8u) {
+			const __m128i words = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			const __m128  lo    = _mm_cvtepi32_ps(_mm_unpacklo_epi16(words, _mm_setzero_si128()));
+			const __m128  hi    = _mm_cvtepi32_ps(_mm_unpackhi_epi16(words, _mm_setzero_si128()));
+
+			_mm_storeu_ps(dst + i,      _mm_add_ps(_mm_mul_ps(lo, factor), minimum));
+			_mm_storeu_ps(dst + i + 4u, _mm_add_ps(_mm_mul_ps(hi, factor), minimum));
+		}
+
+#endif // #ifndef __WEISS__DISABLE_SIMD
+
+		for (; i < count; i++)
+			dst[i] = static_cast<float>(src[i]) * step + min;
+	}
+
+	// ---------- Archive Writer ---------- //
+
+	// Values converted to or from 16 bits at once, on the stack
+	constexpr const size_t WS_ARCHIVE_FLOAT_BATCH_SIZE = 1024u;
+
+	ArchiveWriter::ArchiveWriter(std::vector<uint8_t>& buffer) noexcept
+		: m_pVector(&buffer), m_pData(buffer.data()), m_capacity(buffer.size()), m_size(buffer.size())
+	{
+
+	}
+
+	uint8_t* ArchiveWriter::Reserve(const size_t size) noexcept
+	{
+		if (this->m_bFailed)
+			return nullptr;
+
+		if (this->m_pVector != nullptr) {
+			// The vector grows its capacity geometrically & its size stays the number of bytes written
+			this->m_pVector->resize(this->m_size + size);
+			this->m_pData    = this->m_pVector->data();
+			this->m_capacity = this->m_pVector->size();
+		} else if (size > this->m_capacity - this->m_size) {
+			this->m_bFailed = true;
+			return nullptr;
+		}
+
+		uint8_t* pBytes = this->m_pData + this->m_size;
+		this->m_size += size;
+
+		return pBytes;
+	}
+
+	void ArchiveWriter::WriteBytes(const void* data, const size_t size) noexcept
+	{
+		uint8_t* pBytes = this->Reserve(size);
+
+		if (pBytes != nullptr && size > 0u)
+			std::memcpy(pBytes, data, size);
+	}
+
+	void ArchiveWriter::WriteElements(const void* data, const size_t count, const size_t elementSize) noexcept
+	{
+		uint8_t* pBytes = this->Reserve(count * elementSize);
+
+		if (pBytes == nullptr || count == 0u)
+			return;
+
+		if constexpr (std::endian::native == std::endian::little)
+			std::memcpy(pBytes, data, count * elementSize);
+		else
+			WS::SwapEndianArray(data, pBytes, count, elementSize);
+	}
+
+	void ArchiveWriter::WriteFloats(const float* values, const size_t count, const FloatEncoding encoding, const float min, const float max) noexcept
+	{
+		this->Write(encoding);
+
+		if (encoding == FloatEncoding::FLOAT32) {
+			this->WriteArray(values, count);
+			return;
+		}
+
+		if (encoding == FloatEncoding::UNORM16) {
+			this->Write(min);
+			this->Write(max);
+		}
+
+		uint16_t words[WS_ARCHIVE_FLOAT_BATCH_SIZE];
+
+		for (size_t i = 0u; i < count; i += WS_ARCHIVE_FLOAT_BATCH_SIZE) {
+			const size_t batch = std::min(WS_ARCHIVE_FLOAT_BATCH_SIZE, count - i);
+
+			if (encoding == FloatEncoding::HALF)
+				WS::FloatsToHalves(values + i, words, batch);
+			else
+				WS::QuantizeFloats(values + i, words, batch, min, max);
+
+			this->WriteArray(words, batch);
+		}
+	}
+
+	void ArchiveWriter::Write(const Image& image) noexcept
+	{
+		this->Write(image.GetWidth());
+		this->Write(image.GetHeight());
+
+		// Bytes, whatever the endianness
+		this->WriteBytes(image.GetBuffer(), image.GetPixelCount() * sizeof(Coloru8));
+	}
+
+	// ---------- Archive Reader ---------- //
+
+	const uint8_t* ArchiveReader::Consume(const size_t size) noexcept
+	{
+		if (this->m_bFailed || size > this->m_size - this->m_offset) {
+			this->m_bFailed = true;
+			return nullptr;
+		}
+
+		const uint8_t* pBytes = this->m_pData + this->m_offset;
+		this->m_offset += size;
+
+		return pBytes;
+	}
+
+	bool ArchiveReader::ReadBytes(void* data, const size_t size) noexcept
+	{
+		const uint8_t* pBytes = this->Consume(size);
+
+		if (pBytes == nullptr)
+			return false;
+
+		if (size > 0u)
+			std::memcpy(data, pBytes, size);
+
+		return true;
+	}
+
+	bool ArchiveReader::ReadElements(void* data, const size_t count, const size_t elementSize) noexcept
+	{
+		// Guards the multiplication against counts read from untrusted archives
+		if (elementSize != 0u && count > this->GetRemainingSize() / elementSize) {
+			this->m_bFailed = true;
+			return false;
+		}
+
+		const uint8_t* pBytes = this->Consume(count * elementSize);
+
+		if (pBytes == nullptr)
+			return false;
+
+		if (count == 0u)
+			return true;
+
+		if constexpr (std::endian::native == std::endian::little)
+			std::memcpy(data, pBytes, count * elementSize);
+		else
+			WS::SwapEndianArray(pBytes, data, count, elementSize);
+
+		return true;
+	}
+
+	bool ArchiveReader::ReadFloats(float* values, const size_t count) noexcept
+	{
+		FloatEncoding encoding;
+		if (!this->Read(encoding))
+			return false;
+
+		if (encoding == FloatEncoding::FLOAT32)
+			return this->ReadArray(values, count);
+
+		float min = 0.0f, max = 1.0f;
+		if (encoding == FloatEncoding::UNORM16 && (!this->Read(min) || !this->Read(max)))
+			return false;
+
+		if (encoding != FloatEncoding::HALF && encoding != FloatEncoding::UNORM16) {
+			this->m_bFailed = true;
+			return false;
+		}
+
+		if (count > this->GetRemainingSize() / sizeof(uint16_t)) {
+			this->m_bFailed = true;
+			return false;
+		}
+
+		uint16_t words[WS_ARCHIVE_FLOAT_BATCH_SIZE];
+
+		for (size_t i = 0u; i < count; i += WS_ARCHIVE_FLOAT_BATCH_SIZE) {
+			const size_t batch = std::min(WS_ARCHIVE_FLOAT_BATCH_SIZE, count - i);
+
+			if (!this->ReadArray(words, batch))
+				return false;
+
+			if (encoding == FloatEncoding::HALF)
+				WS::HalvesToFloats(words, values + i, batch);
+			else
+				WS::DequantizeFloats(words, values + i, batch, min, max);
+		}
+
+		return true;
+	}
+
+	bool ArchiveReader::ViewImage(uint32_t& width, uint32_t& height, const Coloru8*& pixels) noexcept
+	{
+		uint32_t w, h;
+		if (!this->Read(w) || !this->Read(h))
+			return false;
+
+		const uint64_t size = static_cast<uint64_t>(w) * h * sizeof(Coloru8);
+		if (size > this->GetRemainingSize()) {
+			this->m_bFailed = true;
+			return false;
+		}
+
+		width  = w;
+		height = h;
+		pixels = reinterpret_cast<const Coloru8*>(this->Consume(static_cast<size_t>(size)));
+
+		return true;
+	}
+
+	bool ArchiveReader::Read(Image& image) noexcept
+	{
+		uint32_t       width, height;
+		const Coloru8* pixels;
+
+		if (!this->ViewImage(width, height, pixels))
+			return false;
+
+		// Reuses the image's buffer when it can
+		if (image.IsWrappingExternalMemory() || image.GetWidth() != width || image.GetHeight() != height || image.GetBuffer() == nullptr)
+			image = Image(width, height);
+
+		if (image.GetPixelCount() > 0u)
+			std::memcpy(image.GetBuffer(), pixels, image.GetPixelCount() * sizeof(Coloru8));
+
+		return true;
+	}
+
+}; // WS
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "WSPch.h"
+#include "WSBitLogic.h"
+#include "../math/WSVector.h"
+#include "../math/WSMatrix.h"
+#include "../media/WSImage.h"
+
+namespace WS {
+
+	// ---------- Bulk Conversions ---------- //
+
+	// Byte swaps of whole arrays are in WSBitLogic.h
+
+	// IEEE 754 binary16, rounded to nearest even. Values out of its range become infinities.
+	[[nodiscard]] uint16_t FloatToHalf(const float value) noexcept;
+	[[nodiscard]] float    HalfToFloat(const uint16_t value) noexcept;
+
+	// F16C when the CPU has it
+	void FloatsToHalves(const float* src, uint16_t* dst, const size_t count) noexcept;
+	void HalvesToFloats(const uint16_t* src, float* dst, const size_t count) noexcept;
+
+	// Maps [min, max] to [0, 65535] (values outside are clamped) and back
+	void QuantizeFloats(const float* src, uint16_t* dst, const size_t count, const float min, const float max) noexcept;
+	void DequantizeFloats(const uint16_t* src, float* dst, const size_t count, const float min, const float max) noexcept;
+
+	// ---------- Archives ---------- //
+
+	// How floats are stored, every encoding but FLOAT32 loses precision
+	enum class FloatEncoding : uint8_t {
+		FLOAT32, // As is
+		HALF,    // IEEE 754 binary16 : 11 significant bits, up to 65504
+		UNORM16  // 16 bit fixed point over a [min, max] range stored along with the values
+	};
+
+	/*
+	 * Serializes values into a contiguous buffer, in little endian : little endian hosts copy arrays as is.
+	 * The buffer is either a std::vector that grows as needed or a fixed span of memory,
+	 * writes that don't fit a fixed span are dropped & mark the archive as failed.
+	 */
+	class ArchiveWriter {
+	private:
+		std::vector<uint8_t>* m_pVector  = nullptr; // Null when writing to a fixed span
+		uint8_t*              m_pData    = nullptr;
+		size_t                m_capacity = 0u;
+		size_t                m_size     = 0u;
+		bool                  m_bFailed  = false;
+
+	private:
+		// Room for "size" more bytes, null if they don't fit
+		[[nodiscard]] uint8_t* Reserve(const size_t size) noexcept;
+
+		void WriteElements(const void* data, const size_t count, const size_t elementSize) noexcept;
+
+	public:
+		// Appends to "buffer", whose size is kept to the bytes written
+		explicit ArchiveWriter(std::vector<uint8_t>& buffer) noexcept;
+
+		ArchiveWriter(void* data, const size_t capacity) noexcept : m_pData(reinterpret_cast<uint8_t*>(data)), m_capacity(capacity) {  }
+
+		[[nodiscard]] inline bool   HasFailed() const noexcept { return this->m_bFailed; }
+		[[nodiscard]] inline size_t GetSize()   const noexcept { return this->m_size;    }
+
+		void WriteBytes(const void* data, const size_t size) noexcept;
+
+		template <typename _T>
+		inline void Write(const _T value) noexcept
+		{
+			static_assert(std::is_arithmetic_v<_T> || std::is_enum_v<_T>);
+
+			this->WriteElements(&value, 1u, sizeof(_T));
+		}
+
+		template <typename _T>
+		inline void WriteArray(const _T* values, const size_t count) noexcept
+		{
+			static_assert(std::is_arithmetic_v<_T> || std::is_enum_v<_T>);
+
+			this->WriteElements(values, count, sizeof(_T));
+		}
+
+		// Writes the encoding (& range) followed by the encoded values
+		void WriteFloats(const float* values, const size_t count, const FloatEncoding encoding = FloatEncoding::FLOAT32, const float min = 0.0f, const float max = 1.0f) noexcept;
+
+		// The 4 components of every vector
+		template <typename _T>
+		inline void WriteVectors(const Vector<_T>* vectors, const size_t count) noexcept { this->WriteArray(&vectors->m_arr[0], count * 4u); }
+
+		inline void WriteVectors(const Vecf32* vectors, const size_t count, const FloatEncoding encoding, const float min = 0.0f, const float max = 1.0f) noexcept
+		{
+			this->WriteFloats(&vectors->m_arr[0], count * 4u, encoding, min, max);
+		}
+
+		template <typename _T>
+		inline void Write(const Vector<_T>& vector) noexcept { this->WriteVectors(&vector, 1u); }
+
+		template <typename _T>
+		inline void Write(const Matrix<_T>& matrix) noexcept { this->WriteArray(&matrix[0], 16u); }
+
+		// Width, height & RGBA8 pixels
+		void Write(const Image& image) noexcept;
+	};
+
+	/*
+	 * Deserializes what an ArchiveWriter wrote, without allocating : values are read into the caller's memory
+	 * or viewed in place. Reads past the end fail, leave their destination untouched & mark the archive as failed.
+	 */
+	class ArchiveReader {
+	private:
+		const uint8_t* m_pData;
+		size_t         m_size;
+		size_t         m_offset  = 0u;
+		bool           m_bFailed = false;
+
+	private:
+		// The next "size" bytes, null if there aren't as many left
+		[[nodiscard]] const uint8_t* Consume(const size_t size) noexcept;
+
+		[[nodiscard]] bool ReadElements(void* data, const size_t count, const size_t elementSize) noexcept;
+
+	public:
+		ArchiveReader(const void* data, const size_t size) noexcept : m_pData(reinterpret_cast<const uint8_t*>(data)), m_size(size) {  }
+
+		[[nodiscard]] inline bool   HasFailed()        const noexcept { return this->m_bFailed;                }
+		[[nodiscard]] inline size_t GetRemainingSize() const noexcept { return this->m_size - this->m_offset; }
+
+		[[nodiscard]] bool ReadBytes(void* data, const size_t size) noexcept;
+
+		// Points into the archive, valid as long as its memory is
+		[[nodiscard]] inline const uint8_t* ViewBytes(const size_t size) noexcept { return this->Consume(size); }
+
+		template <typename _T>
+		[[nodiscard]] inline bool Read(_T& value) noexcept
+		{
+			static_assert(std::is_arithmetic_v<_T> || std::is_enum_v<_T>);
+
+			return this->ReadElements(&value, 1u, sizeof(_T));
+		}
+
+		template <typename _T>
+		[[nodiscard]] inline bool ReadArray(_T* values, const size_t count) noexcept
+		{
+			static_assert(std::is_arithmetic_v<_T> || std::is_enum_v<_T>);
+
+			return this->ReadElements(values, count, sizeof(_T));
+		}
+
+		// Decodes "count" floats whatever their encoding
+		[[nodiscard]] bool ReadFloats(float* values, const size_t count) noexcept;
+
+		template <typename _T>
+		[[nodiscard]] inline bool ReadVectors(Vector<_T>* vectors, const size_t count) noexcept { return this->ReadArray(&vectors->m_arr[0], count * 4u); }
+
+		// Vectors written with an encoding
+		[[nodiscard]] inline bool ReadEncodedVectors(Vecf32* vectors, const size_t count) noexcept { return this->ReadFloats(&vectors->m_arr[0], count * 4u); }
+
+		template <typename _T>
+		[[nodiscard]] inline bool Read(Vector<_T>& vector) noexcept { return this->ReadVectors(&vector, 1u); }
+
+		template <typename _T>
+		[[nodiscard]] inline bool Read(Matrix<_T>& matrix) noexcept { return this->ReadArray(&matrix[0], 16u); }
+
+		// An image's size & pixels, which point into the archive
+		[[nodiscard]] bool ViewImage(uint32_t& width, uint32_t& height, const Coloru8*& pixels) noexcept;
+
+		// Copies the pixels into "image", which only allocates if it doesn't own a buffer of the same size already
+		[[nodiscard]] bool Read(Image& image) noexcept;
+	};
+
+}; // WS
@@ -0,0 +1,98 @@
+#include "WSTask.h"
+
+namespace WS {
+
+	constexpr const size_t WS_FRAME_POOL_CLASS_COUNT = WS_FRAME_POOL_MAX_SIZE / WS_FRAME_POOL_GRANULARITY;
+
+	struct FreeBlock {
+		FreeBlock* m_pNext;
+	};
+
+	// Free blocks left behind by exited threads
+	struct FramePoolDepot {
+		std::mutex m_mutex;
+		FreeBlock* m_freeLists[WS_FRAME_POOL_CLASS_COUNT] = {};
+	};
+
+	static FramePoolDepot& GetFramePoolDepot() noexcept
+	{
+		// Never destroyed : frames may still be freed while static objects are torn down
+		static FramePoolDepot* pDepot = new FramePoolDepot();
+
+		return *pDepot;
+	}
+
+	struct FramePoolCache {
+		FreeBlock* m_freeLists[WS_FRAME_POOL_CLASS_COUNT] = {};
+
+		~FramePoolCache() noexcept
+		{
+			FramePoolDepot& depot = GetFramePoolDepot();
+			std::unique_lock<std::mutex> lock(depot.m_mutex);
+
+			for (size_t i = 0u; i < WS_FRAME_POOL_CLASS_COUNT; i++) {
+				while (this->m_freeLists[i] != nullptr) {
+					FreeBlock* pBlock = this->m_freeLists[i];
+
+					this->m_freeLists[i] = pBlock->m_pNext;
+					pBlock->m_pNext      = depot.m_freeLists[i];
+					depot.m_freeLists[i] = pBlock;
+				}
+			}
+		}
+	};
+
+	static thread_local FramePoolCache g_framePoolCache;
+
+	void* FramePool::Allocate(const size_t size)
+	{
+		if (size > WS_FRAME_POOL_MAX_SIZE)
+			return ::operator new(size);
+
+		const size_t sizeClass = (size + WS_FRAME_POOL_GRANULARITY - 1u) / WS_FRAME_POOL_GRANULARITY - 1u;
+		FreeBlock*&  pFreeList = g_framePoolCache.m_freeLists[sizeClass];
+
+		if (pFreeList == nullptr) {
+			FramePoolDepot& depot = GetFramePoolDepot();
+
+			{
+				std::unique_lock<std::mutex> lock(depot.m_mutex);
+
+				pFreeList = std::exchange(depot.m_freeLists[sizeClass], nullptr);
+			}
+
+			// Carves a new chunk into blocks of the class
+			if (pFreeList == nullptr) {
+				const size_t blockSize = (sizeClass + 1u) * WS_FRAME_POOL_GRANULARITY;
+				uint8_t*     pChunk    = reinterpret_cast<uint8_t*>(::operator new(WS_FRAME_POOL_CHUNK_SIZE));
+
+				for (size_t offset = 0u; offset + blockSize <= WS_FRAME_POOL_CHUNK_SIZE; offset += blockSize) {
+					FreeBlock* pBlock = reinterpret_cast<FreeBlock*>(pChunk + offset);
+
+					pBlock->m_pNext = pFreeList;
+					pFreeList       = pBlock;
+				}
+			}
+		}
+
+		FreeBlock* pBlock = pFreeList;
+		pFreeList = pBlock->m_pNext;
+
+		return pBlock;
+	}
+
+	void FramePool::Free(void* pFrame, const size_t size) noexcept
+	{
+		if (size > WS_FRAME_POOL_MAX_SIZE) {
+			::operator delete(pFrame);
+			return;
+		}
+
+		const size_t sizeClass = (size + WS_FRAME_POOL_GRANULARITY - 1u) / WS_FRAME_POOL_GRANULARITY - 1u;
+		FreeBlock*   pBlock    = reinterpret_cast<FreeBlock*>(pFrame);
+
+		pBlock->m_pNext = g_framePoolCache.m_freeLists[sizeClass];
+		g_framePoolCache.m_freeLists[sizeClass] = pBlock;
+	}
+
+}; // WS
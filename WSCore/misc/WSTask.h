@@ -0,0 +1,182 @@
+#pragma once
+
+#include "WSPch.h"
+
+#define WS_FRAME_POOL_GRANULARITY 64u    // Frame sizes are rounded up to a multiple of it
+#define WS_FRAME_POOL_MAX_SIZE    2048u  // Larger frames come from the global heap
+#define WS_FRAME_POOL_CHUNK_SIZE  65536u // Memory carved into blocks of a size class at once
+
+namespace WS {
+
+	/*
+	 * Allocates coroutine frames from per thread free lists, one per size class, instead of the global heap.
+	 * Frames may be freed from another thread than the one that allocated them.
+	 * The memory is never returned to the system, the free blocks of exiting threads are handed over to the next threads.
+	 */
+	class FramePool {
+	public:
+		[[nodiscard]] static void* Allocate(const size_t size);
+
+		static void Free(void* pFrame, const size_t size) noexcept;
+	};
+
+	template <typename _T>
+	class Task;
+
+	class TaskPromiseBase {
+	private:
+		struct FinalAwaiter {
+			[[nodiscard]] inline bool await_ready() const noexcept { return false; }
+
+			template <typename _P>
+			[[nodiscard]] std::coroutine_handle<> await_suspend(std::coroutine_handle<_P> handle) const noexcept
+			{
+				TaskPromiseBase& promise = handle.promise();
+
+				// Nobody awaits a detached task, it cleans up after itself
+				if (promise.m_bDetached) {
+					if (promise.m_exception)
+						std::terminate();
+
+					handle.destroy();
+
+					return std::noop_coroutine();
+				}
+
+				return promise.m_continuation ? promise.m_continuation : std::noop_coroutine();
+			}
+
+			inline void await_resume() const noexcept {  }
+		};
+
+	public:
+		std::coroutine_handle<> m_continuation;
+		std::exception_ptr      m_exception;
+		bool                    m_bDetached = false;
+
+	public:
+		[[nodiscard]] static inline void* operator new(const size_t size) { return FramePool::Allocate(size); }
+
+		static inline void operator delete(void* pFrame, const size_t size) noexcept { FramePool::Free(pFrame, size); }
+
+		// Tasks start once they're awaited (or spawned)
+		[[nodiscard]] inline std::suspend_always initial_suspend() const noexcept { return {}; }
+		[[nodiscard]] inline FinalAwaiter        final_suspend()   const noexcept { return {}; }
+
+		inline void unhandled_exception() noexcept { this->m_exception = std::current_exception(); }
+	};
+
+	template <typename _T>
+	class TaskPromise : public TaskPromiseBase {
+	public:
+		std::optional<_T> m_value;
+
+	public:
+		[[nodiscard]] inline Task<_T> get_return_object() noexcept;
+
+		template <typename _U>
+		inline void return_value(_U&& value) noexcept(std::is_nothrow_constructible_v<_T, _U&&>) { this->m_value.emplace(std::forward<_U>(value)); }
+	};
+
+	template <>
+	class TaskPromise<void> : public TaskPromiseBase {
+	public:
+		[[nodiscard]] inline Task<void> get_return_object() noexcept;
+
+		inline void return_void() const noexcept {  }
+	};
+
+	/*
+	 * A lazily started coroutine producing a "_T" (co_return) that is awaited with co_await.
+	 * The awaiting coroutine is resumed right where the task completes (symmetric transfer), no scheduler is involved.
+	 * Frames come from the FramePool. A task that is never awaited must be Spawn()ed to run.
+	 */
+	template <typename _T = void>
+	class [[nodiscard]] Task {
+	public:
+		using promise_type = TaskPromise<_T>;
+
+	private:
+		std::coroutine_handle<promise_type> m_handle;
+
+	public:
+		explicit Task(const std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) {  }
+
+		Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {  }
+
+		Task& operator=(Task&& other) noexcept
+		{
+			if (this != &other) {
+				if (this->m_handle)
+					this->m_handle.destroy();
+
+				this->m_handle = std::exchange(other.m_handle, nullptr);
+			}
+
+			return *this;
+		}
+
+		Task(const Task&) = delete;
+		Task& operator=(const Task&) = delete;
+
+		[[nodiscard]] inline bool IsDone() const noexcept { return !this->m_handle || this->m_handle.done(); }
+
+		// Gives up ownership of the coroutine, i.e to spawn it
+		[[nodiscard]] inline std::coroutine_handle<promise_type> Release() noexcept { return std::exchange(this->m_handle, nullptr); }
+
+		[[nodiscard]] auto operator co_await() && noexcept
+		{
+			struct Awaiter {
+				std::coroutine_handle<promise_type> m_handle;
+
+				[[nodiscard]] inline bool await_ready() const noexcept { return !this->m_handle || this->m_handle.done(); }
+
+				[[nodiscard]] inline std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiting) const noexcept
+				{
+					this->m_handle.promise().m_continuation = awaiting;
+
+					return this->m_handle;
+				}
+
+				_T await_resume() const
+				{
+					if (this->m_handle.promise().m_exception)
+						std::rethrow_exception(this->m_handle.promise().m_exception);
+
+					if constexpr (!std::is_void_v<_T>)
+						return std::move(*this->m_handle.promise().m_value);
+				}
+			};
+
+			return Awaiter{ this->m_handle };
+		}
+
+		~Task() noexcept
+		{
+			if (this->m_handle)
+				this->m_handle.destroy();
+		}
+	};
+
+	template <typename _T>
+	inline Task<_T> TaskPromise<_T>::get_return_object() noexcept { return Task<_T>(std::coroutine_handle<TaskPromise<_T>>::from_promise(*this)); }
+
+	inline Task<void> TaskPromise<void>::get_return_object() noexcept { return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this)); }
+
+	/*
+	 * Starts "task" on the calling thread, it runs until its first suspension & destroys itself once it completes.
+	 * Its result is dropped, an exception escaping it terminates the program.
+	 */
+	template <typename _T>
+	void Spawn(Task<_T>&& task) noexcept
+	{
+		const std::coroutine_handle<TaskPromise<_T>> handle = task.Release();
+
+		if (!handle)
+			return;
+
+		handle.promise().m_bDetached = true;
+		handle.resume();
+	}
+
+}; // WS
@@ -0,0 +1,74 @@
+#include "WSThreadPool.h"
+
+namespace WS {
+
+	ThreadPool::ThreadPool(const size_t nThreads) noexcept
+	{
+		const size_t nWorkers = (nThreads != 0u) ? nThreads : std::max<size_t>(1u, std::thread::hardware_concurrency());
+
+		this->m_workers.reserve(nWorkers);
+		for (size_t i = 0u; i < nWorkers; i++)
+			this->m_workers.emplace_back(&ThreadPool::WorkerLoop, this);
+	}
+
+	void ThreadPool::WorkerLoop() noexcept
+	{
+		while (true) {
+			QueuedTask task;
+
+			{
+				std::unique_lock<std::mutex> lock(this->m_mutex);
+				this->m_taskAvailable.wait(lock, [this]() { return this->m_bStopping || !this->m_tasks.empty(); });
+
+				if (this->m_bStopping)
+					return;
+
+				task = this->m_tasks.top();
+				this->m_tasks.pop();
+				this->m_nActiveTasks++;
+			}
+
+			if (!task.m_token.IsCancelled())
+				task.m_function();
+
+			{
+				std::lock_guard<std::mutex> lock(this->m_mutex);
+				this->m_nActiveTasks--;
+
+				if (this->m_nActiveTasks == 0u && this->m_tasks.empty())
+					this->m_idle.notify_all();
+			}
+		}
+	}
+
+	void ThreadPool::Submit(std::function<void()> function, const TaskPriority priority, const CancellationToken& token) noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+			this->m_tasks.push(QueuedTask{ std::move(function), token, priority, this->m_nextSequence++ });
+		}
+
+		this->m_taskAvailable.notify_one();
+	}
+
+	void ThreadPool::WaitIdle() noexcept
+	{
+		std::unique_lock<std::mutex> lock(this->m_mutex);
+		this->m_idle.wait(lock, [this]() { return this->m_nActiveTasks == 0u && this->m_tasks.empty(); });
+	}
+
+	ThreadPool::~ThreadPool() noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+			this->m_bStopping = true;
+			this->m_tasks     = {};
+		}
+
+		this->m_taskAvailable.notify_all();
+
+		for (std::thread& worker : this->m_workers)
+			worker.join();
+	}
+
+}; // WS
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "WSPch.h"
+
+namespace WS {
+
+	enum class TaskPriority : uint8_t {
+		LOW    = 0u,
+		NORMAL = 1u,
+		HIGH   = 2u
+	};
+
+	/*
+	 * Shared flag used to cancel work that was submitted but that may not have started yet.
+	 * Copies of a token refer to the same flag.
+	 */
+	class CancellationToken {
+	private:
+		std::shared_ptr<std::atomic<bool>> m_pbCancelled = std::make_shared<std::atomic<bool>>(false);
+
+	public:
+		inline void Cancel() noexcept { this->m_pbCancelled->store(true, std::memory_order_release); }
+
+		[[nodiscard]] inline bool IsCancelled() const noexcept { return this->m_pbCancelled->load(std::memory_order_acquire); }
+	};
+
+	/*
+	 * A fixed number of worker threads consuming a priority queue of tasks.
+	 * Tasks of equal priority run in submission order.
+	 * Tasks whose token is cancelled before they are dequeued are dropped without running.
+	 */
+	class ThreadPool {
+	private:
+		struct QueuedTask {
+			std::function<void()> m_function;
+			CancellationToken     m_token;
+			TaskPriority          m_priority;
+			uint64_t              m_sequence;
+
+			inline bool operator<(const QueuedTask& other) const noexcept
+			{
+				// std::priority_queue pops the "largest" element first
+				if (this->m_priority != other.m_priority)
+					return this->m_priority < other.m_priority;
+
+				return this->m_sequence > other.m_sequence;
+			}
+		};
+
+		std::vector<std::thread>        m_workers;
+		std::priority_queue<QueuedTask> m_tasks;
+
+		std::mutex              m_mutex;
+		std::condition_variable m_taskAvailable;
+		std::condition_variable m_idle;
+
+		uint64_t m_nextSequence = 0u;
+		size_t   m_nActiveTasks = 0u;
+		bool     m_bStopping    = false;
+
+	private:
+		void WorkerLoop() noexcept;
+
+	public:
+		// nThreads == 0 uses one thread per hardware thread
+		ThreadPool(const size_t nThreads = 0u) noexcept;
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		void Submit(std::function<void()> function, const TaskPriority priority = TaskPriority::NORMAL,
+		            const CancellationToken& token = CancellationToken()) noexcept;
+
+		// Blocks until the queue is empty and no task is running
+		void WaitIdle() noexcept;
+
+		[[nodiscard]] inline size_t GetThreadCount() const noexcept { return this->m_workers.size(); }
+
+		// Drops the tasks that haven't started and joins the workers
+		~ThreadPool() noexcept;
+	};
+
+}; // WS
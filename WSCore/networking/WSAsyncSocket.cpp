@@ -0,0 +1,163 @@
+#include "WSAsyncSocket.h"
+
+#ifdef __WEISS__OS_LINUX
+
+namespace WS {
+
+	AsyncSocket::AsyncSocket(EventLoop& loop, SocketBase<SocketProtocol::TCP>&& socket) noexcept
+		: m_pLoop(&loop)
+	{
+		const int fd = socket.Release();
+
+		if (fd >= 0 && !this->Adopt(fd))
+			close(fd);
+	}
+
+	bool AsyncSocket::Adopt(const int fd) noexcept
+	{
+		const int flags = fcntl(fd, F_GETFL, 0);
+
+		if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+			return false;
+
+		// Edge triggered : operations are always attempted before waiting, so no readiness change can be missed
+		if (!this->m_pLoop->Register(fd, this, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET))
+			return false;
+
+		this->m_fd = fd;
+
+		return true;
+	}
+
+	Task<bool> AsyncSocket::Connect(const char* host, const uint16_t port) noexcept
+	{
+		const SocketAddress address(host, port);
+
+		if (!address.IsSet())
+			co_return false;
+
+		this->Close();
+
+		const int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+		if (fd < 0)
+			co_return false;
+
+		if (!this->Adopt(fd)) {
+			close(fd);
+			co_return false;
+		}
+
+		if (connect(this->m_fd, reinterpret_cast<const sockaddr*>(&address.m_address), sizeof(address.m_address)) == 0)
+			co_return true;
+
+		if (errno != EINPROGRESS)
+			co_return false;
+
+		// The socket becomes writable once the handshake is over, whether it succeeded or not
+		co_await this->WaitWritable();
+
+		int       error       = 0;
+		socklen_t errorLength = sizeof(error);
+
+		co_return getsockopt(this->m_fd, SOL_SOCKET, SO_ERROR, &error, &errorLength) == 0 && error == 0;
+	}
+
+	Task<ClientSocket<SocketProtocol::TCP>> AsyncSocket::Accept() noexcept
+	{
+		while (this->m_fd >= 0) {
+			const int fd = accept4(this->m_fd, nullptr, nullptr, SOCK_CLOEXEC);
+
+			if (fd >= 0)
+				co_return ClientSocket<SocketProtocol::TCP>(fd);
+
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;
+
+			if (errno != EAGAIN && errno != EWOULDBLOCK)
+				break;
+
+			co_await this->WaitReadable();
+		}
+
+		co_return ClientSocket<SocketProtocol::TCP>();
+	}
+
+	Task<int64_t> AsyncSocket::Read(void* data, const size_t size) noexcept
+	{
+		while (this->m_fd >= 0) {
+			const ssize_t nRead = recv(this->m_fd, data, size, 0);
+
+			if (nRead >= 0)
+				co_return static_cast<int64_t>(nRead);
+
+			if (errno == EINTR)
+				continue;
+
+			if (errno != EAGAIN && errno != EWOULDBLOCK)
+				break;
+
+			co_await this->WaitReadable();
+		}
+
+		co_return -1;
+	}
+
+	Task<int64_t> AsyncSocket::Write(const void* data, const size_t size) noexcept
+	{
+		size_t written = 0u;
+
+		while (this->m_fd >= 0) {
+			if (written == size)
+				co_return static_cast<int64_t>(size);
+
+			const ssize_t nWritten = send(this->m_fd, reinterpret_cast<const uint8_t*>(data) + written, size - written, MSG_NOSIGNAL);
+
+			if (nWritten >= 0) {
+				written += static_cast<size_t>(nWritten);
+				continue;
+			}
+
+			if (errno == EINTR)
+				continue;
+
+			if (errno != EAGAIN && errno != EWOULDBLOCK)
+				break;
+
+			co_await this->WaitWritable();
+		}
+
+		co_return -1;
+	}
+
+	void AsyncSocket::OnEvents(const uint32_t events) noexcept
+	{
+		const bool bFailed = (events & (EPOLLERR | EPOLLHUP)) != 0u;
+
+		// Both waiters are taken first : the reader may destroy the socket once resumed
+		std::coroutine_handle<> reader = ((events & (EPOLLIN | EPOLLRDHUP)) != 0u || bFailed) ? std::exchange(this->m_reader, nullptr) : nullptr;
+		std::coroutine_handle<> writer = ((events & EPOLLOUT) != 0u || bFailed)               ? std::exchange(this->m_writer, nullptr) : nullptr;
+
+		if (reader) reader.resume();
+		if (writer) writer.resume();
+	}
+
+	void AsyncSocket::Close() noexcept
+	{
+		if (this->m_fd < 0)
+			return;
+
+		this->m_pLoop->Unregister(this->m_fd);
+
+		close(this->m_fd);
+		this->m_fd = -1;
+	}
+
+	AsyncSocket::~AsyncSocket() noexcept
+	{
+		this->Close();
+	}
+
+}; // WS
+
+#endif // __WEISS__OS_LINUX
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "WSSocket.h"
+#include "WSEventLoop.h"
+#include "../misc/WSTask.h"
+#include "../misc/WSPch.h"
+
+#ifdef __WEISS__OS_LINUX
+
+namespace WS {
+
+	/*
+	 * A non blocking TCP socket whose operations are awaited from coroutines, i.e :
+	 *
+	 *   Task<> Echo(AsyncSocket& socket) {
+	 *       uint8_t buffer[4096];
+	 *       for (int64_t n; (n = co_await socket.Read(buffer, sizeof(buffer))) > 0; )
+	 *           if (co_await socket.Write(buffer, n) < 0) break;
+	 *   }
+	 *
+	 * Operations are attempted right away & only suspend when the socket would block, their coroutine is resumed
+	 * from the event loop the socket is registered with once it's ready. Every operation returns a negative value on failure.
+	 * At most one read (or accept) & one write (or connect) may be in flight, the socket must outlive them & must only be used from its loop's thread.
+	 */
+	class AsyncSocket : public EventHandler {
+	private:
+		// Suspends the calling coroutine until the socket is readable or writable
+		struct ReadinessAwaiter {
+			std::coroutine_handle<>& m_waiter;
+
+			[[nodiscard]] inline bool await_ready() const noexcept { return false; }
+			inline void await_suspend(const std::coroutine_handle<> handle) const noexcept { this->m_waiter = handle; }
+			inline void await_resume() const noexcept {  }
+		};
+
+		EventLoop* m_pLoop;
+		int        m_fd = -1;
+
+		std::coroutine_handle<> m_reader;
+		std::coroutine_handle<> m_writer;
+
+	private:
+		[[nodiscard]] bool Adopt(const int fd) noexcept;
+
+		[[nodiscard]] inline ReadinessAwaiter WaitReadable() noexcept { return ReadinessAwaiter{ this->m_reader }; }
+		[[nodiscard]] inline ReadinessAwaiter WaitWritable() noexcept { return ReadinessAwaiter{ this->m_writer }; }
+
+	public:
+		// A socket to Connect() with
+		explicit AsyncSocket(EventLoop& loop) noexcept : m_pLoop(&loop) {  }
+
+		// Adopts a connected or listening socket, which is made non blocking
+		AsyncSocket(EventLoop& loop, SocketBase<SocketProtocol::TCP>&& socket) noexcept;
+
+		// The loop holds a pointer to the socket
+		AsyncSocket(const AsyncSocket&) = delete;
+		AsyncSocket& operator=(const AsyncSocket&) = delete;
+
+		[[nodiscard]] inline bool       IsValid()   const noexcept { return this->m_fd >= 0;  }
+		[[nodiscard]] inline int        GetHandle() const noexcept { return this->m_fd;       }
+		[[nodiscard]] inline EventLoop& GetLoop()   const noexcept { return *this->m_pLoop;   }
+
+		// Opens the socket & connects it to an IPv4 address, false on failure
+		[[nodiscard]] Task<bool> Connect(const char* host, const uint16_t port) noexcept;
+
+		// Waits for a client of a listening socket, the returned socket is invalid on failure
+		[[nodiscard]] Task<ClientSocket<SocketProtocol::TCP>> Accept() noexcept;
+
+		// Reads at most "size" bytes, returns the number of bytes read (0 once the peer closed the connection)
+		[[nodiscard]] Task<int64_t> Read(void* data, const size_t size) noexcept;
+
+		// Writes all of "data", returns "size" or a negative value if the connection failed first
+		[[nodiscard]] Task<int64_t> Write(const void* data, const size_t size) noexcept;
+
+		void OnEvents(const uint32_t events) noexcept override;
+
+		// Unregisters & closes the socket, no operation may be in flight
+		void Close() noexcept;
+
+		~AsyncSocket() noexcept;
+	};
+
+}; // WS
+
+#endif // __WEISS__OS_LINUX
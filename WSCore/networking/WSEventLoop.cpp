@@ -0,0 +1,1464 @@
+#include "WSEventLoop.h"
+
+#ifdef __WEISS__OS_LINUX
+
+namespace WS {
+
+	static inline bool IsWouldBlockError(const int error) noexcept
+	{
+		return error == EAGAIN || error == EWOULDBLOCK;
+	}
+
+	static inline void SetNoDelay(const int fd) noexcept
+	{
+		// Game traffic is made of small latency sensitive messages, Nagle's algorithm would hold them back
+		const int enable = 1;
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+	}
+
+	// ---------- Listener ---------- //
+
+	class EventLoopListener : public EventHandler {
+	private:
+		EventLoop* m_pLoop;
+		int        m_fd;
+		uint32_t   m_events; // epoll events the listener is registered with
+
+	public:
+		EventLoopListener(EventLoop* pLoop, const int fd, const uint32_t events) noexcept
+			: m_pLoop(pLoop), m_fd(fd), m_events(events)
+		{
+
+		}
+
+		[[nodiscard]] inline int GetHandle() const noexcept { return this->m_fd; }
+
+		void OnEvents([[maybe_unused]] const uint32_t events) noexcept override
+		{
+			// The listener is level triggered : connections left in the queue wake a loop again
+			for (uint32_t i = 0u; i < WS_EVENT_LOOP_MAX_ACCEPTS_PER_WAKEUP; i++) {
+				const int fd = accept4(this->m_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+				if (fd < 0) {
+					if (errno == EINTR || errno == ECONNABORTED)
+						continue;
+
+					// The connections stay queued, a level triggered listener would wake the loop again right away
+					if (errno == EMFILE || errno == ENFILE)
+						this->m_pLoop->BackOffAccept(this, this->m_fd, this->m_events);
+
+					// EAGAIN once the queue is empty
+					break;
+				}
+
+				this->m_pLoop->AddConnection(fd);
+			}
+		}
+	};
+
+	// ---------- Connection ---------- //
+
+	Connection::Connection(EventLoop* pLoop, const int fd, const uint64_t id, const bool bConnecting) noexcept
+		: m_pLoop(pLoop), m_fd(fd), m_id(id), m_lastActivity(std::chrono::steady_clock::now()), m_bConnecting(bConnecting)
+	{
+
+	}
+
+	void Connection::OnEvents(const uint32_t events) noexcept
+	{
+		if (this->m_bClosed)
+			return;
+
+		if (this->m_bConnecting) {
+			if ((events & (EPOLLOUT | EPOLLERR | EPOLLHUP)) == 0u)
+				return;
+
+			this->FinishConnecting();
+		}
+
+		if (!this->m_bClosed && (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)))
+			this->HandleReadable();
+
+		if (!this->m_bClosed && (events & EPOLLOUT))
+			this->HandleWritable();
+	}
+
+	void Connection::FinishConnecting() noexcept
+	{
+		int       error     = 0;
+		socklen_t errorSize = sizeof(error);
+
+		if (getsockopt(this->m_fd, SOL_SOCKET, SO_ERROR, &error, &errorSize) < 0 || error != 0) {
+			this->Close();
+			return;
+		}
+
+		this->m_bConnecting  = false;
+		this->m_lastActivity = std::chrono::steady_clock::now();
+
+		if (this->m_pLoop->m_callbacks.m_onConnect)
+			this->m_pLoop->m_callbacks.m_onConnect(*this);
+	}
+
+	void Connection::ReserveReadSpace(const size_t size) noexcept
+	{
+		if (this->m_readBuffer.size() - this->m_readEnd >= size)
+			return;
+
+		// Moving the unconsumed bytes to the front is cheaper than growing
+		if (this->m_readBegin > 0u) {
+			std::memmove(this->m_readBuffer.data(), this->m_readBuffer.data() + this->m_readBegin, this->m_readEnd - this->m_readBegin);
+			this->m_readEnd  -= this->m_readBegin;
+			this->m_readBegin = 0u;
+		}
+
+		if (this->m_readBuffer.size() - this->m_readEnd < size)
+			this->m_readBuffer.resize(std::max<size_t>(this->m_readBuffer.size() * 2u, this->m_readEnd + size));
+	}
+
+	void Connection::CompactWriteBuffer() noexcept
+	{
+		if (this->m_writeBegin == this->m_writeBuffer.size()) {
+			this->m_writeBuffer.clear();
+			this->m_writeBegin = 0u;
+		} else if (this->m_writeBegin > this->m_writeBuffer.size() / 2u) {
+			this->m_writeBuffer.erase(this->m_writeBuffer.begin(), this->m_writeBuffer.begin() + this->m_writeBegin);
+			this->m_writeBegin = 0u;
+		}
+	}
+
+	void Connection::HandleReadable() noexcept
+	{
+		size_t nReceived    = 0u;
+		bool   bPeerClosed = false;
+
+		// Edge triggered : the socket has to be drained or no further event will come
+		for (;;) {
+			this->ReserveReadSpace(WS_EVENT_LOOP_READ_CHUNK_SIZE);
+
+			const ssize_t n = CountSocketTransfer<SocketProtocol::TCP>(recv(this->m_fd, this->m_readBuffer.data() + this->m_readEnd, this->m_readBuffer.size() - this->m_readEnd, 0), false);
+
+			if (n > 0) {
+				this->m_readEnd += static_cast<size_t>(n);
+				nReceived       += static_cast<size_t>(n);
+			} else if (n == 0) {
+				bPeerClosed = true;
+				break;
+			} else if (errno == EINTR) {
+				continue;
+			} else if (IsWouldBlockError(errno)) {
+				break;
+			} else {
+				bPeerClosed = true;
+				break;
+			}
+		}
+
+		if (nReceived > 0u) {
+			this->m_lastActivity = std::chrono::steady_clock::now();
+
+			if (this->m_pLoop->m_callbacks.m_onData)
+				this->m_pLoop->m_callbacks.m_onData(*this);
+		}
+
+		if (bPeerClosed)
+			this->Close();
+	}
+
+	void Connection::HandleWritable() noexcept
+	{
+		if (this->GetPendingWriteSize() == 0u)
+			return;
+
+		if (this->Flush() && this->GetPendingWriteSize() == 0u && this->m_pLoop->m_callbacks.m_onDrain)
+			this->m_pLoop->m_callbacks.m_onDrain(*this);
+	}
+
+	bool Connection::Flush() noexcept
+	{
+		while (this->m_writeBegin < this->m_writeBuffer.size()) {
+			const ssize_t n = CountSocketTransfer<SocketProtocol::TCP>(send(this->m_fd, this->m_writeBuffer.data() + this->m_writeBegin,
+			                                                                this->m_writeBuffer.size() - this->m_writeBegin, MSG_NOSIGNAL), true);
+
+			if (n >= 0) {
+				this->m_writeBegin  += static_cast<size_t>(n);
+				this->m_lastActivity = std::chrono::steady_clock::now();
+			} else if (errno == EINTR) {
+				continue;
+			} else if (IsWouldBlockError(errno)) {
+				break;
+			} else {
+				this->Close();
+				return false;
+			}
+		}
+
+		this->CompactWriteBuffer();
+
+		return true;
+	}
+
+	void Connection::Consume(const size_t size) noexcept
+	{
+#ifdef __WEISS__DEBUG_MODE
+
+		assert(size <= this->GetReadSize());
+
+#endif // __WEISS__DEBUG_MODE
+
+		this->m_readBegin += size;
+
+		if (this->m_readBegin == this->m_readEnd)
+			this->m_readBegin = this->m_readEnd = 0u;
+	}
+
+	bool Connection::Send(const void* data, const size_t size) noexcept
+	{
+		if (this->m_bClosed)
+			return false;
+
+		const uint8_t* pBytes = reinterpret_cast<const uint8_t*>(data);
+		size_t         offset = 0u;
+
+#ifdef __WEISS__HAS_IO_URING
+
+		// Small sends are gathered & submitted with the rest of the loop's requests, large ones are worth a system call of their own
+		if (this->m_pLoop->m_engine == IoEngine::IO_URING && size <= WS_EVENT_LOOP_SEND_SLOT_SIZE) {
+			this->m_writeBuffer.insert(this->m_writeBuffer.end(), pBytes, pBytes + size);
+
+			if (!this->m_bConnecting)
+				this->m_pLoop->QueueSend(this);
+
+			return true;
+		}
+
+#endif // __WEISS__HAS_IO_URING
+
+		// Nothing queued : write straight from the caller's memory & only copy what the socket didn't take
+		if (this->GetPendingWriteSize() == 0u && !this->m_bConnecting) {
+			while (offset < size) {
+				const ssize_t n = CountSocketTransfer<SocketProtocol::TCP>(send(this->m_fd, pBytes + offset, size - offset, MSG_NOSIGNAL), true);
+
+				if (n >= 0) {
+					offset += static_cast<size_t>(n);
+				} else if (errno == EINTR) {
+					continue;
+				} else if (IsWouldBlockError(errno)) {
+					break;
+				} else {
+					this->Close();
+					return false;
+				}
+			}
+
+			this->m_lastActivity = std::chrono::steady_clock::now();
+		}
+
+		this->m_writeBuffer.insert(this->m_writeBuffer.end(), pBytes + offset, pBytes + size);
+
+#ifdef __WEISS__HAS_IO_URING
+
+		if (this->m_pLoop->m_engine == IoEngine::IO_URING && offset < size && !this->m_bConnecting)
+			this->m_pLoop->QueueSend(this);
+
+#endif // __WEISS__HAS_IO_URING
+
+		return true;
+	}
+
+	void Connection::SetIdleTimeout(const std::chrono::milliseconds timeout) noexcept
+	{
+		if (this->m_idleTimerId != 0u)
+			this->m_pLoop->CancelTimer(this->m_idleTimerId);
+
+		this->m_idleTimeout = timeout;
+		this->m_idleTimerId = 0u;
+
+		if (timeout.count() <= 0)
+			return;
+
+		// Checking a few times per timeout bounds the overshoot without a timer update per byte
+		const std::chrono::milliseconds interval = std::max(timeout / 4, std::chrono::milliseconds(1));
+		EventLoop* const pLoop = this->m_pLoop;
+		const uint64_t   id    = this->m_id;
+
+		this->m_idleTimerId = pLoop->AddTimer(interval, [pLoop, id]() {
+			Connection* pConnection = pLoop->FindConnection(id);
+
+			if (pConnection != nullptr && std::chrono::steady_clock::now() - pConnection->m_lastActivity >= pConnection->m_idleTimeout)
+				pConnection->Close();
+		}, interval);
+	}
+
+	void Connection::Close() noexcept
+	{
+		if (this->m_bClosed)
+			return;
+
+		this->m_bClosed = true;
+
+		if (this->m_idleTimerId != 0u)
+			this->m_pLoop->CancelTimer(this->m_idleTimerId);
+
+#ifdef __WEISS__HAS_IO_URING
+
+		// The descriptor is closed once the requests referencing the connection completed
+		if (this->m_pLoop->m_engine == IoEngine::IO_URING) {
+			this->m_pLoop->CancelRequests(this);
+			this->m_pLoop->OnConnectionClosed(this);
+			return;
+		}
+
+#endif // __WEISS__HAS_IO_URING
+
+		this->m_pLoop->Unregister(this->m_fd);
+		close(this->m_fd);
+		this->m_fd = -1;
+
+		this->m_pLoop->OnConnectionClosed(this);
+	}
+
+	Connection::~Connection() noexcept
+	{
+#ifdef __WEISS__HAS_IO_URING
+
+		if (this->m_fileSlot >= 0)
+			this->m_pLoop->ReleaseFileSlot(this->m_fileSlot);
+
+#endif // __WEISS__HAS_IO_URING
+
+		if (this->m_fd >= 0)
+			close(this->m_fd);
+	}
+
+	// ---------- Event Loop ---------- //
+
+	EventLoop::EventLoop(const EventLoopCallbacks& callbacks, const IoEngine engine) noexcept
+		: m_callbacks(callbacks), m_events(WS_EVENT_LOOP_MAX_EVENTS_PER_WAIT)
+	{
+		this->m_epoll  = epoll_create1(EPOLL_CLOEXEC);
+		this->m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+		// The wake up descriptor is the only one registered without a handler
+		epoll_event event{};
+		event.events   = EPOLLIN;
+		event.data.ptr = nullptr;
+
+		// IsValid() reports it, the descriptors are closed by the destructor
+		if (!this->IsValid() || epoll_ctl(this->m_epoll, EPOLL_CTL_ADD, this->m_wakeFd, &event) != 0) {
+			if (this->m_wakeFd >= 0)
+				close(std::exchange(this->m_wakeFd, -1));
+
+			return;
+		}
+
+#ifdef __WEISS__HAS_IO_URING
+
+		if (engine == IoEngine::IO_URING && this->InitializeIoUring())
+			this->m_engine = IoEngine::IO_URING;
+
+#endif // __WEISS__HAS_IO_URING
+	}
+
+	bool EventLoop::Register(const int fd, EventHandler* pHandler, const uint32_t events) noexcept
+	{
+		epoll_event event{};
+		event.events   = events;
+		event.data.ptr = pHandler;
+
+		return epoll_ctl(this->m_epoll, EPOLL_CTL_ADD, fd, &event) == 0;
+	}
+
+	bool EventLoop::Modify(const int fd, EventHandler* pHandler, const uint32_t events) noexcept
+	{
+		epoll_event event{};
+		event.events   = events;
+		event.data.ptr = pHandler;
+
+		return epoll_ctl(this->m_epoll, EPOLL_CTL_MOD, fd, &event) == 0;
+	}
+
+	void EventLoop::Unregister(const int fd) noexcept
+	{
+		epoll_ctl(this->m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+	}
+
+	bool EventLoop::AddListener(const int listenFd, const bool bExclusive) noexcept
+	{
+		const int flags = fcntl(listenFd, F_GETFL, 0);
+		if (flags < 0 || fcntl(listenFd, F_SETFL, flags | O_NONBLOCK) < 0)
+			return false;
+
+		const uint32_t events = EPOLLIN | (bExclusive ? EPOLLEXCLUSIVE : 0u);
+
+		std::unique_ptr<EventHandler> pListener = std::make_unique<EventLoopListener>(this, listenFd, events);
+
+#ifdef __WEISS__HAS_IO_URING
+
+		// Accept requests wait exclusively already, a connection only completes one of the loops' requests
+		if (this->m_engine == IoEngine::IO_URING) {
+			this->ArmAccept(pListener.get(), listenFd);
+			this->m_listeners.push_back(std::move(pListener));
+
+			return true;
+		}
+
+#endif // __WEISS__HAS_IO_URING
+
+		if (!this->Register(listenFd, pListener.get(), events))
+			return false;
+
+		this->m_listeners.push_back(std::move(pListener));
+
+		return true;
+	}
+
+	Connection* EventLoop::AddConnection(const int fd) noexcept
+	{
+		const int flags = fcntl(fd, F_GETFL, 0);
+		if (flags < 0 || ((flags & O_NONBLOCK) == 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)) {
+			close(fd);
+			return nullptr;
+		}
+
+		SetNoDelay(fd);
+
+#ifdef __WEISS__HAS_IO_URING
+
+		if (this->m_engine == IoEngine::IO_URING)
+			return this->AddIoUringConnection(fd, false, nullptr);
+
+#endif // __WEISS__HAS_IO_URING
+
+		const uint64_t id = this->m_nextId++;
+		std::unique_ptr<Connection> pConnection = std::make_unique<Connection>(this, fd, id, false);
+
+		if (!this->Register(fd, pConnection.get(), EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET))
+			return nullptr;
+
+		Connection* pRaw = pConnection.get();
+		this->m_connections.emplace(id, std::move(pConnection));
+
+		if (this->m_callbacks.m_onConnect)
+			this->m_callbacks.m_onConnect(*pRaw);
+
+		return pRaw->IsClosed() ? nullptr : pRaw;
+	}
+
+	Connection* EventLoop::Connect(const char* host, const uint16_t port) noexcept
+	{
+		sockaddr_in sockAddrIn{};
+		sockAddrIn.sin_family = AF_INET;
+		sockAddrIn.sin_port   = htons(port);
+
+		if (inet_pton(AF_INET, host, &sockAddrIn.sin_addr) != 1)
+			return nullptr;
+
+		const int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_TCP);
+		if (fd < 0)
+			return nullptr;
+
+		SetNoDelay(fd);
+
+#ifdef __WEISS__HAS_IO_URING
+
+		// The handshake is a request of its own, completed by OnConnectCompleted()
+		if (this->m_engine == IoEngine::IO_URING)
+			return this->AddIoUringConnection(fd, true, &sockAddrIn);
+
+#endif // __WEISS__HAS_IO_URING
+
+		if (connect(fd, reinterpret_cast<const sockaddr*>(&sockAddrIn), sizeof(sockAddrIn)) < 0 && errno != EINPROGRESS) {
+			close(fd);
+			return nullptr;
+		}
+
+		// Registering a connected or connecting socket reports EPOLLOUT once the handshake is over
+		const uint64_t id = this->m_nextId++;
+		std::unique_ptr<Connection> pConnection = std::make_unique<Connection>(this, fd, id, true);
+
+		if (!this->Register(fd, pConnection.get(), EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET))
+			return nullptr;
+
+		Connection* pRaw = pConnection.get();
+		this->m_connections.emplace(id, std::move(pConnection));
+
+		return pRaw;
+	}
+
+	Connection* EventLoop::FindConnection(const uint64_t id) noexcept
+	{
+		const auto it = this->m_connections.find(id);
+
+		return (it == this->m_connections.end()) ? nullptr : it->second.get();
+	}
+
+	void EventLoop::OnConnectionClosed(Connection* pConnection) noexcept
+	{
+		const auto it = this->m_connections.find(pConnection->m_id);
+		if (it == this->m_connections.end())
+			return;
+
+		// Events of the current batch may still point to the connection, it is destroyed once they're dispatched
+#ifdef __WEISS__HAS_IO_URING
+
+		if (pConnection->m_nPendingOps > 0u)
+			this->m_drainingConnections.emplace(pConnection, std::move(it->second));
+		else
+			this->m_closedConnections.push_back(std::move(it->second));
+
+#else
+
+		this->m_closedConnections.push_back(std::move(it->second));
+
+#endif // __WEISS__HAS_IO_URING
+
+		this->m_connections.erase(it);
+
+		if (this->m_callbacks.m_onClose)
+			this->m_callbacks.m_onClose(*pConnection);
+	}
+
+	uint64_t EventLoop::AddTimer(const std::chrono::milliseconds delay, std::function<void()> callback,
+	                             const std::chrono::milliseconds interval) noexcept
+	{
+		const uint64_t id = this->m_nextId++;
+
+		this->m_timers.emplace(id, Timer{ std::move(callback), interval });
+		this->m_timerDeadlines.push(TimerDeadline{ std::chrono::steady_clock::now() + delay, id });
+
+		return id;
+	}
+
+	void EventLoop::CancelTimer(const uint64_t id) noexcept
+	{
+		// Its deadline stays in the heap and is skipped when it comes up
+		this->m_timers.erase(id);
+	}
+
+	void EventLoop::RunTimers() noexcept
+	{
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+		while (!this->m_timerDeadlines.empty() && this->m_timerDeadlines.top().m_deadline <= now) {
+			const TimerDeadline deadline = this->m_timerDeadlines.top();
+			this->m_timerDeadlines.pop();
+
+			const auto it = this->m_timers.find(deadline.m_id);
+			if (it == this->m_timers.end())
+				continue;
+
+			// The callback may add or cancel timers, which invalidates "it"
+			std::function<void()> callback = it->second.m_callback;
+			const std::chrono::milliseconds interval = it->second.m_interval;
+
+			if (interval.count() > 0)
+				this->m_timerDeadlines.push(TimerDeadline{ deadline.m_deadline + interval, deadline.m_id });
+			else
+				this->m_timers.erase(it);
+
+			callback();
+		}
+	}
+
+	void EventLoop::Post(std::function<void()> function) noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->m_postedMutex);
+
+			this->m_posted.push_back(std::move(function));
+		}
+
+		const uint64_t one = 1u;
+		[[maybe_unused]] const ssize_t written = write(this->m_wakeFd, &one, sizeof(one));
+	}
+
+	void EventLoop::RunPosted() noexcept
+	{
+		std::vector<std::function<void()>> posted;
+
+		{
+			std::lock_guard<std::mutex> lock(this->m_postedMutex);
+
+			posted.swap(this->m_posted);
+		}
+
+		for (std::function<void()>& function : posted)
+			function();
+	}
+
+	void EventLoop::Stop() noexcept
+	{
+		this->m_bStopping.store(true, std::memory_order_release);
+
+		const uint64_t one = 1u;
+		[[maybe_unused]] const ssize_t written = write(this->m_wakeFd, &one, sizeof(one));
+	}
+
+	int EventLoop::GetWaitTimeout(const int timeout) const noexcept
+	{
+		if (this->m_timerDeadlines.empty())
+			return timeout;
+
+		const std::chrono::steady_clock::duration untilNextTimer = this->m_timerDeadlines.top().m_deadline - std::chrono::steady_clock::now();
+
+		// Rounded up so that the loop doesn't wake up just before the deadline
+		const int untilNextTimerMs = static_cast<int>(std::max<int64_t>(0, std::chrono::ceil<std::chrono::milliseconds>(untilNextTimer).count()));
+
+		return (timeout < 0) ? untilNextTimerMs : std::min(timeout, untilNextTimerMs);
+	}
+
+	size_t EventLoop::DispatchEpollEvents(const int timeout) noexcept
+	{
+		const int nEvents = epoll_wait(this->m_epoll, this->m_events.data(), static_cast<int>(this->m_events.size()), timeout);
+
+		WS_PROFILE_SCOPE("EventLoop::DispatchEvents");
+
+		for (int i = 0; i < nEvents; i++) {
+			EventHandler* pHandler = reinterpret_cast<EventHandler*>(this->m_events[i].data.ptr);
+
+			if (pHandler != nullptr) {
+				pHandler->OnEvents(this->m_events[i].events);
+			} else {
+				uint64_t count;
+				[[maybe_unused]] const ssize_t nRead = read(this->m_wakeFd, &count, sizeof(count));
+			}
+		}
+
+		return static_cast<size_t>(std::max(nEvents, 0));
+	}
+
+	void EventLoop::BackOffAccept(EventHandler* pListener, const int listenFd, const uint32_t events) noexcept
+	{
+		const std::chrono::milliseconds delay(WS_EVENT_LOOP_ACCEPT_BACKOFF_MS);
+
+#ifdef __WEISS__HAS_IO_URING
+
+		// The multishot accept already ended, it is only submitted again
+		if (this->m_engine == IoEngine::IO_URING) {
+			this->AddTimer(delay, [this, pListener, listenFd]() { this->ArmAccept(pListener, listenFd); });
+			return;
+		}
+
+#endif // __WEISS__HAS_IO_URING
+
+		// EPOLLEXCLUSIVE registrations can't be modified, the listener is registered again instead
+		this->Unregister(listenFd);
+		this->AddTimer(delay, [this, pListener, listenFd, events]() { [[maybe_unused]] const bool bRegistered = this->Register(listenFd, pListener, events); });
+	}
+
+	size_t EventLoop::RunOnce(const int timeout) noexcept
+	{
+#ifdef __WEISS__HAS_IO_URING
+
+		const size_t nEvents = (this->m_engine == IoEngine::IO_URING) ? this->RunOnceIoUring(this->GetWaitTimeout(timeout))
+		                                                                : this->DispatchEpollEvents(this->GetWaitTimeout(timeout));
+
+#else
+
+		const size_t nEvents = this->DispatchEpollEvents(this->GetWaitTimeout(timeout));
+
+#endif // __WEISS__HAS_IO_URING
+
+		WS_PROFILE_SCOPE("EventLoop::RunCallbacks");
+
+		this->RunTimers();
+		this->RunPosted();
+
+		this->m_closedConnections.clear();
+
+		return nEvents;
+	}
+
+	void EventLoop::Run() noexcept
+	{
+		while (!this->m_bStopping.load(std::memory_order_acquire))
+			this->RunOnce();
+
+		this->m_bStopping.store(false, std::memory_order_release);
+	}
+
+	EventLoop::~EventLoop() noexcept
+	{
+#ifdef __WEISS__HAS_IO_URING
+
+		// The kernel may still read the connections' send buffers & write to the receive buffers until their requests completed
+		if (this->m_pRing != nullptr)
+			this->DrainIoUring();
+
+#endif // __WEISS__HAS_IO_URING
+
+		// Connections close their descriptors when destroyed
+		this->m_connections.clear();
+		this->m_closedConnections.clear();
+
+#ifdef __WEISS__HAS_IO_URING
+
+		this->m_drainingConnections.clear();
+		this->m_pReceiveBuffers.reset();
+		this->m_pRing.reset();
+
+		if (this->m_pSendArena != nullptr)
+			munmap(this->m_pSendArena, static_cast<size_t>(WS_EVENT_LOOP_SEND_SLOT_COUNT) * WS_EVENT_LOOP_SEND_SLOT_SIZE);
+
+#endif // __WEISS__HAS_IO_URING
+
+		if (this->m_wakeFd >= 0)
+			close(this->m_wakeFd);
+
+		if (this->m_epoll >= 0)
+			close(this->m_epoll);
+	}
+
+#ifdef __WEISS__HAS_IO_URING
+
+	// ---------- io_uring Engine ---------- //
+
+	// Low bits of a request's user data, the rest holds the connection or listener it belongs to
+	enum class IoUringRequest : uint64_t {
+		IGNORE  = 0u,
+		EPOLL   = 1u,
+		ACCEPT  = 2u,
+		RECEIVE = 3u,
+		SEND    = 4u,
+		CONNECT = 5u
+	};
+
+	constexpr const uint64_t WS_IO_URING_REQUEST_MASK = 7u;
+
+	static inline uint64_t MakeUserData(const void* pObject, const IoUringRequest request) noexcept
+	{
+		return reinterpret_cast<uint64_t>(pObject) | static_cast<uint64_t>(request);
+	}
+
+	bool EventLoop::InitializeIoUring() noexcept
+	{
+		std::unique_ptr<IoUring> pRing = std::make_unique<IoUring>(WS_EVENT_LOOP_IO_URING_ENTRIES,
+		                                                           IORING_SETUP_COOP_TASKRUN | IORING_SETUP_SUBMIT_ALL,
+		                                                           WS_EVENT_LOOP_IO_URING_ENTRIES * 4u);
+
+		// Multishot receives & descriptor based cancellation came with zero copy sends (6.0), which is probed instead
+		if (!pRing->IsValid() || (pRing->GetFeatures() & (IORING_FEAT_EXT_ARG | IORING_FEAT_NODROP)) != (IORING_FEAT_EXT_ARG | IORING_FEAT_NODROP) ||
+		    !pRing->IsOpcodeSupported(IORING_OP_SEND_ZC))
+			return false;
+
+		std::unique_ptr<ProvidedBufferRing> pReceiveBuffers = std::make_unique<ProvidedBufferRing>(pRing.get(), 0u, WS_EVENT_LOOP_RECEIVE_BUFFER_COUNT, WS_EVENT_LOOP_RECEIVE_BUFFER_SIZE);
+		if (!pReceiveBuffers->IsValid())
+			return false;
+
+		// Sparse table of registered descriptors, filled as connections come & go (which avoids a lookup per request)
+		rlimit limit;
+		const uint32_t nFileSlots = (getrlimit(RLIMIT_NOFILE, &limit) == 0) ? static_cast<uint32_t>(std::min<rlim_t>(WS_EVENT_LOOP_MAX_REGISTERED_FILES, limit.rlim_cur))
+		                                                                    : 1024u;
+
+		io_uring_rsrc_register files{};
+		files.nr    = nFileSlots;
+		files.flags = IORING_RSRC_REGISTER_SPARSE;
+
+		if (pRing->Register(IORING_REGISTER_FILES2, &files, sizeof(files)) < 0)
+			return false;
+
+		const size_t arenaSize = static_cast<size_t>(WS_EVENT_LOOP_SEND_SLOT_COUNT) * WS_EVENT_LOOP_SEND_SLOT_SIZE;
+		void* pSendArena = mmap(nullptr, arenaSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (pSendArena == MAP_FAILED)
+			return false;
+
+		// The arena is pinned once, zero copy sends from it don't map pages per request (plain sends work without it)
+		const iovec arena{ pSendArena, arenaSize };
+		this->m_bZeroCopySend = pRing->Register(IORING_REGISTER_BUFFERS, &arena, 1u) == 0;
+
+		this->m_pRing           = std::move(pRing);
+		this->m_pReceiveBuffers = std::move(pReceiveBuffers);
+		this->m_pSendArena      = reinterpret_cast<uint8_t*>(pSendArena);
+
+		this->m_freeSendSlots.resize(WS_EVENT_LOOP_SEND_SLOT_COUNT);
+		for (uint32_t i = 0u; i < WS_EVENT_LOOP_SEND_SLOT_COUNT; i++)
+			this->m_freeSendSlots[i] = WS_EVENT_LOOP_SEND_SLOT_COUNT - 1u - i;
+
+		this->m_freeFileSlots.resize(nFileSlots);
+		for (uint32_t i = 0u; i < nFileSlots; i++)
+			this->m_freeFileSlots[i] = nFileSlots - 1u - i;
+
+		this->ArmEpollPoll();
+
+		return true;
+	}
+
+	void EventLoop::DrainIoUring() noexcept
+	{
+		std::vector<Connection*> connections;
+
+		for (const auto& [id, pConnection] : this->m_connections)
+			connections.push_back(pConnection.get());
+
+		for (const auto& [pConnection, pOwned] : this->m_drainingConnections)
+			connections.push_back(pConnection);
+
+		// Marked closed without "m_onClose", the completion handlers then only release what their request held
+		for (Connection* pConnection : connections) {
+			pConnection->m_bClosed = true;
+
+			if (pConnection->m_nPendingOps > 0u)
+				shutdown(pConnection->m_fd, SHUT_RDWR);
+		}
+
+		// Every request of the ring, the listeners' accepts & the epoll poll included
+		io_uring_sqe* pSqe = this->m_pRing->GetSqe();
+		if (pSqe != nullptr) {
+			pSqe->opcode       = IORING_OP_ASYNC_CANCEL;
+			pSqe->cancel_flags = IORING_ASYNC_CANCEL_ANY | IORING_ASYNC_CANCEL_ALL;
+			pSqe->user_data    = MakeUserData(nullptr, IoUringRequest::IGNORE);
+		}
+
+		const auto IsDrained = [&connections]() noexcept {
+			return std::all_of(connections.begin(), connections.end(), [](const Connection* pConnection) { return pConnection->m_nPendingOps == 0u; });
+		};
+
+		const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(WS_EVENT_LOOP_DRAIN_TIMEOUT_MS);
+
+		while (!IsDrained() && std::chrono::steady_clock::now() < deadline) {
+			__kernel_timespec timeoutSpec{};
+			timeoutSpec.tv_nsec = 10000000;
+
+			this->m_pRing->SubmitAndWait(1u, &timeoutSpec);
+
+			this->m_pRing->ForEachCompletion([this](const io_uring_cqe& cqe) {
+				switch (static_cast<IoUringRequest>(cqe.user_data & WS_IO_URING_REQUEST_MASK)) {
+				case IoUringRequest::ACCEPT:
+					if (cqe.res >= 0)
+						close(cqe.res);
+					break;
+				case IoUringRequest::RECEIVE:
+				case IoUringRequest::SEND:
+				case IoUringRequest::CONNECT:
+					this->OnCompletion(cqe);
+					break;
+				default:
+					break;
+				}
+			});
+		}
+
+		if (IsDrained())
+			return;
+
+		// Leaked rather than freed while the kernel may still use them
+		const auto LeakIfPending = [](std::unique_ptr<Connection>& pConnection) noexcept {
+			if (pConnection->m_nPendingOps > 0u) {
+				[[maybe_unused]] Connection* pLeaked = pConnection.release();
+			}
+		};
+
+		for (auto& [id, pConnection] : this->m_connections)
+			LeakIfPending(pConnection);
+
+		for (auto& [pRaw, pConnection] : this->m_drainingConnections)
+			LeakIfPending(pConnection);
+
+		for (std::unique_ptr<Connection>& pConnection : this->m_closedConnections)
+			LeakIfPending(pConnection);
+
+		[[maybe_unused]] ProvidedBufferRing* pLeakedBuffers = this->m_pReceiveBuffers.release();
+		this->m_pSendArena = nullptr;
+	}
+
+	Connection* EventLoop::AddIoUringConnection(const int fd, const bool bConnecting, const sockaddr_in* pAddress) noexcept
+	{
+		if (this->m_freeFileSlots.empty()) {
+			close(fd);
+			return nullptr;
+		}
+
+		const uint32_t slot = this->m_freeFileSlots.back();
+
+		io_uring_rsrc_update2 update{};
+		update.offset = slot;
+		update.data   = reinterpret_cast<uint64_t>(&fd);
+		update.nr     = 1u;
+
+		if (this->m_pRing->Register(IORING_REGISTER_FILES_UPDATE2, &update, sizeof(update)) < 0) {
+			close(fd);
+			return nullptr;
+		}
+
+		this->m_freeFileSlots.pop_back();
+
+		const uint64_t id = this->m_nextId++;
+		std::unique_ptr<Connection> pConnection = std::make_unique<Connection>(this, fd, id, bConnecting);
+		pConnection->m_fileSlot = static_cast<int32_t>(slot);
+
+		Connection* pRaw = pConnection.get();
+		this->m_connections.emplace(id, std::move(pConnection));
+
+		if (bConnecting) {
+			pRaw->m_address = *pAddress;
+
+			io_uring_sqe* pSqe = this->m_pRing->GetSqe();
+			if (pSqe == nullptr) {
+				pRaw->Close();
+				return nullptr;
+			}
+
+			pSqe->opcode    = IORING_OP_CONNECT;
+			pSqe->flags     = IOSQE_FIXED_FILE;
+			pSqe->fd        = static_cast<int32_t>(slot);
+			pSqe->addr      = reinterpret_cast<uint64_t>(&pRaw->m_address);
+			pSqe->off       = sizeof(sockaddr_in);
+			pSqe->user_data = MakeUserData(pRaw, IoUringRequest::CONNECT);
+
+			pRaw->m_nPendingOps++;
+
+			return pRaw;
+		}
+
+		if (!this->ArmReceive(pRaw)) {
+			pRaw->Close();
+			return nullptr;
+		}
+
+		if (this->m_callbacks.m_onConnect)
+			this->m_callbacks.m_onConnect(*pRaw);
+
+		return pRaw->IsClosed() ? nullptr : pRaw;
+	}
+
+	void EventLoop::ReleaseFileSlot(const int32_t slot) noexcept
+	{
+		const int empty = -1;
+
+		io_uring_rsrc_update2 update{};
+		update.offset = static_cast<uint32_t>(slot);
+		update.data   = reinterpret_cast<uint64_t>(&empty);
+		update.nr     = 1u;
+
+		if (this->m_pRing->Register(IORING_REGISTER_FILES_UPDATE2, &update, sizeof(update)) >= 0)
+			this->m_freeFileSlots.push_back(static_cast<uint32_t>(slot));
+	}
+
+	void EventLoop::ArmEpollPoll() noexcept
+	{
+		io_uring_sqe* pSqe = this->m_pRing->GetSqe();
+		if (pSqe == nullptr)
+			return;
+
+		pSqe->opcode        = IORING_OP_POLL_ADD;
+		pSqe->fd            = this->m_epoll;
+		pSqe->poll32_events = POLLIN;
+		pSqe->len           = IORING_POLL_ADD_MULTI;
+		pSqe->user_data     = MakeUserData(nullptr, IoUringRequest::EPOLL);
+	}
+
+	void EventLoop::ArmAccept(EventHandler* pListener, const int listenFd) noexcept
+	{
+		io_uring_sqe* pSqe = this->m_pRing->GetSqe();
+		if (pSqe == nullptr)
+			return;
+
+		pSqe->opcode       = IORING_OP_ACCEPT;
+		pSqe->fd           = listenFd;
+		pSqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+		pSqe->ioprio       = IORING_ACCEPT_MULTISHOT;
+		pSqe->user_data    = MakeUserData(pListener, IoUringRequest::ACCEPT);
+	}
+
+	bool EventLoop::ArmReceive(Connection* pConnection) noexcept
+	{
+		io_uring_sqe* pSqe = this->m_pRing->GetSqe();
+		if (pSqe == nullptr)
+			return false;
+
+		// The kernel picks a buffer when bytes arrive, idle connections don't hold any
+		pSqe->opcode    = IORING_OP_RECV;
+		pSqe->flags     = IOSQE_FIXED_FILE | IOSQE_BUFFER_SELECT;
+		pSqe->fd        = pConnection->m_fileSlot;
+		pSqe->ioprio    = IORING_RECV_MULTISHOT;
+		pSqe->buf_group = this->m_pReceiveBuffers->GetGroupId();
+		pSqe->user_data = MakeUserData(pConnection, IoUringRequest::RECEIVE);
+
+		pConnection->m_bReceiving = true;
+		pConnection->m_nPendingOps++;
+
+		return true;
+	}
+
+	void EventLoop::QueueSend(Connection* pConnection) noexcept
+	{
+		if (pConnection->m_bSendQueued)
+			return;
+
+		pConnection->m_bSendQueued = true;
+		this->m_pendingSends.push_back(pConnection->m_id);
+	}
+
+	void EventLoop::StartSend(Connection* pConnection) noexcept
+	{
+		// One send in flight per connection keeps the bytes in order
+		if (pConnection->m_bClosed || pConnection->m_bConnecting || pConnection->m_bSending || pConnection->m_sendSize > 0u)
+			return;
+
+		const size_t pendingSize = pConnection->m_writeBuffer.size() - pConnection->m_writeBegin;
+		if (pendingSize == 0u)
+			return;
+
+		if (pendingSize <= WS_EVENT_LOOP_SEND_SLOT_SIZE && !this->m_freeSendSlots.empty()) {
+			const uint32_t slot = this->m_freeSendSlots.back();
+			this->m_freeSendSlots.pop_back();
+
+			std::memcpy(this->m_pSendArena + static_cast<size_t>(slot) * WS_EVENT_LOOP_SEND_SLOT_SIZE, pConnection->m_writeBuffer.data() + pConnection->m_writeBegin, pendingSize);
+
+			pConnection->m_writeBuffer.clear();
+			pConnection->m_writeBegin = 0u;
+
+			pConnection->m_sendSlot   = static_cast<int32_t>(slot);
+			pConnection->m_sendSize   = pendingSize;
+			pConnection->m_sendOffset = 0u;
+		} else {
+			// Every pending byte goes in one request without being copied again, Send() appends to the (empty) buffer swapped in
+			std::swap(pConnection->m_sendBuffer, pConnection->m_writeBuffer);
+
+			pConnection->m_sendSize   = pConnection->m_sendBuffer.size();
+			pConnection->m_sendOffset = pConnection->m_writeBegin;
+			pConnection->m_writeBegin = 0u;
+		}
+
+		this->SubmitSend(pConnection);
+	}
+
+	void EventLoop::SubmitSend(Connection* pConnection) noexcept
+	{
+		io_uring_sqe* pSqe = this->m_pRing->GetSqe();
+		if (pSqe == nullptr) {
+			pConnection->Close();
+			return;
+		}
+
+		const bool     bSlot = pConnection->m_sendSlot >= 0;
+		const uint8_t* pData = (bSlot ? this->m_pSendArena + static_cast<size_t>(pConnection->m_sendSlot) * WS_EVENT_LOOP_SEND_SLOT_SIZE
+		                              : pConnection->m_sendBuffer.data()) + pConnection->m_sendOffset;
+
+		// MSG_WAITALL has the kernel retry short sends itself, the request completes once every byte went (or on error)
+		pSqe->opcode    = IORING_OP_SEND;
+		pSqe->flags     = IOSQE_FIXED_FILE;
+		pSqe->fd        = pConnection->m_fileSlot;
+		pSqe->addr      = reinterpret_cast<uint64_t>(pData);
+		pSqe->len       = static_cast<uint32_t>(std::min<size_t>(pConnection->m_sendSize - pConnection->m_sendOffset, 1u << 30u));
+		pSqe->msg_flags = MSG_NOSIGNAL | MSG_WAITALL;
+		pSqe->user_data = MakeUserData(pConnection, IoUringRequest::SEND);
+
+		// The kernel transmits straight from the registered arena, the slot is held until it says it's done with it
+		if (bSlot && this->m_bZeroCopySend && pSqe->len >= WS_EVENT_LOOP_ZERO_COPY_THRESHOLD) {
+			pSqe->opcode    = IORING_OP_SEND_ZC;
+			pSqe->ioprio    = IORING_RECVSEND_FIXED_BUF;
+			pSqe->buf_index = 0u;
+		}
+
+		pConnection->m_bSending = true;
+		pConnection->m_nPendingOps++;
+	}
+
+	void EventLoop::ReleaseSendBuffer(Connection* pConnection) noexcept
+	{
+		// The sent buffer keeps its capacity for the next swap
+		if (pConnection->m_sendSlot >= 0)
+			this->m_freeSendSlots.push_back(static_cast<uint32_t>(pConnection->m_sendSlot));
+		else
+			pConnection->m_sendBuffer.clear();
+
+		pConnection->m_sendSlot   = -1;
+		pConnection->m_sendSize   = 0u;
+		pConnection->m_sendOffset = 0u;
+	}
+
+	void EventLoop::CancelRequests(Connection* pConnection) noexcept
+	{
+		if (pConnection->m_nPendingOps == 0u)
+			return;
+
+		// Shutting the socket down ends its requests even on kernels that can't cancel by descriptor
+		shutdown(pConnection->m_fd, SHUT_RDWR);
+
+		io_uring_sqe* pSqe = this->m_pRing->GetSqe();
+		if (pSqe == nullptr)
+			return;
+
+		pSqe->opcode       = IORING_OP_ASYNC_CANCEL;
+		pSqe->fd           = pConnection->m_fileSlot;
+		pSqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL | IORING_ASYNC_CANCEL_FD_FIXED;
+		pSqe->user_data    = MakeUserData(nullptr, IoUringRequest::IGNORE);
+	}
+
+	void EventLoop::OnCompletion(const io_uring_cqe& cqe) noexcept
+	{
+		void* const pObject = reinterpret_cast<void*>(cqe.user_data & ~WS_IO_URING_REQUEST_MASK);
+
+		switch (static_cast<IoUringRequest>(cqe.user_data & WS_IO_URING_REQUEST_MASK)) {
+		case IoUringRequest::EPOLL:
+			if ((cqe.flags & IORING_CQE_F_MORE) == 0u)
+				this->ArmEpollPoll();
+
+			// Multishot polls only trigger on new events, everything already ready is dispatched now
+			while (this->DispatchEpollEvents(0) == this->m_events.size());
+			break;
+		case IoUringRequest::ACCEPT:
+		{
+			EventLoopListener* pListener = reinterpret_cast<EventLoopListener*>(pObject);
+
+			if (cqe.res >= 0)
+				this->AddConnection(cqe.res);
+
+			if ((cqe.flags & IORING_CQE_F_MORE) != 0u || cqe.res == -EBADF || cqe.res == -EINVAL || cqe.res == -ECANCELED)
+				break;
+
+			// Submitted again right away, the accept would fail the same way until descriptors are freed
+			if (cqe.res == -EMFILE || cqe.res == -ENFILE)
+				this->BackOffAccept(pListener, pListener->GetHandle(), 0u);
+			else
+				this->ArmAccept(pListener, pListener->GetHandle());
+			break;
+		}
+		case IoUringRequest::RECEIVE:
+			this->OnReceiveCompleted(reinterpret_cast<Connection*>(pObject), cqe);
+			break;
+		case IoUringRequest::SEND:
+			this->OnSendCompleted(reinterpret_cast<Connection*>(pObject), cqe);
+			break;
+		case IoUringRequest::CONNECT:
+			this->OnConnectCompleted(reinterpret_cast<Connection*>(pObject), cqe);
+			break;
+		default:
+			break;
+		}
+	}
+
+	void EventLoop::OnReceiveCompleted(Connection* pConnection, const io_uring_cqe& cqe) noexcept
+	{
+		if ((cqe.flags & IORING_CQE_F_MORE) == 0u) {
+			pConnection->m_bReceiving = false;
+			pConnection->m_nPendingOps--;
+		}
+
+		if (cqe.res > 0) {
+			const uint16_t bufferId = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+
+			CountSocketTransfer<SocketProtocol::TCP>(cqe.res, false);
+
+			if (!pConnection->m_bClosed) {
+				pConnection->ReserveReadSpace(static_cast<size_t>(cqe.res));
+
+				std::memcpy(pConnection->m_readBuffer.data() + pConnection->m_readEnd, this->m_pReceiveBuffers->GetBuffer(bufferId), static_cast<size_t>(cqe.res));
+				pConnection->m_readEnd     += static_cast<size_t>(cqe.res);
+				pConnection->m_lastActivity = std::chrono::steady_clock::now();
+			}
+
+			this->m_pReceiveBuffers->Recycle(bufferId);
+
+			if (!pConnection->m_bClosed && this->m_callbacks.m_onData)
+				this->m_callbacks.m_onData(*pConnection);
+
+			if (!pConnection->m_bClosed && !pConnection->m_bReceiving && !this->ArmReceive(pConnection))
+				pConnection->Close();
+		} else if (!pConnection->m_bClosed) {
+			// Every buffer was taken during this batch, they're recycled by the time the request is submitted again
+			if (cqe.res == -ENOBUFS && !pConnection->m_bReceiving && this->ArmReceive(pConnection))
+				return;
+
+			// 0 : the peer closed its side
+			pConnection->Close();
+		}
+
+		this->RetireIfDrained(pConnection);
+	}
+
+	void EventLoop::OnSendCompleted(Connection* pConnection, const io_uring_cqe& cqe) noexcept
+	{
+		if (cqe.flags & IORING_CQE_F_NOTIF) {
+			pConnection->m_nNotifications--;
+			pConnection->m_nPendingOps--;
+		} else {
+			pConnection->m_bSending = false;
+			pConnection->m_nPendingOps--;
+
+			// A notification follows once the kernel no longer references the buffer
+			if (cqe.flags & IORING_CQE_F_MORE) {
+				pConnection->m_nNotifications++;
+				pConnection->m_nPendingOps++;
+			}
+
+			if (!pConnection->m_bClosed) {
+				if (cqe.res < 0) {
+					pConnection->Close();
+				} else {
+					CountSocketTransfer<SocketProtocol::TCP>(cqe.res, true);
+
+					pConnection->m_sendOffset  += static_cast<size_t>(cqe.res);
+					pConnection->m_lastActivity = std::chrono::steady_clock::now();
+
+					if (pConnection->m_sendOffset < pConnection->m_sendSize)
+						this->SubmitSend(pConnection);
+				}
+			}
+		}
+
+		if (pConnection->m_sendSize > 0u && !pConnection->m_bSending && pConnection->m_nNotifications == 0u &&
+		    (pConnection->m_bClosed || pConnection->m_sendOffset == pConnection->m_sendSize)) {
+			this->ReleaseSendBuffer(pConnection);
+
+			if (!pConnection->m_bClosed) {
+				if (pConnection->GetPendingWriteSize() > 0u)
+					this->StartSend(pConnection);
+				else if (this->m_callbacks.m_onDrain)
+					this->m_callbacks.m_onDrain(*pConnection);
+			}
+		}
+
+		this->RetireIfDrained(pConnection);
+	}
+
+	void EventLoop::OnConnectCompleted(Connection* pConnection, const io_uring_cqe& cqe) noexcept
+	{
+		pConnection->m_nPendingOps--;
+
+		if (!pConnection->m_bClosed) {
+			if (cqe.res < 0) {
+				pConnection->Close();
+			} else {
+				pConnection->m_bConnecting  = false;
+				pConnection->m_lastActivity = std::chrono::steady_clock::now();
+
+				if (!this->ArmReceive(pConnection)) {
+					pConnection->Close();
+				} else {
+					if (this->m_callbacks.m_onConnect)
+						this->m_callbacks.m_onConnect(*pConnection);
+
+					// Bytes sent while connecting
+					this->StartSend(pConnection);
+				}
+			}
+		}
+
+		this->RetireIfDrained(pConnection);
+	}
+
+	void EventLoop::RetireIfDrained(Connection* pConnection) noexcept
+	{
+		if (!pConnection->m_bClosed || pConnection->m_nPendingOps > 0u)
+			return;
+
+		const auto it = this->m_drainingConnections.find(pConnection);
+		if (it == this->m_drainingConnections.end())
+			return;
+
+		// Destroyed with the other closed connections, after the current batch
+		this->m_closedConnections.push_back(std::move(it->second));
+		this->m_drainingConnections.erase(it);
+	}
+
+	size_t EventLoop::RunOnceIoUring(const int timeout) noexcept
+	{
+		// Sends gathered since the last iteration go with the same system call as the wait
+		for (size_t i = 0u; i < this->m_pendingSends.size(); i++) {
+			Connection* pConnection = this->FindConnection(this->m_pendingSends[i]);
+
+			if (pConnection != nullptr) {
+				pConnection->m_bSendQueued = false;
+				this->StartSend(pConnection);
+			}
+		}
+
+		this->m_pendingSends.clear();
+
+		__kernel_timespec timeoutSpec{};
+		timeoutSpec.tv_sec  = timeout / 1000;
+		timeoutSpec.tv_nsec = static_cast<long long>(timeout % 1000) * 1000000;
+
+		this->m_pRing->SubmitAndWait(1u, (timeout < 0) ? nullptr : &timeoutSpec);
+
+		WS_PROFILE_SCOPE("EventLoop::DispatchEvents");
+
+		return this->m_pRing->ForEachCompletion([this](const io_uring_cqe& cqe) { this->OnCompletion(cqe); });
+	}
+
+#endif // __WEISS__HAS_IO_URING
+
+	// ---------- Event Loop Group ---------- //
+
+	EventLoopGroup::EventLoopGroup(const EventLoopCallbacks& callbacks, const size_t nLoops, const IoEngine engine) noexcept
+	{
+		const size_t count = (nLoops == 0u) ? std::max<size_t>(1u, std::thread::hardware_concurrency()) : nLoops;
+
+		for (size_t i = 0u; i < count; i++) {
+			this->m_loops.push_back(std::make_unique<EventLoop>(callbacks, engine));
+
+			// A group missing a loop would leave its share of a sharded port unserved
+			if (!this->m_loops.back()->IsValid()) {
+				this->m_loops.clear();
+				return;
+			}
+		}
+	}
+
+	// CPUs the calling thread may run on, in increasing order
+	static std::vector<int> GetAllowedCpus() noexcept
+	{
+		std::vector<int> cpus;
+		cpu_set_t        set;
+
+		CPU_ZERO(&set);
+		if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+			for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+				if (CPU_ISSET(cpu, &set))
+					cpus.push_back(cpu);
+		}
+
+		if (cpus.empty())
+			cpus.push_back(0);
+
+		return cpus;
+	}
+
+	bool EventLoopGroup::Listen(const uint16_t port, const ListenOptions& options) noexcept
+	{
+		if (!this->IsValid() || !this->m_listeners.empty())
+			return false;
+
+		this->m_bPinThreads = options.m_bPinThreads;
+
+		// The sockets join their SO_REUSEPORT group in the order they listen, which is the loops' order
+		const size_t nListeners = options.m_bShardedListeners ? this->m_loops.size() : 1u;
+		uint16_t     boundPort  = port;
+		bool         bListening = true;
+
+		for (size_t i = 0u; i < nListeners; i++) {
+			ServerSocket<SocketProtocol::TCP>& listener = this->m_listeners.emplace_back();
+
+			if (!listener.Bind(boundPort, options.m_bShardedListeners)) {
+				bListening = false;
+				break;
+			}
+
+			// Both are hints, a kernel without them still accepts connections
+			if (options.m_deferAcceptSeconds > 0) {
+				[[maybe_unused]] const bool bDeferred = listener.SetDeferAccept(options.m_deferAcceptSeconds);
+			}
+
+			if (options.m_fastOpenQueueLength > 0) {
+				[[maybe_unused]] const bool bFastOpen = listener.SetFastOpen(options.m_fastOpenQueueLength);
+			}
+
+			if (!listener.Listen(options.m_backlog)) {
+				bListening = false;
+				break;
+			}
+
+			// The next sockets must share the port the kernel picked
+			boundPort = listener.GetPort();
+		}
+
+		if (!bListening) {
+			this->m_listeners.clear();
+			return false;
+		}
+
+		if (options.m_bShardedListeners && options.m_bPinThreads && options.m_bCpuSteering && !this->AttachCpuSteering()) {
+			this->m_listeners.clear();
+			return false;
+		}
+
+		// Registered from the loops' threads in case they already run, a shared socket wakes a single loop per connection
+		for (size_t i = 0u; i < this->m_loops.size(); i++) {
+			EventLoop* pLoop      = this->m_loops[i].get();
+			const int  fd         = this->m_listeners[i % nListeners].GetHandle();
+			const bool bExclusive = nListeners == 1u;
+
+			pLoop->Post([pLoop, fd, bExclusive]() { [[maybe_unused]] const bool bAdded = pLoop->AddListener(fd, bExclusive); });
+		}
+
+		return true;
+	}
+
+	bool EventLoopGroup::AttachCpuSteering() noexcept
+	{
+		const std::vector<int> cpus = GetAllowedCpus();
+
+		// Compares the CPU handling the connection with the one of every loop & returns the index of its socket,
+		// unknown CPUs are spread with a modulo (an index out of the group falls back to the kernel's hash)
+		std::vector<sock_filter> program;
+		program.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)));
+
+		for (size_t i = 0u; i < this->m_loops.size(); i++) {
+			program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, static_cast<uint32_t>(cpus[i % cpus.size()]), 0, 1));
+			program.push_back(BPF_STMT(BPF_RET | BPF_K, static_cast<uint32_t>(i)));
+		}
+
+		program.push_back(BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, static_cast<uint32_t>(this->m_loops.size())));
+		program.push_back(BPF_STMT(BPF_RET | BPF_A, 0));
+
+		if (program.size() > BPF_MAXINSNS)
+			return false;
+
+		sock_fprog fprog{};
+		fprog.len    = static_cast<unsigned short>(program.size());
+		fprog.filter = program.data();
+
+		// The program belongs to the whole group, attaching it to any of its sockets is enough
+		return setsockopt(this->m_listeners.front().GetHandle(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &fprog, sizeof(fprog)) == 0;
+	}
+
+	void EventLoopGroup::Start() noexcept
+	{
+		if (!this->m_threads.empty())
+			return;
+
+		const std::vector<int> cpus = GetAllowedCpus();
+
+		for (size_t i = 0u; i < this->m_loops.size(); i++) {
+			std::thread& thread = this->m_threads.emplace_back([pLoop = this->m_loops[i].get()]() { pLoop->Run(); });
+
+			// Keeps each loop's connections (and their caches) on one core
+			if (this->m_bPinThreads) {
+				cpu_set_t set;
+				CPU_ZERO(&set);
+				CPU_SET(cpus[i % cpus.size()], &set);
+
+				pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+			}
+		}
+	}
+
+	void EventLoopGroup::Stop() noexcept
+	{
+		if (this->m_threads.empty())
+			return;
+
+		for (std::unique_ptr<EventLoop>& pLoop : this->m_loops)
+			pLoop->Stop();
+
+		for (std::thread& thread : this->m_threads)
+			thread.join();
+
+		this->m_threads.clear();
+	}
+
+	EventLoopGroup::~EventLoopGroup() noexcept
+	{
+		this->Stop();
+
+		// The loops have to go before the listening sockets they reference
+		this->m_loops.clear();
+	}
+
+	bool RaiseFileDescriptorLimit() noexcept
+	{
+		rlimit limit;
+		if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+			return false;
+
+		limit.rlim_cur = limit.rlim_max;
+
+		return setrlimit(RLIMIT_NOFILE, &limit) == 0;
+	}
+
+}; // WS
+
+#endif // __WEISS__OS_LINUX
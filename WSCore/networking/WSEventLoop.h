@@ -0,0 +1,392 @@
+#pragma once
+
+#include "WSSocket.h"
+#include "WSIoUring.h"
+#include "../misc/WSPch.h"
+#include "../debugging/WSProfiler.h"
+
+#ifdef __WEISS__OS_LINUX
+
+#define WS_EVENT_LOOP_READ_CHUNK_SIZE          16384u // Minimum free space offered to recv()
+#define WS_EVENT_LOOP_MAX_EVENTS_PER_WAIT      1024u
+#define WS_EVENT_LOOP_MAX_ACCEPTS_PER_WAKEUP   64u    // Leaves the next connections to the other loops sharing a listener
+#define WS_EVENT_LOOP_ACCEPT_BACKOFF_MS        100u   // Out of descriptors (EMFILE / ENFILE) : accepts resume after this delay instead of spinning
+
+// io_uring engine
+#define WS_EVENT_LOOP_IO_URING_ENTRIES         4096u
+#define WS_EVENT_LOOP_RECEIVE_BUFFER_COUNT     1024u  // Shared by every connection of a loop (provided buffer ring)
+#define WS_EVENT_LOOP_RECEIVE_BUFFER_SIZE      4096u
+#define WS_EVENT_LOOP_SEND_SLOT_COUNT          256u   // Registered buffers small sends are copied to, one per connection with a send in flight
+#define WS_EVENT_LOOP_SEND_SLOT_SIZE           16384u // Larger sends (or sends finding no free slot) go from the connection's own buffer
+#define WS_EVENT_LOOP_ZERO_COPY_THRESHOLD      8192u  // Smaller sends are cheaper to copy than to track until the kernel releases them
+#define WS_EVENT_LOOP_MAX_REGISTERED_FILES     65536u
+#define WS_EVENT_LOOP_DRAIN_TIMEOUT_MS         1000u  // How long a destroyed loop waits for the kernel to complete its requests
+
+namespace WS {
+
+	class EventLoop;
+
+	/*
+	 * How an event loop talks to the kernel.
+	 * IO_URING batches every accept, receive & send of an iteration into a single system call,
+	 * loops asking for it fall back to EPOLL when the kernel (or the build) doesn't provide it.
+	 */
+	enum class IoEngine : uint8_t {
+		EPOLL,
+		IO_URING
+	};
+
+	/*
+	 * Anything registered with an event loop,
+	 * "OnEvents" receives the EPOLL* readiness flags of the handler's file descriptor
+	 */
+	class EventHandler {
+	public:
+		virtual void OnEvents(const uint32_t events) noexcept = 0;
+
+		virtual ~EventHandler() = default;
+	};
+
+	/*
+	 * A non blocking TCP connection owned by an event loop.
+	 * Received bytes accumulate in a read buffer until they are consumed,
+	 * sent bytes that the socket can't take right away are queued & written when it becomes writable.
+	 * Connections must only be used from their loop's thread.
+	 */
+	class Connection : public EventHandler {
+	private:
+		friend class EventLoop;
+
+		EventLoop* m_pLoop;
+		int        m_fd;
+		uint64_t   m_id;
+
+		std::vector<uint8_t> m_readBuffer;
+		size_t               m_readBegin = 0u, m_readEnd = 0u;
+
+		std::vector<uint8_t> m_writeBuffer;
+		size_t               m_writeBegin = 0u;
+
+		std::chrono::steady_clock::time_point m_lastActivity;
+		std::chrono::milliseconds             m_idleTimeout = std::chrono::milliseconds(0);
+		uint64_t                              m_idleTimerId = 0u;
+
+		void* m_pUserData   = nullptr;
+		bool  m_bConnecting = false;
+		bool  m_bClosed     = false;
+
+		// io_uring engine only
+		int32_t     m_fileSlot       = -1; // Index in the loop's registered files
+		int32_t     m_sendSlot       = -1; // Registered buffer the bytes in flight were copied to, -1 when they're sent from "m_sendBuffer"
+		size_t      m_sendSize       = 0u; // 0 : no send in flight
+		size_t      m_sendOffset     = 0u;
+		uint32_t    m_nPendingOps    = 0u; // Requests in flight, the connection is destroyed once they all completed
+		uint32_t    m_nNotifications = 0u; // Zero copy sends whose buffer the kernel still references
+		bool        m_bReceiving     = false;
+		bool        m_bSending       = false;
+		bool        m_bSendQueued    = false;
+		sockaddr_in m_address{};
+
+		std::vector<uint8_t> m_sendBuffer; // The write buffer as it was when a send too large for a slot started, Send() appends to a fresh one
+
+	private:
+		// Makes room for at least "size" more bytes after the unconsumed ones
+		void ReserveReadSpace(const size_t size) noexcept;
+
+		// Drops the bytes that were written from the front of the write buffer
+		void CompactWriteBuffer() noexcept;
+
+		void FinishConnecting() noexcept;
+
+		void HandleReadable() noexcept;
+
+		void HandleWritable() noexcept;
+
+		// Writes queued bytes until the socket would block, false if the connection was closed
+		bool Flush() noexcept;
+
+	public:
+		Connection(EventLoop* pLoop, const int fd, const uint64_t id, const bool bConnecting) noexcept;
+
+		Connection(const Connection&) = delete;
+		Connection& operator=(const Connection&) = delete;
+
+		void OnEvents(const uint32_t events) noexcept override;
+
+		[[nodiscard]] inline uint64_t   GetId()     const noexcept { return this->m_id;     }
+		[[nodiscard]] inline int        GetHandle() const noexcept { return this->m_fd;     }
+		[[nodiscard]] inline EventLoop& GetLoop()   const noexcept { return *this->m_pLoop; }
+		[[nodiscard]] inline bool       IsClosed()  const noexcept { return this->m_bClosed; }
+
+		// Bytes received & not consumed yet
+		[[nodiscard]] inline const uint8_t* GetReadData() const noexcept { return this->m_readBuffer.data() + this->m_readBegin; }
+		[[nodiscard]] inline size_t         GetReadSize() const noexcept { return this->m_readEnd - this->m_readBegin; }
+
+		void Consume(const size_t size) noexcept;
+
+		// Writes as much of "data" as the socket takes right away & queues the rest, false if the connection is closed
+		bool Send(const void* data, const size_t size) noexcept;
+
+		[[nodiscard]] inline size_t GetPendingWriteSize() const noexcept { return this->m_writeBuffer.size() - this->m_writeBegin + (this->m_sendSize - this->m_sendOffset); }
+
+		// Closes the connection once "timeout" passes without any byte being received or sent (0 disables it)
+		void SetIdleTimeout(const std::chrono::milliseconds timeout) noexcept;
+
+		inline void  SetUserData(void* pUserData) noexcept { this->m_pUserData = pUserData; }
+		[[nodiscard]] inline void* GetUserData() const noexcept { return this->m_pUserData; }
+
+		// Closes the socket right away, queued bytes are dropped. The connection is destroyed after the current batch of events.
+		void Close() noexcept;
+
+		~Connection() noexcept;
+	};
+
+	// Called on the thread of the loop owning the connection, every callback is optional
+	struct EventLoopCallbacks {
+		std::function<void(Connection&)> m_onConnect; // Accepted, or outgoing connection established
+		std::function<void(Connection&)> m_onData;    // New bytes were appended to the read buffer
+		std::function<void(Connection&)> m_onDrain;   // Every queued byte was written
+		std::function<void(Connection&)> m_onClose;   // Closed by either side, the connection can't be used afterwards
+	};
+
+	/*
+	 * A single threaded reactor over edge triggered epoll or io_uring.
+	 * Connections, listeners, arbitrary event handlers & timers are all driven by Run() / RunOnce().
+	 * With io_uring, handlers registered through Register() keep being served by an epoll instance the ring polls.
+	 * Only Post() and Stop() may be called from other threads.
+	 */
+	class EventLoop {
+	private:
+		friend class Connection;
+		friend class EventLoopListener;
+
+		struct Timer {
+			std::function<void()>     m_callback;
+			std::chrono::milliseconds m_interval;
+		};
+
+		struct TimerDeadline {
+			std::chrono::steady_clock::time_point m_deadline;
+			uint64_t                              m_id;
+
+			// std::priority_queue pops the "largest" element first
+			inline bool operator<(const TimerDeadline& other) const noexcept { return this->m_deadline > other.m_deadline; }
+		};
+
+		int m_epoll  = -1;
+		int m_wakeFd = -1;
+
+		IoEngine m_engine = IoEngine::EPOLL;
+
+		EventLoopCallbacks m_callbacks;
+
+		std::unordered_map<uint64_t, std::unique_ptr<Connection>> m_connections;
+		std::vector<std::unique_ptr<Connection>>                  m_closedConnections;
+		std::vector<std::unique_ptr<EventHandler>>                m_listeners;
+
+		std::unordered_map<uint64_t, Timer> m_timers;
+		std::priority_queue<TimerDeadline>  m_timerDeadlines;
+
+		std::mutex                         m_postedMutex;
+		std::vector<std::function<void()>> m_posted;
+
+		std::vector<epoll_event> m_events;
+		std::atomic<bool>        m_bStopping = false;
+		uint64_t                 m_nextId    = 1u;
+
+#ifdef __WEISS__HAS_IO_URING
+
+		std::unique_ptr<IoUring>            m_pRing;
+		std::unique_ptr<ProvidedBufferRing> m_pReceiveBuffers;
+
+		uint8_t*              m_pSendArena     = nullptr;
+		bool                  m_bZeroCopySend  = false;
+		std::vector<uint32_t> m_freeSendSlots;
+		std::vector<uint32_t> m_freeFileSlots;
+
+		std::vector<uint64_t> m_pendingSends; // Connections with bytes to send once the current batch is dispatched
+
+		// Closed connections with requests still in flight
+		std::unordered_map<Connection*, std::unique_ptr<Connection>> m_drainingConnections;
+
+#endif // __WEISS__HAS_IO_URING
+
+	private:
+		void OnConnectionClosed(Connection* pConnection) noexcept;
+
+		// Dispatches the ready epoll events, waiting at most "timeout" milliseconds
+		[[nodiscard]] size_t DispatchEpollEvents(const int timeout) noexcept;
+
+		// Stops accepting on "listenFd" for WS_EVENT_LOOP_ACCEPT_BACKOFF_MS, "events" are the ones it was registered with (epoll)
+		void BackOffAccept(EventHandler* pListener, const int listenFd, const uint32_t events) noexcept;
+
+#ifdef __WEISS__HAS_IO_URING
+
+		[[nodiscard]] bool InitializeIoUring() noexcept;
+
+		// Cancels every request in flight & waits for their completions, the memory they reference can be freed afterwards
+		void DrainIoUring() noexcept;
+
+		Connection* AddIoUringConnection(const int fd, const bool bConnecting, const sockaddr_in* pAddress) noexcept;
+
+		void ReleaseFileSlot(const int32_t slot) noexcept;
+
+		void ArmEpollPoll() noexcept;
+
+		void ArmAccept(EventHandler* pListener, const int listenFd) noexcept;
+
+		[[nodiscard]] bool ArmReceive(Connection* pConnection) noexcept;
+
+		void QueueSend(Connection* pConnection) noexcept;
+
+		void StartSend(Connection* pConnection) noexcept;
+
+		void SubmitSend(Connection* pConnection) noexcept;
+
+		// Frees the send slot or the swapped out write buffer once the kernel is done with the bytes in flight
+		void ReleaseSendBuffer(Connection* pConnection) noexcept;
+
+		void CancelRequests(Connection* pConnection) noexcept;
+
+		void OnCompletion(const io_uring_cqe& cqe) noexcept;
+
+		void OnReceiveCompleted(Connection* pConnection, const io_uring_cqe& cqe) noexcept;
+
+		void OnSendCompleted(Connection* pConnection, const io_uring_cqe& cqe) noexcept;
+
+		void OnConnectCompleted(Connection* pConnection, const io_uring_cqe& cqe) noexcept;
+
+		// Destroys a closed connection once its last request completed
+		void RetireIfDrained(Connection* pConnection) noexcept;
+
+		[[nodiscard]] size_t RunOnceIoUring(const int timeout) noexcept;
+
+#endif // __WEISS__HAS_IO_URING
+
+		void RunTimers() noexcept;
+
+		void RunPosted() noexcept;
+
+		// Milliseconds until the next timer is due, clamped to "timeout" (negative waits forever)
+		[[nodiscard]] int GetWaitTimeout(const int timeout) const noexcept;
+
+	public:
+		// Check IsValid(), then GetEngine() to know whether IO_URING was available
+		EventLoop(const EventLoopCallbacks& callbacks = {}, const IoEngine engine = IoEngine::EPOLL) noexcept;
+
+		EventLoop(const EventLoop&) = delete;
+		EventLoop& operator=(const EventLoop&) = delete;
+
+		// False if the epoll instance or the wake up descriptor couldn't be created, the loop mustn't be run then
+		[[nodiscard]] inline bool IsValid() const noexcept { return this->m_epoll >= 0 && this->m_wakeFd >= 0; }
+
+		[[nodiscard]] inline IoEngine GetEngine() const noexcept { return this->m_engine; }
+
+		// "pHandler" must stay alive until it is unregistered
+		[[nodiscard]] bool Register(const int fd, EventHandler* pHandler, const uint32_t events) noexcept;
+		[[nodiscard]] bool Modify(const int fd, EventHandler* pHandler, const uint32_t events) noexcept;
+		void Unregister(const int fd) noexcept;
+
+		/*
+		 * Accepts the connections of a listening TCP socket, which must outlive the loop.
+		 * "bExclusive" lets several loops share the socket while only waking one of them per connection (EPOLLEXCLUSIVE).
+		 */
+		[[nodiscard]] bool AddListener(const int listenFd, const bool bExclusive = false) noexcept;
+
+		[[nodiscard]] inline bool AddListener(const ServerSocket<SocketProtocol::TCP>& socket, const bool bExclusive = false) noexcept { return this->AddListener(socket.GetHandle(), bExclusive); }
+
+		// Adopts a connected socket, which is made non blocking
+		Connection* AddConnection(const int fd) noexcept;
+
+		inline Connection* AddConnection(ClientSocket<SocketProtocol::TCP>&& socket) noexcept { return this->AddConnection(socket.Release()); }
+
+		// Starts a non blocking connection to an IPv4 address, "m_onConnect" is called once it is established
+		Connection* Connect(const char* host, const uint16_t port) noexcept;
+
+		[[nodiscard]] Connection* FindConnection(const uint64_t id) noexcept;
+
+		[[nodiscard]] inline size_t GetConnectionCount() const noexcept { return this->m_connections.size(); }
+
+		// Calls "callback" after "delay" then every "interval" if it isn't 0, returns an id for CancelTimer()
+		uint64_t AddTimer(const std::chrono::milliseconds delay, std::function<void()> callback,
+		                  const std::chrono::milliseconds interval = std::chrono::milliseconds(0)) noexcept;
+
+		void CancelTimer(const uint64_t id) noexcept;
+
+		// Thread safe, runs "function" on the loop's thread during its next iteration
+		void Post(std::function<void()> function) noexcept;
+
+		// Thread safe, makes Run() return
+		void Stop() noexcept;
+
+		// Waits at most "timeout" milliseconds (negative : until something happens) & dispatches, returns the number of events
+		size_t RunOnce(const int timeout = -1) noexcept;
+
+		void Run() noexcept;
+
+		// Closes the remaining connections without calling "m_onClose"
+		~EventLoop() noexcept;
+	};
+
+	// How an event loop group listens
+	struct ListenOptions {
+		int  m_backlog             = SOMAXCONN;
+		bool m_bShardedListeners   = false; // One SO_REUSEPORT socket per loop instead of a single shared socket & accept queue
+		bool m_bPinThreads         = false; // Pins the i-th loop's thread to the i-th CPU the process may run on
+		bool m_bCpuSteering        = false; // Hands connections to the listener of the CPU that received them (sharded & pinned only, ignored otherwise)
+		int  m_deferAcceptSeconds  = 0;     // TCP_DEFER_ACCEPT, 0 disables it
+		int  m_fastOpenQueueLength = 0;     // TCP_FASTOPEN, 0 disables it
+	};
+
+	/*
+	 * One event loop per thread (one thread per hardware thread by default) accepting connections on a port.
+	 * The loops either share a listening socket or each get their own (sharded), in which case the kernel spreads
+	 * the connections over the sockets' queues so accepts don't serialize on a single one.
+	 * New connections stay on the loop that accepted them.
+	 */
+	class EventLoopGroup {
+	private:
+		std::vector<std::unique_ptr<EventLoop>>        m_loops;
+		std::vector<std::thread>                       m_threads;
+		std::vector<ServerSocket<SocketProtocol::TCP>> m_listeners;
+		bool                                           m_bPinThreads = false;
+
+	private:
+		// Makes the kernel pick the listener of the loop pinned to the CPU handling the connection
+		[[nodiscard]] bool AttachCpuSteering() noexcept;
+
+	public:
+		// Check IsValid()
+		EventLoopGroup(const EventLoopCallbacks& callbacks, const size_t nLoops = 0u, const IoEngine engine = IoEngine::EPOLL) noexcept;
+
+		EventLoopGroup(const EventLoopGroup&) = delete;
+		EventLoopGroup& operator=(const EventLoopGroup&) = delete;
+
+		// False if one of the loops couldn't be created, the group then holds none
+		[[nodiscard]] inline bool IsValid() const noexcept { return !this->m_loops.empty(); }
+
+		// Binds to "port" (0 picks a free one) & registers the listening socket(s) with the loops, false if the port can't be bound or listened on
+		[[nodiscard]] bool Listen(const uint16_t port, const ListenOptions& options) noexcept;
+
+		[[nodiscard]] inline bool Listen(const uint16_t port, const int backlog = SOMAXCONN) noexcept { return this->Listen(port, ListenOptions{ backlog }); }
+
+		[[nodiscard]] inline uint16_t GetPort() const noexcept { return this->m_listeners.empty() ? 0u : this->m_listeners.front().GetPort(); }
+
+		// Runs every loop on its own thread
+		void Start() noexcept;
+
+		// Stops & joins the loops' threads
+		void Stop() noexcept;
+
+		[[nodiscard]] inline size_t     GetLoopCount()             const noexcept { return this->m_loops.size(); }
+		[[nodiscard]] inline EventLoop& GetLoop(const size_t index) const noexcept { return *this->m_loops[index]; }
+
+		~EventLoopGroup() noexcept;
+	};
+
+	// Raises the soft limit of open file descriptors to the hard limit, servers holding thousands of connections need it
+	bool RaiseFileDescriptorLimit() noexcept;
+
+}; // WS
+
+#endif // __WEISS__OS_LINUX
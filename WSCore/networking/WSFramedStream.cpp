@@ -0,0 +1,252 @@
+#include "WSFramedStream.h"
+
+#ifdef __WEISS__OS_LINUX
+
+namespace WS {
+
+	FramedStream::FramedStream(const int socketFd, const size_t maxFrameSize, const size_t maxPendingWrite) noexcept
+		: m_socket(socketFd), m_maxFrameSize(maxFrameSize), m_maxPendingWrite(maxPendingWrite)
+	{
+		this->m_iovecs.resize(WS_FRAMED_STREAM_MAX_IOVECS);
+
+		// IsValid() reports it, reads fail instead of touching the missing ring
+		if (!this->ResizeReadRing(WS_FRAMED_STREAM_READ_RING_SIZE))
+			this->m_bFailed = true;
+	}
+
+	// ---------- Writing ---------- //
+
+	void FramedStream::AppendToArena(const void* data, const size_t size) noexcept
+	{
+		const size_t offset = this->m_writeArena.size();
+
+		this->m_writeArena.resize(offset + size);
+		std::memcpy(this->m_writeArena.data() + offset, data, size);
+
+		// Consecutive bytes of the arena are written as a single segment
+		if (this->m_writeSegments.size() > this->m_firstSegment && this->m_writeSegments.back().m_pExternal == nullptr) {
+			this->m_writeSegments.back().m_size += size;
+		} else {
+			this->m_writeSegments.push_back(WriteSegment{ nullptr, offset, size });
+		}
+	}
+
+	bool FramedStream::QueueFrame(const void* data, const size_t size, const bool bCopy) noexcept
+	{
+		if (!this->CanQueue(size))
+			return false;
+
+		uint8_t header[WS_VARINT_MAX_SIZE];
+		const size_t headerSize = EncodeVarint(size, header);
+
+		this->AppendToArena(header, headerSize);
+
+		if (bCopy || size < WS_FRAMED_STREAM_REFERENCE_SIZE) {
+			this->AppendToArena(data, size);
+		} else {
+			this->m_writeSegments.push_back(WriteSegment{ reinterpret_cast<const uint8_t*>(data), 0u, size });
+		}
+
+		this->m_pendingWrite += headerSize + size;
+
+		return true;
+	}
+
+	void FramedStream::CompactWriteQueue() noexcept
+	{
+		size_t arenaBegin = this->m_writeArena.size();
+
+		for (size_t i = this->m_firstSegment; i < this->m_writeSegments.size(); i++) {
+			if (this->m_writeSegments[i].m_pExternal == nullptr) {
+				arenaBegin = this->m_writeSegments[i].m_offset;
+				break;
+			}
+		}
+
+		this->m_writeArena.erase(this->m_writeArena.begin(), this->m_writeArena.begin() + arenaBegin);
+		this->m_writeSegments.erase(this->m_writeSegments.begin(), this->m_writeSegments.begin() + this->m_firstSegment);
+		this->m_firstSegment = 0u;
+
+		for (WriteSegment& segment : this->m_writeSegments)
+			if (segment.m_pExternal == nullptr)
+				segment.m_offset -= arenaBegin;
+	}
+
+	int64_t FramedStream::Flush() noexcept
+	{
+		size_t total = 0u;
+
+		while (this->m_pendingWrite > 0u) {
+			const size_t nSegments = std::min<size_t>(this->m_writeSegments.size() - this->m_firstSegment, WS_FRAMED_STREAM_MAX_IOVECS);
+
+			for (size_t i = 0u; i < nSegments; i++) {
+				const WriteSegment& segment = this->m_writeSegments[this->m_firstSegment + i];
+				const size_t        skipped = (i == 0u) ? this->m_segmentOffset : 0u;
+				const uint8_t*      pData   = (segment.m_pExternal == nullptr) ? this->m_writeArena.data() + segment.m_offset : segment.m_pExternal;
+
+				this->m_iovecs[i].iov_base = const_cast<uint8_t*>(pData + skipped);
+				this->m_iovecs[i].iov_len  = segment.m_size - skipped;
+			}
+
+			msghdr message{};
+			message.msg_iov    = this->m_iovecs.data();
+			message.msg_iovlen = nSegments;
+
+			const ssize_t nWritten = sendmsg(this->m_socket, &message, MSG_NOSIGNAL);
+
+			if (nWritten < 0) {
+				if (errno == EINTR)
+					continue;
+
+				if (errno == EAGAIN || errno == EWOULDBLOCK)
+					break;
+
+				return -1;
+			}
+
+			total                += static_cast<size_t>(nWritten);
+			this->m_pendingWrite -= static_cast<size_t>(nWritten);
+
+			// Skips the segments that were fully written
+			size_t remaining = static_cast<size_t>(nWritten);
+			while (remaining > 0u) {
+				const size_t left = this->m_writeSegments[this->m_firstSegment].m_size - this->m_segmentOffset;
+
+				if (remaining < left) {
+					this->m_segmentOffset += remaining;
+					break;
+				}
+
+				remaining -= left;
+				this->m_firstSegment++;
+				this->m_segmentOffset = 0u;
+			}
+		}
+
+		if (this->m_pendingWrite == 0u) {
+			this->m_writeArena.clear();
+			this->m_writeSegments.clear();
+			this->m_firstSegment  = 0u;
+			this->m_segmentOffset = 0u;
+		} else if (this->m_firstSegment >= 64u && this->m_firstSegment * 2u >= this->m_writeSegments.size()) {
+			this->CompactWriteQueue();
+		}
+
+		return static_cast<int64_t>(total);
+	}
+
+	// ---------- Reading ---------- //
+
+	bool FramedStream::ResizeReadRing(const size_t capacity) noexcept
+	{
+		const size_t pageSize    = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+		const size_t newCapacity = std::max(std::bit_ceil(capacity), pageSize);
+
+		const int memoryFd = memfd_create("WSFramedStream", MFD_CLOEXEC);
+		if (memoryFd < 0)
+			return false;
+
+		if (ftruncate(memoryFd, static_cast<off_t>(newCapacity)) != 0) {
+			close(memoryFd);
+			return false;
+		}
+
+		// Reserves both halves first so that nothing else gets mapped in between
+		uint8_t* pRing = reinterpret_cast<uint8_t*>(mmap(nullptr, 2u * newCapacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+
+		if (pRing == MAP_FAILED) {
+			close(memoryFd);
+			return false;
+		}
+
+		const bool bMapped = mmap(pRing,               newCapacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, memoryFd, 0) != MAP_FAILED &&
+		                     mmap(pRing + newCapacity, newCapacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, memoryFd, 0) != MAP_FAILED;
+
+		close(memoryFd);
+
+		if (!bMapped) {
+			munmap(pRing, 2u * newCapacity);
+			return false;
+		}
+
+		const size_t bufferedSize = this->GetBufferedReadSize();
+
+		if (this->m_pReadRing != nullptr) {
+			std::memcpy(pRing, this->m_pReadRing + (this->m_readHead & (this->m_readCapacity - 1u)), bufferedSize);
+			munmap(this->m_pReadRing, 2u * this->m_readCapacity);
+		}
+
+		this->m_pReadRing    = pRing;
+		this->m_readCapacity = newCapacity;
+		this->m_readHead     = 0u;
+		this->m_readTail     = bufferedSize;
+
+		return true;
+	}
+
+	int64_t FramedStream::Receive() noexcept
+	{
+		if (this->m_bFailed)
+			return -1;
+
+		// A frame larger than the ring can only be received once the ring grew to fit it
+		uint64_t     frameSize;
+		const size_t headerSize = DecodeVarint(this->m_pReadRing + (this->m_readHead & (this->m_readCapacity - 1u)), this->GetBufferedReadSize(), frameSize);
+
+		if (headerSize != 0u && headerSize != SIZE_MAX && frameSize <= this->m_maxFrameSize && headerSize + frameSize > this->m_readCapacity)
+			if (!this->ResizeReadRing(headerSize + frameSize))
+				return -1;
+
+		const size_t freeSize = this->m_readCapacity - this->GetBufferedReadSize();
+
+		// Full of complete frames, NextFrame() must be called first
+		if (freeSize == 0u) {
+			errno = ENOBUFS;
+			return -1;
+		}
+
+		// The second mapping makes the free space contiguous even when it wraps around
+		const ssize_t nRead = recv(this->m_socket, this->m_pReadRing + (this->m_readTail & (this->m_readCapacity - 1u)), freeSize, 0);
+
+		if (nRead > 0)
+			this->m_readTail += static_cast<uint64_t>(nRead);
+
+		return static_cast<int64_t>(nRead);
+	}
+
+	bool FramedStream::NextFrame(FrameView& frame) noexcept
+	{
+		if (this->m_bFailed)
+			return false;
+
+		const size_t   bufferedSize = this->GetBufferedReadSize();
+		const uint8_t* pHead        = this->m_pReadRing + (this->m_readHead & (this->m_readCapacity - 1u));
+
+		uint64_t     frameSize;
+		const size_t headerSize = DecodeVarint(pHead, bufferedSize, frameSize);
+
+		if (headerSize == SIZE_MAX || (headerSize != 0u && frameSize > this->m_maxFrameSize)) {
+			this->m_bFailed = true;
+			return false;
+		}
+
+		if (headerSize == 0u || headerSize + frameSize > bufferedSize)
+			return false;
+
+		frame.m_pData = pHead + headerSize;
+		frame.m_size  = static_cast<size_t>(frameSize);
+
+		this->m_readHead += headerSize + frameSize;
+
+		return true;
+	}
+
+	FramedStream::~FramedStream() noexcept
+	{
+		if (this->m_pReadRing != nullptr)
+			munmap(this->m_pReadRing, 2u * this->m_readCapacity);
+	}
+
+}; // WS
+
+#endif // __WEISS__OS_LINUX
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "WSSocket.h"
+#include "../misc/WSPch.h"
+
+#ifdef __WEISS__OS_LINUX
+
+#define WS_FRAMED_STREAM_MAX_FRAME_SIZE     (16u * 1024u * 1024u) // Larger frames are treated as a protocol error
+#define WS_FRAMED_STREAM_MAX_PENDING_WRITE  (4u * 1024u * 1024u)  // Queued bytes above which QueueFrame() refuses frames
+#define WS_FRAMED_STREAM_READ_RING_SIZE     65536u                // Initial read ring capacity, it grows to fit the largest frame received
+#define WS_FRAMED_STREAM_REFERENCE_SIZE     512u                  // Smaller payloads are always copied, referencing them costs more than it saves
+#define WS_FRAMED_STREAM_MAX_IOVECS         1024u                 // IOV_MAX on linux
+#define WS_VARINT_MAX_SIZE                  10u                   // Bytes of the largest 64 bit varint
+
+namespace WS {
+
+	// LEB128 : 7 bits per byte, least significant first, the high bit of each byte but the last is set
+	inline size_t EncodeVarint(uint64_t value, uint8_t* pOutput) noexcept
+	{
+		size_t size = 0u;
+
+		for (; value >= 0x80u; value >>= 7u)
+			pOutput[size++] = static_cast<uint8_t>(value) | 0x80u;
+
+		pOutput[size++] = static_cast<uint8_t>(value);
+
+		return size;
+	}
+
+	[[nodiscard]] inline size_t GetVarintSize(const uint64_t value) noexcept
+	{
+		return 1u + static_cast<size_t>((63 - std::countl_zero(value | 1u)) / 7);
+	}
+
+	// Returns the number of bytes read, 0 if "size" bytes don't hold the whole varint & SIZE_MAX if it is malformed
+	inline size_t DecodeVarint(const uint8_t* pInput, const size_t size, uint64_t& value) noexcept
+	{
+		value = 0u;
+
+		for (size_t i = 0u; i < std::min<size_t>(size, WS_VARINT_MAX_SIZE); i++) {
+			value |= static_cast<uint64_t>(pInput[i] & 0x7Fu) << (7u * i);
+
+			if ((pInput[i] & 0x80u) == 0u)
+				return i + 1u;
+		}
+
+		return (size >= WS_VARINT_MAX_SIZE) ? SIZE_MAX : 0u;
+	}
+
+	// The payload of a received frame, read in place from the stream's read ring
+	struct FrameView {
+		const uint8_t* m_pData = nullptr;
+		size_t         m_size  = 0u;
+	};
+
+	/*
+	 * Splits a TCP stream into messages (frames), each preceded by its size as a varint.
+	 *
+	 * Queued frames are gathered by Flush() into as few writes as possible (sendmsg() with an iovec per segment) : small frames are packed together,
+	 * large payloads can be referenced instead of copied. Received bytes land in a ring mapped twice back to back,
+	 * so every frame is contiguous in memory & NextFrame() hands it out without copying it, wherever it wraps around.
+	 *
+	 * The stream doesn't own the socket, which is usually non blocking, & must only be used by one thread at a time.
+	 */
+	class FramedStream {
+	private:
+		// Queued bytes, either in the write arena or referenced from the caller's memory
+		struct WriteSegment {
+			const uint8_t* m_pExternal; // nullptr for bytes in the arena
+			size_t         m_offset;    // In the arena
+			size_t         m_size;
+		};
+
+		int m_socket;
+
+		size_t m_maxFrameSize;
+		size_t m_maxPendingWrite;
+
+		// ---------- Writing ---------- //
+		std::vector<uint8_t>      m_writeArena;
+		std::vector<WriteSegment> m_writeSegments;
+		std::vector<iovec>        m_iovecs;
+		size_t                    m_firstSegment  = 0u; // Segments before it were written
+		size_t                    m_segmentOffset = 0u; // Bytes of the first segment that were written
+		size_t                    m_pendingWrite  = 0u;
+
+		// ---------- Reading ---------- //
+		uint8_t* m_pReadRing    = nullptr; // "m_readCapacity" bytes mapped twice in a row
+		size_t   m_readCapacity = 0u;
+		uint64_t m_readHead = 0u, m_readTail = 0u;
+		bool     m_bFailed  = false;
+
+	private:
+		// Maps a ring of at least "capacity" bytes holding the unread bytes of the current one
+		[[nodiscard]] bool ResizeReadRing(const size_t capacity) noexcept;
+
+		void AppendToArena(const void* data, const size_t size) noexcept;
+
+		// Drops the written segments & the arena bytes before the first unwritten one
+		void CompactWriteQueue() noexcept;
+
+	public:
+		explicit FramedStream(const int socketFd, const size_t maxFrameSize = WS_FRAMED_STREAM_MAX_FRAME_SIZE, const size_t maxPendingWrite = WS_FRAMED_STREAM_MAX_PENDING_WRITE) noexcept;
+
+		explicit FramedStream(SocketBase<SocketProtocol::TCP>& socket, const size_t maxFrameSize = WS_FRAMED_STREAM_MAX_FRAME_SIZE, const size_t maxPendingWrite = WS_FRAMED_STREAM_MAX_PENDING_WRITE) noexcept
+			: FramedStream(socket.GetHandle(), maxFrameSize, maxPendingWrite) {  }
+
+		FramedStream(const FramedStream&) = delete;
+		FramedStream& operator=(const FramedStream&) = delete;
+
+		// False if the read ring couldn't be mapped
+		[[nodiscard]] inline bool IsValid() const noexcept { return this->m_pReadRing != nullptr; }
+
+		// ---------- Writing ---------- //
+
+		/*
+		 * Queues a frame, false if it exceeds the maximum frame size or would push the queued bytes above the limit (backpressure) :
+		 * Flush() & retry once the socket is writable. Payloads of "bCopy" false frames are sent from "data" in place
+		 * (unless they're small) & must stay untouched until GetPendingWriteSize() drops to 0.
+		 */
+		[[nodiscard]] bool QueueFrame(const void* data, const size_t size, const bool bCopy = true) noexcept;
+
+		// Writes the queued frames until the socket would block, returns the bytes written or a negative value on failure
+		[[nodiscard]] int64_t Flush() noexcept;
+
+		[[nodiscard]] inline size_t GetPendingWriteSize() const noexcept { return this->m_pendingWrite; }
+
+		// Whether a frame of "size" bytes would be accepted by QueueFrame()
+		[[nodiscard]] inline bool CanQueue(const size_t size) const noexcept
+		{
+			return size <= this->m_maxFrameSize && this->m_pendingWrite + GetVarintSize(size) + size <= this->m_maxPendingWrite;
+		}
+
+		// ---------- Reading ---------- //
+
+		/*
+		 * Reads as many bytes as the ring has room for with a single recv(),
+		 * returns the number of bytes read, 0 once the peer closed the stream or a negative value on failure (including "would block").
+		 * Views handed out by NextFrame() are invalidated.
+		 */
+		[[nodiscard]] int64_t Receive() noexcept;
+
+		/*
+		 * Hands out the oldest complete frame, false if none was fully received yet or the stream failed.
+		 * "frame" points into the read ring & stays valid until the next Receive().
+		 */
+		[[nodiscard]] bool NextFrame(FrameView& frame) noexcept;
+
+		[[nodiscard]] inline size_t GetBufferedReadSize() const noexcept { return static_cast<size_t>(this->m_readTail - this->m_readHead); }
+
+		// True once a malformed or oversized frame size was received (or if the stream isn't valid), the stream can't be read from anymore
+		[[nodiscard]] inline bool HasFailed() const noexcept { return this->m_bFailed; }
+
+		~FramedStream() noexcept;
+	};
+
+}; // WS
+
+#endif // __WEISS__OS_LINUX
@@ -0,0 +1,233 @@
+#include "WSIoUring.h"
+
+#ifdef __WEISS__HAS_IO_URING
+
+namespace WS {
+
+	static inline int IoUringSetup(const uint32_t nEntries, io_uring_params* pParams) noexcept
+	{
+		return static_cast<int>(syscall(__NR_io_uring_setup, nEntries, pParams));
+	}
+
+	static inline int IoUringEnter(const int fd, const uint32_t toSubmit, const uint32_t minComplete, const uint32_t flags, const void* arg, const size_t argSize) noexcept
+	{
+		const int result = static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+
+		return (result < 0) ? -errno : result;
+	}
+
+	// ---------- IoUring ---------- //
+
+	IoUring::IoUring(const uint32_t nEntries, const uint32_t flags, const uint32_t nCompletionEntries) noexcept
+	{
+		io_uring_params params{};
+		params.flags      = flags | IORING_SETUP_CQSIZE;
+		params.cq_entries = (nCompletionEntries == 0u) ? nEntries * 2u : nCompletionEntries;
+
+		this->m_fd = IoUringSetup(nEntries, &params);
+
+		// Older kernels reject the flags they don't know about
+		if (this->m_fd < 0 && errno == EINVAL && flags != 0u) {
+			params            = io_uring_params{};
+			params.flags      = IORING_SETUP_CQSIZE;
+			params.cq_entries = (nCompletionEntries == 0u) ? nEntries * 2u : nCompletionEntries;
+
+			this->m_fd = IoUringSetup(nEntries, &params);
+		}
+
+		if (this->m_fd < 0)
+			return;
+
+		this->m_features   = params.features;
+		this->m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+		this->m_cqRingSize = params.cq_off.cqes  + params.cq_entries * sizeof(io_uring_cqe);
+		this->m_sqesSize   = params.sq_entries * sizeof(io_uring_sqe);
+
+		this->m_pSqRing = mmap(nullptr, this->m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->m_fd, IORING_OFF_SQ_RING);
+		this->m_pCqRing = mmap(nullptr, this->m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->m_fd, IORING_OFF_CQ_RING);
+		void* pSqes     = mmap(nullptr, this->m_sqesSize,   PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->m_fd, IORING_OFF_SQES);
+
+		if (this->m_pSqRing == MAP_FAILED || this->m_pCqRing == MAP_FAILED || pSqes == MAP_FAILED) {
+			if (this->m_pSqRing != MAP_FAILED) munmap(this->m_pSqRing, this->m_sqRingSize);
+			if (this->m_pCqRing != MAP_FAILED) munmap(this->m_pCqRing, this->m_cqRingSize);
+			if (pSqes           != MAP_FAILED) munmap(pSqes,           this->m_sqesSize);
+
+			this->m_pSqRing = this->m_pCqRing = nullptr;
+
+			close(this->m_fd);
+			this->m_fd = -1;
+			return;
+		}
+
+		uint8_t* const pSqRing = reinterpret_cast<uint8_t*>(this->m_pSqRing);
+		uint8_t* const pCqRing = reinterpret_cast<uint8_t*>(this->m_pCqRing);
+
+		this->m_pSqes     = reinterpret_cast<io_uring_sqe*>(pSqes);
+		this->m_pSqHead   = reinterpret_cast<uint32_t*>(pSqRing + params.sq_off.head);
+		this->m_pSqTail   = reinterpret_cast<uint32_t*>(pSqRing + params.sq_off.tail);
+		this->m_sqMask    = *reinterpret_cast<uint32_t*>(pSqRing + params.sq_off.ring_mask);
+		this->m_sqEntries = params.sq_entries;
+
+		this->m_pCqHead = reinterpret_cast<uint32_t*>(pCqRing + params.cq_off.head);
+		this->m_pCqTail = reinterpret_cast<uint32_t*>(pCqRing + params.cq_off.tail);
+		this->m_cqMask  = *reinterpret_cast<uint32_t*>(pCqRing + params.cq_off.ring_mask);
+		this->m_pCqes   = reinterpret_cast<io_uring_cqe*>(pCqRing + params.cq_off.cqes);
+
+		// Submission entries are always consumed in order, the indirection array is filled once
+		uint32_t* const pArray = reinterpret_cast<uint32_t*>(pSqRing + params.sq_off.array);
+		for (uint32_t i = 0u; i < params.sq_entries; i++)
+			pArray[i] = i;
+	}
+
+	io_uring_sqe* IoUring::GetSqe() noexcept
+	{
+		std::atomic_ref<uint32_t> head(*this->m_pSqHead);
+
+		if (*this->m_pSqTail + this->m_nPending - head.load(std::memory_order_acquire) >= this->m_sqEntries) {
+			this->Submit();
+
+			// The kernel couldn't take the queued entries (i.e -EBUSY while completions are overflowing)
+			if (*this->m_pSqTail - head.load(std::memory_order_acquire) >= this->m_sqEntries)
+				return nullptr;
+		}
+
+		const uint32_t tail = *this->m_pSqTail + this->m_nPending;
+
+		io_uring_sqe* const pSqe = &this->m_pSqes[tail & this->m_sqMask];
+		std::memset(pSqe, 0, sizeof(io_uring_sqe));
+
+		this->m_nPending++;
+
+		return pSqe;
+	}
+
+	int IoUring::Submit() noexcept
+	{
+		return this->SubmitAndWait(0u, nullptr);
+	}
+
+	int IoUring::SubmitAndWait(const uint32_t waitCount, const __kernel_timespec* pTimeout) noexcept
+	{
+		std::atomic_ref<uint32_t> tail(*this->m_pSqTail);
+
+		// Entries are only visible to the kernel once the tail moved past them
+		const uint32_t newTail = tail.load(std::memory_order_relaxed) + this->m_nPending;
+		tail.store(newTail, std::memory_order_release);
+		this->m_nPending = 0u;
+
+		const uint32_t toSubmit = newTail - std::atomic_ref<uint32_t>(*this->m_pSqHead).load(std::memory_order_acquire);
+
+		if (waitCount == 0u)
+			return IoUringEnter(this->m_fd, toSubmit, 0u, 0u, nullptr, 0u);
+
+		if (pTimeout == nullptr)
+			return IoUringEnter(this->m_fd, toSubmit, waitCount, IORING_ENTER_GETEVENTS, nullptr, 0u);
+
+		io_uring_getevents_arg arg{};
+		arg.sigmask_sz = _NSIG / 8;
+		arg.ts         = reinterpret_cast<uint64_t>(pTimeout);
+
+		return IoUringEnter(this->m_fd, toSubmit, waitCount, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+	}
+
+	int IoUring::Register(const uint32_t opcode, const void* arg, const uint32_t nArgs) noexcept
+	{
+		const int result = static_cast<int>(syscall(__NR_io_uring_register, this->m_fd, opcode, arg, nArgs));
+
+		return (result < 0) ? -errno : result;
+	}
+
+	bool IoUring::IsOpcodeSupported(const uint8_t opcode) noexcept
+	{
+		constexpr const uint32_t maxOpcodes = 256u;
+
+		std::vector<uint8_t> probeMemory(sizeof(io_uring_probe) + maxOpcodes * sizeof(io_uring_probe_op), 0u);
+		io_uring_probe* pProbe = reinterpret_cast<io_uring_probe*>(probeMemory.data());
+
+		if (this->Register(IORING_REGISTER_PROBE, pProbe, maxOpcodes) < 0 || opcode > pProbe->last_op)
+			return false;
+
+		return (pProbe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0u;
+	}
+
+	IoUring::~IoUring() noexcept
+	{
+		if (this->m_fd < 0)
+			return;
+
+		munmap(this->m_pSqes,   this->m_sqesSize);
+		munmap(this->m_pCqRing, this->m_cqRingSize);
+		munmap(this->m_pSqRing, this->m_sqRingSize);
+
+		close(this->m_fd);
+	}
+
+	// ---------- Provided Buffer Ring ---------- //
+
+	ProvidedBufferRing::ProvidedBufferRing(IoUring* pRing, const uint16_t groupId, const uint32_t nBuffers, const uint32_t bufferSize) noexcept
+		: m_pRing(pRing), m_nBuffers(nBuffers), m_bufferSize(bufferSize), m_groupId(groupId)
+	{
+		if (nBuffers == 0u || nBuffers > 32768u || !std::has_single_bit(nBuffers))
+			return;
+
+		this->m_ringMemorySize = nBuffers * sizeof(io_uring_buf);
+
+		void* pRingMemory    = mmap(nullptr, this->m_ringMemorySize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		void* pBufferMemory  = mmap(nullptr, static_cast<size_t>(nBuffers) * bufferSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+		if (pRingMemory == MAP_FAILED || pBufferMemory == MAP_FAILED) {
+			if (pRingMemory   != MAP_FAILED) munmap(pRingMemory,   this->m_ringMemorySize);
+			if (pBufferMemory != MAP_FAILED) munmap(pBufferMemory, static_cast<size_t>(nBuffers) * bufferSize);
+			return;
+		}
+
+		io_uring_buf_reg registration{};
+		registration.ring_addr    = reinterpret_cast<uint64_t>(pRingMemory);
+		registration.ring_entries = nBuffers;
+		registration.bgid         = groupId;
+
+		if (pRing->Register(IORING_REGISTER_PBUF_RING, &registration, 1u) < 0) {
+			munmap(pRingMemory,   this->m_ringMemorySize);
+			munmap(pBufferMemory, static_cast<size_t>(nBuffers) * bufferSize);
+			return;
+		}
+
+		this->m_pBufferRing = reinterpret_cast<io_uring_buf*>(pRingMemory);
+		this->m_pBuffers    = reinterpret_cast<uint8_t*>(pBufferMemory);
+
+		for (uint32_t i = 0u; i < nBuffers; i++)
+			this->Recycle(static_cast<uint16_t>(i));
+	}
+
+	void ProvidedBufferRing::Recycle(const uint16_t bufferId) noexcept
+	{
+		// Indexed by hand : in C++ the header's flexible "bufs" array doesn't start at the ring's beginning
+		io_uring_buf& buffer = this->m_pBufferRing[this->m_tail & (this->m_nBuffers - 1u)];
+
+		// "resv" of the first entry holds the ring's tail, entries are written field by field
+		buffer.addr = reinterpret_cast<uint64_t>(this->m_pBuffers + static_cast<size_t>(bufferId) * this->m_bufferSize);
+		buffer.len  = this->m_bufferSize;
+		buffer.bid  = bufferId;
+
+		this->m_tail++;
+
+		std::atomic_ref<uint16_t>(this->m_pBufferRing[0].resv).store(this->m_tail, std::memory_order_release);
+	}
+
+	ProvidedBufferRing::~ProvidedBufferRing() noexcept
+	{
+		if (this->m_pBufferRing == nullptr)
+			return;
+
+		io_uring_buf_reg registration{};
+		registration.bgid = this->m_groupId;
+
+		this->m_pRing->Register(IORING_UNREGISTER_PBUF_RING, &registration, 1u);
+
+		munmap(this->m_pBufferRing, this->m_ringMemorySize);
+		munmap(this->m_pBuffers,    static_cast<size_t>(this->m_nBuffers) * this->m_bufferSize);
+	}
+
+}; // WS
+
+#endif // __WEISS__HAS_IO_URING
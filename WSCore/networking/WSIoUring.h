@@ -0,0 +1,129 @@
+#pragma once
+
+#include "../misc/WSPch.h"
+
+#ifdef __WEISS__HAS_IO_URING
+
+namespace WS {
+
+	/*
+	 * A minimal io_uring instance driven through raw system calls (no liburing dependency).
+	 *
+	 * Entries returned by GetSqe() are queued locally & handed to the kernel in a single
+	 * io_uring_enter() by Submit() / SubmitAndWait(), completions are then drained by ForEachCompletion().
+	 * An instance must only be used by one thread at a time.
+	 */
+	class IoUring {
+	private:
+		int m_fd = -1;
+
+		void*  m_pSqRing    = nullptr;
+		void*  m_pCqRing    = nullptr;
+		size_t m_sqRingSize = 0u;
+		size_t m_cqRingSize = 0u;
+
+		io_uring_sqe* m_pSqes    = nullptr;
+		size_t        m_sqesSize = 0u;
+
+		uint32_t* m_pSqHead   = nullptr;
+		uint32_t* m_pSqTail   = nullptr;
+		uint32_t  m_sqMask    = 0u;
+		uint32_t  m_sqEntries = 0u;
+		uint32_t  m_nPending  = 0u; // Entries written but not published to the kernel yet
+
+		uint32_t*     m_pCqHead = nullptr;
+		uint32_t*     m_pCqTail = nullptr;
+		uint32_t      m_cqMask  = 0u;
+		io_uring_cqe* m_pCqes   = nullptr;
+
+		uint32_t m_features = 0u;
+
+	public:
+		/*
+		 * "nCompletionEntries" (0 : twice "nEntries") should cover every multishot request that may complete at once.
+		 * Falls back to a ring without "flags" when the kernel rejects them, check IsValid()
+		 */
+		IoUring(const uint32_t nEntries, const uint32_t flags = 0u, const uint32_t nCompletionEntries = 0u) noexcept;
+
+		IoUring(const IoUring&) = delete;
+		IoUring& operator=(const IoUring&) = delete;
+
+		[[nodiscard]] inline bool     IsValid()     const noexcept { return this->m_fd >= 0;    }
+		[[nodiscard]] inline int      GetHandle()   const noexcept { return this->m_fd;         }
+		[[nodiscard]] inline uint32_t GetFeatures() const noexcept { return this->m_features;   }
+
+		// A zeroed submission entry, the queued entries are submitted first when the queue is full
+		[[nodiscard]] io_uring_sqe* GetSqe() noexcept;
+
+		// Submits the queued entries, returns the number submitted or -errno
+		int Submit() noexcept;
+
+		// Submits & waits for "waitCount" completions, at most "pTimeout" when it isn't null
+		int SubmitAndWait(const uint32_t waitCount, const __kernel_timespec* pTimeout) noexcept;
+
+		// io_uring_register(), returns 0 or -errno
+		int Register(const uint32_t opcode, const void* arg, const uint32_t nArgs) noexcept;
+
+		// Whether the kernel implements "opcode" (IORING_OP_*)
+		[[nodiscard]] bool IsOpcodeSupported(const uint8_t opcode) noexcept;
+
+		// Calls "function(const io_uring_cqe&)" on every available completion, returns their number
+		template <typename _F>
+		size_t ForEachCompletion(_F&& function) noexcept
+		{
+			std::atomic_ref<uint32_t> head(*this->m_pCqHead);
+			std::atomic_ref<uint32_t> tail(*this->m_pCqTail);
+
+			const uint32_t first = head.load(std::memory_order_relaxed);
+			const uint32_t last  = tail.load(std::memory_order_acquire);
+
+			for (uint32_t current = first; current != last; current++) {
+				function(this->m_pCqes[current & this->m_cqMask]);
+
+				// Released one at a time : the callback may submit entries whose completions need the room
+				head.store(current + 1u, std::memory_order_release);
+			}
+
+			return static_cast<size_t>(last - first);
+		}
+
+		~IoUring() noexcept;
+	};
+
+	/*
+	 * A ring of equally sized buffers the kernel picks from when a receive completes (IORING_REGISTER_PBUF_RING),
+	 * which lets thousands of sockets have a receive pending without owning a buffer each.
+	 */
+	class ProvidedBufferRing {
+	private:
+		IoUring*           m_pRing          = nullptr;
+		io_uring_buf*      m_pBufferRing    = nullptr; // io_uring_buf_ring, its tail overlays the first entry's "resv"
+		uint8_t*           m_pBuffers       = nullptr;
+		size_t             m_ringMemorySize = 0u;
+		uint32_t           m_nBuffers       = 0u;
+		uint32_t           m_bufferSize     = 0u;
+		uint16_t           m_groupId        = 0u;
+		uint16_t           m_tail           = 0u;
+
+	public:
+		// "nBuffers" must be a power of two (at most 32768)
+		ProvidedBufferRing(IoUring* pRing, const uint16_t groupId, const uint32_t nBuffers, const uint32_t bufferSize) noexcept;
+
+		ProvidedBufferRing(const ProvidedBufferRing&) = delete;
+		ProvidedBufferRing& operator=(const ProvidedBufferRing&) = delete;
+
+		[[nodiscard]] inline bool     IsValid()       const noexcept { return this->m_pBufferRing != nullptr; }
+		[[nodiscard]] inline uint16_t GetGroupId()    const noexcept { return this->m_groupId;    }
+		[[nodiscard]] inline uint32_t GetBufferSize() const noexcept { return this->m_bufferSize; }
+
+		[[nodiscard]] inline const uint8_t* GetBuffer(const uint16_t bufferId) const noexcept { return this->m_pBuffers + static_cast<size_t>(bufferId) * this->m_bufferSize; }
+
+		// Hands a buffer back to the kernel once its content was consumed
+		void Recycle(const uint16_t bufferId) noexcept;
+
+		~ProvidedBufferRing() noexcept;
+	};
+
+}; // WS
+
+#endif // __WEISS__HAS_IO_URING
@@ -0,0 +1,214 @@
+#include "WSPacketRing.h"
+
+#ifdef __WEISS__OS_LINUX
+
+namespace WS {
+
+	// Room for the largest control message exchanged : a GRO segment size (int)
+	constexpr const size_t WS_PACKET_RING_CONTROL_SIZE = CMSG_SPACE(sizeof(int));
+
+	PacketRing::PacketRing(const size_t nSlots, const size_t slotSize) noexcept
+		: m_slotSize(slotSize)
+	{
+		const size_t slotCount = std::bit_ceil(std::max<size_t>(nSlots, 1u));
+
+		this->m_mask = static_cast<uint32_t>(slotCount - 1u);
+
+		this->m_storage.resize(slotCount * slotSize);
+		this->m_packets.resize(slotCount);
+		this->m_iovecs.resize(slotCount);
+		this->m_headers.resize(slotCount);
+		this->m_controls.resize(slotCount * ((WS_PACKET_RING_CONTROL_SIZE + sizeof(uint64_t) - 1u) / sizeof(uint64_t)));
+		this->m_messageSegments.resize(slotCount);
+
+		for (size_t i = 0u; i < slotCount; i++) {
+			this->m_packets[i].m_pData = this->m_storage.data() + i * slotSize;
+			this->m_iovecs[i].iov_base = this->m_packets[i].m_pData;
+		}
+	}
+
+	cmsghdr* PacketRing::GetControl(const size_t message) noexcept
+	{
+		return reinterpret_cast<cmsghdr*>(this->m_controls.data() + message * ((WS_PACKET_RING_CONTROL_SIZE + sizeof(uint64_t) - 1u) / sizeof(uint64_t)));
+	}
+
+	void PacketRing::Pop(const size_t count) noexcept
+	{
+		this->m_head += std::min(count, this->GetCount());
+
+		// Starting over from the first slot gives the next batch the whole ring before it wraps around
+		if (this->m_head == this->m_tail)
+			this->m_head = this->m_tail = 0u;
+	}
+
+	uint8_t* PacketRing::Push(const SocketAddress& address, const size_t size) noexcept
+	{
+		if (this->GetFreeCount() == 0u || size > this->m_slotSize)
+			return nullptr;
+
+		Packet& packet = this->m_packets[this->GetSlot(this->m_tail++)];
+		packet.m_size        = static_cast<uint32_t>(size);
+		packet.m_segmentSize = 0u;
+		packet.m_address     = address;
+
+		return packet.m_pData;
+	}
+
+	bool PacketRing::Push(const SocketAddress& address, const void* data, const size_t size) noexcept
+	{
+		uint8_t* pData = this->Push(address, size);
+
+		if (pData == nullptr)
+			return false;
+
+		std::memcpy(pData, data, size);
+
+		return true;
+	}
+
+	int64_t PacketRing::Receive(SocketBase<SocketProtocol::UDP>& socket) noexcept
+	{
+		const size_t first = this->GetSlot(this->m_tail);
+		const size_t count = std::min(this->GetFreeCount(), this->GetSlotCount() - first);
+
+		if (count == 0u)
+			return 0;
+
+		for (size_t i = 0u; i < count; i++) {
+			Packet& packet = this->m_packets[first + i];
+			msghdr& header = this->m_headers[i].msg_hdr;
+
+			this->m_iovecs[first + i].iov_len = this->m_slotSize;
+
+			header.msg_name       = &packet.m_address.m_address;
+			header.msg_namelen    = sizeof(packet.m_address.m_address);
+			header.msg_iov        = &this->m_iovecs[first + i];
+			header.msg_iovlen     = 1u;
+			header.msg_control    = this->GetControl(i);
+			header.msg_controllen = WS_PACKET_RING_CONTROL_SIZE;
+			header.msg_flags      = 0;
+		}
+
+		const int nReceived = recvmmsg(socket.GetHandle(), this->m_headers.data(), static_cast<unsigned int>(count), MSG_WAITFORONE, nullptr);
+
+		if (nReceived < 0)
+			return -1;
+
+		for (int i = 0; i < nReceived; i++) {
+			Packet& packet = this->m_packets[first + static_cast<size_t>(i)];
+			msghdr& header = this->m_headers[i].msg_hdr;
+
+			packet.m_size        = this->m_headers[i].msg_len;
+			packet.m_segmentSize = 0u;
+
+			for (cmsghdr* pControl = CMSG_FIRSTHDR(&header); pControl != nullptr; pControl = CMSG_NXTHDR(&header, pControl)) {
+				if (pControl->cmsg_level != SOL_UDP || pControl->cmsg_type != UDP_GRO)
+					continue;
+
+				int segmentSize;
+				std::memcpy(&segmentSize, CMSG_DATA(pControl), sizeof(segmentSize));
+
+				if (segmentSize > 0 && static_cast<uint32_t>(segmentSize) < packet.m_size)
+					packet.m_segmentSize = static_cast<uint32_t>(segmentSize);
+			}
+		}
+
+		this->m_tail += static_cast<size_t>(nReceived);
+
+		return nReceived;
+	}
+
+	int64_t PacketRing::Send(SocketBase<SocketProtocol::UDP>& socket) noexcept
+	{
+		const size_t first = this->GetSlot(this->m_head);
+		const size_t count = std::min(this->GetCount(), this->GetSlotCount() - first);
+
+		if (count == 0u)
+			return 0;
+
+		const bool bSegmentationOffload = this->m_bSegmentationOffload;
+		size_t     nMessages            = 0u;
+
+		for (size_t i = 0u; i < count; nMessages++) {
+			const Packet& packet    = this->m_packets[first + i];
+			size_t        nSegments = 1u;
+
+			// Same destination & size, only the last datagram of a segmented send may be shorter
+			if (bSegmentationOffload && packet.m_size > 0u) {
+				size_t totalSize = packet.m_size;
+
+				while (i + nSegments < count && nSegments < WS_PACKET_RING_MAX_GSO_SEGMENTS) {
+					const Packet& next = this->m_packets[first + i + nSegments];
+
+					if (!(next.m_address == packet.m_address) || next.m_size == 0u || next.m_size > packet.m_size || totalSize + next.m_size > WS_PACKET_RING_MAX_GSO_SIZE)
+						break;
+
+					totalSize += next.m_size;
+					nSegments++;
+
+					if (next.m_size < packet.m_size)
+						break;
+				}
+			}
+
+			for (size_t j = 0u; j < nSegments; j++)
+				this->m_iovecs[first + i + j].iov_len = this->m_packets[first + i + j].m_size;
+
+			msghdr& header = this->m_headers[nMessages].msg_hdr;
+			header.msg_name       = packet.m_address.IsSet() ? const_cast<sockaddr_in*>(&packet.m_address.m_address) : nullptr;
+			header.msg_namelen    = packet.m_address.IsSet() ? sizeof(packet.m_address.m_address) : 0u;
+			header.msg_iov        = &this->m_iovecs[first + i];
+			header.msg_iovlen     = nSegments;
+			header.msg_control    = nullptr;
+			header.msg_controllen = 0u;
+			header.msg_flags      = 0;
+
+			if (nSegments > 1u) {
+				const uint16_t segmentSize = static_cast<uint16_t>(packet.m_size);
+
+				cmsghdr* pControl = this->GetControl(nMessages);
+				pControl->cmsg_level = SOL_UDP;
+				pControl->cmsg_type  = UDP_SEGMENT;
+				pControl->cmsg_len   = CMSG_LEN(sizeof(segmentSize));
+				std::memcpy(CMSG_DATA(pControl), &segmentSize, sizeof(segmentSize));
+
+				header.msg_control    = pControl;
+				header.msg_controllen = CMSG_SPACE(sizeof(segmentSize));
+			}
+
+			this->m_messageSegments[nMessages] = static_cast<uint32_t>(nSegments);
+			i += nSegments;
+		}
+
+		const int nSent = sendmmsg(socket.GetHandle(), this->m_headers.data(), static_cast<unsigned int>(nMessages), MSG_NOSIGNAL);
+
+		if (nSent < 0) {
+			// The socket's route or the kernel can't segment, the datagrams are sent one by one from now on
+			if (bSegmentationOffload && (errno == EIO || errno == EINVAL || errno == ENOPROTOOPT || errno == EOPNOTSUPP)) {
+				this->m_bSegmentationOffload = false;
+
+				return this->Send(socket);
+			}
+
+			return -1;
+		}
+
+		size_t nDatagrams = 0u;
+		for (int i = 0; i < nSent; i++)
+			nDatagrams += this->m_messageSegments[i];
+
+		this->Pop(nDatagrams);
+
+		return static_cast<int64_t>(nDatagrams);
+	}
+
+	bool SetReceiveOffload(SocketBase<SocketProtocol::UDP>& socket, const bool bEnabled) noexcept
+	{
+		const int enable = bEnabled ? 1 : 0;
+
+		return setsockopt(socket.GetHandle(), SOL_UDP, UDP_GRO, &enable, sizeof(enable)) == 0;
+	}
+
+}; // WS
+
+#endif // __WEISS__OS_LINUX
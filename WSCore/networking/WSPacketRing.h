@@ -0,0 +1,114 @@
+#pragma once
+
+#include "WSSocket.h"
+#include "../misc/WSPch.h"
+
+#ifdef __WEISS__OS_LINUX
+
+#define WS_PACKET_RING_DEFAULT_SLOT_SIZE 2048u  // Holds any datagram that fits an ethernet frame
+#define WS_PACKET_RING_GRO_SLOT_SIZE     65536u // A receive coalesced by GRO carries up to 64 KiB
+#define WS_PACKET_RING_MAX_GSO_SEGMENTS  64u    // Datagrams the kernel accepts per segmented (GSO) send
+#define WS_PACKET_RING_MAX_GSO_SIZE      65507u // Largest UDP payload over IPv4
+
+namespace WS {
+
+	// A datagram stored in a PacketRing slot
+	struct Packet {
+		uint8_t*      m_pData       = nullptr;
+		uint32_t      m_size        = 0u;
+		uint32_t      m_segmentSize = 0u; // Received with GRO : the datagrams coalesced in the packet all have this size but the last, 0 for a single datagram
+		SocketAddress m_address;          // Source of received packets, destination of sent ones
+
+		// Calls "function(const uint8_t* data, size_t size)" on each datagram the packet holds
+		template <typename _F>
+		void ForEachDatagram(_F&& function) const noexcept
+		{
+			const uint32_t step = (this->m_segmentSize == 0u) ? this->m_size : this->m_segmentSize;
+
+			for (uint32_t offset = 0u; offset < this->m_size; offset += step)
+				function(this->m_pData + offset, static_cast<size_t>(std::min(step, this->m_size - offset)));
+		}
+	};
+
+	/*
+	 * A fixed number of preallocated datagram buffers used as a FIFO,
+	 * moved to & from UDP sockets in batches (a system call per batch instead of per datagram).
+	 *
+	 * Receive() fills the free slots, Push() queues datagrams that Send() transmits, Pop() releases the oldest packets.
+	 * A ring is meant for one direction, use one to receive & another to send.
+	 */
+	class PacketRing {
+	private:
+		std::vector<uint8_t>  m_storage;
+		std::vector<Packet>   m_packets;
+		std::vector<iovec>    m_iovecs;   // One per slot, consecutive slots are gathered by segmented sends
+		std::vector<mmsghdr>  m_headers;  // One per message of the current system call
+		std::vector<uint64_t> m_controls; // Control messages (GRO / GSO segment sizes), one per message
+		std::vector<uint32_t> m_messageSegments; // Datagrams gathered by each message of the current send
+
+		size_t   m_slotSize;
+		size_t   m_head = 0u, m_tail = 0u;
+		uint32_t m_mask;
+
+		bool m_bSegmentationOffload = false;
+
+	private:
+		[[nodiscard]] inline size_t GetSlot(const size_t index) const noexcept { return index & this->m_mask; }
+
+		[[nodiscard]] cmsghdr* GetControl(const size_t message) noexcept;
+
+	public:
+		// "nSlots" is rounded up to a power of two, slots larger than a datagram are only needed to receive with GRO
+		PacketRing(const size_t nSlots, const size_t slotSize = WS_PACKET_RING_DEFAULT_SLOT_SIZE) noexcept;
+
+		PacketRing(const PacketRing&) = delete;
+		PacketRing& operator=(const PacketRing&) = delete;
+
+		[[nodiscard]] inline size_t GetSlotCount() const noexcept { return this->m_packets.size(); }
+		[[nodiscard]] inline size_t GetSlotSize()  const noexcept { return this->m_slotSize; }
+		[[nodiscard]] inline size_t GetCount()     const noexcept { return this->m_tail - this->m_head; }
+		[[nodiscard]] inline size_t GetFreeCount() const noexcept { return this->GetSlotCount() - this->GetCount(); }
+		[[nodiscard]] inline bool   IsEmpty()      const noexcept { return this->m_tail == this->m_head; }
+
+		// "index" 0 is the oldest packet
+		[[nodiscard]] inline       Packet& operator[](const size_t index)       noexcept { return this->m_packets[this->GetSlot(this->m_head + index)]; }
+		[[nodiscard]] inline const Packet& operator[](const size_t index) const noexcept { return this->m_packets[this->GetSlot(this->m_head + index)]; }
+
+		// Releases the "count" oldest packets
+		void Pop(const size_t count = 1u) noexcept;
+
+		inline void Clear() noexcept { this->m_head = this->m_tail = 0u; }
+
+		// Queues a datagram of "size" bytes to be written by the caller, nullptr if the ring is full or "size" exceeds a slot
+		[[nodiscard]] uint8_t* Push(const SocketAddress& address, const size_t size) noexcept;
+
+		// Queues a copy of a datagram, false if the ring is full or "size" exceeds a slot
+		bool Push(const SocketAddress& address, const void* data, const size_t size) noexcept;
+
+		/*
+		 * Lets Send() hand consecutive datagrams of the same size & destination to the kernel as a single buffer,
+		 * which splits them late (UDP GSO, linux 4.18). Turned off on its own if the socket or kernel doesn't support it.
+		 */
+		inline void SetSegmentationOffload(const bool bEnabled) noexcept { this->m_bSegmentationOffload = bEnabled; }
+
+		[[nodiscard]] inline bool IsSegmentationOffloadEnabled() const noexcept { return this->m_bSegmentationOffload; }
+
+		/*
+		 * Receives up to one datagram per free slot (those before the ring wraps around) with a single recvmmsg(),
+		 * blocking sockets only wait for the first one. Returns the number of packets received or a negative value on failure.
+		 */
+		[[nodiscard]] int64_t Receive(SocketBase<SocketProtocol::UDP>& socket) noexcept;
+
+		/*
+		 * Sends the queued datagrams (those before the ring wraps around) with a single sendmmsg() & pops the ones sent.
+		 * Returns the number of datagrams sent or a negative value on failure, i.e when a non blocking socket's buffer is full.
+		 */
+		[[nodiscard]] int64_t Send(SocketBase<SocketProtocol::UDP>& socket) noexcept;
+	};
+
+	// Lets the kernel coalesce datagrams of the same flow before they're received (UDP GRO, linux 5.0), the ring's slots must be large enough
+	bool SetReceiveOffload(SocketBase<SocketProtocol::UDP>& socket, const bool bEnabled) noexcept;
+
+}; // WS
+
+#endif // __WEISS__OS_LINUX
@@ -0,0 +1,326 @@
+#include "WSSharedMemory.h"
+
+#ifdef __WEISS__OS_LINUX
+
+namespace WS {
+
+	constexpr const uint32_t WS_SHARED_MEMORY_MAGIC   = 0x4D485357u; // "WSHM"
+	constexpr const uint32_t WS_SHARED_MEMORY_VERSION = 1u;
+
+	static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+	              "The rings are shared between processes, their atomics can't rely on a lock");
+
+	// Starts the segment, the data of the two rings follows it
+	struct SharedMemoryHeader {
+		uint32_t   m_magic;
+		uint32_t   m_version;
+		uint64_t   m_capacity;
+		SharedRing m_rings[2]; // The creator sends on the first one
+	};
+
+	constexpr const size_t WS_SHARED_MEMORY_HEADER_SIZE = (sizeof(SharedMemoryHeader) + 4095u) & ~size_t(4095u);
+
+	// The futexes live in shared memory, they can't be process private
+	static inline void FutexWait(std::atomic<uint32_t>& word, const uint32_t expected) noexcept
+	{
+		syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+	}
+
+	static inline void FutexWake(std::atomic<uint32_t>& word) noexcept
+	{
+		syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+	}
+
+	static inline void SpinPause() noexcept
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		__builtin_ia32_pause();
+#elif defined(__aarch64__)
+		asm volatile("yield");
+#endif
+	}
+
+	// Polls "isReady" for a while, then sleeps on "sequence" until the other side bumps it
+	template <typename _F>
+	static void WaitUntil(std::atomic<uint32_t>& sequence, std::atomic<uint32_t>& bWaiting, const _F& isReady) noexcept
+	{
+		// Polling on a single CPU only delays the other side
+		static const uint32_t spinCount = (std::thread::hardware_concurrency() > 1u) ? WS_SHARED_MEMORY_SPIN_COUNT : 0u;
+
+		for (uint32_t i = 0u; i < spinCount; i++) {
+			if (isReady())
+				return;
+
+			SpinPause();
+		}
+
+		for (;;) {
+			const uint32_t value = sequence.load(std::memory_order_acquire);
+
+			// Pairs with the fence of Notify() : either it sees the flag or the condition is seen here
+			bWaiting.store(1u, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+
+			if (isReady())
+				break;
+
+			FutexWait(sequence, value);
+		}
+
+		bWaiting.store(0u, std::memory_order_relaxed);
+	}
+
+	static inline void Notify(std::atomic<uint32_t>& sequence, std::atomic<uint32_t>& bWaiting) noexcept
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		// Skips the system call while the other side is busy or polling
+		if (bWaiting.load(std::memory_order_relaxed) != 0u) {
+			sequence.fetch_add(1u, std::memory_order_release);
+			FutexWake(sequence);
+		}
+	}
+
+	SharedMemoryChannel::SharedMemoryChannel(SharedMemoryChannel&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	SharedMemoryChannel& SharedMemoryChannel::operator=(SharedMemoryChannel&& other) noexcept
+	{
+		if (this != &other) {
+			this->Close();
+
+			this->m_fd           = std::exchange(other.m_fd, -1);
+			this->m_pMapping     = std::exchange(other.m_pMapping, nullptr);
+			this->m_mappingSize  = std::exchange(other.m_mappingSize, 0u);
+			this->m_capacity     = std::exchange(other.m_capacity, 0u);
+			this->m_pSendRing    = std::exchange(other.m_pSendRing, nullptr);
+			this->m_pReceiveRing = std::exchange(other.m_pReceiveRing, nullptr);
+			this->m_pSendData    = std::exchange(other.m_pSendData, nullptr);
+			this->m_pReceiveData = std::exchange(other.m_pReceiveData, nullptr);
+			this->m_bNonBlocking = other.m_bNonBlocking;
+		}
+
+		return *this;
+	}
+
+	bool SharedMemoryChannel::Map(const int fd, const bool bCreator) noexcept
+	{
+		struct stat status;
+		if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < WS_SHARED_MEMORY_HEADER_SIZE)
+			return false;
+
+		const size_t mappingSize = static_cast<size_t>(status.st_size);
+		void*        pMapping    = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+		if (pMapping == MAP_FAILED)
+			return false;
+
+		SharedMemoryHeader* pHeader = reinterpret_cast<SharedMemoryHeader*>(pMapping);
+
+		if (bCreator) {
+			// The memfd is zero filled, which is the initial state of the rings
+			pHeader->m_magic    = WS_SHARED_MEMORY_MAGIC;
+			pHeader->m_version  = WS_SHARED_MEMORY_VERSION;
+			pHeader->m_capacity = (mappingSize - WS_SHARED_MEMORY_HEADER_SIZE) / 2u;
+		}
+
+		const uint64_t capacity = pHeader->m_capacity;
+
+		if (pHeader->m_magic != WS_SHARED_MEMORY_MAGIC || pHeader->m_version != WS_SHARED_MEMORY_VERSION ||
+		    capacity == 0u || (capacity & (capacity - 1u)) != 0u || WS_SHARED_MEMORY_HEADER_SIZE + 2u * capacity != mappingSize) {
+			munmap(pMapping, mappingSize);
+			return false;
+		}
+
+		uint8_t* pData = reinterpret_cast<uint8_t*>(pMapping) + WS_SHARED_MEMORY_HEADER_SIZE;
+
+		this->m_fd           = fd;
+		this->m_pMapping     = reinterpret_cast<uint8_t*>(pMapping);
+		this->m_mappingSize  = mappingSize;
+		this->m_capacity     = static_cast<size_t>(capacity);
+		this->m_pSendRing    = &pHeader->m_rings[bCreator ? 0 : 1];
+		this->m_pReceiveRing = &pHeader->m_rings[bCreator ? 1 : 0];
+		this->m_pSendData    = pData + (bCreator ? 0u : this->m_capacity);
+		this->m_pReceiveData = pData + (bCreator ? this->m_capacity : 0u);
+
+		return true;
+	}
+
+	bool SharedMemoryChannel::Create(const size_t capacity) noexcept
+	{
+		this->Close();
+
+		size_t roundedCapacity = 4096u;
+		while (roundedCapacity < capacity)
+			roundedCapacity *= 2u;
+
+		const int fd = memfd_create("WSSharedMemoryChannel", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+		if (fd < 0)
+			return false;
+
+		// Sealed so that the peer can't shrink the segment under our feet (which would raise SIGBUS)
+		if (ftruncate(fd, static_cast<off_t>(WS_SHARED_MEMORY_HEADER_SIZE + 2u * roundedCapacity)) != 0 ||
+		    fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0 || !this->Map(fd, true)) {
+			close(fd);
+			return false;
+		}
+
+		return true;
+	}
+
+	bool SharedMemoryChannel::Open(const int fd) noexcept
+	{
+		this->Close();
+
+		// Only a sealed segment is safe to map
+		const int seals = fcntl(fd, F_GET_SEALS);
+
+		if (seals < 0 || (seals & F_SEAL_SHRINK) == 0 || !this->Map(fd, false)) {
+			close(fd);
+			return false;
+		}
+
+		return true;
+	}
+
+	size_t SharedMemoryChannel::GetReceivableSize() const noexcept
+	{
+		if (!this->IsValid())
+			return 0u;
+
+		return static_cast<size_t>(this->m_pReceiveRing->m_head.load(std::memory_order_acquire) - this->m_pReceiveRing->m_tail.load(std::memory_order_relaxed));
+	}
+
+	int64_t SharedMemoryChannel::Send(const void* data, const size_t size) noexcept
+	{
+		if (!this->IsValid())
+			return -1;
+
+		SharedRing&    ring  = *this->m_pSendRing;
+		const uint8_t* pData = reinterpret_cast<const uint8_t*>(data);
+		size_t         sent  = 0u;
+
+		while (sent < size) {
+			if (ring.m_bClosed.load(std::memory_order_acquire) != 0u) {
+				errno = EPIPE;
+				return -1;
+			}
+
+			const uint64_t head = ring.m_head.load(std::memory_order_relaxed);
+			const size_t   room = this->m_capacity - static_cast<size_t>(head - ring.m_tail.load(std::memory_order_acquire));
+
+			if (room == 0u) {
+				if (this->m_bNonBlocking) {
+					if (sent > 0u)
+						break;
+
+					errno = EAGAIN;
+					return -1;
+				}
+
+				WaitUntil(ring.m_spaceSequence, ring.m_bProducerWaiting, [&ring, head, this]() {
+					return ring.m_bClosed.load(std::memory_order_acquire) != 0u || head - ring.m_tail.load(std::memory_order_acquire) < this->m_capacity;
+				});
+
+				continue;
+			}
+
+			// At most two copies, the chunk may wrap around the end of the ring
+			const size_t chunk  = std::min(room, size - sent);
+			const size_t offset = static_cast<size_t>(head) & (this->m_capacity - 1u);
+			const size_t first  = std::min(chunk, this->m_capacity - offset);
+
+			std::memcpy(this->m_pSendData + offset, pData + sent, first);
+			std::memcpy(this->m_pSendData, pData + sent + first, chunk - first);
+
+			ring.m_head.store(head + chunk, std::memory_order_release);
+			Notify(ring.m_dataSequence, ring.m_bConsumerWaiting);
+
+			sent += chunk;
+		}
+
+		return static_cast<int64_t>(sent);
+	}
+
+	int64_t SharedMemoryChannel::Receive(void* data, const size_t size) noexcept
+	{
+		if (!this->IsValid())
+			return -1;
+
+		if (size == 0u)
+			return 0;
+
+		SharedRing&    ring = *this->m_pReceiveRing;
+		const uint64_t tail = ring.m_tail.load(std::memory_order_relaxed);
+
+		for (;;) {
+			// Read before the head : bytes sent before hanging up are still received
+			const bool     bClosed   = ring.m_bClosed.load(std::memory_order_acquire) != 0u;
+			const size_t   available = static_cast<size_t>(ring.m_head.load(std::memory_order_acquire) - tail);
+
+			if (available > 0u) {
+				const size_t chunk  = std::min(available, size);
+				const size_t offset = static_cast<size_t>(tail) & (this->m_capacity - 1u);
+				const size_t first  = std::min(chunk, this->m_capacity - offset);
+
+				std::memcpy(data, this->m_pReceiveData + offset, first);
+				std::memcpy(reinterpret_cast<uint8_t*>(data) + first, this->m_pReceiveData, chunk - first);
+
+				ring.m_tail.store(tail + chunk, std::memory_order_release);
+				Notify(ring.m_spaceSequence, ring.m_bProducerWaiting);
+
+				return static_cast<int64_t>(chunk);
+			}
+
+			if (bClosed)
+				return 0;
+
+			if (this->m_bNonBlocking) {
+				errno = EAGAIN;
+				return -1;
+			}
+
+			WaitUntil(ring.m_dataSequence, ring.m_bConsumerWaiting, [&ring, tail]() {
+				return ring.m_bClosed.load(std::memory_order_acquire) != 0u || ring.m_head.load(std::memory_order_acquire) != tail;
+			});
+		}
+	}
+
+	void SharedMemoryChannel::Close() noexcept
+	{
+		if (!this->IsValid())
+			return;
+
+		// Wakes the peer whatever it waits for, the flags are never cleared
+		for (SharedRing* pRing : { this->m_pSendRing, this->m_pReceiveRing }) {
+			pRing->m_bClosed.store(1u, std::memory_order_release);
+
+			pRing->m_dataSequence.fetch_add(1u, std::memory_order_release);
+			pRing->m_spaceSequence.fetch_add(1u, std::memory_order_release);
+			FutexWake(pRing->m_dataSequence);
+			FutexWake(pRing->m_spaceSequence);
+		}
+
+		munmap(this->m_pMapping, this->m_mappingSize);
+		close(this->m_fd);
+
+		this->m_fd           = -1;
+		this->m_pMapping     = nullptr;
+		this->m_mappingSize  = 0u;
+		this->m_capacity     = 0u;
+		this->m_pSendRing    = nullptr;
+		this->m_pReceiveRing = nullptr;
+		this->m_pSendData    = nullptr;
+		this->m_pReceiveData = nullptr;
+	}
+
+	SharedMemoryChannel::~SharedMemoryChannel() noexcept
+	{
+		this->Close();
+	}
+
+}; // WS
+
+#endif // __WEISS__OS_LINUX
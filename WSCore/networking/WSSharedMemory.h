@@ -0,0 +1,99 @@
+#pragma once
+
+#include "WSSocket.h"
+#include "../misc/WSPch.h"
+
+#ifdef __WEISS__OS_LINUX
+
+#define WS_SHARED_MEMORY_DEFAULT_CAPACITY 1048576u // Bytes per direction, a power of 2
+#define WS_SHARED_MEMORY_SPIN_COUNT       4096u    // Polls of the ring before sleeping on its futex, waking up costs microseconds
+
+namespace WS {
+
+	// One direction of a channel : a single producer, single consumer byte ring living in shared memory
+	struct SharedRing {
+		alignas(64) std::atomic<uint64_t> m_head; // Bytes written so far, only moved by the producer
+		alignas(64) std::atomic<uint64_t> m_tail; // Bytes read so far, only moved by the consumer
+
+		// Futex words, bumped after the producer published bytes & after the consumer freed space
+		alignas(64) std::atomic<uint32_t> m_dataSequence;
+		std::atomic<uint32_t>             m_bConsumerWaiting;
+		alignas(64) std::atomic<uint32_t> m_spaceSequence;
+		std::atomic<uint32_t>             m_bProducerWaiting;
+
+		alignas(64) std::atomic<uint32_t> m_bClosed; // Either side hung up
+	};
+
+	/*
+	 * A bidirectional byte stream between two processes (or threads) of the same machine,
+	 * made of two lock free rings in a memfd segment. Send() & Receive() behave like the ones of a TCP socket
+	 * but never enter the kernel while the peer keeps up : a waiting side polls for a while before sleeping on a futex.
+	 *
+	 * Create() makes the segment, the peer maps it with Open() from a duplicate of its descriptor,
+	 * which it inherits or receives over a unix socket :
+	 *
+	 *   SharedMemoryChannel channel;
+	 *   channel.Create();
+	 *   const int fd = channel.GetHandle();
+	 *   socket.SendDescriptors("s", 1u, &fd, 1u);
+	 *
+	 * Each side must only be used by one thread at a time. Closing any mapping of a side hangs up,
+	 * including the copy a forked child inherited : such a child must exit without destroying it or Open() its own duplicate.
+	 */
+	class SharedMemoryChannel {
+	private:
+		int      m_fd          = -1;
+		uint8_t* m_pMapping    = nullptr;
+		size_t   m_mappingSize = 0u;
+		size_t   m_capacity    = 0u;
+
+		SharedRing* m_pSendRing    = nullptr;
+		SharedRing* m_pReceiveRing = nullptr;
+		uint8_t*    m_pSendData    = nullptr;
+		uint8_t*    m_pReceiveData = nullptr;
+
+		bool m_bNonBlocking = false;
+
+	private:
+		[[nodiscard]] bool Map(const int fd, const bool bCreator) noexcept;
+
+	public:
+		SharedMemoryChannel() = default;
+
+		SharedMemoryChannel(SharedMemoryChannel&& other) noexcept;
+		SharedMemoryChannel& operator=(SharedMemoryChannel&& other) noexcept;
+
+		SharedMemoryChannel(const SharedMemoryChannel&) = delete;
+		SharedMemoryChannel& operator=(const SharedMemoryChannel&) = delete;
+
+		// Creates the segment, "capacity" is rounded up to a power of 2
+		[[nodiscard]] bool Create(const size_t capacity = WS_SHARED_MEMORY_DEFAULT_CAPACITY) noexcept;
+
+		// Maps the segment of a created channel as its peer, the channel takes ownership of "fd"
+		[[nodiscard]] bool Open(const int fd) noexcept;
+
+		[[nodiscard]] inline bool   IsValid()     const noexcept { return this->m_pMapping != nullptr; }
+		[[nodiscard]] inline int    GetHandle()   const noexcept { return this->m_fd;              }
+		[[nodiscard]] inline size_t GetCapacity() const noexcept { return this->m_capacity;        }
+
+		// Send() & Receive() return -1 with errno set to EAGAIN instead of waiting
+		inline void SetNonBlocking(const bool bNonBlocking) noexcept { this->m_bNonBlocking = bNonBlocking; }
+
+		// Bytes that can be read right away
+		[[nodiscard]] size_t GetReceivableSize() const noexcept;
+
+		// Writes all of "data" (waiting for room when blocking), returns the number of bytes written or a negative value once the peer hung up
+		[[nodiscard]] int64_t Send(const void* data, const size_t size) noexcept;
+
+		// Reads at most "size" bytes (waiting for one when blocking), returns the number of bytes read or 0 once the peer hung up
+		[[nodiscard]] int64_t Receive(void* data, const size_t size) noexcept;
+
+		// Hangs up, the peer drains the bytes that were sent & then sees the end of the stream
+		void Close() noexcept;
+
+		~SharedMemoryChannel() noexcept;
+	};
+
+}; // WS
+
+#endif // __WEISS__OS_LINUX
@@ -0,0 +1,602 @@
+#include "WSSnapshot.h"
+#include "../misc/WSBitStream.h"
+
+namespace WS {
+
+	// Datagram types
+	constexpr const uint8_t WS_SNAPSHOT_FRAGMENT = 1u; // type, sequence (u32), index (u8), count (u8), payload bytes
+	constexpr const uint8_t WS_SNAPSHOT_ACK      = 2u; // type, sequence (u32)
+
+	constexpr const size_t WS_SNAPSHOT_FRAGMENT_HEADER_SIZE = 7u;
+
+	// A payload is the baseline's sequence (u32, 0 for none) followed by the encoded snapshot
+	constexpr const size_t WS_SNAPSHOT_PAYLOAD_HEADER_SIZE = 4u;
+
+	static inline void StoreU32(uint8_t* pBytes, const uint32_t value) noexcept
+	{
+		pBytes[0] = static_cast<uint8_t>(value);
+		pBytes[1] = static_cast<uint8_t>(value >> 8u);
+		pBytes[2] = static_cast<uint8_t>(value >> 16u);
+		pBytes[3] = static_cast<uint8_t>(value >> 24u);
+	}
+
+	[[nodiscard]] static inline uint32_t LoadU32(const uint8_t* pBytes) noexcept
+	{
+		return static_cast<uint32_t>(pBytes[0]) | (static_cast<uint32_t>(pBytes[1]) << 8u) |
+		       (static_cast<uint32_t>(pBytes[2]) << 16u) | (static_cast<uint32_t>(pBytes[3]) << 24u);
+	}
+
+	// ---------- Bit Packing ---------- //
+
+	// Values are packed least significant bit first, see WSBitStream.h
+	using SnapshotBitWriter = BitWriter<BitOrder::LSB_FIRST>;
+	using SnapshotBitReader = BitReader<BitOrder::LSB_FIRST>;
+
+	// Small values are the common case : a 2 bit tier picks 4, 8, 16 or 32 bits
+	static inline void WriteVariable(SnapshotBitWriter& writer, const uint32_t value) noexcept
+	{
+		const uint32_t tier = (value < (1u << 4u)) ? 0u : (value < (1u << 8u)) ? 1u : (value < (1u << 16u)) ? 2u : 3u;
+
+		writer.Write(tier, 2u);
+		writer.Write(value, 4u << tier);
+	}
+
+	[[nodiscard]] static inline uint32_t ReadVariable(SnapshotBitReader& reader) noexcept
+	{
+		const uint32_t tier = static_cast<uint32_t>(reader.Read(2u));
+
+		return static_cast<uint32_t>(reader.Read(4u << tier));
+	}
+
+	[[nodiscard]] static inline uint32_t ZigZag(const int32_t value) noexcept { return (static_cast<uint32_t>(value) << 1u) ^ static_cast<uint32_t>(value >> 31); }
+
+	[[nodiscard]] static inline int32_t UnZigZag(const uint32_t value) noexcept { return static_cast<int32_t>(value >> 1u) ^ -static_cast<int32_t>(value & 1u); }
+
+	// ---------- Codec ---------- //
+
+	SnapshotCodec::SnapshotCodec(const SnapshotQuantization& quantization) noexcept
+		: m_quantization(quantization)
+	{
+		this->m_rotationBits = std::clamp<uint32_t>(quantization.m_rotationBits, 2u, 15u);
+
+		// The widest axis decides whether the precision fits in WS_SNAPSHOT_MAX_POSITION_BITS
+		float range = 0.0f;
+		for (size_t axis = 0u; axis < 3u; axis++)
+			range = std::max(range, quantization.m_boundsMax.m_arr[axis] - quantization.m_boundsMin.m_arr[axis]);
+
+		constexpr const float maxSteps = static_cast<float>((1u << WS_SNAPSHOT_MAX_POSITION_BITS) - 1u);
+		this->m_positionStep = std::max(quantization.m_positionPrecision, range / maxSteps);
+
+		if (!(this->m_positionStep > 0.0f))
+			this->m_positionStep = 1.0f;
+
+		for (size_t axis = 0u; axis < 3u; axis++) {
+			const float    extent = std::max(0.0f, quantization.m_boundsMax.m_arr[axis] - quantization.m_boundsMin.m_arr[axis]);
+			const uint32_t steps  = static_cast<uint32_t>(std::min(maxSteps, std::ceil(extent / this->m_positionStep)));
+
+			this->m_positionBits[axis] = 1u;
+			while (this->m_positionBits[axis] < WS_SNAPSHOT_MAX_POSITION_BITS && (steps >> this->m_positionBits[axis]) != 0u)
+				this->m_positionBits[axis]++;
+		}
+	}
+
+	QuantizedEntity SnapshotCodec::Quantize(const EntityState& entity) const noexcept
+	{
+		QuantizedEntity quantized;
+		quantized.m_id = entity.m_id;
+
+		for (size_t axis = 0u; axis < 3u; axis++) {
+			const float maxStep = static_cast<float>((1u << this->m_positionBits[axis]) - 1u);
+			const float steps   = (entity.m_position.m_arr[axis] - this->m_quantization.m_boundsMin.m_arr[axis]) / this->m_positionStep;
+
+			quantized.m_position[axis] = static_cast<uint32_t>(std::clamp(std::round(steps), 0.0f, maxStep));
+		}
+
+		// Smallest three : the largest component is dropped & rebuilt from the others, which then lie in [-1 / sqrt(2), 1 / sqrt(2)]
+		float q[4u] = { entity.m_rotation.x, entity.m_rotation.y, entity.m_rotation.z, entity.m_rotation.w };
+
+		const float length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+		const float scale  = (length > 0.0f) ? 1.0f / length : 1.0f;
+
+		// A null quaternion is taken as the identity
+		if (!(length > 0.0f))
+			q[3] = 1.0f;
+
+		uint32_t largest = 3u;
+		for (uint32_t i = 0u; i < 3u; i++)
+			if (std::abs(q[i]) > std::abs(q[largest]))
+				largest = i;
+
+		// q & -q are the same rotation : the dropped component is made positive
+		const float sign    = (q[largest] < 0.0f) ? -scale : scale;
+		const float maxCode = static_cast<float>((1u << this->m_rotationBits) - 1u);
+		uint64_t    packed  = largest;
+
+		for (uint32_t i = 0u; i < 4u; i++) {
+			if (i == largest)
+				continue;
+
+			const float normalized = (q[i] * sign * static_cast<float>(M_SQRT2) + 1.0f) * 0.5f;
+
+			packed = (packed << this->m_rotationBits) | static_cast<uint64_t>(std::clamp(std::round(normalized * maxCode), 0.0f, maxCode));
+		}
+
+		quantized.m_rotation = packed;
+
+		return quantized;
+	}
+
+	EntityState SnapshotCodec::Dequantize(const QuantizedEntity& entity) const noexcept
+	{
+		EntityState state;
+		state.m_id = entity.m_id;
+
+		state.m_position = Vecf32(this->m_quantization.m_boundsMin.x + static_cast<float>(entity.m_position[0]) * this->m_positionStep,
+		                          this->m_quantization.m_boundsMin.y + static_cast<float>(entity.m_position[1]) * this->m_positionStep,
+		                          this->m_quantization.m_boundsMin.z + static_cast<float>(entity.m_position[2]) * this->m_positionStep);
+
+		const uint32_t largest = static_cast<uint32_t>(entity.m_rotation >> (3u * this->m_rotationBits)) & 3u;
+		const uint32_t mask    = (1u << this->m_rotationBits) - 1u;
+		const float    maxCode = static_cast<float>(mask);
+
+		float q[4u];
+		float sum   = 0.0f;
+		int   shift = 2 * static_cast<int>(this->m_rotationBits);
+
+		for (uint32_t i = 0u; i < 4u; i++) {
+			if (i == largest)
+				continue;
+
+			const uint32_t code = static_cast<uint32_t>(entity.m_rotation >> shift) & mask;
+			shift -= static_cast<int>(this->m_rotationBits);
+
+			q[i] = (static_cast<float>(code) / maxCode * 2.0f - 1.0f) * static_cast<float>(M_SQRT1_2);
+			sum += q[i] * q[i];
+		}
+
+		q[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+
+		state.m_rotation = Vecf32(q[0], q[1], q[2], q[3]);
+
+		return state;
+	}
+
+	void SnapshotCodec::Quantize(const EntityState* entities, const size_t count, std::vector<QuantizedEntity>& snapshot) const noexcept
+	{
+		snapshot.resize(count);
+
+		for (size_t i = 0u; i < count; i++)
+			snapshot[i] = this->Quantize(entities[i]);
+
+		// Already sorted in the usual case of entities stored by id
+		if (!std::is_sorted(snapshot.begin(), snapshot.end(), [](const QuantizedEntity& a, const QuantizedEntity& b) { return a.m_id < b.m_id; }))
+			std::sort(snapshot.begin(), snapshot.end(), [](const QuantizedEntity& a, const QuantizedEntity& b) { return a.m_id < b.m_id; });
+	}
+
+	/*
+	 * Encoding (bit packed, every count & id gap is a variable length integer) :
+	 *   removed entity count, then the gap between the ids of consecutive removed entities
+	 *   updated entity count, then for each updated entity :
+	 *     the gap between its id & the previous updated one's
+	 *     if the baseline has it : position changed bit [+ 3 zigzag step deltas], rotation changed bit [+ rotation]
+	 *     otherwise : full position & rotation
+	 */
+	void SnapshotCodec::Encode(const std::vector<QuantizedEntity>* pBaseline, const std::vector<QuantizedEntity>& snapshot, std::vector<uint8_t>& output) const noexcept
+	{
+		static const std::vector<QuantizedEntity> empty;
+		const std::vector<QuantizedEntity>& baseline = (pBaseline != nullptr) ? *pBaseline : empty;
+
+		// Walks both sorted lists, calling "onRemoved(baselineEntity)" & "onUpdated(entity, pBaselineEntity)"
+		const auto diff = [&baseline, &snapshot](const auto& onRemoved, const auto& onUpdated) {
+			size_t b = 0u;
+
+			for (const QuantizedEntity& entity : snapshot) {
+				while (b < baseline.size() && baseline[b].m_id < entity.m_id)
+					onRemoved(baseline[b++]);
+
+				if (b < baseline.size() && baseline[b].m_id == entity.m_id) {
+					const QuantizedEntity& previous = baseline[b++];
+
+					if (!entity.HasSamePosition(previous) || entity.m_rotation != previous.m_rotation)
+						onUpdated(entity, &previous);
+				} else {
+					onUpdated(entity, nullptr);
+				}
+			}
+
+			for (; b < baseline.size(); b++)
+				onRemoved(baseline[b]);
+		};
+
+		uint32_t nRemoved = 0u, nUpdated = 0u;
+		diff([&nRemoved](const QuantizedEntity&) { nRemoved++; },
+		     [&nUpdated](const QuantizedEntity&, const QuantizedEntity*) { nUpdated++; });
+
+		SnapshotBitWriter writer(output);
+		uint32_t          previousId   = 0u;
+		const uint32_t    rotationSize = 2u + 3u * this->m_rotationBits;
+
+		WriteVariable(writer, nRemoved);
+		diff([&writer, &previousId](const QuantizedEntity& removed) {
+			WriteVariable(writer, removed.m_id - previousId);
+			previousId = removed.m_id;
+		}, [](const QuantizedEntity&, const QuantizedEntity*) {  });
+
+		previousId = 0u;
+		WriteVariable(writer, nUpdated);
+		diff([](const QuantizedEntity&) {  }, [this, &writer, &previousId, rotationSize](const QuantizedEntity& entity, const QuantizedEntity* pPrevious) {
+			WriteVariable(writer, entity.m_id - previousId);
+			previousId = entity.m_id;
+
+			if (pPrevious == nullptr) {
+				for (size_t axis = 0u; axis < 3u; axis++)
+					writer.Write(entity.m_position[axis], this->m_positionBits[axis]);
+
+				writer.Write(entity.m_rotation, rotationSize);
+				return;
+			}
+
+			const bool bMoved = !entity.HasSamePosition(*pPrevious);
+			writer.WriteBit(bMoved);
+
+			if (bMoved)
+				for (size_t axis = 0u; axis < 3u; axis++)
+					WriteVariable(writer, ZigZag(static_cast<int32_t>(entity.m_position[axis] - pPrevious->m_position[axis])));
+
+			const bool bRotated = entity.m_rotation != pPrevious->m_rotation;
+			writer.WriteBit(bRotated);
+
+			if (bRotated)
+				writer.Write(entity.m_rotation, rotationSize);
+		});
+
+		writer.Flush();
+	}
+
+	bool SnapshotCodec::Decode(const std::vector<QuantizedEntity>* pBaseline, const uint8_t* data, const size_t size, std::vector<QuantizedEntity>& snapshot) const noexcept
+	{
+		static const std::vector<QuantizedEntity> empty;
+		const std::vector<QuantizedEntity>& baseline = (pBaseline != nullptr) ? *pBaseline : empty;
+
+		SnapshotBitReader reader(data, size);
+		const uint32_t    rotationSize = 2u + 3u * this->m_rotationBits;
+
+		const uint32_t nRemoved = ReadVariable(reader);
+		if (reader.HasOverrun() || nRemoved > baseline.size())
+			return false;
+
+		snapshot.clear();
+		snapshot.reserve(baseline.size());
+
+		// Baseline entities that weren't removed, updated entities replace them below
+		size_t   b      = 0u;
+		uint32_t lastId = 0u;
+
+		for (uint32_t i = 0u; i < nRemoved; i++) {
+			const uint32_t id = lastId + ReadVariable(reader);
+
+			if (reader.HasOverrun() || (i > 0u && id <= lastId))
+				return false;
+
+			lastId = id;
+
+			while (b < baseline.size() && baseline[b].m_id < id)
+				snapshot.push_back(baseline[b++]);
+
+			if (b == baseline.size() || baseline[b].m_id != id)
+				return false;
+
+			b++;
+		}
+
+		for (; b < baseline.size(); b++)
+			snapshot.push_back(baseline[b]);
+
+		// Every updated entity takes at least 8 bits, which bounds what a malformed count makes us reserve
+		const uint32_t nUpdated = ReadVariable(reader);
+		if (reader.HasOverrun() || nUpdated > size)
+			return false;
+
+		// Merged in place : updates are appended then the two sorted runs are merged, updated ids replacing the kept ones
+		const size_t nKept = snapshot.size();
+		size_t       k     = 0u;
+
+		lastId = 0u;
+		for (uint32_t i = 0u; i < nUpdated; i++) {
+			QuantizedEntity entity;
+			entity.m_id = lastId + ReadVariable(reader);
+
+			if (reader.HasOverrun() || (i > 0u && entity.m_id <= lastId))
+				return false;
+
+			lastId = entity.m_id;
+
+			while (k < nKept && snapshot[k].m_id < entity.m_id)
+				k++;
+
+			if (k < nKept && snapshot[k].m_id == entity.m_id) {
+				const QuantizedEntity& previous = snapshot[k];
+
+				entity.m_rotation = previous.m_rotation;
+				std::memcpy(entity.m_position, previous.m_position, sizeof(entity.m_position));
+
+				if (reader.ReadBit())
+					for (size_t axis = 0u; axis < 3u; axis++)
+						entity.m_position[axis] = previous.m_position[axis] + static_cast<uint32_t>(UnZigZag(ReadVariable(reader)));
+
+				if (reader.ReadBit())
+					entity.m_rotation = reader.Read(rotationSize);
+			} else {
+				for (size_t axis = 0u; axis < 3u; axis++)
+					entity.m_position[axis] = static_cast<uint32_t>(reader.Read(this->m_positionBits[axis]));
+
+				entity.m_rotation = reader.Read(rotationSize);
+			}
+
+			if (reader.HasOverrun())
+				return false;
+
+			snapshot.push_back(entity);
+		}
+
+		// Both runs are sorted, an updated entity comes after the kept one it replaces
+		std::inplace_merge(snapshot.begin(), snapshot.begin() + static_cast<ptrdiff_t>(nKept), snapshot.end(),
+		                   [](const QuantizedEntity& a, const QuantizedEntity& b) { return a.m_id < b.m_id; });
+
+		size_t nEntities = 0u;
+		for (size_t i = 0u; i < snapshot.size(); i++) {
+			if (i + 1u < snapshot.size() && snapshot[i + 1u].m_id == snapshot[i].m_id)
+				continue;
+
+			snapshot[nEntities++] = snapshot[i];
+		}
+
+		snapshot.resize(nEntities);
+
+		return true;
+	}
+
+	// ---------- Server ---------- //
+
+	uint32_t SnapshotServer::AddClient(const SocketAddress& address) noexcept
+	{
+		Client client;
+		client.m_id      = this->m_nextClientId++;
+		client.m_address = address;
+
+		this->m_clients.push_back(client);
+
+		return client.m_id;
+	}
+
+	void SnapshotServer::RemoveClient(const uint32_t clientId) noexcept
+	{
+		std::erase_if(this->m_clients, [clientId](const Client& client) { return client.m_id == clientId; });
+	}
+
+	const SnapshotServer::ClientStats* SnapshotServer::GetClientStats(const uint32_t clientId) const noexcept
+	{
+		for (const Client& client : this->m_clients)
+			if (client.m_id == clientId)
+				return &client.m_stats;
+
+		return nullptr;
+	}
+
+	uint32_t SnapshotServer::Capture(const EntityState* entities, const size_t count) noexcept
+	{
+		WS_PROFILE_SCOPE("SnapshotServer::Capture");
+
+		// Sequence 0 means "no baseline" on the wire
+		if (++this->m_sequence == 0u)
+			++this->m_sequence;
+
+		this->m_codec.Quantize(entities, count, this->m_history[this->m_sequence % WS_SNAPSHOT_HISTORY_SIZE]);
+
+		return this->m_sequence;
+	}
+
+	const std::vector<uint8_t>& SnapshotServer::GetPayload(const uint32_t baseline, size_t& nPayloads) noexcept
+	{
+		// Clients that acknowledged the same snapshot share its encoding
+		for (size_t i = 0u; i < nPayloads; i++)
+			if (this->m_payloads[i].first == baseline)
+				return this->m_payloads[i].second;
+
+		if (nPayloads == this->m_payloads.size())
+			this->m_payloads.emplace_back();
+
+		std::pair<uint32_t, std::vector<uint8_t>>& payload = this->m_payloads[nPayloads++];
+		payload.first = baseline;
+		payload.second.resize(WS_SNAPSHOT_PAYLOAD_HEADER_SIZE);
+		StoreU32(payload.second.data(), baseline);
+
+		const std::vector<QuantizedEntity>* pBaseline = (baseline != 0u) ? &this->m_history[baseline % WS_SNAPSHOT_HISTORY_SIZE] : nullptr;
+		this->m_codec.Encode(pBaseline, this->m_history[this->m_sequence % WS_SNAPSHOT_HISTORY_SIZE], payload.second);
+
+		return payload.second;
+	}
+
+	int64_t SnapshotServer::Send(SocketBase<SocketProtocol::UDP>& socket) noexcept
+	{
+		WS_PROFILE_SCOPE("SnapshotServer::Send");
+
+		if (this->m_sequence == 0u)
+			return 0;
+
+		int64_t totalSent = 0;
+		size_t  nPayloads = 0u;
+
+		this->m_datagram.resize(WS_SNAPSHOT_FRAGMENT_HEADER_SIZE + WS_SNAPSHOT_FRAGMENT_SIZE);
+
+		for (Client& client : this->m_clients) {
+			// Snapshots older than the history were overwritten, the client gets a full one
+			const uint32_t acked    = client.m_stats.m_ackedSequence;
+			const uint32_t age      = this->m_sequence - acked;
+			const uint32_t baseline = (acked != 0u && age > 0u && age < WS_SNAPSHOT_HISTORY_SIZE) ? acked : 0u;
+
+			const std::vector<uint8_t>& payload    = this->GetPayload(baseline, nPayloads);
+			const size_t                nFragments = (payload.size() + WS_SNAPSHOT_FRAGMENT_SIZE - 1u) / WS_SNAPSHOT_FRAGMENT_SIZE;
+
+			if (nFragments > WS_SNAPSHOT_MAX_FRAGMENTS)
+				continue;
+
+			for (size_t fragment = 0u; fragment < nFragments; fragment++) {
+				const size_t offset = fragment * WS_SNAPSHOT_FRAGMENT_SIZE;
+				const size_t size   = std::min<size_t>(WS_SNAPSHOT_FRAGMENT_SIZE, payload.size() - offset);
+
+				this->m_datagram[0] = WS_SNAPSHOT_FRAGMENT;
+				StoreU32(&this->m_datagram[1], this->m_sequence);
+				this->m_datagram[5] = static_cast<uint8_t>(fragment);
+				this->m_datagram[6] = static_cast<uint8_t>(nFragments);
+				std::memcpy(&this->m_datagram[WS_SNAPSHOT_FRAGMENT_HEADER_SIZE], &payload[offset], size);
+
+				const int64_t sent = socket.SendTo(this->m_datagram.data(), WS_SNAPSHOT_FRAGMENT_HEADER_SIZE + size, client.m_address);
+				if (sent < 0)
+					return sent;
+
+				totalSent                  += sent;
+				client.m_stats.m_bytesSent += static_cast<uint64_t>(sent);
+			}
+
+			client.m_stats.m_snapshotsSent++;
+			if (baseline == 0u)
+				client.m_stats.m_fullSnapshots++;
+		}
+
+		return totalSent;
+	}
+
+	void SnapshotServer::OnDatagram(const SocketAddress& address, const uint8_t* data, const size_t size) noexcept
+	{
+		if (size != 5u || data[0] != WS_SNAPSHOT_ACK)
+			return;
+
+		const uint32_t sequence = LoadU32(&data[1]);
+
+		// Acknowledgements can arrive out of order & must not be from the future
+		for (Client& client : this->m_clients) {
+			if (!(client.m_address == address))
+				continue;
+
+			if (sequence != 0u && sequence <= this->m_sequence && sequence > client.m_stats.m_ackedSequence)
+				client.m_stats.m_ackedSequence = sequence;
+
+			return;
+		}
+	}
+
+	// ---------- Client ---------- //
+
+	bool SnapshotClient::DecodePayload(const uint32_t sequence, const uint8_t* data, const size_t size) noexcept
+	{
+		if (size < WS_SNAPSHOT_PAYLOAD_HEADER_SIZE)
+			return false;
+
+		const uint32_t baseline = LoadU32(data);
+
+		const std::vector<QuantizedEntity>* pBaseline = nullptr;
+		if (baseline != 0u) {
+			// The baseline must still be in the history
+			const size_t slot = baseline % WS_SNAPSHOT_HISTORY_SIZE;
+			if (this->m_historySequences[slot] != baseline)
+				return false;
+
+			pBaseline = &this->m_history[slot];
+		}
+
+		// The baseline may share the slot of the new snapshot, which is only overwritten once decoded
+		std::vector<QuantizedEntity> snapshot;
+		if (!this->m_codec.Decode(pBaseline, data + WS_SNAPSHOT_PAYLOAD_HEADER_SIZE, size - WS_SNAPSHOT_PAYLOAD_HEADER_SIZE, snapshot))
+			return false;
+
+		const size_t slot = sequence % WS_SNAPSHOT_HISTORY_SIZE;
+
+		this->m_history[slot]          = std::move(snapshot);
+		this->m_historySequences[slot] = sequence;
+		this->m_sequence               = sequence;
+
+		return true;
+	}
+
+	bool SnapshotClient::OnDatagram(const uint8_t* data, const size_t size) noexcept
+	{
+		if (size <= WS_SNAPSHOT_FRAGMENT_HEADER_SIZE || data[0] != WS_SNAPSHOT_FRAGMENT)
+			return false;
+
+		const uint32_t sequence     = LoadU32(&data[1]);
+		const uint8_t  index        = data[5];
+		const uint8_t  nFragments   = data[6];
+		const size_t   fragmentSize = size - WS_SNAPSHOT_FRAGMENT_HEADER_SIZE;
+
+		// Only the last fragment may be smaller than the others
+		if (sequence <= this->m_sequence || nFragments == 0u || index >= nFragments || fragmentSize > WS_SNAPSHOT_FRAGMENT_SIZE ||
+		    (index + 1u < nFragments && fragmentSize != WS_SNAPSHOT_FRAGMENT_SIZE))
+			return false;
+
+		// The snapshot's slot, otherwise a free one, otherwise the oldest
+		Reassembly* pReassembly = nullptr;
+		for (Reassembly& reassembly : this->m_reassemblies) {
+			if (reassembly.m_sequence == sequence) {
+				pReassembly = &reassembly;
+				break;
+			}
+
+			if (pReassembly == nullptr || reassembly.m_sequence < pReassembly->m_sequence)
+				pReassembly = &reassembly;
+		}
+
+		Reassembly& reassembly = *pReassembly;
+
+		if (reassembly.m_sequence != sequence) {
+			reassembly.m_sequence   = sequence;
+			reassembly.m_nFragments = nFragments;
+			reassembly.m_nReceived  = 0u;
+			reassembly.m_size       = 0u;
+			reassembly.m_received.reset();
+			reassembly.m_payload.resize(static_cast<size_t>(nFragments) * WS_SNAPSHOT_FRAGMENT_SIZE);
+		} else if (reassembly.m_nFragments != nFragments || reassembly.m_received[index]) {
+			return false;
+		}
+
+		std::memcpy(&reassembly.m_payload[static_cast<size_t>(index) * WS_SNAPSHOT_FRAGMENT_SIZE], data + WS_SNAPSHOT_FRAGMENT_HEADER_SIZE, fragmentSize);
+
+		if (index + 1u == nFragments)
+			reassembly.m_size = static_cast<size_t>(index) * WS_SNAPSHOT_FRAGMENT_SIZE + fragmentSize;
+
+		reassembly.m_received[index] = true;
+		if (++reassembly.m_nReceived < nFragments)
+			return false;
+
+		const bool bDecoded = this->DecodePayload(sequence, reassembly.m_payload.data(), reassembly.m_size);
+
+		// Older partial snapshots won't be of any use anymore
+		for (Reassembly& other : this->m_reassemblies)
+			if (other.m_sequence <= sequence)
+				other.m_sequence = 0u;
+
+		return bDecoded;
+	}
+
+	int64_t SnapshotClient::SendAck(SocketBase<SocketProtocol::UDP>& socket, const SocketAddress& server) noexcept
+	{
+		if (this->m_sequence == 0u)
+			return 0;
+
+		uint8_t datagram[5u];
+		datagram[0] = WS_SNAPSHOT_ACK;
+		StoreU32(&datagram[1], this->m_sequence);
+
+		return socket.SendTo(datagram, sizeof(datagram), server);
+	}
+
+	void SnapshotClient::GetEntities(std::vector<EntityState>& entities) const noexcept
+	{
+		const std::vector<QuantizedEntity>& snapshot = this->GetQuantizedEntities();
+
+		entities.resize(snapshot.size());
+		for (size_t i = 0u; i < snapshot.size(); i++)
+			entities[i] = this->m_codec.Dequantize(snapshot[i]);
+	}
+
+}; // WS
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "WSSocket.h"
+#include "../misc/WSPch.h"
+#include "../math/WSVector.h"
+#include "../debugging/WSProfiler.h"
+
+#define WS_SNAPSHOT_HISTORY_SIZE      32u   // Snapshots kept to delta encode against, per server & client
+#define WS_SNAPSHOT_FRAGMENT_SIZE     1200u // Payload bytes per datagram, below the usual path MTU
+#define WS_SNAPSHOT_MAX_FRAGMENTS     255u  // A snapshot larger than 255 fragments isn't sent
+#define WS_SNAPSHOT_REASSEMBLY_SLOTS  4u    // Snapshots a client reassembles at once, older partial ones are dropped
+#define WS_SNAPSHOT_MAX_POSITION_BITS 24u   // The position step is widened when the bounds need more bits per axis
+
+namespace WS {
+
+	// The replicated state of an entity, "m_rotation" is a unit quaternion (x, y, z, w)
+	struct EntityState {
+		uint32_t m_id = 0u;
+		Vecf32   m_position;
+		Vecf32   m_rotation = Vecf32(0.0f, 0.0f, 0.0f, 1.0f);
+	};
+
+	// Must be the same on the server & its clients
+	struct SnapshotQuantization {
+		Vecf32  m_boundsMin         = Vecf32(-1024.0f, -1024.0f, -1024.0f);
+		Vecf32  m_boundsMax         = Vecf32( 1024.0f,  1024.0f,  1024.0f);
+		float   m_positionPrecision = 1.0f / 256.0f; // World units per step
+		uint8_t m_rotationBits      = 10u;           // Per smallest three component, from 2 to 15
+	};
+
+	struct QuantizedEntity {
+		uint32_t m_id;
+		uint32_t m_position[3]; // Steps from the bounds' minimum
+		uint64_t m_rotation;    // Index of the dropped component (2 bits) followed by the 3 others, up to 47 bits
+
+		[[nodiscard]] inline bool HasSamePosition(const QuantizedEntity& other) const noexcept
+		{
+			return this->m_position[0] == other.m_position[0] && this->m_position[1] == other.m_position[1] && this->m_position[2] == other.m_position[2];
+		}
+	};
+
+	/*
+	 * Quantizes entities & bit packs snapshots (lists of quantized entities sorted by id).
+	 * A snapshot is encoded against a baseline the receiver has : entities that didn't change cost nothing,
+	 * the others send small position deltas & their rotation if it changed, removed entities send their id.
+	 */
+	class SnapshotCodec {
+	private:
+		SnapshotQuantization m_quantization;
+		float                m_positionStep;
+		uint32_t             m_positionBits[3];
+		uint32_t             m_rotationBits;
+
+	public:
+		explicit SnapshotCodec(const SnapshotQuantization& quantization = {}) noexcept;
+
+		[[nodiscard]] inline const SnapshotQuantization& GetQuantization() const noexcept { return this->m_quantization; }
+
+		// Positions are clamped to the bounds
+		[[nodiscard]] QuantizedEntity Quantize(const EntityState& entity) const noexcept;
+		[[nodiscard]] EntityState     Dequantize(const QuantizedEntity& entity) const noexcept;
+
+		// Sorts by id, "entities" must not hold an id twice
+		void Quantize(const EntityState* entities, const size_t count, std::vector<QuantizedEntity>& snapshot) const noexcept;
+
+		// Appends the encoding of "snapshot" to "output", "pBaseline" is null to encode every entity in full
+		void Encode(const std::vector<QuantizedEntity>* pBaseline, const std::vector<QuantizedEntity>& snapshot, std::vector<uint8_t>& output) const noexcept;
+
+		// False if the data is malformed, "snapshot" is then unspecified
+		[[nodiscard]] bool Decode(const std::vector<QuantizedEntity>* pBaseline, const uint8_t* data, const size_t size, std::vector<QuantizedEntity>& snapshot) const noexcept;
+	};
+
+	/*
+	 * Replicates snapshots to clients over UDP : each one gets the latest snapshot encoded against the last one it acknowledged
+	 * (or in full when it's too old), split in fragments of at most WS_SNAPSHOT_FRAGMENT_SIZE bytes.
+	 */
+	class SnapshotServer {
+	public:
+		struct ClientStats {
+			uint64_t m_bytesSent     = 0u; // Datagram payloads, without the UDP & IP headers
+			uint64_t m_snapshotsSent = 0u;
+			uint64_t m_fullSnapshots = 0u; // Sent without a baseline
+			uint32_t m_ackedSequence = 0u; // 0 until the first acknowledgement
+		};
+
+	private:
+		struct Client {
+			uint32_t      m_id;
+			SocketAddress m_address;
+			ClientStats   m_stats;
+		};
+
+		SnapshotCodec m_codec;
+
+		std::vector<QuantizedEntity> m_history[WS_SNAPSHOT_HISTORY_SIZE]; // Indexed by sequence
+		uint32_t                     m_sequence     = 0u;                 // Of the latest capture, sequences start at 1
+		uint32_t                     m_nextClientId = 1u;
+
+		std::vector<Client> m_clients;
+
+		// Scratch buffers, kept to avoid allocating every tick
+		std::vector<uint8_t>                                   m_datagram;
+		std::vector<std::pair<uint32_t, std::vector<uint8_t>>> m_payloads; // Encodings of the current tick, by baseline
+
+	private:
+		// The latest snapshot encoded against "baseline", reusing the first "nPayloads" encodings of the tick
+		[[nodiscard]] const std::vector<uint8_t>& GetPayload(const uint32_t baseline, size_t& nPayloads) noexcept;
+
+	public:
+		explicit SnapshotServer(const SnapshotQuantization& quantization = {}) noexcept : m_codec(quantization) {  }
+
+		// Returns the id of the client
+		uint32_t AddClient(const SocketAddress& address) noexcept;
+
+		void RemoveClient(const uint32_t clientId) noexcept;
+
+		[[nodiscard]] const ClientStats* GetClientStats(const uint32_t clientId) const noexcept;
+
+		[[nodiscard]] inline size_t   GetClientCount() const noexcept { return this->m_clients.size(); }
+		[[nodiscard]] inline uint32_t GetSequence()    const noexcept { return this->m_sequence;       }
+
+		// Quantizes & stores the current state of the world, returns the sequence of the snapshot
+		uint32_t Capture(const EntityState* entities, const size_t count) noexcept;
+
+		// Sends the latest snapshot to every client (skipping ones too large to fragment), returns the number of bytes sent or a negative value on failure
+		int64_t Send(SocketBase<SocketProtocol::UDP>& socket) noexcept;
+
+		// Handles a datagram received from a client (acknowledgements)
+		void OnDatagram(const SocketAddress& address, const uint8_t* data, const size_t size) noexcept;
+	};
+
+	/*
+	 * Reassembles & decodes the snapshots sent by a SnapshotServer.
+	 * Late or incomplete snapshots are dropped, every decoded one should be acknowledged with SendAck().
+	 */
+	class SnapshotClient {
+	private:
+		struct Reassembly {
+			uint32_t             m_sequence   = 0u; // 0 when the slot is free
+			uint8_t              m_nFragments = 0u;
+			uint8_t              m_nReceived  = 0u;
+			std::bitset<256u>    m_received;
+			size_t               m_size       = 0u;
+			std::vector<uint8_t> m_payload;
+		};
+
+		SnapshotCodec m_codec;
+
+		std::vector<QuantizedEntity> m_history[WS_SNAPSHOT_HISTORY_SIZE];
+		uint32_t                     m_historySequences[WS_SNAPSHOT_HISTORY_SIZE] = {};
+		uint32_t                     m_sequence = 0u; // Of the latest decoded snapshot
+
+		Reassembly m_reassemblies[WS_SNAPSHOT_REASSEMBLY_SLOTS];
+
+	private:
+		[[nodiscard]] bool DecodePayload(const uint32_t sequence, const uint8_t* data, const size_t size) noexcept;
+
+	public:
+		explicit SnapshotClient(const SnapshotQuantization& quantization = {}) noexcept : m_codec(quantization) {  }
+
+		// Handles a datagram received from the server, true when it completed a newer snapshot
+		bool OnDatagram(const uint8_t* data, const size_t size) noexcept;
+
+		// Acknowledges the latest decoded snapshot, returns the number of bytes sent or a negative value on failure
+		int64_t SendAck(SocketBase<SocketProtocol::UDP>& socket, const SocketAddress& server) noexcept;
+
+		[[nodiscard]] inline uint32_t GetSequence() const noexcept { return this->m_sequence; }
+
+		// Entities of the latest decoded snapshot, sorted by id
+		[[nodiscard]] inline const std::vector<QuantizedEntity>& GetQuantizedEntities() const noexcept { return this->m_history[this->m_sequence % WS_SNAPSHOT_HISTORY_SIZE]; }
+
+		void GetEntities(std::vector<EntityState>& entities) const noexcept;
+	};
+
+}; // WS
@@ -2,9 +2,315 @@
 
 namespace WS {
 
+	SocketAddress::SocketAddress(const char* host, const uint16_t port) noexcept
+	{
+		if (inet_pton(AF_INET, host, &this->m_address.sin_addr) != 1)
+			return;
+
+		this->m_address.sin_family = AF_INET;
+		this->m_address.sin_port   = htons(port);
+	}
+
+	std::string SocketAddress::ToString() const noexcept
+	{
+		char host[INET_ADDRSTRLEN] = {};
+		inet_ntop(AF_INET, &this->m_address.sin_addr, host, sizeof(host));
+
+		return std::string(host) + ':' + std::to_string(this->GetPort());
+	}
+
+#ifdef __WEISS__OS_LINUX
+
+	// Fills a unix socket address, a leading '@' designates the abstract namespace
+	[[nodiscard]] static bool MakeUnixAddress(const char* path, sockaddr_un& address, socklen_t& addressSize) noexcept
+	{
+		const size_t length = std::strlen(path);
+
+		// Abstract names aren't null terminated
+		if (length == 0u || length >= sizeof(address.sun_path))
+			return false;
+
+		std::memset(&address, 0, sizeof(address));
+		address.sun_family = AF_UNIX;
+		std::memcpy(address.sun_path, path, length);
+
+		if (path[0] == '@')
+			address.sun_path[0] = '\0';
+
+		addressSize = static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + length + ((path[0] == '@') ? 0u : 1u));
+
+		return true;
+	}
+
+#endif // __WEISS__OS_LINUX
+
+	template <SocketProtocol _PROTOCOL>
+	SocketBase<_PROTOCOL>::SocketBase() noexcept
+	{
+		WS_SET_SOCKET_TO_INVALID_STATE(this->m_socket);
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	SocketBase<_PROTOCOL>::SocketBase(const WS_SOCKET_TYPE socket) noexcept
+		: m_socket(socket)
+	{
+
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	SocketBase<_PROTOCOL>::SocketBase(SocketBase&& other) noexcept
+		: m_socket(other.m_socket)
+	{
+		WS_SET_SOCKET_TO_INVALID_STATE(other.m_socket);
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	SocketBase<_PROTOCOL>& SocketBase<_PROTOCOL>::operator=(SocketBase&& other) noexcept
+	{
+		if (this != &other) {
+			this->Disconnect();
+
+			this->m_socket = other.m_socket;
+			WS_SET_SOCKET_TO_INVALID_STATE(other.m_socket);
+		}
+
+		return *this;
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	bool SocketBase<_PROTOCOL>::Open() noexcept
+	{
+		this->Disconnect();
+
+		if constexpr (IsUnixProtocol(_PROTOCOL)) {
+#ifdef __WEISS__OS_LINUX
+
+			this->m_socket = socket(AF_UNIX, ((_PROTOCOL == SocketProtocol::UNIX) ? SOCK_STREAM : SOCK_DGRAM) | SOCK_CLOEXEC, 0);
+
+#else
+
+			return false;
+
+#endif
+		} else {
+																							   // TCP       // UDP
+			constexpr const int addressFamily = WS_SOCKET_SELECT_VALUE_PER_PROTOCOL(_PROTOCOL, AF_INET,     AF_INET);
+			constexpr const int type          = WS_SOCKET_SELECT_VALUE_PER_PROTOCOL(_PROTOCOL, SOCK_STREAM, SOCK_DGRAM);
+			constexpr const int protocol      = WS_SOCKET_SELECT_VALUE_PER_PROTOCOL(_PROTOCOL, IPPROTO_TCP, IPPROTO_UDP);
+
+			this->m_socket = socket(addressFamily, type, protocol);
+		}
+
+		return !WS_IS_SOCKET_INVALID(this->m_socket);
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	WS_SOCKET_TYPE SocketBase<_PROTOCOL>::Release() noexcept
+	{
+		const WS_SOCKET_TYPE socket = this->m_socket;
+
+		WS_SET_SOCKET_TO_INVALID_STATE(this->m_socket);
+
+		return socket;
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	bool SocketBase<_PROTOCOL>::SetNonBlocking(const bool bNonBlocking) noexcept
+	{
+#ifdef __WEISS__OS_WINDOWS
+
+		u_long mode = bNonBlocking ? 1u : 0u;
+		const bool bFailed = ioctlsocket(this->m_socket, FIONBIO, &mode) != 0;
+
+#elif defined(__WEISS__OS_LINUX)
+
+		const int flags = fcntl(this->m_socket, F_GETFL, 0);
+		const bool bFailed = flags < 0 || fcntl(this->m_socket, F_SETFL, bNonBlocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK)) < 0;
+
+#endif
+
+		return !bFailed;
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	bool SocketBase<_PROTOCOL>::SetBufferSizes(const int receiveSize, const int sendSize) noexcept
+	{
+		bool bSucceeded = true;
+
+		if (receiveSize > 0)
+			bSucceeded &= setsockopt(this->m_socket, SOL_SOCKET, SO_RCVBUF, (const char*)&receiveSize, sizeof(receiveSize)) == 0;
+
+		if (sendSize > 0)
+			bSucceeded &= setsockopt(this->m_socket, SOL_SOCKET, SO_SNDBUF, (const char*)&sendSize, sizeof(sendSize)) == 0;
+
+		return bSucceeded;
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	bool SocketBase<_PROTOCOL>::SetNoDelay(const bool bNoDelay) noexcept
+	{
+		if constexpr (_PROTOCOL == SocketProtocol::TCP) {
+			const int enable = bNoDelay ? 1 : 0;
+
+			return setsockopt(this->m_socket, IPPROTO_TCP, TCP_NODELAY, (const char*)&enable, sizeof(enable)) == 0;
+		} else {
+			(void)bNoDelay;
+
+			return false;
+		}
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	int64_t SocketBase<_PROTOCOL>::Send(const void* data, const size_t size) noexcept
+	{
+#ifdef __WEISS__OS_WINDOWS
+
+		return CountSocketTransfer<_PROTOCOL>(send(this->m_socket, reinterpret_cast<const char*>(data), static_cast<int>(size), 0), true);
+
+#elif defined(__WEISS__OS_LINUX)
+
+		// A peer closing the connection must not raise SIGPIPE
+		return CountSocketTransfer<_PROTOCOL>(send(this->m_socket, data, size, MSG_NOSIGNAL), true);
+
+#endif
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	int64_t SocketBase<_PROTOCOL>::Receive(void* data, const size_t size) noexcept
+	{
+#ifdef __WEISS__OS_WINDOWS
+
+		return CountSocketTransfer<_PROTOCOL>(recv(this->m_socket, reinterpret_cast<char*>(data), static_cast<int>(size), 0), false);
+
+#elif defined(__WEISS__OS_LINUX)
+
+		return CountSocketTransfer<_PROTOCOL>(recv(this->m_socket, data, size, 0), false);
+
+#endif
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	int64_t SocketBase<_PROTOCOL>::SendTo(const void* data, const size_t size, const SocketAddress& address) noexcept
+	{
+		const sockaddr* pAddress    = address.IsSet() ? reinterpret_cast<const sockaddr*>(&address.m_address) : nullptr;
+		const int       addressSize = address.IsSet() ? static_cast<int>(sizeof(address.m_address)) : 0;
+
+#ifdef __WEISS__OS_WINDOWS
+
+		return CountSocketTransfer<_PROTOCOL>(sendto(this->m_socket, reinterpret_cast<const char*>(data), static_cast<int>(size), 0, pAddress, addressSize), true);
+
+#elif defined(__WEISS__OS_LINUX)
+
+		return CountSocketTransfer<_PROTOCOL>(sendto(this->m_socket, data, size, MSG_NOSIGNAL, pAddress, static_cast<socklen_t>(addressSize)), true);
+
+#endif
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	int64_t SocketBase<_PROTOCOL>::ReceiveFrom(void* data, const size_t size, SocketAddress& address) noexcept
+	{
+#ifdef __WEISS__OS_WINDOWS
+
+		int addressSize = sizeof(address.m_address);
+		return CountSocketTransfer<_PROTOCOL>(recvfrom(this->m_socket, reinterpret_cast<char*>(data), static_cast<int>(size), 0, reinterpret_cast<sockaddr*>(&address.m_address), &addressSize), false);
+
+#elif defined(__WEISS__OS_LINUX)
+
+		socklen_t addressSize = sizeof(address.m_address);
+		return CountSocketTransfer<_PROTOCOL>(recvfrom(this->m_socket, data, size, 0, reinterpret_cast<sockaddr*>(&address.m_address), &addressSize), false);
+
+#endif
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	int64_t SocketBase<_PROTOCOL>::SendDescriptors(const void* data, const size_t size, const int* fds, const size_t fdCount) noexcept
+	{
+#ifdef __WEISS__OS_LINUX
+
+		if constexpr (IsUnixProtocol(_PROTOCOL)) {
+			if (size == 0u || fdCount > WS_SOCKET_MAX_PASSED_DESCRIPTORS)
+				return -1;
+
+			alignas(cmsghdr) uint8_t control[CMSG_SPACE(sizeof(int) * WS_SOCKET_MAX_PASSED_DESCRIPTORS)];
+
+			iovec  vector{ const_cast<void*>(data), size };
+			msghdr message{};
+			message.msg_iov    = &vector;
+			message.msg_iovlen = 1;
+
+			if (fdCount > 0u) {
+				message.msg_control    = control;
+				message.msg_controllen = CMSG_SPACE(sizeof(int) * fdCount);
+
+				cmsghdr* pHeader    = CMSG_FIRSTHDR(&message);
+				pHeader->cmsg_level = SOL_SOCKET;
+				pHeader->cmsg_type  = SCM_RIGHTS;
+				pHeader->cmsg_len   = CMSG_LEN(sizeof(int) * fdCount);
+				std::memcpy(CMSG_DATA(pHeader), fds, sizeof(int) * fdCount);
+			}
+
+			return CountSocketTransfer<_PROTOCOL>(sendmsg(this->m_socket, &message, MSG_NOSIGNAL), true);
+		}
+
+#endif // __WEISS__OS_LINUX
+
+		return -1;
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	int64_t SocketBase<_PROTOCOL>::ReceiveDescriptors(void* data, const size_t size, int* fds, const size_t maxFdCount, size_t& fdCount) noexcept
+	{
+		fdCount = 0u;
+
+#ifdef __WEISS__OS_LINUX
+
+		if constexpr (IsUnixProtocol(_PROTOCOL)) {
+			alignas(cmsghdr) uint8_t control[CMSG_SPACE(sizeof(int) * WS_SOCKET_MAX_PASSED_DESCRIPTORS)];
+
+			iovec  vector{ data, size };
+			msghdr message{};
+			message.msg_iov        = &vector;
+			message.msg_iovlen     = 1;
+			message.msg_control    = control;
+			message.msg_controllen = sizeof(control);
+
+			const ssize_t nReceived = recvmsg(this->m_socket, &message, MSG_CMSG_CLOEXEC);
+
+			if (nReceived < 0)
+				return nReceived;
+
+			for (cmsghdr* pHeader = CMSG_FIRSTHDR(&message); pHeader != nullptr; pHeader = CMSG_NXTHDR(&message, pHeader)) {
+				if (pHeader->cmsg_level != SOL_SOCKET || pHeader->cmsg_type != SCM_RIGHTS)
+					continue;
+
+				const size_t count = (pHeader->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+
+				for (size_t i = 0u; i < count; i++) {
+					int fd;
+					std::memcpy(&fd, CMSG_DATA(pHeader) + i * sizeof(int), sizeof(int));
+
+					// The caller can't take more, the duplicate would leak otherwise
+					if (fdCount < maxFdCount)
+						fds[fdCount++] = fd;
+					else
+						close(fd);
+				}
+			}
+
+			return CountSocketTransfer<_PROTOCOL>(nReceived, false);
+		}
+
+#endif // __WEISS__OS_LINUX
+
+		return -1;
+	}
+
 	template <SocketProtocol _PROTOCOL>
 	void SocketBase<_PROTOCOL>::Disconnect() WS_NOEXCEPT
 	{
+		if (WS_IS_SOCKET_INVALID(this->m_socket))
+			return;
+
 		WS_CLOSE_SOCKET(this->m_socket);
 
 		WS_SET_SOCKET_TO_INVALID_STATE(this->m_socket);
@@ -17,57 +323,197 @@ namespace WS {
 	}
 
 	template <SocketProtocol _PROTOCOL>
-	[[nodiscard]] bool ClientSocket<_PROTOCOL>::Connect(const char* host, const uint16_t port) const WS_NOEXCEPT
+	[[nodiscard]] bool ClientSocket<_PROTOCOL>::Connect(const char* host, const uint16_t port) noexcept
 	{
-		sockaddr_in sockAddrIn;
-		sockAddrIn.sin_addr.s_addr = inet_addr(host);
-		sockAddrIn.sin_family      = AF_INET;
-		sockAddrIn.sin_port        = htons(port);
-																						   // TCP       // UDP
-		constexpr const int addressFamily = WS_SOCKET_SELECT_VALUE_PER_PROTOCOL(_PROTOCOL, AF_INET,     AF_INET);
-		constexpr const int type          = WS_SOCKET_SELECT_VALUE_PER_PROTOCOL(_PROTOCOL, SOCK_STREAM, SOCK_DGRAM);
-		constexpr const int protocol      = WS_SOCKET_SELECT_VALUE_PER_PROTOCOL(_PROTOCOL, IPPROTO_TCP, IPPROTO_UDP);
+		// Unix sockets connect to a path
+		if constexpr (IsUnixProtocol(_PROTOCOL))
+			return false;
 
-		this->m_socket = socket(addressFamily, type, protocol);
+		const SocketAddress address(host, port);
 
-		if (WS_IS_SOCKET_INVALID(this->m_socket)) {
-			WS_THROW("[WS] Failed To Open Socket");
+		if (!address.IsSet() || !this->Open())
 			return false;
-		}
 
-		if (WS_SOCKET_FAILED(connect(this->m_socket, (sockaddr*)&sockAddrIn, sizeof(sockAddrIn)))) {
-			WS_THROW("[WS] Failed To Connect Client Socket To Server Socket");
+		return !WS_SOCKET_FAILED(connect(this->m_socket, (const sockaddr*)&address.m_address, sizeof(address.m_address)));
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	[[nodiscard]] bool ClientSocket<_PROTOCOL>::Connect(const char* path) noexcept
+	{
+#ifdef __WEISS__OS_LINUX
+
+		sockaddr_un address;
+		socklen_t   addressSize;
+
+		// Only unix sockets connect to a path
+		if (!IsUnixProtocol(_PROTOCOL) || !MakeUnixAddress(path, address, addressSize) || !this->Open())
 			return false;
-		}
 
-		return true;
+		return !WS_SOCKET_FAILED(connect(this->m_socket, (sockaddr*)&address, addressSize));
+
+#else
+
+		return false;
+
+#endif
 	}
 
 	template <SocketProtocol _PROTOCOL>
-	[[nodiscard]] bool ServerSocket<_PROTOCOL>::Bind(const uint16_t port) const WS_NOEXCEPT
+	[[nodiscard]] bool ServerSocket<_PROTOCOL>::Bind(const uint16_t port, const bool bReusePort) noexcept
 	{
+		// Unix sockets bind to a path
+		if constexpr (IsUnixProtocol(_PROTOCOL))
+			return false;
+
 		sockaddr_in sockAddr;
 		sockAddr.sin_addr.s_addr = INADDR_ANY;
 		sockAddr.sin_family      = AF_INET;
 		sockAddr.sin_port        = htons(port);
 
-		if (WS_SOCKET_FAILED(bind(this->m_socket, (sockaddr*)&sockAddr, sizeof(sockAddr)))) {
-			WS_THROW("[SERVER SOCKET] Binding Failed");
+		if (!this->Open())
 			return false;
+
+		// Lets a restarted server bind while the previous connections are in TIME_WAIT
+		const int enable = 1;
+		setsockopt(this->m_socket, SOL_SOCKET, SO_REUSEADDR, (const char*)&enable, sizeof(enable));
+
+		if (bReusePort) {
+#ifdef __WEISS__OS_LINUX
+
+			const bool bFailed = setsockopt(this->m_socket, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) != 0;
+
+#else
+
+			const bool bFailed = true;
+
+#endif
+
+			if (bFailed)
+				return false;
 		}
 
-		return true;
+		return !WS_SOCKET_FAILED(bind(this->m_socket, (sockaddr*)&sockAddr, sizeof(sockAddr)));
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	[[nodiscard]] bool ServerSocket<_PROTOCOL>::Listen(const int backlog) const noexcept
+	{
+		return !WS_SOCKET_FAILED(listen(this->m_socket, backlog));
 	}
 
 	template <SocketProtocol _PROTOCOL>
-	[[nodiscard]] bool ServerSocket<_PROTOCOL>::Listen() const WS_NOEXCEPT
+	[[nodiscard]] bool ServerSocket<_PROTOCOL>::Bind(const char* path) noexcept
 	{
-		if (WS_SOCKET_FAILED(listen(this->m_socket, SOMAXCONN))) {
-			WS_THROW("[SERVER SOCKET] Listening Failed");
+#ifdef __WEISS__OS_LINUX
+
+		sockaddr_un address;
+		socklen_t   addressSize;
+
+		// Only unix sockets bind to a path
+		if (!IsUnixProtocol(_PROTOCOL) || !MakeUnixAddress(path, address, addressSize) || !this->Open())
 			return false;
+
+		// Only ever removes a socket file, never a regular one
+		struct stat status;
+		if (path[0] != '@' && stat(path, &status) == 0 && S_ISSOCK(status.st_mode))
+			unlink(path);
+
+		return !WS_SOCKET_FAILED(bind(this->m_socket, (sockaddr*)&address, addressSize));
+
+#else
+
+		return false;
+
+#endif
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	bool ServerSocket<_PROTOCOL>::SetDeferAccept(const int seconds) noexcept
+	{
+#ifdef __WEISS__OS_LINUX
+
+		if constexpr (_PROTOCOL == SocketProtocol::TCP)
+			return setsockopt(this->m_socket, IPPROTO_TCP, TCP_DEFER_ACCEPT, &seconds, sizeof(seconds)) == 0;
+
+#endif
+
+		return false;
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	bool ServerSocket<_PROTOCOL>::SetFastOpen(const int queueLength) noexcept
+	{
+		if constexpr (_PROTOCOL == SocketProtocol::TCP)
+			return setsockopt(this->m_socket, IPPROTO_TCP, TCP_FASTOPEN, (const char*)&queueLength, sizeof(queueLength)) == 0;
+
+		return false;
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	[[nodiscard]] ClientSocket<_PROTOCOL> ServerSocket<_PROTOCOL>::Accept() const noexcept
+	{
+		// Only stream sockets accept connections
+		if constexpr (!IsStreamProtocol(_PROTOCOL))
+			return ClientSocket<_PROTOCOL>();
+
+		// An invalid socket on failure (EINTR, ECONNABORTED, EMFILE...)
+		return ClientSocket<_PROTOCOL>(accept(this->m_socket, nullptr, nullptr));
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	[[nodiscard]] uint16_t ServerSocket<_PROTOCOL>::GetPort() const noexcept
+	{
+		if constexpr (IsUnixProtocol(_PROTOCOL))
+			return 0u;
+
+		sockaddr_in sockAddr;
+		socklen_t   sockAddrSize = sizeof(sockAddr);
+
+		if (WS_SOCKET_FAILED(getsockname(this->m_socket, (sockaddr*)&sockAddr, &sockAddrSize)))
+			return 0u;
+
+		return ntohs(sockAddr.sin_port);
+	}
+
+	template <SocketProtocol _PROTOCOL>
+	bool CreateSocketPair(ClientSocket<_PROTOCOL>& first, ClientSocket<_PROTOCOL>& second) noexcept
+	{
+#ifdef __WEISS__OS_LINUX
+
+		if constexpr (IsUnixProtocol(_PROTOCOL)) {
+			int fds[2];
+
+			if (socketpair(AF_UNIX, ((_PROTOCOL == SocketProtocol::UNIX) ? SOCK_STREAM : SOCK_DGRAM) | SOCK_CLOEXEC, 0, fds) != 0)
+				return false;
+
+			first  = ClientSocket<_PROTOCOL>(fds[0]);
+			second = ClientSocket<_PROTOCOL>(fds[1]);
+
+			return true;
 		}
 
-		return true;
+#endif // __WEISS__OS_LINUX
+
+		return false;
 	}
 
-}; // WS
\ No newline at end of file
+	// The templates are defined here, every protocol has to be instantiated explicitly
+	template class SocketBase<SocketProtocol::TCP>;
+	template class SocketBase<SocketProtocol::UDP>;
+	template class SocketBase<SocketProtocol::UNIX>;
+	template class SocketBase<SocketProtocol::UNIX_DATAGRAM>;
+
+	template class ClientSocket<SocketProtocol::TCP>;
+	template class ClientSocket<SocketProtocol::UDP>;
+	template class ClientSocket<SocketProtocol::UNIX>;
+	template class ClientSocket<SocketProtocol::UNIX_DATAGRAM>;
+
+	template class ServerSocket<SocketProtocol::TCP>;
+	template class ServerSocket<SocketProtocol::UDP>;
+	template class ServerSocket<SocketProtocol::UNIX>;
+	template class ServerSocket<SocketProtocol::UNIX_DATAGRAM>;
+
+	template bool CreateSocketPair(ClientSocket<SocketProtocol::UNIX>& first, ClientSocket<SocketProtocol::UNIX>& second) noexcept;
+	template bool CreateSocketPair(ClientSocket<SocketProtocol::UNIX_DATAGRAM>& first, ClientSocket<SocketProtocol::UNIX_DATAGRAM>& second) noexcept;
+
+}; // WS
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../misc/WSPch.h"
+#include "../debugging/WSMetrics.h"
 
 #ifdef __WEISS__OS_WINDOWS
 
@@ -18,6 +19,8 @@
 
 #define WS_SOCKET_FAILED(code) (code < 0)
 
+#define WS_SOCKET_MAX_PASSED_DESCRIPTORS 64u // File descriptors sent or received at once over a unix socket
+
 #define WS_SOCKET_SELECT_VALUE_PER_PROTOCOL(_PROTOCOL, tcpValue, udpValue) (SocketProtocol::TCP == _PROTOCOL ? tcpValue : (SocketProtocol::UDP == _PROTOCOL ? udpValue : 0))
 
 namespace WS {
@@ -33,16 +36,118 @@ namespace WS {
 #endif
 
 	enum class SocketProtocol {
-		TCP, // TCP
-		UDP  // UDP
+		TCP,          // TCP
+		UDP,          // UDP
+		UNIX,         // Unix domain stream socket, between processes of the same machine (linux only)
+		UNIX_DATAGRAM // Unix domain datagram socket, boundaries are kept & nothing is lost (linux only)
+	};
+
+	[[nodiscard]] constexpr bool IsUnixProtocol(const SocketProtocol protocol) noexcept { return protocol == SocketProtocol::UNIX || protocol == SocketProtocol::UNIX_DATAGRAM; }
+
+	[[nodiscard]] constexpr bool IsStreamProtocol(const SocketProtocol protocol) noexcept { return protocol == SocketProtocol::TCP || protocol == SocketProtocol::UNIX; }
+
+	// Adds the bytes of a successful transfer to the "socket.<protocol>.bytes_sent" or "socket.<protocol>.bytes_received" counter, returns "result"
+	template <SocketProtocol _PROTOCOL>
+	inline int64_t CountSocketTransfer(const int64_t result, const bool bSent) noexcept
+	{
+		static constexpr const char* PREFIXES[] = { "socket.tcp.", "socket.udp.", "socket.unix.", "socket.unix_datagram." };
+
+		static Counter& s_bytesSent     = MetricsRegistry::Get().GetCounter(std::string(PREFIXES[static_cast<size_t>(_PROTOCOL)]) + "bytes_sent");
+		static Counter& s_bytesReceived = MetricsRegistry::Get().GetCounter(std::string(PREFIXES[static_cast<size_t>(_PROTOCOL)]) + "bytes_received");
+
+		if (result > 0)
+			(bSent ? s_bytesSent : s_bytesReceived).Add(static_cast<uint64_t>(result));
+
+		return result;
+	}
+
+	/*
+	 * An IPv4 address & port.
+	 * A default constructed address is unset, datagrams sent to it go to the socket's connected peer.
+	 */
+	struct SocketAddress {
+		sockaddr_in m_address{};
+
+		SocketAddress() = default;
+
+		// "host" is a dotted IPv4 address, the address stays unset if it can't be parsed
+		SocketAddress(const char* host, const uint16_t port) noexcept;
+
+		explicit SocketAddress(const sockaddr_in& address) noexcept : m_address(address) {  }
+
+		[[nodiscard]] inline bool     IsSet()   const noexcept { return this->m_address.sin_family == AF_INET; }
+		[[nodiscard]] inline uint16_t GetPort() const noexcept { return ntohs(this->m_address.sin_port);     }
+
+		// "a.b.c.d:port"
+		[[nodiscard]] std::string ToString() const noexcept;
+
+		[[nodiscard]] inline bool operator==(const SocketAddress& other) const noexcept
+		{
+			return this->m_address.sin_addr.s_addr == other.m_address.sin_addr.s_addr && this->m_address.sin_port == other.m_address.sin_port &&
+			       this->m_address.sin_family == other.m_address.sin_family;
+		}
 	};
 
+	/*
+	 * Owns a socket handle, sockets can be moved but not copied.
+	 * Failures are reported through return values rather than thrown : false, an invalid socket or,
+	 * for Send() & Receive(), a negative value (which includes "would block" on non blocking sockets).
+	 */
 	template <SocketProtocol _PROTOCOL>
 	class SocketBase {
 	protected:
 		WS_SOCKET_TYPE m_socket;
-	
+
+	protected:
+		// Opens a new socket, closing the current one
+		[[nodiscard]] bool Open() noexcept;
+
 	public:
+		SocketBase() noexcept;
+
+		// Takes ownership of "socket"
+		explicit SocketBase(const WS_SOCKET_TYPE socket) noexcept;
+
+		SocketBase(SocketBase&& other) noexcept;
+		SocketBase& operator=(SocketBase&& other) noexcept;
+
+		SocketBase(const SocketBase&) = delete;
+		SocketBase& operator=(const SocketBase&) = delete;
+
+		[[nodiscard]] inline bool IsValid() const noexcept { return !WS_IS_SOCKET_INVALID(this->m_socket); }
+
+		[[nodiscard]] inline WS_SOCKET_TYPE GetHandle() const noexcept { return this->m_socket; }
+
+		// Gives up ownership of the handle, i.e to hand it over to an event loop
+		[[nodiscard]] WS_SOCKET_TYPE Release() noexcept;
+
+		[[nodiscard]] bool SetNonBlocking(const bool bNonBlocking) noexcept;
+
+		// Kernel buffer sizes in bytes, larger buffers absorb bursts of datagrams between two receives (0 keeps a size)
+		[[nodiscard]] bool SetBufferSizes(const int receiveSize, const int sendSize) noexcept;
+
+		// Disables Nagle's algorithm (TCP_NODELAY) so small writes leave immediately, TCP only
+		[[nodiscard]] bool SetNoDelay(const bool bNoDelay) noexcept;
+
+		[[nodiscard]] int64_t Send(const void* data, const size_t size) noexcept;
+
+		[[nodiscard]] int64_t Receive(void* data, const size_t size) noexcept;
+
+		// Sends a single datagram, to the connected peer if "address" is unset
+		[[nodiscard]] int64_t SendTo(const void* data, const size_t size, const SocketAddress& address) noexcept;
+
+		// Receives a single datagram & the address it comes from, the rest of a datagram larger than "size" is lost
+		[[nodiscard]] int64_t ReceiveFrom(void* data, const size_t size, SocketAddress& address) noexcept;
+
+		/*
+		 * Sends "data" (at least one byte) along with "fdCount" file descriptors, the peer receives duplicates of them (unix sockets only).
+		 * The descriptors are attached to the first byte sent, stream peers get them with the Receive call that reads it.
+		 */
+		[[nodiscard]] int64_t SendDescriptors(const void* data, const size_t size, const int* fds, const size_t fdCount) noexcept;
+
+		// Receives bytes & at most "maxFdCount" file descriptors (unix sockets only), any other descriptor that came along is closed
+		[[nodiscard]] int64_t ReceiveDescriptors(void* data, const size_t size, int* fds, const size_t maxFdCount, size_t& fdCount) noexcept;
+
 		void Disconnect() WS_NOEXCEPT;
 
 		~SocketBase() WS_NOEXCEPT;
@@ -50,26 +155,54 @@ namespace WS {
 
 	template <SocketProtocol _PROTOCOL>
 	class ClientSocket : public SocketBase<_PROTOCOL> {
-	private:
-		WS_SOCKET_TYPE m_socket;
-
 	public:
 		ClientSocket() = default;
 
-		[[nodiscard]] bool Connect(const char* host, const uint16_t port) const WS_NOEXCEPT;
+		// Takes ownership of an already connected socket (see ServerSocket::Accept)
+		explicit ClientSocket(const WS_SOCKET_TYPE socket) noexcept : SocketBase<_PROTOCOL>(socket) {  }
+
+		// "host" is a dotted IPv4 address, fails if it can't be parsed
+		[[nodiscard]] bool Connect(const char* host, const uint16_t port) noexcept;
+
+		// Connects a unix socket to the one bound to "path", a leading '@' designates the abstract namespace (linux only)
+		[[nodiscard]] bool Connect(const char* path) noexcept;
 	};
 
 	template <SocketProtocol _PROTOCOL>
 	class ServerSocket : public SocketBase<_PROTOCOL> {
-	private:
-		WS_SOCKET_TYPE m_socket;
-	
 	public:
 		ServerSocket() = default;
 
-		[[nodiscard]] bool Bind(const uint16_t port) const WS_NOEXCEPT;
+		/*
+		 * Opens the socket & binds it to every interface.
+		 * "bReusePort" (SO_REUSEPORT, linux only) lets several sockets bind to the same port, the kernel then spreads
+		 * the incoming connections (or datagrams) over them instead of queueing them all on a single socket.
+		 */
+		[[nodiscard]] bool Bind(const uint16_t port, const bool bReusePort = false) noexcept;
+
+		/*
+		 * Opens a unix socket & binds it to "path", replacing a socket file left there by a previous run.
+		 * A leading '@' binds in the abstract namespace instead, which leaves no file behind.
+		 */
+		[[nodiscard]] bool Bind(const char* path) noexcept;
+
+		[[nodiscard]] bool Listen(const int backlog = SOMAXCONN) const noexcept;
 
-		[[nodiscard]] bool Listen() const WS_NOEXCEPT;
+		// Only wakes the accepting side once a client sent data, or after "seconds" (TCP_DEFER_ACCEPT, linux only)
+		[[nodiscard]] bool SetDeferAccept(const int seconds) noexcept;
+
+		// Lets clients send data with their SYN, "queueLength" bounds the pending fast open requests (TCP_FASTOPEN, before Listen())
+		[[nodiscard]] bool SetFastOpen(const int queueLength) noexcept;
+
+		// Blocks until a client connects (TCP & UNIX only), the returned socket is invalid on failure
+		[[nodiscard]] ClientSocket<_PROTOCOL> Accept() const noexcept;
+
+		// Port the socket is bound to, useful after binding to port 0
+		[[nodiscard]] uint16_t GetPort() const noexcept;
 	};
 
-}; // WS
\ No newline at end of file
+	// Creates two unix sockets connected to each other, i.e to share with a child process (linux only)
+	template <SocketProtocol _PROTOCOL>
+	[[nodiscard]] bool CreateSocketPair(ClientSocket<_PROTOCOL>& first, ClientSocket<_PROTOCOL>& second) noexcept;
+
+}; // WS
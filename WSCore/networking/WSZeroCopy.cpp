@@ -0,0 +1,234 @@
+#include "WSZeroCopy.h"
+
+#ifdef __WEISS__OS_LINUX
+
+namespace WS {
+
+	TransmitMethod ChooseTransmitMethod(const int sourceFd, const size_t size, const bool bZeroCopyAvailable) noexcept
+	{
+		if (sourceFd < 0)
+			return (bZeroCopyAvailable && size >= WS_ZERO_COPY_THRESHOLD) ? TransmitMethod::ZEROCOPY : TransmitMethod::COPY;
+
+		struct stat status;
+		if (fstat(sourceFd, &status) != 0)
+			return TransmitMethod::COPY;
+
+		if (S_ISREG(status.st_mode))  return TransmitMethod::SENDFILE;
+		if (S_ISFIFO(status.st_mode)) return TransmitMethod::SPLICE;
+
+		return TransmitMethod::COPY;
+	}
+
+	ZeroCopySender::ZeroCopySender(const int socketFd, const size_t zeroCopyThreshold) noexcept
+		: m_socket(socketFd), m_zeroCopyThreshold(zeroCopyThreshold)
+	{
+		const int enable = 1;
+
+		this->m_bZeroCopyEnabled = setsockopt(socketFd, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) == 0;
+	}
+
+	int64_t ZeroCopySender::Send(const void* data, const size_t size, uint32_t& ticket) noexcept
+	{
+		ticket = 0u;
+
+		if (this->m_bZeroCopyEnabled && size >= this->m_zeroCopyThreshold) {
+			const ssize_t nSent = send(this->m_socket, data, size, MSG_ZEROCOPY | MSG_NOSIGNAL);
+
+			// Every successful call is given the next id, even when only part of the buffer was taken
+			if (nSent >= 0) {
+				ticket = ++this->m_nZeroCopySends;
+
+				return static_cast<int64_t>(nSent);
+			}
+
+			// ENOBUFS : the socket's pinned memory limit (optmem_max) is reached, the bytes are copied instead
+			if (errno != ENOBUFS)
+				return -1;
+		}
+
+		return static_cast<int64_t>(send(this->m_socket, data, size, MSG_NOSIGNAL));
+	}
+
+	int64_t ZeroCopySender::SendFile(const int fileFd, uint64_t& offset, const size_t size) noexcept
+	{
+		size_t total = 0u;
+
+		while (total < size) {
+			off_t position = static_cast<off_t>(offset);
+
+			const ssize_t nSent = sendfile(this->m_socket, fileFd, &position, size - total);
+
+			if (nSent <= 0) {
+				if (nSent < 0 && errno == EINTR)
+					continue;
+
+				// End of file, or "would block" once some bytes were sent
+				if (nSent == 0 || total > 0u)
+					break;
+
+				return -1;
+			}
+
+			offset += static_cast<uint64_t>(nSent);
+			total  += static_cast<size_t>(nSent);
+		}
+
+		return static_cast<int64_t>(total);
+	}
+
+	int64_t ZeroCopySender::SendPipe(const int pipeFd, const size_t size) noexcept
+	{
+		size_t total = 0u;
+
+		while (total < size) {
+			const ssize_t nMoved = splice(pipeFd, nullptr, this->m_socket, nullptr, size - total, SPLICE_F_MOVE | SPLICE_F_MORE | SPLICE_F_NONBLOCK);
+
+			if (nMoved <= 0) {
+				if (nMoved < 0 && errno == EINTR)
+					continue;
+
+				if (nMoved == 0 || total > 0u)
+					break;
+
+				return -1;
+			}
+
+			total += static_cast<size_t>(nMoved);
+		}
+
+		return static_cast<int64_t>(total);
+	}
+
+	int64_t ZeroCopySender::SendCopy(const int sourceFd, uint64_t& offset, const size_t size) noexcept
+	{
+		if (this->m_copyBuffer.size() < WS_ZERO_COPY_FILE_CHUNK_SIZE)
+			this->m_copyBuffer.resize(WS_ZERO_COPY_FILE_CHUNK_SIZE);
+
+		size_t total = 0u;
+
+		while (total < size) {
+			const ssize_t nRead = read(sourceFd, this->m_copyBuffer.data(), std::min(size - total, this->m_copyBuffer.size()));
+
+			if (nRead <= 0) {
+				if (nRead < 0 && errno == EINTR)
+					continue;
+
+				if (nRead == 0 || total > 0u)
+					break;
+
+				return -1;
+			}
+
+			// Bytes read from a stream can't be put back, they're all sent even if the socket has to be waited for
+			for (ssize_t sent = 0; sent < nRead; ) {
+				const ssize_t nSent = send(this->m_socket, this->m_copyBuffer.data() + sent, static_cast<size_t>(nRead - sent), MSG_NOSIGNAL);
+
+				if (nSent < 0) {
+					if (errno == EINTR)
+						continue;
+
+					if (errno == EAGAIN || errno == EWOULDBLOCK) {
+						pollfd descriptor{ this->m_socket, POLLOUT, 0 };
+						poll(&descriptor, 1u, -1);
+						continue;
+					}
+
+					return -1;
+				}
+
+				sent += nSent;
+			}
+
+			offset += static_cast<uint64_t>(nRead);
+			total  += static_cast<size_t>(nRead);
+		}
+
+		return static_cast<int64_t>(total);
+	}
+
+	int64_t ZeroCopySender::Transmit(const int sourceFd, uint64_t& offset, const size_t size) noexcept
+	{
+		switch (ChooseTransmitMethod(sourceFd, size, this->m_bZeroCopyEnabled)) {
+		case TransmitMethod::SENDFILE: return this->SendFile(sourceFd, offset, size);
+		case TransmitMethod::SPLICE:   return this->SendPipe(sourceFd, size);
+		default:                       return this->SendCopy(sourceFd, offset, size);
+		}
+	}
+
+	size_t ZeroCopySender::ReapCompletions() noexcept
+	{
+		size_t nReleased = 0u;
+
+		while (this->GetPendingCount() > 0u) {
+			uint64_t control[(CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6)) + sizeof(uint64_t) - 1u) / sizeof(uint64_t)];
+
+			msghdr message{};
+			message.msg_control    = control;
+			message.msg_controllen = sizeof(control);
+
+			if (recvmsg(this->m_socket, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+				break;
+
+			for (cmsghdr* pControl = CMSG_FIRSTHDR(&message); pControl != nullptr; pControl = CMSG_NXTHDR(&message, pControl)) {
+				if (!((pControl->cmsg_level == SOL_IP   && pControl->cmsg_type == IP_RECVERR) ||
+				      (pControl->cmsg_level == SOL_IPV6 && pControl->cmsg_type == IPV6_RECVERR)))
+					continue;
+
+				sock_extended_err error;
+				std::memcpy(&error, CMSG_DATA(pControl), sizeof(error));
+
+				if (error.ee_origin != SO_EE_ORIGIN_ZEROCOPY || error.ee_errno != 0u)
+					continue;
+
+				// The notification covers the ids [ee_info, ee_data], the tickets are the ids plus one
+				const uint32_t nCompleted = error.ee_data - error.ee_info + 1u;
+
+				nReleased        += nCompleted;
+				this->m_nReleased = error.ee_data + 1u;
+
+				// The kernel had to copy the pages anyway (i.e loopback or a device without scatter-gather) : pinning them only costs
+				if ((error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0u) {
+					this->m_copiedStreak += nCompleted;
+
+					if (this->m_copiedStreak >= WS_ZERO_COPY_MAX_COPIED_STREAK)
+						this->m_bZeroCopyEnabled = false;
+				} else {
+					this->m_copiedStreak = 0u;
+				}
+			}
+		}
+
+		return nReleased;
+	}
+
+	bool ZeroCopySender::WaitForCompletions(const int timeout) noexcept
+	{
+		const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(timeout, 0));
+
+		this->ReapCompletions();
+
+		while (this->GetPendingCount() > 0u) {
+			int remaining = -1;
+
+			if (timeout >= 0) {
+				remaining = static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count());
+
+				if (remaining <= 0)
+					return false;
+			}
+
+			// A non empty error queue is reported as POLLERR, which doesn't need to be requested
+			pollfd descriptor{ this->m_socket, 0, 0 };
+
+			if (poll(&descriptor, 1u, remaining) < 0 && errno != EINTR)
+				return false;
+
+			this->ReapCompletions();
+		}
+
+		return true;
+	}
+
+}; // WS
+
+#endif // __WEISS__OS_LINUX
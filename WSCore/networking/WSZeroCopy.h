@@ -0,0 +1,86 @@
+#pragma once
+
+#include "WSSocket.h"
+#include "../misc/WSPch.h"
+
+#ifdef __WEISS__OS_LINUX
+
+#define WS_ZERO_COPY_THRESHOLD           16384u // Smaller buffers are cheaper to copy than to pin & wait for
+#define WS_ZERO_COPY_MAX_COPIED_STREAK   8u     // Sends the kernel had to copy anyway (i.e loopback) before MSG_ZEROCOPY is given up
+#define WS_ZERO_COPY_FILE_CHUNK_SIZE     65536u // Bytes read per call when a source can only be copied
+
+namespace WS {
+
+	// How bytes reach a socket
+	enum class TransmitMethod : uint8_t {
+		COPY,     // send() / read() + send() : the bytes go through user space
+		ZEROCOPY, // send(MSG_ZEROCOPY) : the kernel transmits from the caller's pages, which it releases later
+		SENDFILE, // sendfile() : from the page cache of a regular file
+		SPLICE    // splice() : the pages of a pipe are moved to the socket
+	};
+
+	/*
+	 * Picks the cheapest way to transmit "size" bytes,
+	 * from memory when "sourceFd" is negative or from a file descriptor otherwise.
+	 */
+	[[nodiscard]] TransmitMethod ChooseTransmitMethod(const int sourceFd, const size_t size, const bool bZeroCopyAvailable = true) noexcept;
+
+	/*
+	 * Sends buffers, files & pipes over a TCP socket without copying them through user space when it pays off.
+	 *
+	 * Buffers of at least "zeroCopyThreshold" bytes are sent with MSG_ZEROCOPY : they must stay untouched until
+	 * the ticket returned for them is released, which the kernel reports through the socket's error queue (see ReapCompletions()).
+	 * The sender doesn't own the socket & must only be used by one thread at a time.
+	 */
+	class ZeroCopySender {
+	private:
+		int    m_socket;
+		size_t m_zeroCopyThreshold;
+		bool   m_bZeroCopyEnabled = false;
+
+		uint32_t m_nZeroCopySends = 0u; // Zero copy sends issued, the kernel numbers them from 0
+		uint32_t m_nReleased      = 0u; // Zero copy sends whose pages were released (the kernel completes them in order)
+		uint32_t m_copiedStreak   = 0u;
+
+		std::vector<uint8_t> m_copyBuffer;
+
+	private:
+		[[nodiscard]] int64_t SendCopy(const int sourceFd, uint64_t& offset, const size_t size) noexcept;
+
+	public:
+		explicit ZeroCopySender(const int socketFd, const size_t zeroCopyThreshold = WS_ZERO_COPY_THRESHOLD) noexcept;
+
+		explicit ZeroCopySender(SocketBase<SocketProtocol::TCP>& socket, const size_t zeroCopyThreshold = WS_ZERO_COPY_THRESHOLD) noexcept
+			: ZeroCopySender(socket.GetHandle(), zeroCopyThreshold) {  }
+
+		// False when the kernel doesn't support SO_ZEROCOPY or gave up on it, buffers are then always copied
+		[[nodiscard]] inline bool IsZeroCopyEnabled() const noexcept { return this->m_bZeroCopyEnabled; }
+
+		/*
+		 * Sends "data", returns the number of bytes sent or a negative value on failure (including "would block").
+		 * "ticket" is 0 if the bytes were copied, otherwise "data" must not change until IsReleased(ticket).
+		 */
+		[[nodiscard]] int64_t Send(const void* data, const size_t size, uint32_t& ticket) noexcept;
+
+		// Sends "size" bytes of a regular file from "offset", which is advanced by the number of bytes sent
+		[[nodiscard]] int64_t SendFile(const int fileFd, uint64_t& offset, const size_t size) noexcept;
+
+		// Moves up to "size" bytes from the read end of a pipe to the socket
+		[[nodiscard]] int64_t SendPipe(const int pipeFd, const size_t size) noexcept;
+
+		// Sends from any descriptor with the method ChooseTransmitMethod() picks, "offset" is only used by regular files
+		[[nodiscard]] int64_t Transmit(const int sourceFd, uint64_t& offset, const size_t size) noexcept;
+
+		// Reads the completions queued on the socket's error queue without blocking, returns the number of tickets released
+		size_t ReapCompletions() noexcept;
+
+		// Waits at most "timeout" milliseconds (negative : forever) for every ticket to be released, false on timeout
+		bool WaitForCompletions(const int timeout = -1) noexcept;
+
+		[[nodiscard]] inline bool     IsReleased(const uint32_t ticket) const noexcept { return ticket == 0u || ticket <= this->m_nReleased; }
+		[[nodiscard]] inline uint32_t GetPendingCount()                 const noexcept { return this->m_nZeroCopySends - this->m_nReleased; }
+	};
+
+}; // WS
+
+#endif // __WEISS__OS_LINUX
@@ -103,6 +103,9 @@ namespace WS {
 
 	void Window::Update() WS_NOEXCEPT
 	{
+		WS_PROFILE_SCOPE("Window::Update");
+
+		this->RecordUpdateMetrics();
 		this->m_mouse.PrepareForUpdate();
 
 		MSG msg = { };
@@ -246,6 +249,9 @@ namespace WS {
 
 	void Window::Update() WS_NOEXCEPT
 	{
+		WS_PROFILE_SCOPE("Window::Update");
+
+		this->RecordUpdateMetrics();
 		this->m_mouse.PrepareForUpdate();
 
 		// Process Events
@@ -321,6 +327,21 @@ namespace WS {
 
 #endif
 
+	void Window::RecordUpdateMetrics() noexcept
+	{
+		static Counter&   s_updates   = MetricsRegistry::Get().GetCounter("window.updates");
+		static Histogram& s_frameTime = MetricsRegistry::Get().GetHistogram("window.frame_time_ns");
+
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+		// The first update has no previous frame
+		if (this->m_lastUpdateTime != std::chrono::steady_clock::time_point())
+			s_frameTime.Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - this->m_lastUpdateTime).count()));
+
+		this->m_lastUpdateTime = now;
+		s_updates.Add();
+	}
+
 	Window::~Window() WS_NOEXCEPT
 	{
 		if (this->m_bIsRunning)
@@ -3,6 +3,8 @@
 #include "WSPeripheral.h"
 #include "../misc/WSPch.h"
 #include "../math/WSVector.h"
+#include "../debugging/WSProfiler.h"
+#include "../debugging/WSMetrics.h"
 
 namespace WS {
 
@@ -32,6 +34,12 @@ namespace WS {
 
         bool m_bIsRunning = false;
 
+        std::chrono::steady_clock::time_point m_lastUpdateTime; // Of the previous Update(), for the frame time histogram
+
+    private:
+        // Counts the update & records the time since the previous one
+        void RecordUpdateMetrics() noexcept;
+
     public:
         Window() = delete;
 
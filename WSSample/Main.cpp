@@ -2,11 +2,22 @@
 
 int WS::EntryPoint(int argc, char** argv) {
     WS::Window window("Weiss Test", 1920 / 2, 720);
-    //WS::Image test("Branding/icon64x64.png");
+
+    WS::ImageLoader imageLoader;
+    WS::ImageLoadHandle iconHandle = imageLoader.LoadImageAsync("Branding/icon64x64.png");
 
     while (window.IsRunning()) {
         window.Update();
 
+        imageLoader.PollCompleted([](WS::ImageLoadHandle& handle) {
+            if (handle.GetStatus() == WS::ImageLoadStatus::COMPLETED) {
+                const WS::Image image = handle.TakeImage();
+                WS::Print("Loaded ", handle.GetPath(), " (", image.GetWidth(), 'x', image.GetHeight(), ')');
+            } else {
+                WS::Print("Failed To Load ", handle.GetPath(), " : ", handle.GetError());
+            }
+        });
+
         std::this_thread::sleep_for(std::chrono::milliseconds(16));
     }
 
@@ -0,0 +1,78 @@
+#include <WSCore/WSInclude.h>
+
+/*
+ * WeissLogDecode [options] <binary log>
+ *
+ * Turns a log written by a WS::BinaryFileSink into the lines a console or file sink would have written.
+ *
+ * Options :
+ *   -o <file>      Output file (defaults to the standard output)
+ *   -l <level>     Skips the records below this level (trace, debug, info, success, warning or error)
+ */
+
+static void PrintUsage() noexcept
+{
+    WS::Print("Usage : WeissLogDecode [-o <file>] [-l trace|debug|info|success|warning|error] <binary log>");
+}
+
+int WS::EntryPoint(int argc, char** argv) {
+    std::string input;
+    std::string outputPath;
+    WS::LogLevel minLevel = WS::LogLevel::TRACE;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-o" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (argument == "-l" && i + 1 < argc) {
+            if (!WS::ParseLogLevel(argv[++i], minLevel)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (argument.starts_with("-") || !input.empty()) {
+            PrintUsage();
+            return 1;
+        } else {
+            input = argument;
+        }
+    }
+
+    if (input.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::ifstream file(input, std::ios::binary);
+    if (!file) {
+        WS::Print(input, " : could not open the file");
+        return 1;
+    }
+
+    const std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::FILE* pOutput = outputPath.empty() ? stdout : std::fopen(outputPath.c_str(), "wb");
+    if (pOutput == nullptr) {
+        WS::Print(outputPath, " : could not open the file");
+        return 1;
+    }
+
+    size_t nLines = 0u;
+    const bool bValid = WS::DecodeBinaryLog(data.data(), data.size(), [&](const WS::LogLevel level, const std::string_view line) {
+        if (level >= minLevel) {
+            std::fwrite(line.data(), 1u, line.size(), pOutput);
+            nLines++;
+        }
+    });
+
+    if (pOutput != stdout)
+        std::fclose(pOutput);
+
+    // A log whose program didn't exit cleanly usually ends with a truncated batch
+    if (!bValid) {
+        WS::Print(input, " : malformed or truncated after ", nLines, " lines");
+        return 1;
+    }
+
+    return 0;
+}
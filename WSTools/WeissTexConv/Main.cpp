@@ -0,0 +1,147 @@
+#include <WSCore/WSInclude.h>
+
+#include <filesystem>
+
+/*
+ * WeissTexConv [options] <input images...>
+ *
+ * Converts every input image to Weiss' native texture container (.wstex), one file per thread.
+ *
+ * Options :
+ *   -o <directory>  Output directory (defaults to each input's directory)
+ *   --no-mips       Only store the base level
+ *   --linear        The input isn't sRGB encoded (normal maps, masks...)
+ *   -j <threads>    Number of conversion threads (defaults to one per hardware thread)
+ *   -f <format>     rgba8 (default), bc1, bc3 or bc7
+ *   -q <quality>    BC7 encoder quality : fast, normal (default) or slow
+ *
+ * Block compressed outputs report the PSNR of their base level against the input.
+ * Inputs that don't decode to any pixel are reported and skipped, the tool then exits with 1.
+ */
+
+static void PrintUsage() noexcept
+{
+    WS::Print("Usage : WeissTexConv [-o <directory>] [--no-mips] [--linear] [-j <threads>] [-f rgba8|bc1|bc3|bc7] [-q fast|normal|slow] <input images...>");
+}
+
+static bool ParseFormat(const std::string& name, WS::TextureFormat& format) noexcept
+{
+    if      (name == "rgba8") format = WS::TextureFormat::RGBA8;
+    else if (name == "bc1")   format = WS::TextureFormat::BC1;
+    else if (name == "bc3")   format = WS::TextureFormat::BC3;
+    else if (name == "bc7")   format = WS::TextureFormat::BC7;
+    else return false;
+
+    return true;
+}
+
+static bool ParseQuality(const std::string& name, WS::BC7Quality& quality) noexcept
+{
+    if      (name == "fast")   quality = WS::BC7Quality::FAST;
+    else if (name == "normal") quality = WS::BC7Quality::NORMAL;
+    else if (name == "slow")   quality = WS::BC7Quality::SLOW;
+    else return false;
+
+    return true;
+}
+
+int WS::EntryPoint(int argc, char** argv) {
+    std::vector<std::filesystem::path> inputs;
+    std::filesystem::path outputDirectory;
+    WS::TextureFileWriteOptions options;
+    size_t nThreads = 0u;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+
+        if (argument == "-o" && i + 1 < argc) {
+            outputDirectory = argv[++i];
+        } else if (argument == "-j" && i + 1 < argc) {
+            nThreads = std::strtoul(argv[++i], nullptr, 10);
+        } else if (argument == "-f" && i + 1 < argc) {
+            if (!ParseFormat(argv[++i], options.m_format)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (argument == "-q" && i + 1 < argc) {
+            if (!ParseQuality(argv[++i], options.m_bc7Quality)) {
+                PrintUsage();
+                return 1;
+            }
+        } else if (argument == "--no-mips") {
+            options.m_bGenerateMips = false;
+        } else if (argument == "--linear") {
+            options.m_bSRGB = false;
+        } else if (argument.starts_with("-")) {
+            PrintUsage();
+            return 1;
+        } else {
+            inputs.emplace_back(argument);
+        }
+    }
+
+    if (inputs.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::mutex printMutex;
+    std::atomic<size_t> nFailures = 0u;
+
+    {
+        WS::ThreadPool pool(nThreads);
+
+        for (const std::filesystem::path& input : inputs) {
+            pool.Submit([&, input]() {
+                std::filesystem::path output = input;
+                output.replace_extension(".wstex");
+
+                if (!outputDirectory.empty())
+                    output = outputDirectory / output.filename();
+
+                std::string error;
+                double psnr = 0.0;
+                WS::Image image;
+
+                // The PNG decoder doesn't inflate IDAT yet : nothing is written rather than an empty texture
+                if (image.Load(input.string().c_str(), &error) && image.GetPixelCount() == 0u)
+                    error = "the image has no decoded pixels (the PNG decoder only reads headers for now), nothing was written";
+
+                if (error.empty()) {
+                    try {
+                        if (!WS::WriteTextureFile(output.string().c_str(), image, options)) {
+                            error = "could not write the texture file";
+                        } else if (options.m_format != WS::TextureFormat::RGBA8) {
+                            const WS::TextureFile file(output.string().c_str());
+
+                            if (!file.IsValid()) {
+                                error = "could not map the written texture file";
+                            } else {
+                                const WS::Image decoded = WS::DecodeBlocks(file.GetMipData(0u), file.GetFormat(), file.GetWidth(), file.GetHeight());
+
+                                psnr = WS::ComputePSNR(image, decoded, options.m_format != WS::TextureFormat::BC1);
+                            }
+                        }
+                    } catch (const std::exception& e) {
+                        error = e.what();
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(printMutex);
+
+                if (error.empty() && options.m_format != WS::TextureFormat::RGBA8) {
+                    WS::Print(input.string(), " -> ", output.string(), " (PSNR ", psnr, " dB)");
+                } else if (error.empty()) {
+                    WS::Print(input.string(), " -> ", output.string());
+                } else {
+                    WS::Print(input.string(), " : ", error);
+                    nFailures++;
+                }
+            });
+        }
+
+        pool.WaitIdle();
+    }
+
+    return nFailures == 0u ? 0 : 1;
+}